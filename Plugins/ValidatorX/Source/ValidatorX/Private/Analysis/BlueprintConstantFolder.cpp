@@ -0,0 +1,232 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "Analysis/BlueprintConstantFolder.h"
+#include "Analysis/BlueprintSnapshot.h"
+#include "EdGraphSchema_K2.h"
+
+namespace
+{
+	/** Package of the Kismet libraries declaring the folded operators. */
+	const FName ConstantFolderEnginePackage(TEXT("/Script/Engine"));
+
+	/** Pin names of reroute nodes. */
+	const FName ConstantFolderKnotInput(TEXT("InputPin"));
+	const FName ConstantFolderKnotOutput(TEXT("OutputPin"));
+
+	/** @return Whether literals of a type are booleans or numbers; objects, classes and text keep theirs outside `DefaultValue`. */
+	bool IsFoldableConstantType(FName Category, bool bIsEnum)
+	{
+		return Category == UEdGraphSchema_K2::PC_Boolean
+			|| (Category == UEdGraphSchema_K2::PC_Byte && !bIsEnum)
+			|| Category == UEdGraphSchema_K2::PC_Int
+			|| Category == UEdGraphSchema_K2::PC_Int64
+			|| Category == UEdGraphSchema_K2::PC_Real;
+	}
+
+	TOptional<double> MakeFoldedBool(bool bValue)
+	{
+		return bValue ? 1.0 : 0.0;
+	}
+} // namespace
+
+FBlueprintConstantFolder::FBlueprintConstantFolder(const FBlueprintSnapshot& InSnapshot, TFunction<bool(const FBlueprintSnapshotVariable&)> InIsConstantMember)
+	: Snapshot(InSnapshot)
+	, IsConstantMember(MoveTemp(InIsConstantMember))
+{
+	for (int32 VariableIndex = 0; VariableIndex < Snapshot.Variables.Num(); ++VariableIndex)
+	{
+		for (const int32 NodeIndex : Snapshot.FindVariableReads(VariableIndex))
+		{
+			GetNodeVariables.Add(NodeIndex, VariableIndex);
+		}
+	}
+}
+
+TOptional<double> FBlueprintConstantFolder::FoldInput(int32 PinIndex)
+{
+	const TConstArrayView<FBlueprintSnapshotLink> Links = Snapshot.GetLinks(PinIndex);
+	if (Links.IsEmpty())
+	{
+		const FBlueprintSnapshotPin& Pin = Snapshot.Pins[PinIndex];
+		return IsFoldableConstantType(Pin.Category, Pin.bIsEnum) ? ParseConstant(Pin.DefaultValue) : TOptional<double>();
+	}
+	return Links.Num() == 1 ? FoldOutput(Links[0].ToPin) : TOptional<double>();
+}
+
+TOptional<double> FBlueprintConstantFolder::ParseConstant(const FString& DefaultValue)
+{
+	if (DefaultValue.IsEmpty())
+	{
+		return 0.0;
+	}
+	if (DefaultValue.Equals(TEXT("true"), ESearchCase::IgnoreCase))
+	{
+		return 1.0;
+	}
+	if (DefaultValue.Equals(TEXT("false"), ESearchCase::IgnoreCase))
+	{
+		return 0.0;
+	}
+	if (DefaultValue.IsNumeric())
+	{
+		return FCString::Atod(*DefaultValue);
+	}
+	return {};
+}
+
+TOptional<double> FBlueprintConstantFolder::FoldOutput(int32 PinIndex)
+{
+	if (const TOptional<double>* const Folded = FoldedOutputs.Find(PinIndex))
+	{
+		return *Folded;
+	}
+
+	// Unset while folding, so a cycle through this pin folds to a runtime value
+	FoldedOutputs.Add(PinIndex);
+	const TOptional<double> Value = FoldNode(Snapshot.Pins[PinIndex].Node);
+	FoldedOutputs.Add(PinIndex, Value);
+	return Value;
+}
+
+TOptional<double> FBlueprintConstantFolder::FoldNode(int32 NodeIndex)
+{
+	const FBlueprintSnapshotNode& Node = Snapshot.Nodes[NodeIndex];
+	switch (Node.Kind)
+	{
+		case EValidatorXNodeKind::VariableGet:
+			return FoldVariableGet(NodeIndex);
+
+		case EValidatorXNodeKind::CallFunction:
+			return FoldOperator(NodeIndex);
+
+		case EValidatorXNodeKind::Other:
+			if (Node.NumPins == 2 && Snapshot.FindPin(NodeIndex, ConstantFolderKnotOutput))
+			{
+				const int32 InputPin = Snapshot.FindPinIndex(NodeIndex, ConstantFolderKnotInput);
+				return InputPin != INDEX_NONE ? FoldInput(InputPin) : TOptional<double>();
+			}
+			return {};
+
+		default:
+			return {};
+	}
+}
+
+TOptional<double> FBlueprintConstantFolder::FoldVariableGet(int32 NodeIndex)
+{
+	const int32* const VariableIndex = GetNodeVariables.Find(NodeIndex);
+	if (!VariableIndex)
+	{
+		return {};
+	}
+
+	for (const FBlueprintSnapshotPin& Pin : Snapshot.GetPins(NodeIndex))
+	{
+		// Impure Gets, and Gets reading the variable of another object
+		if (Pin.Category == UEdGraphSchema_K2::PC_Exec || (Pin.Name == UEdGraphSchema_K2::PN_Self && Pin.NumLinks > 0))
+		{
+			return {};
+		}
+	}
+
+	const FBlueprintSnapshotVariable& Variable = Snapshot.Variables[*VariableIndex];
+	if (Variable.ContainerType != EPinContainerType::None || !IsFoldableConstantType(Variable.Category, Variable.bIsEnum))
+	{
+		return {};
+	}
+
+	const bool bIsConstant = Variable.Graph != INDEX_NONE
+		? Snapshot.FindVariableWrites(*VariableIndex).IsEmpty()
+		: Variable.bHasProperty && IsConstantMember(Variable);
+	return bIsConstant ? ParseConstant(Variable.DefaultValue) : TOptional<double>();
+}
+
+TOptional<double> FBlueprintConstantFolder::FoldOperator(int32 NodeIndex)
+{
+	const FBlueprintSnapshotNode& Node = Snapshot.Nodes[NodeIndex];
+	if (!Node.bIsPure || Node.MemberPackage != ConstantFolderEnginePackage)
+	{
+		return {};
+	}
+
+	// Operands are the data inputs in pin order, without the hidden library target
+	TArray<TOptional<double>, TInlineAllocator<4>> Operands;
+	for (int32 PinIndex = Node.FirstPin; PinIndex < Node.FirstPin + Node.NumPins; ++PinIndex)
+	{
+		const FBlueprintSnapshotPin& Pin = Snapshot.Pins[PinIndex];
+		if (Pin.Direction == EGPD_Input && Pin.Name != UEdGraphSchema_K2::PN_Self)
+		{
+			Operands.Add(FoldInput(PinIndex));
+		}
+	}
+
+	const bool bAllKnown = !Operands.ContainsByPredicate([](const TOptional<double>& Operand) { return !Operand.IsSet(); });
+	const bool bAnyFalse = Operands.ContainsByPredicate([](const TOptional<double>& Operand) { return Operand.IsSet() && *Operand == 0.0; });
+	const bool bAnyTrue = Operands.ContainsByPredicate([](const TOptional<double>& Operand) { return Operand.IsSet() && *Operand != 0.0; });
+
+	const FString Operator = Node.MemberName.ToString();
+	if (Operator == TEXT("Not_PreBool"))
+	{
+		return Operands.Num() == 1 && bAllKnown ? MakeFoldedBool(!bAnyTrue) : TOptional<double>();
+	}
+	if (Operator == TEXT("BooleanAND") || Operator == TEXT("BooleanNAND"))
+	{
+		if (!bAnyFalse && !bAllKnown)
+		{
+			return {};
+		}
+		return MakeFoldedBool(bAnyFalse == (Operator == TEXT("BooleanNAND")));
+	}
+	if (Operator == TEXT("BooleanOR") || Operator == TEXT("BooleanNOR"))
+	{
+		if (!bAnyTrue && !bAllKnown)
+		{
+			return {};
+		}
+		return MakeFoldedBool(bAnyTrue != (Operator == TEXT("BooleanNOR")));
+	}
+
+	if (Operands.Num() != 2 || !bAllKnown)
+	{
+		return {};
+	}
+
+	const double A = *Operands[0];
+	const double B = *Operands[1];
+	if (Operator == TEXT("BooleanXOR"))
+	{
+		return MakeFoldedBool((A != 0.0) != (B != 0.0));
+	}
+
+	// Comparisons are named "<Operator>_<Type><Type>", e.g. "LessEqual_IntInt"
+	FString Comparison;
+	if (!Operator.Split(TEXT("_"), &Comparison, nullptr))
+	{
+		return {};
+	}
+	if (Comparison == TEXT("EqualEqual"))
+	{
+		return MakeFoldedBool(A == B);
+	}
+	if (Comparison == TEXT("NotEqual"))
+	{
+		return MakeFoldedBool(A != B);
+	}
+	if (Comparison == TEXT("Less"))
+	{
+		return MakeFoldedBool(A < B);
+	}
+	if (Comparison == TEXT("LessEqual"))
+	{
+		return MakeFoldedBool(A <= B);
+	}
+	if (Comparison == TEXT("Greater"))
+	{
+		return MakeFoldedBool(A > B);
+	}
+	if (Comparison == TEXT("GreaterEqual"))
+	{
+		return MakeFoldedBool(A >= B);
+	}
+	return {};
+}
@@ -0,0 +1,178 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "Analysis/BlueprintGraphIndex.h"
+#include "Engine/Blueprint.h"
+#include "EdGraph/EdGraph.h"
+#include "EdGraphNode_Comment.h"
+#include "K2Node_BaseMCDelegate.h"
+#include "K2Node_CallFunction.h"
+#include "K2Node_Event.h"
+#include "K2Node_FunctionEntry.h"
+#include "K2Node_IfThenElse.h"
+#include "K2Node_MacroInstance.h"
+#include "K2Node_VariableGet.h"
+#include "K2Node_VariableSet.h"
+
+namespace
+{
+	template <typename KeyType, typename NodeType>
+	TConstArrayView<NodeType*> FindBucket(const TMap<KeyType, TArray<NodeType*>>& Buckets, const KeyType& Key)
+	{
+		if (const TArray<NodeType*>* const Bucket = Buckets.Find(Key))
+		{
+			return *Bucket;
+		}
+		return TConstArrayView<NodeType*>();
+	}
+} // namespace
+
+FBlueprintGraphIndex::FBlueprintGraphIndex(UBlueprint* InBlueprint)
+	: Blueprint(InBlueprint)
+{
+	if (!InBlueprint)
+	{
+		return;
+	}
+
+	InBlueprint->GetAllGraphs(Graphs);
+	Graphs.RemoveAll([](const UEdGraph* Graph) { return Graph == nullptr; });
+
+	for (UEdGraph* const Graph : Graphs)
+	{
+		GraphsByName.Add(Graph->GetFName(), Graph);
+
+		for (UEdGraphNode* const Node : Graph->Nodes)
+		{
+			if (!Node)
+			{
+				continue;
+			}
+
+			++NumNodes;
+			NodesByGuid.Add(Node->NodeGuid, Node);
+
+			if (UK2Node_VariableGet* const VariableGet = Cast<UK2Node_VariableGet>(Node))
+			{
+				VariableGets.FindOrAdd(VariableGet->GetVarName()).Add(VariableGet);
+			}
+			else if (UK2Node_VariableSet* const VariableSet = Cast<UK2Node_VariableSet>(Node))
+			{
+				VariableSets.FindOrAdd(VariableSet->GetVarName()).Add(VariableSet);
+			}
+			else if (UK2Node_CallFunction* const CallFunction = Cast<UK2Node_CallFunction>(Node))
+			{
+				FunctionCalls.FindOrAdd(CallFunction->FunctionReference.GetMemberName()).Add(CallFunction);
+				FunctionCallsByGraph.FindOrAdd(Graph).Add(CallFunction);
+			}
+			else if (UK2Node_MacroInstance* const MacroInstance = Cast<UK2Node_MacroInstance>(Node))
+			{
+				MacroInstances.FindOrAdd(MacroInstance->GetMacroGraph()).Add(MacroInstance);
+				MacroInstancesByGraph.FindOrAdd(Graph).Add(MacroInstance);
+			}
+			else if (UK2Node_IfThenElse* const Branch = Cast<UK2Node_IfThenElse>(Node))
+			{
+				Branches.Add(Branch);
+			}
+			else if (UK2Node_Event* const Event = Cast<UK2Node_Event>(Node))
+			{
+				Events.Add(Event);
+			}
+			else if (UK2Node_FunctionEntry* const FunctionEntry = Cast<UK2Node_FunctionEntry>(Node))
+			{
+				FunctionEntries.FindOrAdd(Graph, FunctionEntry);
+			}
+			else if (UK2Node_BaseMCDelegate* const DelegateNode = Cast<UK2Node_BaseMCDelegate>(Node))
+			{
+				DelegateNodes.FindOrAdd(DelegateNode->GetPropertyName()).Add(DelegateNode);
+			}
+			else if (UEdGraphNode_Comment* const Comment = Cast<UEdGraphNode_Comment>(Node))
+			{
+				Comments.FindOrAdd(Graph).Add(Comment);
+			}
+		}
+	}
+}
+
+UEdGraph* FBlueprintGraphIndex::FindGraph(FName GraphName) const
+{
+	UEdGraph* const* const Graph = GraphsByName.Find(GraphName);
+	return Graph ? *Graph : nullptr;
+}
+
+UEdGraphNode* FBlueprintGraphIndex::FindNode(const FGuid& NodeGuid) const
+{
+	UEdGraphNode* const* const Node = NodesByGuid.Find(NodeGuid);
+	return Node ? *Node : nullptr;
+}
+
+TConstArrayView<UK2Node_VariableGet*> FBlueprintGraphIndex::FindVariableGets(FName VarName) const
+{
+	return FindBucket(VariableGets, VarName);
+}
+
+TConstArrayView<UK2Node_VariableSet*> FBlueprintGraphIndex::FindVariableSets(FName VarName) const
+{
+	return FindBucket(VariableSets, VarName);
+}
+
+bool FBlueprintGraphIndex::IsVariableReferenced(FName VarName, const UEdGraph* InGraph) const
+{
+	if (!InGraph)
+	{
+		return !FindVariableGets(VarName).IsEmpty() || !FindVariableSets(VarName).IsEmpty();
+	}
+
+	for (const UK2Node_VariableGet* const VariableGet : FindVariableGets(VarName))
+	{
+		if (VariableGet->GetGraph() == InGraph)
+		{
+			return true;
+		}
+	}
+
+	for (const UK2Node_VariableSet* const VariableSet : FindVariableSets(VarName))
+	{
+		if (VariableSet->GetGraph() == InGraph)
+		{
+			return true;
+		}
+	}
+
+	return false;
+}
+
+TConstArrayView<UK2Node_CallFunction*> FBlueprintGraphIndex::FindFunctionCalls(FName MemberName) const
+{
+	return FindBucket(FunctionCalls, MemberName);
+}
+
+TConstArrayView<UK2Node_CallFunction*> FBlueprintGraphIndex::FindFunctionCallsInGraph(const UEdGraph* Graph) const
+{
+	return FindBucket(FunctionCallsByGraph, Graph);
+}
+
+TConstArrayView<UK2Node_MacroInstance*> FBlueprintGraphIndex::FindMacroInstances(const UEdGraph* MacroGraph) const
+{
+	return FindBucket(MacroInstances, MacroGraph);
+}
+
+TConstArrayView<UK2Node_MacroInstance*> FBlueprintGraphIndex::FindMacroInstancesInGraph(const UEdGraph* Graph) const
+{
+	return FindBucket(MacroInstancesByGraph, Graph);
+}
+
+TConstArrayView<UK2Node_BaseMCDelegate*> FBlueprintGraphIndex::FindDelegateNodes(FName PropertyName) const
+{
+	return FindBucket(DelegateNodes, PropertyName);
+}
+
+TConstArrayView<UEdGraphNode_Comment*> FBlueprintGraphIndex::FindComments(const UEdGraph* Graph) const
+{
+	return FindBucket(Comments, Graph);
+}
+
+UK2Node_FunctionEntry* FBlueprintGraphIndex::FindFunctionEntry(const UEdGraph* Graph) const
+{
+	UK2Node_FunctionEntry* const* const FunctionEntry = FunctionEntries.Find(Graph);
+	return FunctionEntry ? *FunctionEntry : nullptr;
+}
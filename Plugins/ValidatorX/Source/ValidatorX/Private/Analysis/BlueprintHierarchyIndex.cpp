@@ -0,0 +1,235 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "Analysis/BlueprintHierarchyIndex.h"
+#include "AssetRegistry/IAssetRegistry.h"
+#include "Engine/Blueprint.h"
+#include "Misc/PackageName.h"
+
+namespace
+{
+	/** Reads a class path tag of a Blueprint asset. */
+	FTopLevelAssetPath GetHierarchyClassTag(const FAssetData& AssetData, FName Tag)
+	{
+		FString ExportPath;
+		if (!AssetData.GetTagValue(Tag, ExportPath))
+		{
+			return FTopLevelAssetPath();
+		}
+		return FTopLevelAssetPath(FPackageName::ExportTextPathToObjectPath(ExportPath));
+	}
+
+	bool IsNativeClassPath(const FTopLevelAssetPath& ClassPath)
+	{
+		return FPackageName::IsScriptPackage(ClassPath.GetPackageName().ToString());
+	}
+} // namespace
+
+FBlueprintHierarchyIndex::~FBlueprintHierarchyIndex()
+{
+	Shutdown();
+}
+
+void FBlueprintHierarchyIndex::Initialize()
+{
+	if (bIsInitialized)
+	{
+		return;
+	}
+
+	IAssetRegistry* const AssetRegistry = IAssetRegistry::Get();
+	if (!AssetRegistry)
+	{
+		return;
+	}
+
+	bIsInitialized = true;
+
+	// Subscribe first: assets discovered by a scan still in progress are added by the events
+	AssetAddedHandle = AssetRegistry->OnAssetAdded().AddRaw(this, &FBlueprintHierarchyIndex::HandleAssetAdded);
+	AssetRemovedHandle = AssetRegistry->OnAssetRemoved().AddRaw(this, &FBlueprintHierarchyIndex::HandleAssetRemoved);
+	AssetRenamedHandle = AssetRegistry->OnAssetRenamed().AddRaw(this, &FBlueprintHierarchyIndex::HandleAssetRenamed);
+	AssetUpdatedHandle = AssetRegistry->OnAssetUpdated().AddRaw(this, &FBlueprintHierarchyIndex::HandleAssetAdded);
+
+	FARFilter Filter;
+	Filter.ClassPaths.Add(UBlueprint::StaticClass()->GetClassPathName());
+	Filter.bRecursiveClasses = true;
+
+	AssetRegistry->EnumerateAssets(Filter, [this](const FAssetData& AssetData)
+	{
+		AddAsset(AssetData);
+		return true;
+	});
+}
+
+void FBlueprintHierarchyIndex::Shutdown()
+{
+	if (!bIsInitialized)
+	{
+		return;
+	}
+
+	if (IAssetRegistry* const AssetRegistry = IAssetRegistry::Get())
+	{
+		AssetRegistry->OnAssetAdded().Remove(AssetAddedHandle);
+		AssetRegistry->OnAssetRemoved().Remove(AssetRemovedHandle);
+		AssetRegistry->OnAssetRenamed().Remove(AssetRenamedHandle);
+		AssetRegistry->OnAssetUpdated().Remove(AssetUpdatedHandle);
+	}
+
+	ParentClasses.Reset();
+	ChildClasses.Reset();
+	ClassesByPackage.Reset();
+	bIsInitialized = false;
+}
+
+FTopLevelAssetPath FBlueprintHierarchyIndex::FindGeneratedClass(FName PackageName) const
+{
+	const FTopLevelAssetPath* const ClassPath = ClassesByPackage.Find(PackageName);
+	return ClassPath ? *ClassPath : FTopLevelAssetPath();
+}
+
+FTopLevelAssetPath FBlueprintHierarchyIndex::GetParentClass(const FTopLevelAssetPath& ClassPath) const
+{
+	const FTopLevelAssetPath* const ParentClass = ParentClasses.Find(ClassPath);
+	return ParentClass ? *ParentClass : FTopLevelAssetPath();
+}
+
+void FBlueprintHierarchyIndex::GetParentClasses(const FTopLevelAssetPath& ClassPath, TArray<FTopLevelAssetPath>& OutClassPaths) const
+{
+	FTopLevelAssetPath CurrentClass = GetParentClass(ClassPath);
+	while (CurrentClass.IsValid() && ParentClasses.Contains(CurrentClass) && !OutClassPaths.Contains(CurrentClass))
+	{
+		OutClassPaths.Add(CurrentClass);
+		CurrentClass = GetParentClass(CurrentClass);
+	}
+}
+
+void FBlueprintHierarchyIndex::GetDerivedClasses(const FTopLevelAssetPath& ClassPath, TArray<FTopLevelAssetPath>& OutClassPaths) const
+{
+	TArray<FTopLevelAssetPath> Roots;
+	Roots.Add(ClassPath);
+
+	// Blueprints may derive from native subclasses of a native class
+	if (IsNativeClassPath(ClassPath))
+	{
+		if (const UClass* const NativeClass = FindObject<UClass>(ClassPath))
+		{
+			for (const TPair<FTopLevelAssetPath, TArray<FTopLevelAssetPath>>& Pair : ChildClasses)
+			{
+				if (Pair.Key != ClassPath && IsNativeClassPath(Pair.Key))
+				{
+					const UClass* const ChildNativeClass = FindObject<UClass>(Pair.Key);
+					if (ChildNativeClass && ChildNativeClass->IsChildOf(NativeClass))
+					{
+						Roots.Add(Pair.Key);
+					}
+				}
+			}
+		}
+	}
+
+	// Breadth first, so parents come before their children
+	TSet<FTopLevelAssetPath> Visited;
+	Visited.Append(Roots);
+	const int32 FirstDerived = OutClassPaths.Num();
+	auto AddChildren = [this, &Visited, &OutClassPaths](const FTopLevelAssetPath& Parent)
+	{
+		if (const TArray<FTopLevelAssetPath>* const Children = ChildClasses.Find(Parent))
+		{
+			for (const FTopLevelAssetPath& Child : *Children)
+			{
+				// Also guards against cycles in stale registry data
+				bool bIsAlreadyVisited = false;
+				Visited.Add(Child, &bIsAlreadyVisited);
+				if (!bIsAlreadyVisited)
+				{
+					OutClassPaths.Add(Child);
+				}
+			}
+		}
+	};
+
+	for (const FTopLevelAssetPath& Root : Roots)
+	{
+		AddChildren(Root);
+	}
+
+	for (int32 Index = FirstDerived; Index < OutClassPaths.Num(); ++Index)
+	{
+		AddChildren(OutClassPaths[Index]);
+	}
+}
+
+void FBlueprintHierarchyIndex::AddAsset(const FAssetData& AssetData)
+{
+	const FTopLevelAssetPath ClassPath = GetHierarchyClassTag(AssetData, FBlueprintTags::GeneratedClassPath);
+	const FTopLevelAssetPath ParentClassPath = GetHierarchyClassTag(AssetData, FBlueprintTags::ParentClassPath);
+	if (!ClassPath.IsValid() || !ParentClassPath.IsValid())
+	{
+		return;
+	}
+
+	RemovePackage(AssetData.PackageName);
+
+	ParentClasses.Add(ClassPath, ParentClassPath);
+	ChildClasses.FindOrAdd(ParentClassPath).AddUnique(ClassPath);
+	ClassesByPackage.Add(AssetData.PackageName, ClassPath);
+}
+
+void FBlueprintHierarchyIndex::RemovePackage(FName PackageName)
+{
+	FTopLevelAssetPath ClassPath;
+	if (!ClassesByPackage.RemoveAndCopyValue(PackageName, ClassPath))
+	{
+		return;
+	}
+
+	FTopLevelAssetPath ParentClassPath;
+	if (ParentClasses.RemoveAndCopyValue(ClassPath, ParentClassPath))
+	{
+		if (TArray<FTopLevelAssetPath>* const Siblings = ChildClasses.Find(ParentClassPath))
+		{
+			Siblings->Remove(ClassPath);
+			if (Siblings->IsEmpty())
+			{
+				ChildClasses.Remove(ParentClassPath);
+			}
+		}
+	}
+
+	// Children of the removed class keep their edge: their tags still point at it
+}
+
+void FBlueprintHierarchyIndex::HandleAssetAdded(const FAssetData& AssetData)
+{
+	if (AssetData.FindTag(FBlueprintTags::ParentClassPath))
+	{
+		AddAsset(AssetData);
+	}
+}
+
+void FBlueprintHierarchyIndex::HandleAssetRemoved(const FAssetData& AssetData)
+{
+	RemovePackage(AssetData.PackageName);
+}
+
+void FBlueprintHierarchyIndex::HandleAssetRenamed(const FAssetData& AssetData, const FString& OldObjectPath)
+{
+	const FName OldPackageName = FSoftObjectPath(OldObjectPath).GetLongPackageFName();
+	const FTopLevelAssetPath OldClassPath = FindGeneratedClass(OldPackageName);
+
+	RemovePackage(OldPackageName);
+	HandleAssetAdded(AssetData);
+
+	// Children still reference the old class path until they are resaved; move them to the new one
+	const FTopLevelAssetPath NewClassPath = FindGeneratedClass(AssetData.PackageName);
+	TArray<FTopLevelAssetPath> Children;
+	if (OldClassPath.IsValid() && NewClassPath.IsValid() && ChildClasses.RemoveAndCopyValue(OldClassPath, Children))
+	{
+		for (const FTopLevelAssetPath& Child : Children)
+		{
+			ParentClasses.Add(Child, NewClassPath);
+			ChildClasses.FindOrAdd(NewClassPath).AddUnique(Child);
+		}
+	}
+}
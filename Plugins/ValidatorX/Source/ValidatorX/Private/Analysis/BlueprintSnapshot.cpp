@@ -0,0 +1,634 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "Analysis/BlueprintSnapshot.h"
+#include "Analysis/BlueprintGraphIndex.h"
+#include "Engine/Blueprint.h"
+#include "EdGraph/EdGraph.h"
+#include "EdGraphNode_Comment.h"
+#include "EdGraphSchema_K2.h"
+#include "K2Node_AddDelegate.h"
+#include "K2Node_BaseMCDelegate.h"
+#include "K2Node_CallDelegate.h"
+#include "K2Node_CallFunction.h"
+#include "K2Node_Event.h"
+#include "K2Node_FunctionEntry.h"
+#include "K2Node_FunctionResult.h"
+#include "K2Node_IfThenElse.h"
+#include "K2Node_MacroInstance.h"
+#include "K2Node_RemoveDelegate.h"
+#include "K2Node_Tunnel.h"
+#include "K2Node_VariableGet.h"
+#include "K2Node_VariableSet.h"
+
+namespace
+{
+	template <typename KeyType>
+	TConstArrayView<int32> FindSnapshotBucket(const TMap<KeyType, TArray<int32>>& Buckets, const KeyType& Key)
+	{
+		if (const TArray<int32>* const Bucket = Buckets.Find(Key))
+		{
+			return *Bucket;
+		}
+		return TConstArrayView<int32>();
+	}
+
+	EValidatorXGraphType GetSnapshotGraphType(const UBlueprint& Blueprint, const UEdGraph* Graph)
+	{
+		if (Blueprint.FunctionGraphs.Contains(Graph))
+		{
+			return EValidatorXGraphType::Function;
+		}
+		if (Blueprint.MacroGraphs.Contains(Graph))
+		{
+			return EValidatorXGraphType::Macro;
+		}
+		if (Blueprint.UbergraphPages.Contains(Graph))
+		{
+			return EValidatorXGraphType::EventGraph;
+		}
+		if (Blueprint.DelegateSignatureGraphs.Contains(Graph))
+		{
+			return EValidatorXGraphType::Delegate;
+		}
+		if (Blueprint.IntermediateGeneratedGraphs.Contains(Graph))
+		{
+			return EValidatorXGraphType::Intermediate;
+		}
+		return EValidatorXGraphType::Nested;
+	}
+
+	bool IsSnapshotEnumType(const FEdGraphPinType& PinType)
+	{
+		return PinType.PinCategory == UEdGraphSchema_K2::PC_Enum
+			|| (PinType.PinCategory == UEdGraphSchema_K2::PC_Byte && PinType.PinSubCategoryObject.IsValid() && PinType.PinSubCategoryObject->IsA<UEnum>());
+	}
+
+	FName GetOwningPackageName(const UObject* Object)
+	{
+		return Object ? Object->GetOutermost()->GetFName() : NAME_None;
+	}
+
+	/** Fills the class tag and member reference of a snapshot node. */
+	void CaptureNodeKind(UEdGraphNode& Node, FBlueprintSnapshotNode& OutNode)
+	{
+		if (const UK2Node_VariableGet* const VariableGet = Cast<UK2Node_VariableGet>(&Node))
+		{
+			OutNode.Kind = EValidatorXNodeKind::VariableGet;
+			OutNode.MemberName = VariableGet->GetVarName();
+		}
+		else if (const UK2Node_VariableSet* const VariableSet = Cast<UK2Node_VariableSet>(&Node))
+		{
+			OutNode.Kind = EValidatorXNodeKind::VariableSet;
+			OutNode.MemberName = VariableSet->GetVarName();
+		}
+		else if (UK2Node_CallFunction* const CallFunction = Cast<UK2Node_CallFunction>(&Node))
+		{
+			OutNode.Kind = EValidatorXNodeKind::CallFunction;
+			OutNode.MemberName = CallFunction->FunctionReference.GetMemberName();
+			OutNode.MemberPackage = GetOwningPackageName(CallFunction->FunctionReference.GetMemberParentClass(CallFunction->GetBlueprintClassFromNode()));
+		}
+		else if (const UK2Node_MacroInstance* const MacroInstance = Cast<UK2Node_MacroInstance>(&Node))
+		{
+			const UEdGraph* const MacroGraph = MacroInstance->GetMacroGraph();
+			OutNode.Kind = EValidatorXNodeKind::MacroInstance;
+			OutNode.MemberName = MacroGraph ? MacroGraph->GetFName() : NAME_None;
+			OutNode.MemberPackage = GetOwningPackageName(MacroGraph);
+		}
+		else if (Node.IsA<UK2Node_IfThenElse>())
+		{
+			OutNode.Kind = EValidatorXNodeKind::Branch;
+		}
+		else if (const UK2Node_Event* const Event = Cast<UK2Node_Event>(&Node))
+		{
+			OutNode.Kind = EValidatorXNodeKind::Event;
+			OutNode.MemberName = Event->GetFunctionName();
+		}
+		else if (Node.IsA<UK2Node_FunctionEntry>())
+		{
+			OutNode.Kind = EValidatorXNodeKind::FunctionEntry;
+		}
+		else if (Node.IsA<UK2Node_FunctionResult>())
+		{
+			OutNode.Kind = EValidatorXNodeKind::FunctionResult;
+		}
+		else if (Node.IsA<UK2Node_Tunnel>())
+		{
+			OutNode.Kind = EValidatorXNodeKind::Tunnel;
+		}
+		else if (const UK2Node_BaseMCDelegate* const DelegateNode = Cast<UK2Node_BaseMCDelegate>(&Node))
+		{
+			OutNode.MemberName = DelegateNode->GetPropertyName();
+			if (Node.IsA<UK2Node_AddDelegate>())
+			{
+				OutNode.Kind = EValidatorXNodeKind::AddDelegate;
+			}
+			else if (Node.IsA<UK2Node_RemoveDelegate>())
+			{
+				OutNode.Kind = EValidatorXNodeKind::RemoveDelegate;
+			}
+			else if (Node.IsA<UK2Node_CallDelegate>())
+			{
+				OutNode.Kind = EValidatorXNodeKind::CallDelegate;
+			}
+			else
+			{
+				OutNode.Kind = EValidatorXNodeKind::OtherDelegate;
+			}
+		}
+		else if (Node.IsA<UEdGraphNode_Comment>())
+		{
+			OutNode.Kind = EValidatorXNodeKind::Comment;
+		}
+
+		OutNode.bIsTunnel = Node.IsA<UK2Node_Tunnel>();
+		if (const UK2Node* const K2Node = Cast<UK2Node>(&Node))
+		{
+			OutNode.bIsPure = K2Node->IsNodePure();
+		}
+	}
+
+	/**
+	 * Appends a graph with its nodes and pins to a snapshot.
+	 *
+	 * @return The first function entry node of the graph, or null.
+	 */
+	const UK2Node_FunctionEntry* CaptureSnapshotGraph(const UBlueprint& Blueprint, const UEdGraph& Graph, FBlueprintSnapshot& Snapshot)
+	{
+		const UK2Node_FunctionEntry* EntryNode = nullptr;
+		const int32 SnapshotGraphIndex = Snapshot.Graphs.Num();
+
+		FBlueprintSnapshotGraph& SnapshotGraph = Snapshot.Graphs.AddDefaulted_GetRef();
+		SnapshotGraph.Name = Graph.GetFName();
+		SnapshotGraph.Type = GetSnapshotGraphType(Blueprint, &Graph);
+		SnapshotGraph.FirstNode = Snapshot.Nodes.Num();
+
+		// Links never leave their graph, so pins only need to be resolved within it
+		TMap<const UEdGraphPin*, int32> PinIndices;
+
+		for (UEdGraphNode* const Node : Graph.Nodes)
+		{
+			if (!Node)
+			{
+				continue;
+			}
+
+			const int32 NodeIndex = Snapshot.Nodes.Num();
+
+			FBlueprintSnapshotNode& SnapshotNode = Snapshot.Nodes.AddDefaulted_GetRef();
+			SnapshotNode.Graph = SnapshotGraphIndex;
+			SnapshotNode.Guid = Node->NodeGuid;
+			SnapshotNode.Name = Node->GetFName();
+			SnapshotNode.Title = Node->GetNodeTitle(ENodeTitleType::FullTitle).ToString();
+			SnapshotNode.NodeClass = Node->GetClass()->GetFName();
+			SnapshotNode.PosX = Node->NodePosX;
+			SnapshotNode.PosY = Node->NodePosY;
+			SnapshotNode.Width = Node->NodeWidth;
+			SnapshotNode.Height = Node->NodeHeight;
+			SnapshotNode.FirstPin = Snapshot.Pins.Num();
+			CaptureNodeKind(*Node, SnapshotNode);
+
+			if (const UK2Node_Event* const Event = Cast<UK2Node_Event>(Node))
+			{
+				SnapshotNode.bIsGhost = Event->IsAutomaticallyPlacedGhostNode();
+			}
+
+			if (SnapshotNode.Kind == EValidatorXNodeKind::FunctionEntry && SnapshotGraph.EntryNode == INDEX_NONE)
+			{
+				SnapshotGraph.EntryNode = NodeIndex;
+				EntryNode = CastChecked<UK2Node_FunctionEntry>(Node);
+			}
+
+			for (const UEdGraphPin* const Pin : Node->Pins)
+			{
+				if (!Pin)
+				{
+					continue;
+				}
+
+				PinIndices.Add(Pin, Snapshot.Pins.Num());
+
+				FBlueprintSnapshotPin& SnapshotPin = Snapshot.Pins.AddDefaulted_GetRef();
+				SnapshotPin.Name = Pin->PinName;
+				SnapshotPin.Category = Pin->PinType.PinCategory;
+				SnapshotPin.bIsEnum = IsSnapshotEnumType(Pin->PinType);
+				SnapshotPin.DefaultValue = Pin->DefaultValue;
+				SnapshotPin.Direction = Pin->Direction;
+				SnapshotPin.Node = NodeIndex;
+			}
+
+			SnapshotNode.NumPins = Snapshot.Pins.Num() - SnapshotNode.FirstPin;
+		}
+
+		for (const TPair<const UEdGraphPin*, int32>& PinIndex : PinIndices)
+		{
+			for (const UEdGraphPin* const LinkedPin : PinIndex.Key->LinkedTo)
+			{
+				if (const int32* const LinkedIndex = PinIndices.Find(LinkedPin))
+				{
+					Snapshot.Links.Add(FBlueprintSnapshotLink{PinIndex.Value, *LinkedIndex});
+				}
+			}
+		}
+
+		SnapshotGraph.NumNodes = Snapshot.Nodes.Num() - SnapshotGraph.FirstNode;
+		return EntryNode;
+	}
+
+	/** Fills the element size and count of a member variable from its property and the class default value. */
+	void CaptureValueSize(const FProperty& Property, const UObject* DefaultObject, FBlueprintSnapshotVariable& Variable)
+	{
+		if (const FArrayProperty* const ArrayProperty = CastField<FArrayProperty>(&Property))
+		{
+			Variable.ElementSize = ArrayProperty->Inner->GetSize();
+			Variable.NumElements = DefaultObject ? FScriptArrayHelper_InContainer(ArrayProperty, DefaultObject).Num() : 0;
+		}
+		else if (const FSetProperty* const SetProperty = CastField<FSetProperty>(&Property))
+		{
+			Variable.ElementSize = SetProperty->ElementProp->GetSize();
+			Variable.NumElements = DefaultObject ? FScriptSetHelper_InContainer(SetProperty, DefaultObject).Num() : 0;
+		}
+		else if (const FMapProperty* const MapProperty = CastField<FMapProperty>(&Property))
+		{
+			Variable.ElementSize = MapProperty->KeyProp->GetSize() + MapProperty->ValueProp->GetSize();
+			Variable.NumElements = DefaultObject ? FScriptMapHelper_InContainer(MapProperty, DefaultObject).Num() : 0;
+		}
+		else
+		{
+			Variable.ElementSize = Property.GetSize();
+			Variable.NumElements = 1;
+		}
+	}
+
+	/** Appends the declared member variables, then the inherited ones referenced by captured nodes. */
+	void CaptureMemberVariables(const UBlueprint& Blueprint, FBlueprintSnapshot& Snapshot)
+	{
+		UClass* const GeneratedClass = Blueprint.GeneratedClass;
+		UObject* const DefaultObject = GeneratedClass ? GeneratedClass->GetDefaultObject(false) : nullptr;
+		TSet<FName> MemberNames;
+
+		auto AddMemberVariable = [&](FName VarName, const FEdGraphPinType& PinType, uint64 PropertyFlags, bool bIsDeclared)
+		{
+			FBlueprintSnapshotVariable& Variable = Snapshot.Variables.AddDefaulted_GetRef();
+			Variable.Name = VarName;
+			Variable.Category = PinType.PinCategory;
+			Variable.bIsEnum = IsSnapshotEnumType(PinType);
+			Variable.ContainerType = PinType.ContainerType;
+			Variable.PropertyFlags = PropertyFlags;
+			Variable.bIsDeclared = bIsDeclared;
+
+			if (const FProperty* const Property = GeneratedClass ? FindFProperty<FProperty>(GeneratedClass, VarName) : nullptr)
+			{
+				Variable.bHasProperty = true;
+				Variable.PropertyFlags = Property->PropertyFlags;
+				CaptureValueSize(*Property, DefaultObject, Variable);
+				if (DefaultObject)
+				{
+					Property->ExportText_InContainer(0, Variable.DefaultValue, DefaultObject, DefaultObject, nullptr, PPF_None);
+				}
+			}
+		};
+
+		for (const FBPVariableDescription& VarDesc : Blueprint.NewVariables)
+		{
+			MemberNames.Add(VarDesc.VarName);
+			AddMemberVariable(VarDesc.VarName, VarDesc.VarType, VarDesc.PropertyFlags, true);
+
+			FBlueprintSnapshotVariable& Variable = Snapshot.Variables.Last();
+			Variable.bIsPrivate = VarDesc.HasMetaData(FBlueprintMetadata::MD_Private)
+				&& VarDesc.GetMetaData(FBlueprintMetadata::MD_Private).ToBool();
+		}
+
+		if (!GeneratedClass)
+		{
+			return;
+		}
+
+		for (int32 NodeIndex = 0; NodeIndex < Snapshot.Nodes.Num(); ++NodeIndex)
+		{
+			const FBlueprintSnapshotNode& Node = Snapshot.Nodes[NodeIndex];
+			if (Node.Kind != EValidatorXNodeKind::VariableGet && Node.Kind != EValidatorXNodeKind::VariableSet)
+			{
+				continue;
+			}
+
+			bool bIsAlreadyAdded = false;
+			MemberNames.Add(Node.MemberName, &bIsAlreadyAdded);
+			if (bIsAlreadyAdded)
+			{
+				continue;
+			}
+
+			if (const FProperty* const Property = FindFProperty<FProperty>(GeneratedClass, Node.MemberName))
+			{
+				FEdGraphPinType PinType;
+				GetDefault<UEdGraphSchema_K2>()->ConvertPropertyToPinType(Property, PinType);
+				AddMemberVariable(Node.MemberName, PinType, Property->PropertyFlags, false);
+			}
+		}
+	}
+
+	/** Appends the local variables declared by a function entry node. */
+	void CaptureLocalVariables(const UK2Node_FunctionEntry& EntryNode, int32 SnapshotGraphIndex, FBlueprintSnapshot& Snapshot)
+	{
+		for (const FBPVariableDescription& LocalVar : EntryNode.LocalVariables)
+		{
+			FBlueprintSnapshotVariable& Variable = Snapshot.Variables.AddDefaulted_GetRef();
+			Variable.Name = LocalVar.VarName;
+			Variable.Category = LocalVar.VarType.PinCategory;
+			Variable.bIsEnum = IsSnapshotEnumType(LocalVar.VarType);
+			Variable.ContainerType = LocalVar.VarType.ContainerType;
+			Variable.PropertyFlags = LocalVar.PropertyFlags;
+			Variable.DefaultValue = LocalVar.DefaultValue;
+			Variable.Graph = SnapshotGraphIndex;
+			Variable.bIsDeclared = true;
+		}
+	}
+} // namespace
+
+const TCHAR* LexToString(EValidatorXGraphType GraphType)
+{
+	switch (GraphType)
+	{
+		case EValidatorXGraphType::EventGraph:
+			return TEXT("Event Graph");
+		case EValidatorXGraphType::Function:
+			return TEXT("Function");
+		case EValidatorXGraphType::Macro:
+			return TEXT("Macro");
+		case EValidatorXGraphType::Delegate:
+			return TEXT("Delegate");
+		case EValidatorXGraphType::Intermediate:
+			return TEXT("Intermediate");
+		default:
+			return TEXT("Unknown");
+	}
+}
+
+TSharedRef<const FBlueprintSnapshot> FBlueprintSnapshot::Create(const FBlueprintGraphIndex& GraphIndex)
+{
+	check(IsInGameThread());
+
+	const TSharedRef<FBlueprintSnapshot> Snapshot = MakeShared<FBlueprintSnapshot>();
+
+	UBlueprint* const Blueprint = GraphIndex.GetBlueprint();
+	if (!Blueprint)
+	{
+		return Snapshot;
+	}
+
+	Snapshot->BlueprintName = Blueprint->GetFName();
+	Snapshot->PackageName = GetOwningPackageName(Blueprint);
+	Snapshot->Graphs.Reserve(GraphIndex.GetGraphs().Num());
+	Snapshot->Nodes.Reserve(GraphIndex.GetNumNodes());
+
+	// Graphs, nodes and pins
+	TArray<const UK2Node_FunctionEntry*> EntryNodes;
+	EntryNodes.Reserve(GraphIndex.GetGraphs().Num());
+	for (const UEdGraph* const Graph : GraphIndex.GetGraphs())
+	{
+		EntryNodes.Add(CaptureSnapshotGraph(*Blueprint, *Graph, *Snapshot));
+	}
+
+	// Member variables, then local variables
+	CaptureMemberVariables(*Blueprint, *Snapshot);
+	for (int32 SnapshotGraphIndex = 0; SnapshotGraphIndex < EntryNodes.Num(); ++SnapshotGraphIndex)
+	{
+		if (EntryNodes[SnapshotGraphIndex])
+		{
+			CaptureLocalVariables(*EntryNodes[SnapshotGraphIndex], SnapshotGraphIndex, *Snapshot);
+		}
+	}
+
+	Snapshot->BuildLookups();
+	return Snapshot;
+}
+
+TSharedRef<const FBlueprintSnapshot> FBlueprintSnapshot::CreateForGraph(const UBlueprint& Blueprint, const UEdGraph& Graph)
+{
+	check(IsInGameThread());
+
+	const TSharedRef<FBlueprintSnapshot> Snapshot = MakeShared<FBlueprintSnapshot>();
+	Snapshot->BlueprintName = Blueprint.GetFName();
+	Snapshot->PackageName = GetOwningPackageName(&Blueprint);
+	Snapshot->Nodes.Reserve(Graph.Nodes.Num());
+
+	const UK2Node_FunctionEntry* const EntryNode = CaptureSnapshotGraph(Blueprint, Graph, *Snapshot);
+	CaptureMemberVariables(Blueprint, *Snapshot);
+	if (EntryNode)
+	{
+		CaptureLocalVariables(*EntryNode, 0, *Snapshot);
+	}
+
+	Snapshot->BuildLookups();
+	return Snapshot;
+}
+
+void FBlueprintSnapshot::BuildLookups()
+{
+	Links.Sort([](const FBlueprintSnapshotLink& A, const FBlueprintSnapshotLink& B)
+	{
+		return A.FromPin != B.FromPin ? A.FromPin < B.FromPin : A.ToPin < B.ToPin;
+	});
+
+	for (FBlueprintSnapshotPin& Pin : Pins)
+	{
+		Pin.NumLinks = 0;
+	}
+
+	for (int32 LinkIndex = Links.Num() - 1; LinkIndex >= 0; --LinkIndex)
+	{
+		FBlueprintSnapshotPin& Pin = Pins[Links[LinkIndex].FromPin];
+		Pin.FirstLink = LinkIndex;
+		++Pin.NumLinks;
+	}
+
+	for (int32 GraphIndex = 0; GraphIndex < Graphs.Num(); ++GraphIndex)
+	{
+		GraphsByName.Add(Graphs[GraphIndex].Name, GraphIndex);
+	}
+
+	for (int32 NodeIndex = 0; NodeIndex < Nodes.Num(); ++NodeIndex)
+	{
+		const FBlueprintSnapshotNode& Node = Nodes[NodeIndex];
+		switch (Node.Kind)
+		{
+			case EValidatorXNodeKind::VariableGet:
+			case EValidatorXNodeKind::VariableSet:
+				VariableNodes.FindOrAdd(Node.MemberName).Add(NodeIndex);
+				break;
+			case EValidatorXNodeKind::CallFunction:
+				FunctionCalls.FindOrAdd(Node.MemberName).Add(NodeIndex);
+				break;
+			case EValidatorXNodeKind::MacroInstance:
+				MacroInstances.FindOrAdd(Node.MemberName).Add(NodeIndex);
+				break;
+			case EValidatorXNodeKind::AddDelegate:
+			case EValidatorXNodeKind::RemoveDelegate:
+			case EValidatorXNodeKind::CallDelegate:
+			case EValidatorXNodeKind::OtherDelegate:
+				DelegateNodes.FindOrAdd(Node.MemberName).Add(NodeIndex);
+				break;
+			default:
+				break;
+		}
+	}
+
+	TMap<TPair<int32, FName>, int32> LocalVariables;
+	for (int32 VariableIndex = 0; VariableIndex < Variables.Num(); ++VariableIndex)
+	{
+		const FBlueprintSnapshotVariable& Variable = Variables[VariableIndex];
+		if (Variable.Graph == INDEX_NONE)
+		{
+			MemberVariables.Add(Variable.Name, VariableIndex);
+		}
+		else
+		{
+			LocalVariables.Add({Variable.Graph, Variable.Name}, VariableIndex);
+		}
+	}
+
+	VariableReads.SetNum(Variables.Num());
+	VariableWrites.SetNum(Variables.Num());
+	NodeVariables.Init(INDEX_NONE, Nodes.Num());
+	for (int32 NodeIndex = 0; NodeIndex < Nodes.Num(); ++NodeIndex)
+	{
+		const FBlueprintSnapshotNode& Node = Nodes[NodeIndex];
+		if (Node.Kind != EValidatorXNodeKind::VariableGet && Node.Kind != EValidatorXNodeKind::VariableSet)
+		{
+			continue;
+		}
+
+		// Locals shadow members of the same name
+		const int32* VariableIndex = LocalVariables.Find({Node.Graph, Node.MemberName});
+		if (!VariableIndex)
+		{
+			VariableIndex = MemberVariables.Find(Node.MemberName);
+		}
+
+		if (VariableIndex)
+		{
+			(Node.Kind == EValidatorXNodeKind::VariableGet ? VariableReads : VariableWrites)[*VariableIndex].Add(NodeIndex);
+			NodeVariables[NodeIndex] = *VariableIndex;
+		}
+	}
+}
+
+TConstArrayView<FBlueprintSnapshotPin> FBlueprintSnapshot::GetPins(int32 NodeIndex) const
+{
+	const FBlueprintSnapshotNode& Node = Nodes[NodeIndex];
+	return TConstArrayView<FBlueprintSnapshotPin>(Pins.GetData() + Node.FirstPin, Node.NumPins);
+}
+
+const FBlueprintSnapshotPin* FBlueprintSnapshot::FindPin(int32 NodeIndex, FName PinName) const
+{
+	for (const FBlueprintSnapshotPin& Pin : GetPins(NodeIndex))
+	{
+		if (Pin.Name == PinName)
+		{
+			return &Pin;
+		}
+	}
+	return nullptr;
+}
+
+int32 FBlueprintSnapshot::FindPinIndex(int32 NodeIndex, FName PinName) const
+{
+	const FBlueprintSnapshotNode& Node = Nodes[NodeIndex];
+	for (int32 PinIndex = Node.FirstPin; PinIndex < Node.FirstPin + Node.NumPins; ++PinIndex)
+	{
+		if (Pins[PinIndex].Name == PinName)
+		{
+			return PinIndex;
+		}
+	}
+	return INDEX_NONE;
+}
+
+TConstArrayView<FBlueprintSnapshotLink> FBlueprintSnapshot::GetLinks(int32 PinIndex) const
+{
+	const FBlueprintSnapshotPin& Pin = Pins[PinIndex];
+	return TConstArrayView<FBlueprintSnapshotLink>(Links.GetData() + Pin.FirstLink, Pin.NumLinks);
+}
+
+int32 FBlueprintSnapshot::FindGraph(FName GraphName) const
+{
+	const int32* const GraphIndex = GraphsByName.Find(GraphName);
+	return GraphIndex ? *GraphIndex : INDEX_NONE;
+}
+
+TConstArrayView<FBlueprintSnapshotNode> FBlueprintSnapshot::GetNodes(int32 GraphIndex) const
+{
+	const FBlueprintSnapshotGraph& Graph = Graphs[GraphIndex];
+	return TConstArrayView<FBlueprintSnapshotNode>(Nodes.GetData() + Graph.FirstNode, Graph.NumNodes);
+}
+
+TConstArrayView<int32> FBlueprintSnapshot::FindVariableNodes(FName VarName) const
+{
+	return FindSnapshotBucket(VariableNodes, VarName);
+}
+
+TConstArrayView<int32> FBlueprintSnapshot::FindVariableReads(int32 VariableIndex) const
+{
+	return VariableReads[VariableIndex];
+}
+
+TConstArrayView<int32> FBlueprintSnapshot::FindVariableWrites(int32 VariableIndex) const
+{
+	return VariableWrites[VariableIndex];
+}
+
+int32 FBlueprintSnapshot::FindNodeVariable(int32 NodeIndex) const
+{
+	return NodeVariables[NodeIndex];
+}
+
+bool FBlueprintSnapshot::HasLinkedDataOutput(int32 NodeIndex) const
+{
+	const FBlueprintSnapshotNode& Node = Nodes[NodeIndex];
+	for (int32 PinIndex = Node.FirstPin; PinIndex < Node.FirstPin + Node.NumPins; ++PinIndex)
+	{
+		const FBlueprintSnapshotPin& Pin = Pins[PinIndex];
+		if (Pin.Direction == EGPD_Output && Pin.Category != UEdGraphSchema_K2::PC_Exec && Pin.NumLinks > 0)
+		{
+			return true;
+		}
+	}
+	return false;
+}
+
+bool FBlueprintSnapshot::IsVariableRead(int32 VariableIndex) const
+{
+	if (!VariableReads[VariableIndex].IsEmpty())
+	{
+		return true;
+	}
+	for (const int32 WriteNode : VariableWrites[VariableIndex])
+	{
+		if (HasLinkedDataOutput(WriteNode))
+		{
+			return true;
+		}
+	}
+	return false;
+}
+
+TConstArrayView<int32> FBlueprintSnapshot::FindFunctionCalls(FName FunctionName) const
+{
+	return FindSnapshotBucket(FunctionCalls, FunctionName);
+}
+
+TConstArrayView<int32> FBlueprintSnapshot::FindMacroInstances(FName MacroName) const
+{
+	return FindSnapshotBucket(MacroInstances, MacroName);
+}
+
+TConstArrayView<int32> FBlueprintSnapshot::FindDelegateNodes(FName PropertyName) const
+{
+	return FindSnapshotBucket(DelegateNodes, PropertyName);
+}
+
+const FBlueprintSnapshotVariable* FBlueprintSnapshot::FindMemberVariable(FName VarName) const
+{
+	const int32* const VariableIndex = MemberVariables.Find(VarName);
+	return VariableIndex ? &Variables[*VariableIndex] : nullptr;
+}
@@ -0,0 +1,444 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "Analysis/BlueprintSnapshot.h"
+#include "Dom/JsonObject.h"
+#include "Serialization/JsonReader.h"
+#include "Serialization/JsonSerializer.h"
+
+namespace
+{
+	/** JSON names of `EValidatorXNodeKind`, in enum order. */
+	const TCHAR* const SnapshotNodeKindNames[] = {
+		TEXT("Other"),
+		TEXT("Comment"),
+		TEXT("Event"),
+		TEXT("FunctionEntry"),
+		TEXT("FunctionResult"),
+		TEXT("Tunnel"),
+		TEXT("MacroInstance"),
+		TEXT("CallFunction"),
+		TEXT("VariableGet"),
+		TEXT("VariableSet"),
+		TEXT("Branch"),
+		TEXT("AddDelegate"),
+		TEXT("RemoveDelegate"),
+		TEXT("CallDelegate"),
+		TEXT("OtherDelegate"),
+	};
+	static_assert(UE_ARRAY_COUNT(SnapshotNodeKindNames) == int32(EValidatorXNodeKind::OtherDelegate) + 1, "Every node kind needs a JSON name");
+
+	/** JSON names of `EValidatorXGraphType`, in enum order. */
+	const TCHAR* const SnapshotGraphTypeNames[] = {
+		TEXT("EventGraph"),
+		TEXT("Function"),
+		TEXT("Macro"),
+		TEXT("Delegate"),
+		TEXT("Intermediate"),
+		TEXT("Nested"),
+	};
+	static_assert(UE_ARRAY_COUNT(SnapshotGraphTypeNames) == int32(EValidatorXGraphType::Nested) + 1, "Every graph type needs a JSON name");
+
+	/** JSON names of `EPinContainerType`, in enum order. */
+	const TCHAR* const SnapshotContainerTypeNames[] = {
+		TEXT("None"),
+		TEXT("Array"),
+		TEXT("Set"),
+		TEXT("Map"),
+	};
+	static_assert(UE_ARRAY_COUNT(SnapshotContainerTypeNames) == int32(EPinContainerType::Map) + 1, "Every container type needs a JSON name");
+
+	template <typename EnumType, int32 NumNames>
+	bool ParseSnapshotEnum(const FString& Name, const TCHAR* const (&Names)[NumNames], EnumType& OutValue)
+	{
+		for (int32 Index = 0; Index < NumNames; ++Index)
+		{
+			if (Name == Names[Index])
+			{
+				OutValue = EnumType(Index);
+				return true;
+			}
+		}
+		return false;
+	}
+
+	FName GetSnapshotNameField(const FJsonObject& Object, const TCHAR* Field)
+	{
+		FString Value;
+		return Object.TryGetStringField(Field, Value) ? FName(*Value) : NAME_None;
+	}
+
+	/** @return `"Node.Pin"`, how links refer to pins in JSON. */
+	FString GetSnapshotPinPath(const FBlueprintSnapshot& Snapshot, int32 PinIndex)
+	{
+		const FBlueprintSnapshotPin& Pin = Snapshot.Pins[PinIndex];
+		return Snapshot.Nodes[Pin.Node].Name.ToString() + TEXT(".") + Pin.Name.ToString();
+	}
+} // namespace
+
+FString FBlueprintSnapshot::ToJson() const
+{
+	const TSharedRef<FJsonObject> Root = MakeShared<FJsonObject>();
+	Root->SetStringField(TEXT("blueprint"), BlueprintName.ToString());
+	Root->SetStringField(TEXT("package"), PackageName.ToString());
+
+	TArray<TSharedPtr<FJsonValue>> GraphValues;
+	for (int32 GraphIndex = 0; GraphIndex < Graphs.Num(); ++GraphIndex)
+	{
+		const FBlueprintSnapshotGraph& Graph = Graphs[GraphIndex];
+
+		const TSharedRef<FJsonObject> GraphObject = MakeShared<FJsonObject>();
+		GraphObject->SetStringField(TEXT("name"), Graph.Name.ToString());
+		GraphObject->SetStringField(TEXT("type"), SnapshotGraphTypeNames[int32(Graph.Type)]);
+
+		TArray<TSharedPtr<FJsonValue>> NodeValues;
+		TArray<TSharedPtr<FJsonValue>> LinkValues;
+		for (int32 NodeIndex = Graph.FirstNode; NodeIndex < Graph.FirstNode + Graph.NumNodes; ++NodeIndex)
+		{
+			const FBlueprintSnapshotNode& Node = Nodes[NodeIndex];
+
+			const TSharedRef<FJsonObject> NodeObject = MakeShared<FJsonObject>();
+			NodeObject->SetStringField(TEXT("kind"), SnapshotNodeKindNames[int32(Node.Kind)]);
+			NodeObject->SetStringField(TEXT("name"), Node.Name.ToString());
+			if (!Node.Title.IsEmpty())
+			{
+				NodeObject->SetStringField(TEXT("title"), Node.Title);
+			}
+			if (!Node.NodeClass.IsNone())
+			{
+				NodeObject->SetStringField(TEXT("class"), Node.NodeClass.ToString());
+			}
+			if (Node.Guid.IsValid())
+			{
+				NodeObject->SetStringField(TEXT("guid"), Node.Guid.ToString());
+			}
+			if (!Node.MemberName.IsNone())
+			{
+				NodeObject->SetStringField(TEXT("member"), Node.MemberName.ToString());
+			}
+			if (!Node.MemberPackage.IsNone())
+			{
+				NodeObject->SetStringField(TEXT("memberPackage"), Node.MemberPackage.ToString());
+			}
+			NodeObject->SetNumberField(TEXT("x"), Node.PosX);
+			NodeObject->SetNumberField(TEXT("y"), Node.PosY);
+			if (Node.Width != 0 || Node.Height != 0)
+			{
+				NodeObject->SetNumberField(TEXT("width"), Node.Width);
+				NodeObject->SetNumberField(TEXT("height"), Node.Height);
+			}
+			if (Node.bIsPure)
+			{
+				NodeObject->SetBoolField(TEXT("pure"), true);
+			}
+			if (Node.bIsTunnel)
+			{
+				NodeObject->SetBoolField(TEXT("tunnel"), true);
+			}
+			if (Node.bIsGhost)
+			{
+				NodeObject->SetBoolField(TEXT("ghost"), true);
+			}
+
+			TArray<TSharedPtr<FJsonValue>> PinValues;
+			for (int32 PinIndex = Node.FirstPin; PinIndex < Node.FirstPin + Node.NumPins; ++PinIndex)
+			{
+				const FBlueprintSnapshotPin& Pin = Pins[PinIndex];
+
+				const TSharedRef<FJsonObject> PinObject = MakeShared<FJsonObject>();
+				PinObject->SetStringField(TEXT("name"), Pin.Name.ToString());
+				PinObject->SetStringField(TEXT("category"), Pin.Category.ToString());
+				PinObject->SetStringField(TEXT("direction"), Pin.Direction == EGPD_Output ? TEXT("Output") : TEXT("Input"));
+				if (Pin.bIsEnum)
+				{
+					PinObject->SetBoolField(TEXT("enum"), true);
+				}
+				if (!Pin.DefaultValue.IsEmpty())
+				{
+					PinObject->SetStringField(TEXT("default"), Pin.DefaultValue);
+				}
+				PinValues.Add(MakeShared<FJsonValueObject>(PinObject));
+
+				// Each connection is stored from both pins; list it once, from the output side
+				for (const FBlueprintSnapshotLink& Link : GetLinks(PinIndex))
+				{
+					const bool bIsOutputSide = Pin.Direction == EGPD_Output;
+					if (bIsOutputSide || (Pins[Link.ToPin].Direction != EGPD_Output && Link.FromPin < Link.ToPin))
+					{
+						LinkValues.Add(MakeShared<FJsonValueArray>(TArray<TSharedPtr<FJsonValue>>{
+							MakeShared<FJsonValueString>(GetSnapshotPinPath(*this, Link.FromPin)),
+							MakeShared<FJsonValueString>(GetSnapshotPinPath(*this, Link.ToPin))}));
+					}
+				}
+			}
+			NodeObject->SetArrayField(TEXT("pins"), PinValues);
+
+			NodeValues.Add(MakeShared<FJsonValueObject>(NodeObject));
+		}
+		GraphObject->SetArrayField(TEXT("nodes"), NodeValues);
+		GraphObject->SetArrayField(TEXT("links"), LinkValues);
+
+		GraphValues.Add(MakeShared<FJsonValueObject>(GraphObject));
+	}
+	Root->SetArrayField(TEXT("graphs"), GraphValues);
+
+	TArray<TSharedPtr<FJsonValue>> VariableValues;
+	for (const FBlueprintSnapshotVariable& Variable : Variables)
+	{
+		const TSharedRef<FJsonObject> VariableObject = MakeShared<FJsonObject>();
+		VariableObject->SetStringField(TEXT("name"), Variable.Name.ToString());
+		VariableObject->SetStringField(TEXT("category"), Variable.Category.ToString());
+		if (Variable.bIsEnum)
+		{
+			VariableObject->SetBoolField(TEXT("enum"), true);
+		}
+		if (Variable.ContainerType != EPinContainerType::None)
+		{
+			VariableObject->SetStringField(TEXT("container"), SnapshotContainerTypeNames[int32(Variable.ContainerType)]);
+		}
+		if (Variable.ElementSize != 0 || Variable.NumElements != 0)
+		{
+			VariableObject->SetNumberField(TEXT("elementSize"), Variable.ElementSize);
+			VariableObject->SetNumberField(TEXT("numElements"), Variable.NumElements);
+		}
+		// 64-bit flags do not survive a JSON number
+		VariableObject->SetStringField(TEXT("propertyFlags"), FString::Printf(TEXT("0x%016llx"), Variable.PropertyFlags));
+		if (!Variable.DefaultValue.IsEmpty())
+		{
+			VariableObject->SetStringField(TEXT("default"), Variable.DefaultValue);
+		}
+		if (Variable.Graph != INDEX_NONE)
+		{
+			VariableObject->SetStringField(TEXT("graph"), Graphs[Variable.Graph].Name.ToString());
+		}
+		VariableObject->SetBoolField(TEXT("declared"), Variable.bIsDeclared);
+		VariableObject->SetBoolField(TEXT("hasProperty"), Variable.bHasProperty);
+		if (Variable.bIsPrivate)
+		{
+			VariableObject->SetBoolField(TEXT("private"), true);
+		}
+		VariableValues.Add(MakeShared<FJsonValueObject>(VariableObject));
+	}
+	Root->SetArrayField(TEXT("variables"), VariableValues);
+
+	FString Json;
+	FJsonSerializer::Serialize(Root, TJsonWriterFactory<>::Create(&Json));
+	return Json;
+}
+
+TSharedPtr<const FBlueprintSnapshot> FBlueprintSnapshot::CreateFromJson(const FString& Json, FString& OutError)
+{
+	TSharedPtr<FJsonObject> Root;
+	if (!FJsonSerializer::Deserialize(TJsonReaderFactory<>::Create(Json), Root) || !Root.IsValid())
+	{
+		OutError = TEXT("The document is not a JSON object.");
+		return nullptr;
+	}
+
+	const TSharedRef<FBlueprintSnapshot> Snapshot = MakeShared<FBlueprintSnapshot>();
+	Snapshot->BlueprintName = GetSnapshotNameField(*Root, TEXT("blueprint"));
+	Snapshot->PackageName = GetSnapshotNameField(*Root, TEXT("package"));
+
+	const TArray<TSharedPtr<FJsonValue>>* GraphValues = nullptr;
+	if (Root->TryGetArrayField(TEXT("graphs"), GraphValues))
+	{
+		for (const TSharedPtr<FJsonValue>& GraphValue : *GraphValues)
+		{
+			const TSharedPtr<FJsonObject> GraphObject = GraphValue->AsObject();
+			if (!GraphObject.IsValid())
+			{
+				OutError = TEXT("Graphs must be objects.");
+				return nullptr;
+			}
+
+			const int32 GraphIndex = Snapshot->Graphs.Num();
+			FBlueprintSnapshotGraph& Graph = Snapshot->Graphs.AddDefaulted_GetRef();
+			Graph.Name = GetSnapshotNameField(*GraphObject, TEXT("name"));
+			Graph.FirstNode = Snapshot->Nodes.Num();
+
+			FString TypeName;
+			if (GraphObject->TryGetStringField(TEXT("type"), TypeName) && !ParseSnapshotEnum(TypeName, SnapshotGraphTypeNames, Graph.Type))
+			{
+				OutError = FString::Printf(TEXT("Unknown graph type '%s'."), *TypeName);
+				return nullptr;
+			}
+
+			TMap<FName, int32> NodesByName;
+			const TArray<TSharedPtr<FJsonValue>>* NodeValues = nullptr;
+			if (GraphObject->TryGetArrayField(TEXT("nodes"), NodeValues))
+			{
+				for (const TSharedPtr<FJsonValue>& NodeValue : *NodeValues)
+				{
+					const TSharedPtr<FJsonObject> NodeObject = NodeValue->AsObject();
+					if (!NodeObject.IsValid())
+					{
+						OutError = TEXT("Nodes must be objects.");
+						return nullptr;
+					}
+
+					const int32 NodeIndex = Snapshot->Nodes.Num();
+					FBlueprintSnapshotNode& Node = Snapshot->Nodes.AddDefaulted_GetRef();
+					Node.Graph = GraphIndex;
+					Node.FirstPin = Snapshot->Pins.Num();
+
+					FString KindName;
+					if (NodeObject->TryGetStringField(TEXT("kind"), KindName) && !ParseSnapshotEnum(KindName, SnapshotNodeKindNames, Node.Kind))
+					{
+						OutError = FString::Printf(TEXT("Unknown node kind '%s'."), *KindName);
+						return nullptr;
+					}
+
+					Node.Name = GetSnapshotNameField(*NodeObject, TEXT("name"));
+					if (Node.Name.IsNone())
+					{
+						Node.Name = FName(*FString::Printf(TEXT("Node_%d"), NodeIndex - Graph.FirstNode));
+					}
+					NodesByName.Add(Node.Name, NodeIndex);
+					Node.NodeClass = GetSnapshotNameField(*NodeObject, TEXT("class"));
+					NodeObject->TryGetStringField(TEXT("title"), Node.Title);
+
+					FString GuidString;
+					if (NodeObject->TryGetStringField(TEXT("guid"), GuidString))
+					{
+						FGuid::Parse(GuidString, Node.Guid);
+					}
+
+					Node.MemberName = GetSnapshotNameField(*NodeObject, TEXT("member"));
+					Node.MemberPackage = GetSnapshotNameField(*NodeObject, TEXT("memberPackage"));
+					NodeObject->TryGetNumberField(TEXT("x"), Node.PosX);
+					NodeObject->TryGetNumberField(TEXT("y"), Node.PosY);
+					NodeObject->TryGetNumberField(TEXT("width"), Node.Width);
+					NodeObject->TryGetNumberField(TEXT("height"), Node.Height);
+					NodeObject->TryGetBoolField(TEXT("pure"), Node.bIsPure);
+					NodeObject->TryGetBoolField(TEXT("tunnel"), Node.bIsTunnel);
+					NodeObject->TryGetBoolField(TEXT("ghost"), Node.bIsGhost);
+
+					if (Node.Kind == EValidatorXNodeKind::FunctionEntry && Graph.EntryNode == INDEX_NONE)
+					{
+						Graph.EntryNode = NodeIndex;
+					}
+
+					const TArray<TSharedPtr<FJsonValue>>* PinValues = nullptr;
+					if (NodeObject->TryGetArrayField(TEXT("pins"), PinValues))
+					{
+						for (const TSharedPtr<FJsonValue>& PinValue : *PinValues)
+						{
+							const TSharedPtr<FJsonObject> PinObject = PinValue->AsObject();
+							if (!PinObject.IsValid())
+							{
+								OutError = TEXT("Pins must be objects.");
+								return nullptr;
+							}
+
+							FBlueprintSnapshotPin& Pin = Snapshot->Pins.AddDefaulted_GetRef();
+							Pin.Name = GetSnapshotNameField(*PinObject, TEXT("name"));
+							Pin.Category = GetSnapshotNameField(*PinObject, TEXT("category"));
+							Pin.Node = NodeIndex;
+							PinObject->TryGetStringField(TEXT("default"), Pin.DefaultValue);
+							PinObject->TryGetBoolField(TEXT("enum"), Pin.bIsEnum);
+
+							FString Direction;
+							Pin.Direction = PinObject->TryGetStringField(TEXT("direction"), Direction) && Direction == TEXT("Output") ? EGPD_Output : EGPD_Input;
+						}
+					}
+
+					// Node is not used past this point, as adding nodes may reallocate the array
+					Snapshot->Nodes[NodeIndex].NumPins = Snapshot->Pins.Num() - Snapshot->Nodes[NodeIndex].FirstPin;
+				}
+			}
+
+			FBlueprintSnapshotGraph& FilledGraph = Snapshot->Graphs[GraphIndex];
+			FilledGraph.NumNodes = Snapshot->Nodes.Num() - FilledGraph.FirstNode;
+
+			auto ResolvePin = [&Snapshot, &NodesByName](const FString& PinPath) -> int32
+			{
+				FString NodeName;
+				FString PinName;
+				if (!PinPath.Split(TEXT("."), &NodeName, &PinName))
+				{
+					return INDEX_NONE;
+				}
+				const int32* const NodeIndex = NodesByName.Find(FName(*NodeName));
+				return NodeIndex ? Snapshot->FindPinIndex(*NodeIndex, FName(*PinName)) : INDEX_NONE;
+			};
+
+			const TArray<TSharedPtr<FJsonValue>>* LinkValues = nullptr;
+			if (GraphObject->TryGetArrayField(TEXT("links"), LinkValues))
+			{
+				for (const TSharedPtr<FJsonValue>& LinkValue : *LinkValues)
+				{
+					const TArray<TSharedPtr<FJsonValue>>* Ends = nullptr;
+					if (!LinkValue->TryGetArray(Ends) || Ends->Num() != 2)
+					{
+						OutError = TEXT("Links must be [\"Node.Pin\", \"Node.Pin\"] pairs.");
+						return nullptr;
+					}
+
+					const FString FromPath = (*Ends)[0]->AsString();
+					const FString ToPath = (*Ends)[1]->AsString();
+					const int32 FromPin = ResolvePin(FromPath);
+					const int32 ToPin = ResolvePin(ToPath);
+					if (FromPin == INDEX_NONE || ToPin == INDEX_NONE)
+					{
+						OutError = FString::Printf(TEXT("Unknown pin in link '%s' -> '%s' of graph '%s'."), *FromPath, *ToPath, *FilledGraph.Name.ToString());
+						return nullptr;
+					}
+
+					Snapshot->Links.Add(FBlueprintSnapshotLink{FromPin, ToPin});
+					Snapshot->Links.Add(FBlueprintSnapshotLink{ToPin, FromPin});
+				}
+			}
+		}
+	}
+
+	const TArray<TSharedPtr<FJsonValue>>* VariableValues = nullptr;
+	if (Root->TryGetArrayField(TEXT("variables"), VariableValues))
+	{
+		for (const TSharedPtr<FJsonValue>& VariableValue : *VariableValues)
+		{
+			const TSharedPtr<FJsonObject> VariableObject = VariableValue->AsObject();
+			if (!VariableObject.IsValid())
+			{
+				OutError = TEXT("Variables must be objects.");
+				return nullptr;
+			}
+
+			FBlueprintSnapshotVariable& Variable = Snapshot->Variables.AddDefaulted_GetRef();
+			Variable.Name = GetSnapshotNameField(*VariableObject, TEXT("name"));
+			Variable.Category = GetSnapshotNameField(*VariableObject, TEXT("category"));
+			VariableObject->TryGetStringField(TEXT("default"), Variable.DefaultValue);
+			VariableObject->TryGetBoolField(TEXT("declared"), Variable.bIsDeclared);
+			VariableObject->TryGetBoolField(TEXT("hasProperty"), Variable.bHasProperty);
+			VariableObject->TryGetBoolField(TEXT("private"), Variable.bIsPrivate);
+			VariableObject->TryGetBoolField(TEXT("enum"), Variable.bIsEnum);
+			VariableObject->TryGetNumberField(TEXT("elementSize"), Variable.ElementSize);
+			VariableObject->TryGetNumberField(TEXT("numElements"), Variable.NumElements);
+
+			FString ContainerName;
+			if (VariableObject->TryGetStringField(TEXT("container"), ContainerName) && !ParseSnapshotEnum(ContainerName, SnapshotContainerTypeNames, Variable.ContainerType))
+			{
+				OutError = FString::Printf(TEXT("Unknown container type '%s' of variable '%s'."), *ContainerName, *Variable.Name.ToString());
+				return nullptr;
+			}
+
+			FString PropertyFlags;
+			if (VariableObject->TryGetStringField(TEXT("propertyFlags"), PropertyFlags))
+			{
+				Variable.PropertyFlags = FCString::Strtoui64(*PropertyFlags, nullptr, 0);
+			}
+
+			const FName GraphName = GetSnapshotNameField(*VariableObject, TEXT("graph"));
+			if (!GraphName.IsNone())
+			{
+				Variable.Graph = Snapshot->Graphs.IndexOfByPredicate([GraphName](const FBlueprintSnapshotGraph& Graph) { return Graph.Name == GraphName; });
+				if (Variable.Graph == INDEX_NONE)
+				{
+					OutError = FString::Printf(TEXT("Local variable '%s' refers to unknown graph '%s'."), *Variable.Name.ToString(), *GraphName.ToString());
+					return nullptr;
+				}
+			}
+		}
+	}
+
+	Snapshot->BuildLookups();
+	return Snapshot;
+}
@@ -0,0 +1,102 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "Analysis/CommentSpatialIndex.h"
+
+FCommentSpatialIndex::FCommentSpatialIndex(TArray<FBox> InBoxes)
+	: Boxes(MoveTemp(InBoxes))
+{
+	if (Boxes.IsEmpty())
+	{
+		return;
+	}
+
+	Bounds = Boxes[0];
+	for (const FBox& Box : Boxes)
+	{
+		Bounds.MinX = FMath::Min(Bounds.MinX, Box.MinX);
+		Bounds.MinY = FMath::Min(Bounds.MinY, Box.MinY);
+		Bounds.MaxX = FMath::Max(Bounds.MaxX, Box.MaxX);
+		Bounds.MaxY = FMath::Max(Bounds.MaxY, Box.MaxY);
+	}
+
+	// Roughly one box per cell along each axis, so a cell holds a handful of boxes
+	const int32 CellsPerAxis = FMath::Clamp(FMath::CeilToInt(FMath::Sqrt(float(Boxes.Num()))) * 2, 1, MaxCellsPerAxis);
+	const int64 ExtentX = int64(Bounds.MaxX) - Bounds.MinX + 1;
+	const int64 ExtentY = int64(Bounds.MaxY) - Bounds.MinY + 1;
+	CellWidth = int32(FMath::Max<int64>((ExtentX + CellsPerAxis - 1) / CellsPerAxis, 1));
+	CellHeight = int32(FMath::Max<int64>((ExtentY + CellsPerAxis - 1) / CellsPerAxis, 1));
+	NumCellsX = int32((ExtentX + CellWidth - 1) / CellWidth);
+	NumCellsY = int32((ExtentY + CellHeight - 1) / CellHeight);
+
+	auto ForEachCoveredCell = [this](const FBox& Box, auto&& Func)
+	{
+		const int32 FirstX = int32((int64(Box.MinX) - Bounds.MinX) / CellWidth);
+		const int32 LastX = int32((int64(Box.MaxX) - Bounds.MinX) / CellWidth);
+		const int32 FirstY = int32((int64(Box.MinY) - Bounds.MinY) / CellHeight);
+		const int32 LastY = int32((int64(Box.MaxY) - Bounds.MinY) / CellHeight);
+		for (int32 CellY = FirstY; CellY <= LastY; ++CellY)
+		{
+			for (int32 CellX = FirstX; CellX <= LastX; ++CellX)
+			{
+				Func(CellY * NumCellsX + CellX);
+			}
+		}
+	};
+
+	// Count, then fill, so every cell is a contiguous slice of one array
+	CellStarts.SetNumZeroed(NumCellsX * NumCellsY + 1);
+	for (const FBox& Box : Boxes)
+	{
+		ForEachCoveredCell(Box, [this](int32 Cell) { ++CellStarts[Cell + 1]; });
+	}
+
+	for (int32 Cell = 1; Cell < CellStarts.Num(); ++Cell)
+	{
+		CellStarts[Cell] += CellStarts[Cell - 1];
+	}
+
+	TArray<int32> CellFill(CellStarts.GetData(), CellStarts.Num() - 1);
+	CellBoxes.SetNumUninitialized(CellStarts.Last());
+	for (int32 BoxIndex = 0; BoxIndex < Boxes.Num(); ++BoxIndex)
+	{
+		ForEachCoveredCell(Boxes[BoxIndex], [this, &CellFill, BoxIndex](int32 Cell) { CellBoxes[CellFill[Cell]++] = BoxIndex; });
+	}
+}
+
+bool FCommentSpatialIndex::IsInsideAnyBox(int32 X, int32 Y) const
+{
+	for (const int32 BoxIndex : GetCellBoxes(X, Y))
+	{
+		if (Boxes[BoxIndex].Contains(X, Y))
+		{
+			return true;
+		}
+	}
+	return false;
+}
+
+int32 FCommentSpatialIndex::FindEnclosingBox(int32 X, int32 Y) const
+{
+	int32 Innermost = INDEX_NONE;
+	ForEachEnclosingBox(X, Y, [this, &Innermost](int32 BoxIndex)
+	{
+		if (Innermost == INDEX_NONE || Boxes[BoxIndex].GetArea() < Boxes[Innermost].GetArea())
+		{
+			Innermost = BoxIndex;
+		}
+	});
+	return Innermost;
+}
+
+TConstArrayView<int32> FCommentSpatialIndex::GetCellBoxes(int32 X, int32 Y) const
+{
+	if (Boxes.IsEmpty() || !Bounds.Contains(X, Y))
+	{
+		return TConstArrayView<int32>();
+	}
+
+	const int32 CellX = int32((int64(X) - Bounds.MinX) / CellWidth);
+	const int32 CellY = int32((int64(Y) - Bounds.MinY) / CellHeight);
+	const int32 Cell = CellY * NumCellsX + CellX;
+	return MakeArrayView(CellBoxes).Slice(CellStarts[Cell], CellStarts[Cell + 1] - CellStarts[Cell]);
+}
@@ -0,0 +1,88 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "Analysis/CostlyNodeClassifier.h"
+#include "Analysis/BlueprintSnapshot.h"
+
+EValidatorXCostlyNode ClassifyCostlyNode(const FBlueprintSnapshotNode& Node)
+{
+	static const FName DynamicCastClass(TEXT("K2Node_DynamicCast"));
+	static const FName ClassDynamicCastClass(TEXT("K2Node_ClassDynamicCast"));
+	static const FName SpawnActorFromClassClass(TEXT("K2Node_SpawnActorFromClass"));
+	static const FName SpawnActorClass(TEXT("K2Node_SpawnActor"));
+	static const FName CreateWidgetClass(TEXT("K2Node_CreateWidget"));
+	static const FName AddComponentClass(TEXT("K2Node_AddComponent"));
+	static const FName AddComponentByClassClass(TEXT("K2Node_AddComponentByClass"));
+	static const FName LoadAssetClass(TEXT("K2Node_LoadAsset"));
+	static const FName LoadAssetClassClass(TEXT("K2Node_LoadAssetClass"));
+	static const FName FormatTextClass(TEXT("K2Node_FormatText"));
+
+	if (Node.NodeClass == DynamicCastClass || Node.NodeClass == ClassDynamicCastClass)
+	{
+		return EValidatorXCostlyNode::Cast;
+	}
+	if (Node.NodeClass == SpawnActorFromClassClass || Node.NodeClass == SpawnActorClass || Node.NodeClass == CreateWidgetClass)
+	{
+		return EValidatorXCostlyNode::Spawn;
+	}
+	if (Node.NodeClass == AddComponentClass || Node.NodeClass == AddComponentByClassClass)
+	{
+		return EValidatorXCostlyNode::AddComponent;
+	}
+	if (Node.NodeClass == LoadAssetClass || Node.NodeClass == LoadAssetClassClass)
+	{
+		return EValidatorXCostlyNode::LoadAsset;
+	}
+	if (Node.NodeClass == FormatTextClass)
+	{
+		return EValidatorXCostlyNode::StringFormat;
+	}
+	if (Node.Kind != EValidatorXNodeKind::CallFunction)
+	{
+		return EValidatorXCostlyNode::None;
+	}
+
+	const FString FunctionName = Node.MemberName.ToString();
+	if (FunctionName.StartsWith(TEXT("GetAllActors")) || FunctionName.StartsWith(TEXT("GetAllWidgets")) || FunctionName == TEXT("GetActorOfClass"))
+	{
+		return EValidatorXCostlyNode::WorldQuery;
+	}
+	if (FunctionName.StartsWith(TEXT("LineTrace")) || FunctionName.StartsWith(TEXT("SphereTrace")) || FunctionName.StartsWith(TEXT("BoxTrace")) || FunctionName.StartsWith(TEXT("CapsuleTrace"))
+		|| FunctionName.EndsWith(TEXT("OverlapActors")) || FunctionName.EndsWith(TEXT("OverlapComponents")))
+	{
+		return EValidatorXCostlyNode::Trace;
+	}
+	if (FunctionName == TEXT("BeginDeferredActorSpawnFromClass"))
+	{
+		return EValidatorXCostlyNode::Spawn;
+	}
+	if (FunctionName == TEXT("K2_DestroyActor") || FunctionName == TEXT("K2_DestroyComponent"))
+	{
+		return EValidatorXCostlyNode::Destroy;
+	}
+	if (FunctionName == TEXT("AddComponentByClass"))
+	{
+		return EValidatorXCostlyNode::AddComponent;
+	}
+	if (FunctionName == TEXT("LoadAsset_Blocking") || FunctionName == TEXT("LoadClassAsset_Blocking"))
+	{
+		return EValidatorXCostlyNode::LoadAsset;
+	}
+	if (FunctionName == TEXT("Concat_StrStr") || FunctionName == TEXT("JoinStringArray") || FunctionName.StartsWith(TEXT("BuildString_"))
+		|| (FunctionName.StartsWith(TEXT("Conv_")) && (FunctionName.EndsWith(TEXT("ToString")) || FunctionName.EndsWith(TEXT("ToText")))))
+	{
+		return EValidatorXCostlyNode::StringFormat;
+	}
+	return EValidatorXCostlyNode::None;
+}
+
+FString GetCostlyNodeDisplayName(const FBlueprintSnapshotNode& Node)
+{
+	if (!Node.MemberName.IsNone())
+	{
+		return Node.MemberName.ToString();
+	}
+
+	FString ClassName = Node.NodeClass.ToString();
+	ClassName.RemoveFromStart(TEXT("K2Node_"));
+	return ClassName;
+}
@@ -0,0 +1,182 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "Analysis/ExecReachability.h"
+#include "Analysis/BlueprintSnapshot.h"
+#include "Algo/Sort.h"
+#include "EdGraphSchema_K2.h"
+
+namespace
+{
+	/** Execution pins of a snapshot node, found in one pass over its pins. */
+	struct FReachabilityNodePins
+	{
+		bool bHasExecInput = false;
+		bool bHasExecOutput = false;
+		bool bIsLinked = false;
+	};
+
+	FReachabilityNodePins GetReachabilityNodePins(const FBlueprintSnapshot& Snapshot, int32 NodeIndex)
+	{
+		FReachabilityNodePins Result;
+		for (const FBlueprintSnapshotPin& Pin : Snapshot.GetPins(NodeIndex))
+		{
+			if (Pin.Category == UEdGraphSchema_K2::PC_Exec)
+			{
+				(Pin.Direction == EGPD_Output ? Result.bHasExecOutput : Result.bHasExecInput) = true;
+			}
+			Result.bIsLinked |= Pin.NumLinks > 0;
+		}
+		return Result;
+	}
+
+	/** @return Whether tunnel nodes of a graph are its boundaries rather than collapsed nodes. */
+	bool HasTunnelBoundaries(EValidatorXGraphType GraphType)
+	{
+		return GraphType == EValidatorXGraphType::Macro || GraphType == EValidatorXGraphType::Nested;
+	}
+
+	/** @return Whether a node is left out of dead chains even when it is never reached. */
+	bool IsReachabilityExempt(const FBlueprintSnapshot& Snapshot, int32 NodeIndex)
+	{
+		const FBlueprintSnapshotNode& Node = Snapshot.Nodes[NodeIndex];
+		if (Node.Kind == EValidatorXNodeKind::Comment || Node.Kind == EValidatorXNodeKind::FunctionResult)
+		{
+			return true;
+		}
+
+		// Output tunnels mirror function results; input tunnels are entry points
+		return Node.Kind == EValidatorXNodeKind::Tunnel && HasTunnelBoundaries(Snapshot.Graphs[Node.Graph].Type);
+	}
+} // namespace
+
+FExecReachability::FExecReachability(const FBlueprintSnapshot& Snapshot)
+	: Reachable(false, Snapshot.Nodes.Num())
+	, EntryPoints(false, Snapshot.Nodes.Num())
+{
+	MarkReachableNodes(Snapshot);
+	CollectDeadChains(Snapshot);
+}
+
+void FExecReachability::MarkReachableNodes(const FBlueprintSnapshot& Snapshot)
+{
+	TBitArray<> HasExecPins(false, Snapshot.Nodes.Num());
+	TArray<int32> Stack;
+
+	auto Visit = [this, &Stack](int32 NodeIndex)
+	{
+		if (!Reachable[NodeIndex])
+		{
+			Reachable[NodeIndex] = true;
+			Stack.Add(NodeIndex);
+		}
+	};
+
+	for (int32 NodeIndex = 0; NodeIndex < Snapshot.Nodes.Num(); ++NodeIndex)
+	{
+		const FBlueprintSnapshotNode& Node = Snapshot.Nodes[NodeIndex];
+		const FReachabilityNodePins NodePins = GetReachabilityNodePins(Snapshot, NodeIndex);
+		HasExecPins[NodeIndex] = NodePins.bHasExecInput || NodePins.bHasExecOutput;
+
+		bool bIsEntryPoint = false;
+		if (Node.Kind == EValidatorXNodeKind::FunctionEntry)
+		{
+			bIsEntryPoint = true;
+		}
+		else if (Node.Kind == EValidatorXNodeKind::Tunnel && HasTunnelBoundaries(Snapshot.Graphs[Node.Graph].Type))
+		{
+			// Input tunnel, or either tunnel of a macro without execution pins
+			bIsEntryPoint = !NodePins.bHasExecInput;
+		}
+		else if (Node.Kind == EValidatorXNodeKind::Event || (NodePins.bHasExecOutput && !NodePins.bHasExecInput))
+		{
+			// An event without any link does nothing, so it is reported with the dead chains, unless the
+			// editor placed it
+			bIsEntryPoint = NodePins.bIsLinked || Node.bIsGhost;
+		}
+
+		if (bIsEntryPoint)
+		{
+			EntryPoints[NodeIndex] = true;
+			Visit(NodeIndex);
+		}
+	}
+
+	while (!Stack.IsEmpty())
+	{
+		const int32 NodeIndex = Stack.Pop(EAllowShrinking::No);
+		const FBlueprintSnapshotNode& Node = Snapshot.Nodes[NodeIndex];
+
+		for (int32 PinIndex = Node.FirstPin; PinIndex < Node.FirstPin + Node.NumPins; ++PinIndex)
+		{
+			const FBlueprintSnapshotPin& Pin = Snapshot.Pins[PinIndex];
+			const bool bIsExec = Pin.Category == UEdGraphSchema_K2::PC_Exec;
+
+			if (bIsExec && Pin.Direction == EGPD_Output)
+			{
+				for (const FBlueprintSnapshotLink& Link : Snapshot.GetLinks(PinIndex))
+				{
+					Visit(Snapshot.Pins[Link.ToPin].Node);
+				}
+			}
+			else if (!bIsExec && Pin.Direction == EGPD_Input)
+			{
+				// Impure nodes feeding a data input only run when execution reaches them
+				for (const FBlueprintSnapshotLink& Link : Snapshot.GetLinks(PinIndex))
+				{
+					const int32 SourceNode = Snapshot.Pins[Link.ToPin].Node;
+					if (!HasExecPins[SourceNode])
+					{
+						Visit(SourceNode);
+					}
+				}
+			}
+		}
+	}
+}
+
+void FExecReachability::CollectDeadChains(const FBlueprintSnapshot& Snapshot)
+{
+	TBitArray<> Collected(false, Snapshot.Nodes.Num());
+	TArray<int32> Stack;
+
+	auto IsDead = [this, &Snapshot](int32 NodeIndex)
+	{
+		return !Reachable[NodeIndex] && !IsReachabilityExempt(Snapshot, NodeIndex);
+	};
+
+	ChainStarts.Add(0);
+	for (int32 FirstNode = 0; FirstNode < Snapshot.Nodes.Num(); ++FirstNode)
+	{
+		if (Collected[FirstNode] || !IsDead(FirstNode))
+		{
+			continue;
+		}
+
+		const int32 ChainStart = ChainNodes.Num();
+		Collected[FirstNode] = true;
+		Stack.Add(FirstNode);
+
+		while (!Stack.IsEmpty())
+		{
+			const int32 NodeIndex = Stack.Pop(EAllowShrinking::No);
+			ChainNodes.Add(NodeIndex);
+
+			const FBlueprintSnapshotNode& Node = Snapshot.Nodes[NodeIndex];
+			for (int32 PinIndex = Node.FirstPin; PinIndex < Node.FirstPin + Node.NumPins; ++PinIndex)
+			{
+				for (const FBlueprintSnapshotLink& Link : Snapshot.GetLinks(PinIndex))
+				{
+					const int32 LinkedNode = Snapshot.Pins[Link.ToPin].Node;
+					if (!Collected[LinkedNode] && IsDead(LinkedNode))
+					{
+						Collected[LinkedNode] = true;
+						Stack.Add(LinkedNode);
+					}
+				}
+			}
+		}
+
+		Algo::Sort(MakeArrayView(ChainNodes.GetData() + ChainStart, ChainNodes.Num() - ChainStart));
+		ChainStarts.Add(ChainNodes.Num());
+	}
+}
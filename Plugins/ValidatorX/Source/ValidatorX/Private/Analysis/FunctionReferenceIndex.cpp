@@ -0,0 +1,538 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "Analysis/FunctionReferenceIndex.h"
+#include "ValidatorXManager.h"
+#include "AssetRegistry/IAssetRegistry.h"
+#include "Editor.h"
+#include "Engine/Blueprint.h"
+#include "HAL/FileManager.h"
+#include "K2Node_CallFunction.h"
+#include "K2Node_CreateDelegate.h"
+#include "Kismet2/BlueprintEditorUtils.h"
+#include "Library/BPUtilsNodeFunctionLibrary.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "Misc/ScopedSlowTask.h"
+#include "Serialization/MemoryReader.h"
+#include "Serialization/MemoryWriter.h"
+#include "UObject/ObjectSaveContext.h"
+#include "UObject/Package.h"
+
+DEFINE_LOG_CATEGORY_STATIC(LogValidatorXFunctionReferences, Log, All);
+
+namespace
+{
+	/** Identifies a ValidatorX function reference index file. */
+	constexpr uint32 FunctionReferenceIndexMagic = 0x52465856; // "VXFR"
+
+	/** Bumped whenever the layout of the index file, or what is indexed, changes. */
+	constexpr int32 FunctionReferenceIndexFormatVersion = 1;
+
+	/** Number of Blueprints loaded by `IndexPendingPackages` between garbage collections. */
+	constexpr int32 FunctionReferenceIndexGCInterval = 64;
+
+	/** Returns the key of a function that could not be resolved, from its owner class and name. */
+	FValidatorXFunctionKey MakeUnresolvedFunctionKey(const UClass* OwnerClass, FName FunctionName)
+	{
+		if (!OwnerClass || FunctionName.IsNone())
+		{
+			return FValidatorXFunctionKey();
+		}
+		return FValidatorXFunctionKey{OwnerClass->GetAuthoritativeClass()->GetClassPathName(), FunctionName};
+	}
+
+	/** Returns the function called or bound by a node, or an invalid key if the node does neither. */
+	FValidatorXFunctionKey GetReferencedFunctionKey(const UEdGraphNode* Node)
+	{
+		if (const UK2Node_CallFunction* const CallNode = Cast<UK2Node_CallFunction>(Node))
+		{
+			if (const UFunction* const Function = CallNode->GetTargetFunction())
+			{
+				return FFunctionReferenceIndex::GetFunctionKey(*Function);
+			}
+			return MakeUnresolvedFunctionKey(CallNode->FunctionReference.GetMemberParentClass(CallNode->GetBlueprintClassFromNode()), CallNode->FunctionReference.GetMemberName());
+		}
+
+		if (const UK2Node_CreateDelegate* const DelegateNode = Cast<UK2Node_CreateDelegate>(Node))
+		{
+			const UClass* const ScopeClass = DelegateNode->GetScopeClass();
+			const FName FunctionName = DelegateNode->GetFunctionName();
+			if (const UFunction* const Function = ScopeClass ? ScopeClass->FindFunctionByName(FunctionName) : nullptr)
+			{
+				return FFunctionReferenceIndex::GetFunctionKey(*Function);
+			}
+			return MakeUnresolvedFunctionKey(ScopeClass, FunctionName);
+		}
+
+		return FValidatorXFunctionKey();
+	}
+} // namespace
+
+FArchive& operator<<(FArchive& Ar, FValidatorXFunctionKey& Key)
+{
+	return Ar << Key.OwnerClass << Key.FunctionName;
+}
+
+FArchive& operator<<(FArchive& Ar, FFunctionReferenceIndex::FPackageRecord::FCall& Call)
+{
+	return Ar << Call.Function << Call.GraphName;
+}
+
+FArchive& operator<<(FArchive& Ar, FFunctionReferenceIndex::FPackageRecord& Record)
+{
+	return Ar << Record.PackageHash << Record.Calls;
+}
+
+FFunctionReferenceIndex::~FFunctionReferenceIndex()
+{
+	Shutdown();
+}
+
+FString FFunctionReferenceIndex::GetIndexFilename()
+{
+	return FPaths::ProjectSavedDir() / TEXT("ValidatorX") / TEXT("FunctionReferences.bin");
+}
+
+void FFunctionReferenceIndex::Initialize()
+{
+	if (bIsInitialized)
+	{
+		return;
+	}
+
+	IAssetRegistry* const AssetRegistry = IAssetRegistry::Get();
+	if (!AssetRegistry)
+	{
+		return;
+	}
+
+	bIsInitialized = true;
+
+	TArray<uint8> Bytes;
+	if (FFileHelper::LoadFileToArray(Bytes, *GetIndexFilename(), FILEREAD_Silent))
+	{
+		FMemoryReader Reader(Bytes);
+		uint32 Magic = 0;
+		int32 FormatVersion = 0;
+		Reader << Magic << FormatVersion;
+		if (Magic == FunctionReferenceIndexMagic && FormatVersion == FunctionReferenceIndexFormatVersion)
+		{
+			Reader << Records;
+			if (Reader.IsError())
+			{
+				UE_LOG(LogValidatorXFunctionReferences, Warning, TEXT("Function reference index '%s' is corrupted and will be rebuilt."), *GetIndexFilename());
+				Records.Reset();
+			}
+		}
+		else
+		{
+			UE_LOG(LogValidatorXFunctionReferences, Display, TEXT("Discarding function reference index with an unknown format."));
+		}
+	}
+
+	// Subscribe first: assets discovered by a scan still in progress are checked by the events
+	AssetAddedHandle = AssetRegistry->OnAssetAdded().AddRaw(this, &FFunctionReferenceIndex::HandleAssetAdded);
+	AssetRemovedHandle = AssetRegistry->OnAssetRemoved().AddRaw(this, &FFunctionReferenceIndex::HandleAssetRemoved);
+	AssetRenamedHandle = AssetRegistry->OnAssetRenamed().AddRaw(this, &FFunctionReferenceIndex::HandleAssetRenamed);
+	AssetLoadedHandle = FCoreUObjectDelegates::OnAssetLoaded.AddRaw(this, &FFunctionReferenceIndex::HandleAssetLoaded);
+	PackageSavedHandle = UPackage::PackageSavedWithContextEvent.AddRaw(this, &FFunctionReferenceIndex::HandlePackageSaved);
+	if (GEditor)
+	{
+		BlueprintPreCompileHandle = GEditor->OnBlueprintPreCompile().AddRaw(this, &FFunctionReferenceIndex::HandleBlueprintPreCompile);
+	}
+
+	FARFilter Filter;
+	Filter.ClassPaths.Add(UBlueprint::StaticClass()->GetClassPathName());
+	Filter.bRecursiveClasses = true;
+
+	TSet<FName> BlueprintPackages;
+	AssetRegistry->EnumerateAssets(Filter, [&BlueprintPackages](const FAssetData& AssetData)
+	{
+		BlueprintPackages.Add(AssetData.PackageName);
+		return true;
+	});
+
+	for (auto It = Records.CreateIterator(); It; ++It)
+	{
+		if (!BlueprintPackages.Contains(It.Key()))
+		{
+			It.RemoveCurrent();
+			bIsDirty = true;
+		}
+	}
+
+	for (const TPair<FName, FPackageRecord>& Pair : Records)
+	{
+		AddRecordCallSites(Pair.Key, Pair.Value);
+	}
+
+	for (const FName PackageName : BlueprintPackages)
+	{
+		CheckPackage(PackageName);
+	}
+
+	UE_LOG(LogValidatorXFunctionReferences, Verbose, TEXT("Function reference index: %d packages up to date, %d pending."), BlueprintPackages.Num() - PendingPackages.Num(), PendingPackages.Num());
+}
+
+void FFunctionReferenceIndex::Shutdown()
+{
+	if (!bIsInitialized)
+	{
+		return;
+	}
+
+	Save();
+
+	if (IAssetRegistry* const AssetRegistry = IAssetRegistry::Get())
+	{
+		AssetRegistry->OnAssetAdded().Remove(AssetAddedHandle);
+		AssetRegistry->OnAssetRemoved().Remove(AssetRemovedHandle);
+		AssetRegistry->OnAssetRenamed().Remove(AssetRenamedHandle);
+	}
+	FCoreUObjectDelegates::OnAssetLoaded.Remove(AssetLoadedHandle);
+	UPackage::PackageSavedWithContextEvent.Remove(PackageSavedHandle);
+	if (GEditor)
+	{
+		GEditor->OnBlueprintPreCompile().Remove(BlueprintPreCompileHandle);
+	}
+
+	Records.Reset();
+	CallSites.Reset();
+	CallerPackages.Reset();
+	PendingPackages.Reset();
+	LoadedPendingPackages.Reset();
+	bIsInitialized = false;
+}
+
+void FFunctionReferenceIndex::Refresh()
+{
+	if (LoadedPendingPackages.IsEmpty())
+	{
+		return;
+	}
+
+	const TArray<FName> PackageNames = LoadedPendingPackages.Array();
+	LoadedPendingPackages.Reset();
+
+	for (const FName PackageName : PackageNames)
+	{
+		if (const UBlueprint* const Blueprint = UBPUtilsNodeFunctionLibrary::FindLoadedBlueprint(PackageName))
+		{
+			IndexBlueprint(*Blueprint);
+		}
+	}
+}
+
+int32 FFunctionReferenceIndex::IndexPendingPackages(bool bShowProgress)
+{
+	check(IsInGameThread());
+
+	Refresh();
+
+	TArray<FName> PackageNames = PendingPackages.Array();
+	PackageNames.Sort(FNameLexicalLess());
+
+	FScopedSlowTask SlowTask(PackageNames.Num(), INVTEXT("Indexing Blueprint function calls..."), bShowProgress);
+	if (bShowProgress)
+	{
+		SlowTask.MakeDialog(true);
+	}
+
+	IAssetRegistry& AssetRegistry = IAssetRegistry::GetChecked();
+	int32 NumIndexed = 0;
+	int32 NumLoaded = 0;
+	for (const FName PackageName : PackageNames)
+	{
+		if (SlowTask.ShouldCancel())
+		{
+			break;
+		}
+		SlowTask.EnterProgressFrame();
+
+		const UBlueprint* Blueprint = UBPUtilsNodeFunctionLibrary::FindLoadedBlueprint(PackageName);
+		if (!Blueprint)
+		{
+			TArray<FAssetData> Assets;
+			AssetRegistry.GetAssetsByPackageName(PackageName, Assets);
+			for (const FAssetData& AssetData : Assets)
+			{
+				if (AssetData.IsInstanceOf(UBlueprint::StaticClass()))
+				{
+					Blueprint = Cast<UBlueprint>(AssetData.GetAsset());
+					break;
+				}
+			}
+			++NumLoaded;
+		}
+
+		if (Blueprint)
+		{
+			IndexBlueprint(*Blueprint);
+		}
+		else
+		{
+			// Unloadable packages call nothing; record them so they do not stay pending
+			RemovePackage(PackageName);
+			Records.Add(PackageName).PackageHash = FValidatorXManager::Get().GetResultCache().GetPackageHash(PackageName);
+			PendingPackages.Remove(PackageName);
+			bIsDirty = true;
+		}
+		++NumIndexed;
+
+		if (NumLoaded >= FunctionReferenceIndexGCInterval)
+		{
+			CollectGarbage(GARBAGE_COLLECTION_KEEPFLAGS);
+			NumLoaded = 0;
+		}
+	}
+
+	Save();
+
+	UE_LOG(LogValidatorXFunctionReferences, Display, TEXT("Indexed the function calls of %d Blueprint packages, %d still pending."), NumIndexed, PendingPackages.Num());
+	return NumIndexed;
+}
+
+FValidatorXFunctionKey FFunctionReferenceIndex::GetFunctionKey(const UFunction& Function)
+{
+	const UFunction* Declaration = &Function;
+	while (const UFunction* const SuperFunction = Declaration->GetSuperFunction())
+	{
+		Declaration = SuperFunction;
+	}
+
+	const UClass* const OwnerClass = Declaration->GetOwnerClass();
+	return FValidatorXFunctionKey{OwnerClass ? OwnerClass->GetAuthoritativeClass()->GetClassPathName() : FTopLevelAssetPath(), Declaration->GetFName()};
+}
+
+TConstArrayView<FValidatorXFunctionCallSite> FFunctionReferenceIndex::FindCallSites(const FValidatorXFunctionKey& Key) const
+{
+	if (const TArray<FValidatorXFunctionCallSite>* const Sites = CallSites.Find(Key))
+	{
+		return *Sites;
+	}
+	return TConstArrayView<FValidatorXFunctionCallSite>();
+}
+
+void FFunctionReferenceIndex::GetCallerPackages(FName PackageName, TArray<FName>& OutPackages) const
+{
+	if (const TSet<FName>* const Callers = CallerPackages.Find(PackageName))
+	{
+		TArray<FName> SortedCallers = Callers->Array();
+		SortedCallers.Sort(FNameLexicalLess());
+		OutPackages.Append(SortedCallers);
+	}
+}
+
+void FFunctionReferenceIndex::Save()
+{
+	if (!bIsDirty)
+	{
+		return;
+	}
+
+	TArray<uint8> Bytes;
+	FMemoryWriter Writer(Bytes);
+	uint32 Magic = FunctionReferenceIndexMagic;
+	int32 FormatVersion = FunctionReferenceIndexFormatVersion;
+	Writer << Magic << FormatVersion << Records;
+
+	if (FFileHelper::SaveArrayToFile(Bytes, *GetIndexFilename()))
+	{
+		bIsDirty = false;
+	}
+	else
+	{
+		UE_LOG(LogValidatorXFunctionReferences, Warning, TEXT("Failed to write function reference index '%s'."), *GetIndexFilename());
+	}
+}
+
+void FFunctionReferenceIndex::Clear()
+{
+	TArray<FName> PackageNames;
+	Records.GetKeys(PackageNames);
+	PackageNames.Append(PendingPackages.Array());
+
+	Records.Reset();
+	CallSites.Reset();
+	CallerPackages.Reset();
+	PendingPackages.Reset();
+	LoadedPendingPackages.Reset();
+	bIsDirty = false;
+	IFileManager::Get().Delete(*GetIndexFilename(), false, false, true);
+
+	for (const FName PackageName : PackageNames)
+	{
+		CheckPackage(PackageName);
+	}
+}
+
+void FFunctionReferenceIndex::IndexBlueprint(const UBlueprint& Blueprint)
+{
+	const FName PackageName = Blueprint.GetPackage()->GetFName();
+	RemovePackage(PackageName);
+
+	FPackageRecord& Record = Records.Add(PackageName);
+	Record.PackageHash = FValidatorXManager::Get().GetResultCache().GetPackageHash(PackageName);
+
+	TArray<UEdGraph*> Graphs;
+	Blueprint.GetAllGraphs(Graphs);
+	for (const UEdGraph* const Graph : Graphs)
+	{
+		if (!Graph)
+		{
+			continue;
+		}
+
+		// Calls inside collapsed graphs belong to the function or event graph containing them
+		const UEdGraph* const TopLevelGraph = FBlueprintEditorUtils::GetTopLevelGraph(Graph);
+		const FName GraphName = TopLevelGraph ? TopLevelGraph->GetFName() : Graph->GetFName();
+
+		for (const UEdGraphNode* const Node : Graph->Nodes)
+		{
+			const FValidatorXFunctionKey Key = GetReferencedFunctionKey(Node);
+			if (Key.OwnerClass.IsValid())
+			{
+				Record.Calls.Add(FPackageRecord::FCall{Key, GraphName});
+			}
+		}
+	}
+
+	AddRecordCallSites(PackageName, Record);
+	PendingPackages.Remove(PackageName);
+	LoadedPendingPackages.Remove(PackageName);
+	bIsDirty = true;
+}
+
+void FFunctionReferenceIndex::AddRecordCallSites(FName PackageName, const FPackageRecord& Record)
+{
+	for (const FPackageRecord::FCall& Call : Record.Calls)
+	{
+		CallSites.FindOrAdd(Call.Function).Add(FValidatorXFunctionCallSite{PackageName, Call.GraphName});
+
+		const FName CalledPackage = Call.Function.OwnerClass.GetPackageName();
+		if (CalledPackage != PackageName)
+		{
+			CallerPackages.FindOrAdd(CalledPackage).Add(PackageName);
+		}
+	}
+}
+
+void FFunctionReferenceIndex::RemovePackage(FName PackageName)
+{
+	FPackageRecord Record;
+	if (!Records.RemoveAndCopyValue(PackageName, Record))
+	{
+		return;
+	}
+
+	for (const FPackageRecord::FCall& Call : Record.Calls)
+	{
+		if (TArray<FValidatorXFunctionCallSite>* const Sites = CallSites.Find(Call.Function))
+		{
+			Sites->RemoveAll([PackageName](const FValidatorXFunctionCallSite& Site) { return Site.PackageName == PackageName; });
+			if (Sites->IsEmpty())
+			{
+				CallSites.Remove(Call.Function);
+			}
+		}
+
+		const FName CalledPackage = Call.Function.OwnerClass.GetPackageName();
+		if (TSet<FName>* const Callers = CallerPackages.Find(CalledPackage))
+		{
+			Callers->Remove(PackageName);
+			if (Callers->IsEmpty())
+			{
+				CallerPackages.Remove(CalledPackage);
+			}
+		}
+	}
+
+	bIsDirty = true;
+}
+
+void FFunctionReferenceIndex::CheckPackage(FName PackageName)
+{
+	const FPackageRecord* const Record = Records.Find(PackageName);
+	const FString& PackageHash = FValidatorXManager::Get().GetResultCache().GetPackageHash(PackageName);
+	if (Record && !PackageHash.IsEmpty() && Record->PackageHash == PackageHash)
+	{
+		return;
+	}
+
+	PendingPackages.Add(PackageName);
+	if (UBPUtilsNodeFunctionLibrary::FindLoadedBlueprint(PackageName))
+	{
+		LoadedPendingPackages.Add(PackageName);
+	}
+}
+
+void FFunctionReferenceIndex::HandleAssetAdded(const FAssetData& AssetData)
+{
+	if (AssetData.IsInstanceOf(UBlueprint::StaticClass()))
+	{
+		CheckPackage(AssetData.PackageName);
+	}
+}
+
+void FFunctionReferenceIndex::HandleAssetRemoved(const FAssetData& AssetData)
+{
+	RemovePackage(AssetData.PackageName);
+	PendingPackages.Remove(AssetData.PackageName);
+	LoadedPendingPackages.Remove(AssetData.PackageName);
+}
+
+void FFunctionReferenceIndex::HandleAssetRenamed(const FAssetData& AssetData, const FString& OldObjectPath)
+{
+	const FName OldPackageName = FSoftObjectPath(OldObjectPath).GetLongPackageFName();
+	RemovePackage(OldPackageName);
+	PendingPackages.Remove(OldPackageName);
+	LoadedPendingPackages.Remove(OldPackageName);
+
+	// Calls into the renamed Blueprint are keyed by its old class path until the callers are indexed again
+	if (TSet<FName>* const Callers = CallerPackages.Find(OldPackageName))
+	{
+		for (const FName Caller : *Callers)
+		{
+			PendingPackages.Add(Caller);
+			if (UBPUtilsNodeFunctionLibrary::FindLoadedBlueprint(Caller))
+			{
+				LoadedPendingPackages.Add(Caller);
+			}
+		}
+	}
+
+	HandleAssetAdded(AssetData);
+}
+
+void FFunctionReferenceIndex::HandleAssetLoaded(UObject* Object)
+{
+	if (const UBlueprint* const Blueprint = Cast<UBlueprint>(Object))
+	{
+		const FName PackageName = Blueprint->GetPackage()->GetFName();
+		if (PendingPackages.Contains(PackageName))
+		{
+			LoadedPendingPackages.Add(PackageName);
+		}
+	}
+}
+
+void FFunctionReferenceIndex::HandleBlueprintPreCompile(UBlueprint* Blueprint)
+{
+	if (Blueprint)
+	{
+		const FName PackageName = Blueprint->GetPackage()->GetFName();
+		PendingPackages.Add(PackageName);
+		LoadedPendingPackages.Add(PackageName);
+	}
+}
+
+void FFunctionReferenceIndex::HandlePackageSaved(const FString& PackageFilename, UPackage* Package, FObjectPostSaveContext ObjectSaveContext)
+{
+	if (Package && UBPUtilsNodeFunctionLibrary::FindLoadedBlueprint(Package->GetFName()))
+	{
+		// Records store the saved hash, which has just changed
+		FValidatorXManager::Get().GetResultCache().ResetPackageHashes();
+		PendingPackages.Add(Package->GetFName());
+		LoadedPendingPackages.Add(Package->GetFName());
+	}
+}
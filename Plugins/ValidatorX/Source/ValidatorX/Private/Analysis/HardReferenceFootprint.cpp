@@ -0,0 +1,184 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "Analysis/HardReferenceFootprint.h"
+#include "AssetRegistry/IAssetRegistry.h"
+
+namespace
+{
+	const FName TextureDimensionsTag(TEXT("Dimensions"));
+
+	bool IsCountedFootprintPackage(FName PackageName, bool bIncludeEngineContent)
+	{
+		TStringBuilder<256> PackagePath;
+		PackageName.ToString(PackagePath);
+		const FStringView PathView = PackagePath.ToView();
+		return !PathView.StartsWith(TEXT("/Script/")) && (bIncludeEngineContent || !PathView.StartsWith(TEXT("/Engine/")));
+	}
+
+	/**
+	 * Estimates the memory of a texture from its "WidthxHeight" dimensions tag: one byte per pixel,
+	 * as BC3 and BC7 compress to, plus a third for the mip chain.
+	 */
+	TOptional<int64> EstimateTextureMemory(const FAssetData& AssetData)
+	{
+		FString Dimensions;
+		FString Width;
+		FString Height;
+		if (!AssetData.GetTagValue(TextureDimensionsTag, Dimensions) || !Dimensions.Split(TEXT("x"), &Width, &Height))
+		{
+			return {};
+		}
+
+		const int64 NumPixels = static_cast<int64>(FCString::Atoi(*Width)) * FCString::Atoi(*Height);
+		return NumPixels > 0 ? NumPixels * 4 / 3 : TOptional<int64>();
+	}
+} // namespace
+
+FHardReferenceFootprint::FHardReferenceFootprint(bool bInIncludeEngineContent, TMap<FName, float> InClassSizeFactors)
+	: bIncludeEngineContent(bInIncludeEngineContent)
+	, ClassSizeFactors(MoveTemp(InClassSizeFactors))
+{
+}
+
+bool FHardReferenceFootprint::HasSettings(bool bInIncludeEngineContent, const TMap<FName, float>& InClassSizeFactors) const
+{
+	return bIncludeEngineContent == bInIncludeEngineContent && ClassSizeFactors.OrderIndependentCompareEqual(InClassSizeFactors);
+}
+
+bool FHardReferenceFootprint::IsCounted(FName PackageName) const
+{
+	return IsCountedFootprintPackage(PackageName, bIncludeEngineContent);
+}
+
+TConstArrayView<FName> FHardReferenceFootprint::GetDependencies(FName PackageName)
+{
+	return GetPackageInfo(PackageName).Dependencies;
+}
+
+FHardReferenceFootprint::FSize FHardReferenceFootprint::GetClosureSize(TConstArrayView<FName> Roots, TArray<FName>* OutPackages)
+{
+	FSize Size;
+	TSet<FName> Visited;
+	TArray<FName> Stack;
+
+	for (const FName Root : Roots)
+	{
+		bool bIsAlreadyVisited = false;
+		Visited.Add(Root, &bIsAlreadyVisited);
+		if (!bIsAlreadyVisited && IsCounted(Root))
+		{
+			Stack.Add(Root);
+		}
+	}
+
+	while (!Stack.IsEmpty())
+	{
+		const FName PackageName = Stack.Pop(EAllowShrinking::No);
+
+		// Copied out, as querying the dependencies below can grow the memoized map
+		const FPackageInfo& Info = GetPackageInfo(PackageName);
+		const TArray<FName> Dependencies = Info.Dependencies;
+		Size.DiskSize += Info.DiskSize;
+		Size.EstimatedSize += Info.EstimatedSize;
+		++Size.NumPackages;
+		if (OutPackages)
+		{
+			OutPackages->Add(PackageName);
+		}
+
+		for (const FName Dependency : Dependencies)
+		{
+			bool bIsAlreadyVisited = false;
+			Visited.Add(Dependency, &bIsAlreadyVisited);
+			if (!bIsAlreadyVisited)
+			{
+				Stack.Add(Dependency);
+			}
+		}
+	}
+
+	return Size;
+}
+
+FHardReferenceFootprint::FSize FHardReferenceFootprint::GetClosureSize(FName PackageName)
+{
+	if (const FSize* const ExistingSize = ClosureSizes.Find(PackageName))
+	{
+		return *ExistingSize;
+	}
+
+	const FSize Size = GetClosureSize(MakeArrayView(&PackageName, 1));
+	ClosureSizes.Add(PackageName, Size);
+	return Size;
+}
+
+void FHardReferenceFootprint::GetHardReferencedPackages(FName PackageName, bool bIncludeEngineContent, TArray<FName>& OutPackages)
+{
+	const IAssetRegistry& AssetRegistry = IAssetRegistry::GetChecked();
+
+	TArray<FName> ReferencedPackages;
+	TSet<FName> Visited;
+	Visited.Add(PackageName);
+
+	TArray<FName> Queue;
+	Queue.Add(PackageName);
+	for (int32 QueueIndex = 0; QueueIndex < Queue.Num(); ++QueueIndex)
+	{
+		TArray<FName> Dependencies;
+		AssetRegistry.GetDependencies(Queue[QueueIndex], Dependencies, UE::AssetRegistry::EDependencyCategory::Package, UE::AssetRegistry::EDependencyQuery::Hard);
+
+		for (const FName Dependency : Dependencies)
+		{
+			bool bIsAlreadyVisited = false;
+			Visited.Add(Dependency, &bIsAlreadyVisited);
+			if (!bIsAlreadyVisited && IsCountedFootprintPackage(Dependency, bIncludeEngineContent))
+			{
+				ReferencedPackages.Add(Dependency);
+				Queue.Add(Dependency);
+			}
+		}
+	}
+
+	ReferencedPackages.Sort(FNameLexicalLess());
+	OutPackages.Append(ReferencedPackages);
+}
+
+const FHardReferenceFootprint::FPackageInfo& FHardReferenceFootprint::GetPackageInfo(FName PackageName)
+{
+	if (const FPackageInfo* const ExistingInfo = Packages.Find(PackageName))
+	{
+		return *ExistingInfo;
+	}
+
+	const IAssetRegistry& AssetRegistry = IAssetRegistry::GetChecked();
+	FPackageInfo Info;
+
+	TArray<FName> Dependencies;
+	AssetRegistry.GetDependencies(PackageName, Dependencies, UE::AssetRegistry::EDependencyCategory::Package, UE::AssetRegistry::EDependencyQuery::Hard);
+	for (const FName Dependency : Dependencies)
+	{
+		if (Dependency != PackageName && IsCounted(Dependency))
+		{
+			Info.Dependencies.Add(Dependency);
+		}
+	}
+
+	if (const TOptional<FAssetPackageData> PackageData = AssetRegistry.GetAssetPackageDataCopy(PackageName))
+	{
+		Info.DiskSize = FMath::Max<int64>(PackageData->DiskSize, 0);
+	}
+
+	TArray<FAssetData> Assets;
+	AssetRegistry.GetAssetsByPackageName(PackageName, Assets);
+	const FAssetData* const MainAsset = Assets.IsEmpty() ? nullptr : &Assets[0];
+
+	TOptional<int64> EstimatedSize = MainAsset ? EstimateTextureMemory(*MainAsset) : TOptional<int64>();
+	if (!EstimatedSize.IsSet())
+	{
+		const float* const Factor = MainAsset ? ClassSizeFactors.Find(MainAsset->AssetClassPath.GetAssetName()) : nullptr;
+		EstimatedSize = static_cast<int64>(Info.DiskSize * (Factor ? *Factor : 1.0f));
+	}
+	Info.EstimatedSize = EstimatedSize.GetValue();
+
+	return Packages.Add(PackageName, MoveTemp(Info));
+}
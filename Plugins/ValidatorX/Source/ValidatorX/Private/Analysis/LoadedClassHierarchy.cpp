@@ -0,0 +1,130 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "Analysis/LoadedClassHierarchy.h"
+#include "EdGraph/EdGraph.h"
+#include "EdGraphSchema_K2.h"
+#include "Engine/Blueprint.h"
+#include "Engine/BlueprintGeneratedClass.h"
+#include "K2Node_Event.h"
+#include "UObject/UObjectIterator.h"
+
+TConstArrayView<UClass*> FLoadedClassHierarchy::GetDerivedClasses(const UClass* ParentClass)
+{
+	if (!ParentClass)
+	{
+		return TConstArrayView<UClass*>();
+	}
+
+	if (const TArray<UClass*>* const CachedClasses = DerivedClasses.Find(ParentClass))
+	{
+		return *CachedClasses;
+	}
+
+	Build();
+
+	// Blueprints may derive from native subclasses of a native parent
+	TArray<const UClass*> Roots;
+	Roots.Add(ParentClass);
+	if (ParentClass->HasAnyClassFlags(CLASS_Native))
+	{
+		for (const TPair<const UClass*, TArray<UClass*>>& Pair : DirectChildren)
+		{
+			if (Pair.Key != ParentClass && Pair.Key->HasAnyClassFlags(CLASS_Native) && Pair.Key->IsChildOf(ParentClass))
+			{
+				Roots.Add(Pair.Key);
+			}
+		}
+	}
+
+	TArray<UClass*>& Result = DerivedClasses.Add(ParentClass);
+	for (const UClass* const Root : Roots)
+	{
+		if (const TArray<UClass*>* const Children = DirectChildren.Find(Root))
+		{
+			Result.Append(*Children);
+		}
+	}
+
+	// Breadth first, so parents come before their children
+	for (int32 Index = 0; Index < Result.Num(); ++Index)
+	{
+		if (const TArray<UClass*>* const Children = DirectChildren.Find(Result[Index]))
+		{
+			Result.Append(*Children);
+		}
+	}
+
+	return Result;
+}
+
+bool FLoadedClassHierarchy::IsEventImplementedByDerivedClass(const UClass* ParentClass, FName EventName)
+{
+	if (const TSet<FName>* const CachedEvents = DerivedImplementedEvents.Find(ParentClass))
+	{
+		return CachedEvents->Contains(EventName);
+	}
+
+	TSet<FName> ImplementedEvents;
+	for (const UClass* const DerivedClass : GetDerivedClasses(ParentClass))
+	{
+		const UBlueprint* const DerivedBP = Cast<UBlueprint>(DerivedClass->ClassGeneratedBy);
+		if (!DerivedBP)
+		{
+			continue;
+		}
+
+		for (const UEdGraph* const Graph : DerivedBP->UbergraphPages)
+		{
+			if (!Graph)
+			{
+				continue;
+			}
+
+			for (const UEdGraphNode* const Node : Graph->Nodes)
+			{
+				const UK2Node_Event* const ChildEvent = Cast<UK2Node_Event>(Node);
+				if (!ChildEvent)
+				{
+					continue;
+				}
+
+				const UEdGraphPin* const ChildThen = ChildEvent->FindPin(UEdGraphSchema_K2::PN_Then);
+				if (ChildThen && !ChildThen->LinkedTo.IsEmpty())
+				{
+					ImplementedEvents.Add(ChildEvent->GetFunctionName());
+				}
+			}
+		}
+	}
+
+	return DerivedImplementedEvents.Add(ParentClass, MoveTemp(ImplementedEvents)).Contains(EventName);
+}
+
+void FLoadedClassHierarchy::Reset()
+{
+	bIsBuilt = false;
+	DirectChildren.Reset();
+	DerivedClasses.Reset();
+	DerivedImplementedEvents.Reset();
+}
+
+void FLoadedClassHierarchy::Build()
+{
+	if (bIsBuilt)
+	{
+		return;
+	}
+	bIsBuilt = true;
+
+	for (TObjectIterator<UBlueprintGeneratedClass> It; It; ++It)
+	{
+		UBlueprintGeneratedClass* const Candidate = *It;
+		if (Candidate && !Candidate->HasAnyClassFlags(CLASS_NewerVersionExists))
+		{
+			if (const UClass* const SuperClass = Candidate->GetSuperClass())
+			{
+				DirectChildren.FindOrAdd(SuperClass).Add(Candidate);
+			}
+		}
+	}
+}
@@ -0,0 +1,164 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "Analysis/LoopBodyIndex.h"
+#include "Analysis/BlueprintSnapshot.h"
+#include "Algo/Sort.h"
+#include "EdGraphSchema_K2.h"
+
+namespace
+{
+	/** Package of the engine macro library the loop macros are declared in. */
+	const FName StandardMacrosPackage(TEXT("/Engine/EditorBlueprintResources/StandardMacros"));
+
+	/** Name of the execution output of the loop macros run once per iteration. */
+	const FName LoopBodyPinName(TEXT("LoopBody"));
+
+	/** Macro graph names of the StandardMacros loops. */
+	const FName LoopMacroNames[] = {
+		TEXT("ForEachLoop"),
+		TEXT("ForEachLoopWithBreak"),
+		TEXT("ReverseForEachLoop"),
+		TEXT("ForLoop"),
+		TEXT("ForLoopWithBreak"),
+		TEXT("WhileLoop"),
+	};
+} // namespace
+
+FLoopBodyIndex::FLoopBodyIndex(const FBlueprintSnapshot& Snapshot)
+{
+	for (const FName MacroName : LoopMacroNames)
+	{
+		for (const int32 NodeIndex : Snapshot.FindMacroInstances(MacroName))
+		{
+			if (IsLoopNode(Snapshot.Nodes[NodeIndex]))
+			{
+				LoopNodes.Add(NodeIndex);
+			}
+		}
+	}
+
+	BodyStarts.Add(0);
+	if (LoopNodes.IsEmpty())
+	{
+		return;
+	}
+
+	Algo::Sort(LoopNodes);
+
+	// Stamped with the loop being walked, so the visit marks never need to be cleared
+	TArray<int32> VisitStamps;
+	VisitStamps.Init(INDEX_NONE, Snapshot.Nodes.Num());
+
+	for (int32 LoopIndex = 0; LoopIndex < LoopNodes.Num(); ++LoopIndex)
+	{
+		CollectBody(Snapshot, LoopIndex, VisitStamps);
+	}
+
+	LoopDepths.Init(0, Snapshot.Nodes.Num());
+	InnermostLoops.Init(INDEX_NONE, Snapshot.Nodes.Num());
+	ComputeNesting();
+}
+
+bool FLoopBodyIndex::IsLoopNode(const FBlueprintSnapshotNode& Node)
+{
+	if (Node.Kind != EValidatorXNodeKind::MacroInstance || Node.MemberPackage != StandardMacrosPackage)
+	{
+		return false;
+	}
+
+	for (const FName MacroName : LoopMacroNames)
+	{
+		if (Node.MemberName == MacroName)
+		{
+			return true;
+		}
+	}
+	return false;
+}
+
+void FLoopBodyIndex::CollectBody(const FBlueprintSnapshot& Snapshot, int32 LoopIndex, TArray<int32>& VisitStamps)
+{
+	const int32 LoopNode = LoopNodes[LoopIndex];
+	const int32 BodyStart = BodyNodes.Num();
+	TArray<int32> Stack;
+
+	auto Visit = [&VisitStamps, &Stack, LoopIndex, LoopNode](int32 NodeIndex)
+	{
+		if (NodeIndex != LoopNode && VisitStamps[NodeIndex] != LoopIndex)
+		{
+			VisitStamps[NodeIndex] = LoopIndex;
+			Stack.Add(NodeIndex);
+		}
+	};
+
+	// Pushes the nodes following the execution outputs and the pure nodes feeding the data inputs of a node
+	auto VisitSuccessors = [&Snapshot, &Visit](int32 NodeIndex, bool bFollowExec)
+	{
+		const FBlueprintSnapshotNode& Node = Snapshot.Nodes[NodeIndex];
+		for (int32 PinIndex = Node.FirstPin; PinIndex < Node.FirstPin + Node.NumPins; ++PinIndex)
+		{
+			const FBlueprintSnapshotPin& Pin = Snapshot.Pins[PinIndex];
+			const bool bIsExec = Pin.Category == UEdGraphSchema_K2::PC_Exec;
+			if (bIsExec ? (!bFollowExec || Pin.Direction != EGPD_Output) : Pin.Direction != EGPD_Input)
+			{
+				continue;
+			}
+
+			for (const FBlueprintSnapshotLink& Link : Snapshot.GetLinks(PinIndex))
+			{
+				const int32 LinkedNode = Snapshot.Pins[Link.ToPin].Node;
+				if (bIsExec || Snapshot.Nodes[LinkedNode].bIsPure)
+				{
+					Visit(LinkedNode);
+				}
+			}
+		}
+	};
+
+	// Macro inputs are read again by every iteration, so the pure nodes feeding them are part of the body
+	VisitSuccessors(LoopNode, false);
+
+	const int32 LoopBodyPin = Snapshot.FindPinIndex(LoopNode, LoopBodyPinName);
+	if (LoopBodyPin != INDEX_NONE)
+	{
+		for (const FBlueprintSnapshotLink& Link : Snapshot.GetLinks(LoopBodyPin))
+		{
+			Visit(Snapshot.Pins[Link.ToPin].Node);
+		}
+	}
+
+	while (!Stack.IsEmpty())
+	{
+		const int32 NodeIndex = Stack.Pop(EAllowShrinking::No);
+		BodyNodes.Add(NodeIndex);
+		VisitSuccessors(NodeIndex, true);
+	}
+
+	Algo::Sort(MakeArrayView(BodyNodes.GetData() + BodyStart, BodyNodes.Num() - BodyStart));
+	BodyStarts.Add(BodyNodes.Num());
+}
+
+void FLoopBodyIndex::ComputeNesting()
+{
+	for (int32 LoopIndex = 0; LoopIndex < LoopNodes.Num(); ++LoopIndex)
+	{
+		for (const int32 NodeIndex : GetBody(LoopIndex))
+		{
+			++LoopDepths[NodeIndex];
+		}
+	}
+
+	// Loops holding the same node are nested in each other, so the innermost one is the deepest
+	for (int32 LoopIndex = 0; LoopIndex < LoopNodes.Num(); ++LoopIndex)
+	{
+		const int32 LoopDepth = LoopDepths[LoopNodes[LoopIndex]];
+		for (const int32 NodeIndex : GetBody(LoopIndex))
+		{
+			int32& InnermostLoop = InnermostLoops[NodeIndex];
+			if (InnermostLoop == INDEX_NONE || LoopDepths[LoopNodes[InnermostLoop]] < LoopDepth)
+			{
+				InnermostLoop = LoopIndex;
+			}
+		}
+	}
+}
@@ -0,0 +1,278 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "Analysis/VariableLiveness.h"
+#include "Analysis/BlueprintSnapshot.h"
+#include "Algo/Sort.h"
+#include "EdGraphSchema_K2.h"
+
+namespace
+{
+	/** @return The number of execution output pins of a node, zero for pure nodes. */
+	int32 GetNumLivenessExecOutputs(const FBlueprintSnapshot& Snapshot, int32 NodeIndex, bool& bOutHasExecPins)
+	{
+		int32 NumExecOutputs = 0;
+		bOutHasExecPins = false;
+		for (const FBlueprintSnapshotPin& Pin : Snapshot.GetPins(NodeIndex))
+		{
+			if (Pin.Category == UEdGraphSchema_K2::PC_Exec)
+			{
+				bOutHasExecPins = true;
+				NumExecOutputs += Pin.Direction == EGPD_Output ? 1 : 0;
+			}
+		}
+		return NumExecOutputs;
+	}
+} // namespace
+
+FVariableLiveness::FVariableLiveness(const FBlueprintSnapshot& Snapshot, int32 GraphIndex)
+{
+	const FBlueprintSnapshotGraph& Graph = Snapshot.Graphs[GraphIndex];
+
+	// Each local of the function is one bit of the liveness sets
+	TArray<int32> Locals;
+	for (int32 VariableIndex = 0; VariableIndex < Snapshot.Variables.Num(); ++VariableIndex)
+	{
+		if (Snapshot.Variables[VariableIndex].Graph == GraphIndex)
+		{
+			Locals.Add(VariableIndex);
+		}
+	}
+
+	if (Locals.IsEmpty() || Graph.EntryNode == INDEX_NONE)
+	{
+		return;
+	}
+
+	// Steps are the nodes with execution pins, in node order; graph nodes are addressed relative to the first one
+	TArray<int32> StepOfNode;
+	StepOfNode.Init(INDEX_NONE, Graph.NumNodes);
+	TArray<int32> StepNodes;
+	TBitArray<> ResumingSteps;
+
+	for (int32 NodeIndex = Graph.FirstNode; NodeIndex < Graph.FirstNode + Graph.NumNodes; ++NodeIndex)
+	{
+		bool bHasExecPins = false;
+		const int32 NumExecOutputs = GetNumLivenessExecOutputs(Snapshot, NodeIndex, bHasExecPins);
+		if (!bHasExecPins)
+		{
+			continue;
+		}
+
+		const EValidatorXNodeKind Kind = Snapshot.Nodes[NodeIndex].Kind;
+		StepOfNode[NodeIndex - Graph.FirstNode] = StepNodes.Add(NodeIndex);
+		ResumingSteps.Add(Kind == EValidatorXNodeKind::MacroInstance
+			|| (Kind == EValidatorXNodeKind::Tunnel && NumExecOutputs > 0)
+			|| (Kind != EValidatorXNodeKind::Branch && NumExecOutputs > 1));
+	}
+
+	const int32 NumSteps = StepNodes.Num();
+	const int32 NumLocals = Locals.Num();
+	auto GetStep = [&Graph, &StepOfNode](int32 NodeIndex)
+	{
+		return StepOfNode[NodeIndex - Graph.FirstNode];
+	};
+
+	TArray<TArray<int32>> Successors;
+	Successors.SetNum(NumSteps);
+	for (int32 Step = 0; Step < NumSteps; ++Step)
+	{
+		const FBlueprintSnapshotNode& Node = Snapshot.Nodes[StepNodes[Step]];
+		for (int32 PinIndex = Node.FirstPin; PinIndex < Node.FirstPin + Node.NumPins; ++PinIndex)
+		{
+			const FBlueprintSnapshotPin& Pin = Snapshot.Pins[PinIndex];
+			if (Pin.Category != UEdGraphSchema_K2::PC_Exec || Pin.Direction != EGPD_Output)
+			{
+				continue;
+			}
+
+			for (const FBlueprintSnapshotLink& Link : Snapshot.GetLinks(PinIndex))
+			{
+				const int32 LinkedStep = GetStep(Snapshot.Pins[Link.ToPin].Node);
+				if (LinkedStep != INDEX_NONE)
+				{
+					Successors[Step].AddUnique(LinkedStep);
+				}
+			}
+		}
+	}
+
+	// Chain ends below a resuming step continue with that step; returns leave the function instead
+	TArray<TPair<int32, int32>> ResumeEdges;
+	{
+		TBitArray<> Visited(false, NumSteps);
+		TArray<int32> Stack;
+		for (int32 ResumingStep = 0; ResumingStep < NumSteps; ++ResumingStep)
+		{
+			if (!ResumingSteps[ResumingStep])
+			{
+				continue;
+			}
+
+			Visited.Init(false, NumSteps);
+			Stack.Append(Successors[ResumingStep]);
+			while (!Stack.IsEmpty())
+			{
+				const int32 Step = Stack.Pop(EAllowShrinking::No);
+				if (Visited[Step])
+				{
+					continue;
+				}
+				Visited[Step] = true;
+
+				if (Successors[Step].IsEmpty() && Snapshot.Nodes[StepNodes[Step]].Kind != EValidatorXNodeKind::FunctionResult)
+				{
+					ResumeEdges.Emplace(Step, ResumingStep);
+				}
+				Stack.Append(Successors[Step]);
+			}
+		}
+	}
+
+	for (const TPair<int32, int32>& ResumeEdge : ResumeEdges)
+	{
+		Successors[ResumeEdge.Key].AddUnique(ResumeEdge.Value);
+	}
+
+	// Def/use sets of every step
+	TArray<TBitArray<>> Uses;
+	TArray<TBitArray<>> Defs;
+	Uses.Init(TBitArray<>(false, NumLocals), NumSteps);
+	Defs.Init(TBitArray<>(false, NumLocals), NumSteps);
+	{
+		TBitArray<> Visited(false, Graph.NumNodes);
+		TArray<int32> VisitedNodes;
+		TArray<int32> Stack;
+
+		for (int32 LocalBit = 0; LocalBit < NumLocals; ++LocalBit)
+		{
+			// A pure Get is evaluated by every step its value flows into, through other pure nodes. The
+			// value output of a Set node reads the local the same way, after the Set step defined it.
+			Stack.Append(Snapshot.FindVariableReads(Locals[LocalBit]));
+			for (const int32 WriteNode : Snapshot.FindVariableWrites(Locals[LocalBit]))
+			{
+				const FBlueprintSnapshotNode& Set = Snapshot.Nodes[WriteNode];
+				for (int32 PinIndex = Set.FirstPin; PinIndex < Set.FirstPin + Set.NumPins; ++PinIndex)
+				{
+					const FBlueprintSnapshotPin& Pin = Snapshot.Pins[PinIndex];
+					if (Pin.Direction == EGPD_Output && Pin.Category != UEdGraphSchema_K2::PC_Exec)
+					{
+						for (const FBlueprintSnapshotLink& Link : Snapshot.GetLinks(PinIndex))
+						{
+							Stack.Add(Snapshot.Pins[Link.ToPin].Node);
+						}
+					}
+				}
+			}
+
+			while (!Stack.IsEmpty())
+			{
+				const int32 NodeIndex = Stack.Pop(EAllowShrinking::No);
+				if (Visited[NodeIndex - Graph.FirstNode])
+				{
+					continue;
+				}
+				Visited[NodeIndex - Graph.FirstNode] = true;
+				VisitedNodes.Add(NodeIndex);
+
+				const int32 Step = GetStep(NodeIndex);
+				if (Step != INDEX_NONE)
+				{
+					Uses[Step][LocalBit] = true;
+					continue;
+				}
+
+				const FBlueprintSnapshotNode& Node = Snapshot.Nodes[NodeIndex];
+				for (int32 PinIndex = Node.FirstPin; PinIndex < Node.FirstPin + Node.NumPins; ++PinIndex)
+				{
+					if (Snapshot.Pins[PinIndex].Direction == EGPD_Output)
+					{
+						for (const FBlueprintSnapshotLink& Link : Snapshot.GetLinks(PinIndex))
+						{
+							Stack.Add(Snapshot.Pins[Link.ToPin].Node);
+						}
+					}
+				}
+			}
+
+			for (const int32 VisitedNode : VisitedNodes)
+			{
+				Visited[VisitedNode - Graph.FirstNode] = false;
+			}
+			VisitedNodes.Reset();
+
+			for (const int32 WriteNode : Snapshot.FindVariableWrites(Locals[LocalBit]))
+			{
+				const int32 Step = GetStep(WriteNode);
+				if (Step != INDEX_NONE)
+				{
+					Defs[Step][LocalBit] = true;
+				}
+			}
+		}
+	}
+
+	// LiveIn = Uses | (LiveOut & ~Defs), LiveOut = union of the successors' LiveIn, iterated to a fixed point
+	TArray<TBitArray<>> LiveIn;
+	TArray<TBitArray<>> LiveOut;
+	LiveIn.Init(TBitArray<>(false, NumLocals), NumSteps);
+	LiveOut.Init(TBitArray<>(false, NumLocals), NumSteps);
+
+	bool bChanged = true;
+	while (bChanged)
+	{
+		bChanged = false;
+		for (int32 Step = NumSteps - 1; Step >= 0; --Step)
+		{
+			for (const int32 Successor : Successors[Step])
+			{
+				LiveOut[Step].CombineWithBitwiseOR(LiveIn[Successor], EBitwiseOperatorFlags::MaintainSize);
+			}
+
+			for (int32 LocalBit = 0; LocalBit < NumLocals; ++LocalBit)
+			{
+				const bool bIsLive = Uses[Step][LocalBit] || (LiveOut[Step][LocalBit] && !Defs[Step][LocalBit]);
+				if (bIsLive && !LiveIn[Step][LocalBit])
+				{
+					LiveIn[Step][LocalBit] = true;
+					bChanged = true;
+				}
+			}
+		}
+	}
+
+	// Stores in code that never runs are left to the unused node check
+	TBitArray<> Reachable(false, NumSteps);
+	{
+		TArray<int32> Stack;
+		Stack.Add(GetStep(Graph.EntryNode));
+		while (!Stack.IsEmpty())
+		{
+			const int32 Step = Stack.Pop(EAllowShrinking::No);
+			if (Step != INDEX_NONE && !Reachable[Step])
+			{
+				Reachable[Step] = true;
+				Stack.Append(Successors[Step]);
+			}
+		}
+	}
+
+	for (int32 LocalBit = 0; LocalBit < NumLocals; ++LocalBit)
+	{
+		for (const int32 WriteNode : Snapshot.FindVariableWrites(Locals[LocalBit]))
+		{
+			const int32 Step = GetStep(WriteNode);
+			if (Step != INDEX_NONE && Reachable[Step] && !LiveOut[Step][LocalBit])
+			{
+				DeadStores.Add(WriteNode);
+			}
+		}
+
+		const int32 EntryStep = GetStep(Graph.EntryNode);
+		if (EntryStep != INDEX_NONE && LiveIn[EntryStep][LocalBit])
+		{
+			LocalsReadBeforeAssigned.Add(Locals[LocalBit]);
+		}
+	}
+
+	Algo::Sort(DeadStores);
+}
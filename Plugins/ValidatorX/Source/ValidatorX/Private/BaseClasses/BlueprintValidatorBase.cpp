@@ -2,6 +2,98 @@
 
 
 #include "BaseClasses/BlueprintValidatorBase.h"
+#include "ValidatorXManager.h"
+#include "ValidatorXTypes.h"
+#include "Analysis/BlueprintGraphIndex.h"
+#include "Analysis/BlueprintSnapshot.h"
+#include "Misc/DataValidation.h"
+#include "Subsystems/AssetEditorSubsystem.h"
+#include "BlueprintEditorModule.h"
 
+TSharedRef<const FBlueprintGraphIndex> UBlueprintValidatorBase::GetGraphIndex(UBlueprint* Blueprint) const
+{
+	return FValidatorXManager::Get().GetGraphIndex(Blueprint);
+}
 
+TSharedRef<const FBlueprintSnapshot> UBlueprintValidatorBase::GetSnapshot(UBlueprint* Blueprint) const
+{
+	return FValidatorXManager::Get().GetSnapshot(Blueprint);
+}
 
+EDataValidationResult UBlueprintValidatorBase::ValidateSnapshot(UBlueprint* Blueprint, FDataValidationContext& Context)
+{
+	TArray<FValidatorXIssue> Issues;
+	AnalyzeSnapshot(*GetSnapshot(Blueprint), Issues);
+	return CommitIssues(Blueprint, Issues, Context);
+}
+
+EDataValidationResult UBlueprintValidatorBase::CommitIssues(UBlueprint* Blueprint, TConstArrayView<FValidatorXIssue> Issues, FDataValidationContext& Context, TArray<FValidatorXIssue>* OutCommittedIssues, bool bAddTokens)
+{
+	check(IsInGameThread());
+
+	bIsError = false;
+
+	for (const FValidatorXIssue& Issue : Issues)
+	{
+		if (!ConfirmIssue(Blueprint, Issue))
+		{
+			continue;
+		}
+
+		const TSharedRef<FTokenizedMessage> Message = Context.AddMessage(Issue.Severity, Issue.GetMessage());
+		if (bAddTokens)
+		{
+			AddIssueTokens(Blueprint, Issue, Message);
+		}
+		if (OutCommittedIssues)
+		{
+			OutCommittedIssues->Add(Issue);
+		}
+		bIsError = true;
+	}
+
+	return bIsError ? EDataValidationResult::Invalid : EDataValidationResult::Valid;
+}
+
+UEdGraph* UBlueprintValidatorBase::FindIssueGraph(UBlueprint* Blueprint, const FValidatorXIssue& Issue) const
+{
+	return Issue.GraphName.IsNone() ? nullptr : GetGraphIndex(Blueprint)->FindGraph(Issue.GraphName);
+}
+
+UEdGraphNode* UBlueprintValidatorBase::FindIssueNode(UBlueprint* Blueprint, const FValidatorXIssue& Issue) const
+{
+	return Issue.NodeGuid.IsValid() ? GetGraphIndex(Blueprint)->FindNode(Issue.NodeGuid) : nullptr;
+}
+
+void UBlueprintValidatorBase::AddJumpToNodeToken(UBlueprint* Blueprint, const FValidatorXIssue& Issue, const TSharedRef<FTokenizedMessage>& Message) const
+{
+	UEdGraph* const Graph = FindIssueGraph(Blueprint, Issue);
+	UEdGraphNode* const Node = FindIssueNode(Blueprint, Issue);
+	if (!Graph || !Node)
+	{
+		return;
+	}
+
+	Message->AddToken(FActionToken::Create(
+		FText::Format(INVTEXT("Jump to '{0}'"), Node->GetNodeTitle(ENodeTitleType::ListView)),
+		FText::GetEmpty(),
+		FSimpleDelegate::CreateLambda([=]
+			{
+				if (Blueprint && Graph && Node)
+				{
+					UAssetEditorSubsystem* const AssetEditorSubsystem = GEditor->GetEditorSubsystem<UAssetEditorSubsystem>();
+					AssetEditorSubsystem->OpenEditorForAsset(Blueprint);
+
+					if (IAssetEditorInstance* const EditorInstance = AssetEditorSubsystem->FindEditorForAsset(Blueprint, false))
+					{
+						if (IBlueprintEditor* const BlueprintEditor = StaticCast<IBlueprintEditor*>(EditorInstance))
+						{
+							if (TSharedPtr<SGraphEditor> GraphEditor = BlueprintEditor->OpenGraphAndBringToFront(Graph, true))
+							{
+								GraphEditor->JumpToNode(Node, false);
+							}
+						}
+					}
+				}
+			})));
+}
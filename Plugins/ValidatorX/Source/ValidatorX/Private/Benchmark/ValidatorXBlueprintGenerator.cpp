@@ -0,0 +1,222 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "Benchmark/ValidatorXBlueprintGenerator.h"
+#include "EdGraphNode_Comment.h"
+#include "EdGraphSchema_K2.h"
+#include "Engine/Blueprint.h"
+#include "Engine/BlueprintGeneratedClass.h"
+#include "GameFramework/Actor.h"
+#include "K2Node_CallFunction.h"
+#include "K2Node_FunctionEntry.h"
+#include "K2Node_IfThenElse.h"
+#include "K2Node_VariableGet.h"
+#include "K2Node_VariableSet.h"
+#include "Kismet/KismetSystemLibrary.h"
+#include "Kismet2/BlueprintEditorUtils.h"
+#include "Kismet2/KismetEditorUtilities.h"
+#include "UObject/Package.h"
+
+namespace
+{
+	/** Distance between two nodes of an execution chain, and between two rows of nodes. */
+	constexpr int32 GeneratedNodeSpacingX = 320;
+	constexpr int32 GeneratedNodeSpacingY = 160;
+
+	/** Kinds of nodes appended to a generated function graph. */
+	enum class EGeneratedNodeKind : uint8
+	{
+		CallFunction,
+		PrintString,
+		Branch,
+		VariableSet,
+		UnusedGet,
+		Count
+	};
+
+	/** Creates a node, lets the caller set it up before its pins are allocated, then finalizes it. */
+	template <typename NodeType, typename SetupType>
+	NodeType* PlaceGeneratedNode(UEdGraph& Graph, int32 X, int32 Y, SetupType&& Setup)
+	{
+		FGraphNodeCreator<NodeType> NodeCreator(Graph);
+		NodeType* const Node = NodeCreator.CreateNode(false);
+		Setup(*Node);
+		Node->NodePosX = X;
+		Node->NodePosY = Y;
+		NodeCreator.Finalize();
+		return Node;
+	}
+
+	/** Links the end of an execution chain to a node, which becomes the new end of the chain. */
+	void AppendToExecChain(UEdGraphPin*& ThenPin, UEdGraphNode& Node)
+	{
+		UEdGraphPin* const ExecPin = Node.FindPin(UEdGraphSchema_K2::PN_Execute, EGPD_Input);
+		if (ThenPin && ExecPin)
+		{
+			ThenPin->MakeLinkTo(ExecPin);
+		}
+		ThenPin = Node.FindPin(UEdGraphSchema_K2::PN_Then, EGPD_Output);
+	}
+} // namespace
+
+TArray<UBlueprint*> FValidatorXBlueprintGenerator::Generate(const FValidatorXBlueprintGeneratorSettings& Settings)
+{
+	// Generated names must stay unique when the generator runs several times in one editor session
+	static int32 NumGenerateCalls = 0;
+	const int32 GenerateCall = NumGenerateCalls++;
+
+	FRandomStream Random(Settings.Seed);
+
+	TArray<UBlueprint*> Blueprints;
+	UClass* ParentClass = AActor::StaticClass();
+	for (int32 Level = 0; Level < FMath::Max(Settings.InheritanceDepth, 1); ++Level)
+	{
+		const FString Name = FString::Printf(TEXT("BP_ValidatorXBenchmark_%d_%d"), GenerateCall, Level);
+		UBlueprint* const Blueprint = GenerateBlueprint(ParentClass, Name, Settings, Random);
+		Blueprints.Add(Blueprint);
+		ParentClass = Blueprint->GeneratedClass;
+	}
+
+	return Blueprints;
+}
+
+UBlueprint* FValidatorXBlueprintGenerator::GenerateBlueprint(UClass* ParentClass, const FString& Name, const FValidatorXBlueprintGeneratorSettings& Settings, FRandomStream& Random)
+{
+	UPackage* const Package = CreatePackage(*FString::Printf(TEXT("/Temp/ValidatorXBenchmark/%s"), *Name));
+	Package->SetFlags(RF_Transient);
+
+	UBlueprint* const Blueprint = FKismetEditorUtilities::CreateBlueprint(ParentClass, Package, FName(*Name), BPTYPE_Normal, UBlueprint::StaticClass(), UBlueprintGeneratedClass::StaticClass());
+	const UEdGraphSchema_K2* const Schema = GetDefault<UEdGraphSchema_K2>();
+
+	// Members are prefixed with the Blueprint name, so derived Blueprints do not redeclare them
+	TArray<FName> VariableNames;
+	for (int32 VariableIndex = 0; VariableIndex < Settings.NumVariables; ++VariableIndex)
+	{
+		const FName VariableName(*FString::Printf(TEXT("%s_Var%d"), *Name, VariableIndex));
+		FEdGraphPinType VariableType;
+		VariableType.PinCategory = UEdGraphSchema_K2::PC_Boolean;
+		FBlueprintEditorUtils::AddMemberVariable(Blueprint, VariableName, VariableType);
+		VariableNames.Add(VariableName);
+	}
+
+	for (int32 DispatcherIndex = 0; DispatcherIndex < Settings.NumDispatchers; ++DispatcherIndex)
+	{
+		const FName DispatcherName(*FString::Printf(TEXT("%s_Dispatcher%d"), *Name, DispatcherIndex));
+		FEdGraphPinType DelegateType;
+		DelegateType.PinCategory = UEdGraphSchema_K2::PC_MCDelegate;
+		FBlueprintEditorUtils::AddMemberVariable(Blueprint, DispatcherName, DelegateType);
+
+		// Same setup as "Add Event Dispatcher" in the My Blueprint panel
+		UEdGraph* const SignatureGraph = FBlueprintEditorUtils::CreateNewGraph(Blueprint, DispatcherName, UEdGraph::StaticClass(), UEdGraphSchema_K2::StaticClass());
+		SignatureGraph->bEditable = false;
+		Schema->CreateDefaultNodesForGraph(*SignatureGraph);
+		Schema->CreateFunctionGraphTerminators(*SignatureGraph, static_cast<UClass*>(nullptr));
+		Schema->AddExtraFunctionFlags(SignatureGraph, FUNC_BlueprintCallable | FUNC_BlueprintEvent | FUNC_Public);
+		Schema->MarkFunctionEntryAsEditable(SignatureGraph, true);
+		Blueprint->DelegateSignatureGraphs.Add(SignatureGraph);
+	}
+
+	TArray<UEdGraph*> FunctionGraphs;
+	TArray<FName> FunctionNames;
+	for (int32 FunctionIndex = 0; FunctionIndex < Settings.NumFunctions; ++FunctionIndex)
+	{
+		const FName FunctionName(*FString::Printf(TEXT("%s_Function%d"), *Name, FunctionIndex));
+		UEdGraph* const Graph = FBlueprintEditorUtils::CreateNewGraph(Blueprint, FunctionName, UEdGraph::StaticClass(), UEdGraphSchema_K2::StaticClass());
+		FBlueprintEditorUtils::AddFunctionGraph<UClass>(Blueprint, Graph, true, nullptr);
+		FunctionGraphs.Add(Graph);
+		FunctionNames.Add(FunctionName);
+	}
+
+	// Variable and call nodes resolve their pins against the skeleton class, which needs the members first
+	FKismetEditorUtilities::CompileBlueprint(Blueprint, EBlueprintCompileOptions::SkipGarbageCollection | EBlueprintCompileOptions::SkipSave);
+
+	UFunction* const PrintStringFunction = UKismetSystemLibrary::StaticClass()->FindFunctionByName(GET_FUNCTION_NAME_CHECKED(UKismetSystemLibrary, PrintString));
+
+	for (UEdGraph* const Graph : FunctionGraphs)
+	{
+		TArray<UK2Node_FunctionEntry*> Entries;
+		Graph->GetNodesOfClass(Entries);
+		UEdGraphPin* ThenPin = Entries.IsEmpty() ? nullptr : Entries[0]->FindPin(UEdGraphSchema_K2::PN_Then, EGPD_Output);
+
+		int32 NumPlacedNodes = 0;
+		while (NumPlacedNodes < Settings.NodesPerGraph)
+		{
+			const int32 X = (NumPlacedNodes + 1) * GeneratedNodeSpacingX;
+			const int32 Y = Random.RandRange(0, 3) * GeneratedNodeSpacingY;
+
+			EGeneratedNodeKind Kind = EGeneratedNodeKind(Random.RandHelper(int32(EGeneratedNodeKind::Count)));
+			if (VariableNames.IsEmpty() && Kind != EGeneratedNodeKind::CallFunction)
+			{
+				Kind = EGeneratedNodeKind::PrintString;
+			}
+
+			switch (Kind)
+			{
+				case EGeneratedNodeKind::CallFunction:
+				{
+					const FName Callee = FunctionNames[Random.RandHelper(FunctionNames.Num())];
+					UK2Node_CallFunction* const Call = PlaceGeneratedNode<UK2Node_CallFunction>(*Graph, X, Y, [Callee](UK2Node_CallFunction& Node) { Node.FunctionReference.SetSelfMember(Callee); });
+					AppendToExecChain(ThenPin, *Call);
+					++NumPlacedNodes;
+					break;
+				}
+
+				case EGeneratedNodeKind::PrintString:
+				{
+					UK2Node_CallFunction* const Call = PlaceGeneratedNode<UK2Node_CallFunction>(*Graph, X, Y, [PrintStringFunction](UK2Node_CallFunction& Node) { Node.SetFromFunction(PrintStringFunction); });
+					AppendToExecChain(ThenPin, *Call);
+					++NumPlacedNodes;
+					break;
+				}
+
+				case EGeneratedNodeKind::Branch:
+				{
+					const FName Condition = VariableNames[Random.RandHelper(VariableNames.Num())];
+					UK2Node_IfThenElse* const Branch = PlaceGeneratedNode<UK2Node_IfThenElse>(*Graph, X, Y, [](UK2Node_IfThenElse&) {});
+					UK2Node_VariableGet* const Get = PlaceGeneratedNode<UK2Node_VariableGet>(*Graph, X - GeneratedNodeSpacingX / 2, Y + GeneratedNodeSpacingY / 2, [Condition](UK2Node_VariableGet& Node) { Node.VariableReference.SetSelfMember(Condition); });
+					if (UEdGraphPin* const ValuePin = Get->GetValuePin())
+					{
+						ValuePin->MakeLinkTo(Branch->GetConditionPin());
+					}
+
+					// The chain continues from "Then"; "Else" is left unconnected
+					AppendToExecChain(ThenPin, *Branch);
+					NumPlacedNodes += 2;
+					break;
+				}
+
+				case EGeneratedNodeKind::VariableSet:
+				{
+					const FName Variable = VariableNames[Random.RandHelper(VariableNames.Num())];
+					UK2Node_VariableSet* const Set = PlaceGeneratedNode<UK2Node_VariableSet>(*Graph, X, Y, [Variable](UK2Node_VariableSet& Node) { Node.VariableReference.SetSelfMember(Variable); });
+					AppendToExecChain(ThenPin, *Set);
+					++NumPlacedNodes;
+					break;
+				}
+
+				default:
+				{
+					const FName Variable = VariableNames[Random.RandHelper(VariableNames.Num())];
+					PlaceGeneratedNode<UK2Node_VariableGet>(*Graph, X, Y + GeneratedNodeSpacingY * 4, [Variable](UK2Node_VariableGet& Node) { Node.VariableReference.SetSelfMember(Variable); });
+					++NumPlacedNodes;
+					break;
+				}
+			}
+		}
+
+		for (int32 CommentIndex = 0; CommentIndex < Settings.CommentsPerGraph; ++CommentIndex)
+		{
+			const int32 FirstNode = Random.RandRange(0, FMath::Max(Settings.NodesPerGraph - 1, 0));
+			const int32 NumSpannedNodes = Random.RandRange(1, 8);
+			PlaceGeneratedNode<UEdGraphNode_Comment>(*Graph, (FirstNode + 1) * GeneratedNodeSpacingX - GeneratedNodeSpacingX / 4, -GeneratedNodeSpacingY / 2,
+				[CommentIndex, NumSpannedNodes](UEdGraphNode_Comment& Comment)
+				{
+					Comment.NodeWidth = NumSpannedNodes * GeneratedNodeSpacingX;
+					Comment.NodeHeight = GeneratedNodeSpacingY * 5;
+					Comment.NodeComment = FString::Printf(TEXT("Section %d"), CommentIndex);
+				});
+		}
+	}
+
+	FKismetEditorUtilities::CompileBlueprint(Blueprint, EBlueprintCompileOptions::SkipGarbageCollection | EBlueprintCompileOptions::SkipSave);
+	return Blueprint;
+}
@@ -0,0 +1,371 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "Cache/ValidatorXResultCache.h"
+#include "BaseClasses/BlueprintValidatorBase.h"
+#include "ValidatorXManager.h"
+#include "Analysis/BlueprintHierarchyIndex.h"
+#include "Analysis/HardReferenceFootprint.h"
+#include "AssetRegistry/IAssetRegistry.h"
+#include "Engine/Blueprint.h"
+#include "HAL/FileManager.h"
+#include "Misc/FileHelper.h"
+#include "Misc/PackageName.h"
+#include "Misc/Paths.h"
+#include "Serialization/MemoryReader.h"
+#include "Serialization/MemoryWriter.h"
+#include "UObject/Package.h"
+
+DEFINE_LOG_CATEGORY_STATIC(LogValidatorXResultCache, Log, All);
+
+namespace
+{
+	/** Identifies a ValidatorX result cache file. */
+	constexpr uint32 ResultCacheMagic = 0x52435856; // "VXCR"
+
+	/** Bumped whenever the layout of the cache file changes. */
+	constexpr int32 ResultCacheFormatVersion = 2;
+
+	/** Macro libraries are Blueprints without a generated class, so they are not in the hierarchy index. */
+	bool IsMacroLibraryPackage(const IAssetRegistry& AssetRegistry, FName PackageName)
+	{
+		TArray<FAssetData> Assets;
+		AssetRegistry.GetAssetsByPackageName(PackageName, Assets);
+		return Assets.ContainsByPredicate([](const FAssetData& AssetData)
+		{
+			FString BlueprintType;
+			return AssetData.GetTagValue(FBlueprintTags::BlueprintType, BlueprintType) && BlueprintType == TEXT("BPTYPE_MacroLibrary");
+		});
+	}
+} // namespace
+
+FArchive& operator<<(FArchive& Ar, FValidatorXResultCache::FMessage& Message)
+{
+	return Ar << Message.Severity << Message.Text << Message.bHasIssue << Message.GraphName << Message.NodeGuid << Message.Subject;
+}
+
+FArchive& operator<<(FArchive& Ar, FValidatorXResultCache::FEntry& Entry)
+{
+	uint8 Result = static_cast<uint8>(Entry.Result);
+	Ar << Entry.InputsHash << Result << Entry.Messages;
+	Entry.Result = static_cast<EDataValidationResult>(Result);
+	return Ar;
+}
+
+FString FValidatorXResultCache::GetCacheFilename()
+{
+	return FPaths::ProjectSavedDir() / TEXT("ValidatorX") / TEXT("ResultCache.bin");
+}
+
+bool FValidatorXResultCache::ComputeInputsHash(FName PackageName, const UBlueprintValidatorBase& Validator, FSHAHash& OutHash)
+{
+	TArray<FName> Dependencies;
+	Dependencies.Add(PackageName);
+	GetParentPackages(PackageName, Dependencies);
+	if (Validator.DependsOnDerivedBlueprints())
+	{
+		GetChildPackages(PackageName, Dependencies);
+	}
+	if (Validator.DependsOnReferencedBlueprints())
+	{
+		GetReferencedPackages(PackageName, Dependencies);
+	}
+	if (Validator.DependsOnHardReferencedAssets())
+	{
+		// Engine content only changes with engine upgrades, so it is left out to keep the key cheap
+		FHardReferenceFootprint::GetHardReferencedPackages(PackageName, false, Dependencies);
+	}
+	if (Validator.UsesFunctionReferenceIndex())
+	{
+		FValidatorXManager::Get().GetFunctionReferenceIndex().GetCallerPackages(PackageName, Dependencies);
+	}
+
+	FSHA1 Sha;
+	const int32 CacheVersion = Validator.GetCacheVersion();
+	Sha.Update(reinterpret_cast<const uint8*>(&CacheVersion), sizeof(CacheVersion));
+
+	for (const FName Dependency : Dependencies)
+	{
+		const FString& PackageHash = GetPackageHash(Dependency);
+		if (PackageHash.IsEmpty())
+		{
+			return false;
+		}
+
+		const FString Key = FString::Printf(TEXT("%s=%s;"), *Dependency.ToString(), *PackageHash);
+		Sha.UpdateWithString(*Key, Key.Len());
+	}
+
+	Sha.Final();
+	Sha.GetHash(OutHash.Hash);
+	return true;
+}
+
+const FValidatorXResultCache::FEntry* FValidatorXResultCache::Find(FName PackageName, FName ValidatorName, const FSHAHash& InputsHash)
+{
+	if (const TMap<FName, FEntry>* const PackageEntries = Entries.Find(PackageName))
+	{
+		if (const FEntry* const Entry = PackageEntries->Find(ValidatorName))
+		{
+			if (Entry->InputsHash == InputsHash)
+			{
+				++Stats.Hits;
+				return Entry;
+			}
+		}
+	}
+
+	++Stats.Misses;
+	return nullptr;
+}
+
+void FValidatorXResultCache::Store(FName PackageName, FName ValidatorName, const FSHAHash& InputsHash, EDataValidationResult Result, TConstArrayView<FValidatorXMessage> Messages)
+{
+	FEntry& Entry = Entries.FindOrAdd(PackageName).FindOrAdd(ValidatorName);
+	Entry.InputsHash = InputsHash;
+	Entry.Result = Result;
+	Entry.Messages.Reset(Messages.Num());
+	for (const FValidatorXMessage& Message : Messages)
+	{
+		FMessage& CachedMessage = Entry.Messages.AddDefaulted_GetRef();
+		CachedMessage.Severity = static_cast<uint8>(Message.Message->GetSeverity());
+		if (Message.Issue.IsValid())
+		{
+			// The issue text, without the names of the action tokens
+			CachedMessage.Text = Message.Issue->GetMessage().ToString();
+			CachedMessage.bHasIssue = true;
+			CachedMessage.GraphName = Message.Issue->GraphName;
+			CachedMessage.NodeGuid = Message.Issue->NodeGuid;
+			CachedMessage.Subject = Message.Issue->Subject;
+		}
+		else
+		{
+			CachedMessage.Text = Message.Message->ToText().ToString();
+		}
+	}
+	bIsDirty = true;
+}
+
+void FValidatorXResultCache::ReplayMessages(const FEntry& Entry, const FAssetData& AssetData, FName ValidatorName, TArray<FValidatorXMessage>& OutMessages)
+{
+	for (const FMessage& CachedMessage : Entry.Messages)
+	{
+		const TSharedRef<FTokenizedMessage> Message = FTokenizedMessage::Create(static_cast<EMessageSeverity::Type>(CachedMessage.Severity));
+		Message->AddToken(FAssetNameToken::Create(AssetData.GetObjectPathString(), FText::FromName(AssetData.AssetName)));
+		Message->AddToken(FTextToken::Create(FText::FromString(CachedMessage.Text)));
+		FValidatorXMessage& ReplayedMessage = OutMessages.Add_GetRef(FValidatorXMessage{ValidatorName, Message});
+
+		if (CachedMessage.bHasIssue)
+		{
+			const TSharedRef<FValidatorXIssue> Issue = MakeShared<FValidatorXIssue>(Message->GetSeverity(), INVTEXT("{0}"), FFormatOrderedArguments{FText::FromString(CachedMessage.Text)});
+			Issue->GraphName = CachedMessage.GraphName;
+			Issue->NodeGuid = CachedMessage.NodeGuid;
+			Issue->Subject = CachedMessage.Subject;
+			ReplayedMessage.Issue = Issue;
+		}
+	}
+}
+
+void FValidatorXResultCache::Load()
+{
+	if (bIsLoaded)
+	{
+		return;
+	}
+	bIsLoaded = true;
+
+	ReadCacheFile(GetCacheFilename(), Entries);
+}
+
+bool FValidatorXResultCache::Merge(const FString& Filename)
+{
+	TMap<FName, TMap<FName, FEntry>> MergedEntries;
+	if (!ReadCacheFile(Filename, MergedEntries))
+	{
+		return false;
+	}
+
+	for (TPair<FName, TMap<FName, FEntry>>& PackageEntries : MergedEntries)
+	{
+		Entries.FindOrAdd(PackageEntries.Key).Append(MoveTemp(PackageEntries.Value));
+	}
+	bIsDirty |= !MergedEntries.IsEmpty();
+	return true;
+}
+
+bool FValidatorXResultCache::ReadCacheFile(const FString& Filename, TMap<FName, TMap<FName, FEntry>>& OutEntries)
+{
+	TArray<uint8> Bytes;
+	if (!FFileHelper::LoadFileToArray(Bytes, *Filename, FILEREAD_Silent))
+	{
+		return false;
+	}
+
+	FMemoryReader Reader(Bytes);
+	uint32 Magic = 0;
+	int32 FormatVersion = 0;
+	Reader << Magic << FormatVersion;
+	if (Magic != ResultCacheMagic || FormatVersion != ResultCacheFormatVersion)
+	{
+		UE_LOG(LogValidatorXResultCache, Display, TEXT("Discarding result cache '%s' with an unknown format."), *Filename);
+		return false;
+	}
+
+	Reader << OutEntries;
+	if (Reader.IsError())
+	{
+		UE_LOG(LogValidatorXResultCache, Warning, TEXT("Result cache '%s' is corrupted and will be rebuilt."), *Filename);
+		OutEntries.Reset();
+		return false;
+	}
+	return true;
+}
+
+void FValidatorXResultCache::Save()
+{
+	if (!bIsDirty)
+	{
+		return;
+	}
+
+	TArray<uint8> Bytes;
+	FMemoryWriter Writer(Bytes);
+	uint32 Magic = ResultCacheMagic;
+	int32 FormatVersion = ResultCacheFormatVersion;
+	Writer << Magic << FormatVersion << Entries;
+
+	const FString Filename = SaveFilename.IsEmpty() ? GetCacheFilename() : SaveFilename;
+	if (FFileHelper::SaveArrayToFile(Bytes, *Filename))
+	{
+		bIsDirty = false;
+	}
+	else
+	{
+		UE_LOG(LogValidatorXResultCache, Warning, TEXT("Failed to write result cache '%s'."), *Filename);
+	}
+}
+
+void FValidatorXResultCache::Clear()
+{
+	Entries.Reset();
+	PackageHashes.Reset();
+	bIsLoaded = true;
+	bIsDirty = false;
+	IFileManager::Get().Delete(*GetCacheFilename(), false, false, true);
+}
+
+void FValidatorXResultCache::ResetPackageHashes()
+{
+	PackageHashes.Reset();
+}
+
+const FString& FValidatorXResultCache::GetPackageHash(FName PackageName)
+{
+	if (const FString* const CachedHash = PackageHashes.Find(PackageName))
+	{
+		return *CachedHash;
+	}
+
+	FString& PackageHash = PackageHashes.Add(PackageName);
+
+	// In-memory edits are not reflected by the saved hash
+	if (const UPackage* const Package = FindPackage(nullptr, *PackageName.ToString()))
+	{
+		if (Package->IsDirty())
+		{
+			return PackageHash;
+		}
+	}
+
+	if (const TOptional<FAssetPackageData> PackageData = IAssetRegistry::GetChecked().GetAssetPackageDataCopy(PackageName))
+	{
+		if (!PackageData->GetPackageSavedHash().IsZero())
+		{
+			PackageHash = LexToString(PackageData->GetPackageSavedHash());
+			return PackageHash;
+		}
+	}
+
+	// Fall back to hashing the package file
+	FString Filename;
+	if (FPackageName::TryConvertLongPackageNameToFilename(PackageName.ToString(), Filename, FPackageName::GetAssetPackageExtension()))
+	{
+		const FMD5Hash FileHash = FMD5Hash::HashFile(*Filename);
+		if (FileHash.IsValid())
+		{
+			PackageHash = LexToString(FileHash);
+		}
+	}
+
+	return PackageHash;
+}
+
+void FValidatorXResultCache::GetParentPackages(FName PackageName, TArray<FName>& OutPackages) const
+{
+	const FBlueprintHierarchyIndex& HierarchyIndex = FValidatorXManager::Get().GetHierarchyIndex();
+
+	TArray<FTopLevelAssetPath> ParentClasses;
+	HierarchyIndex.GetParentClasses(HierarchyIndex.FindGeneratedClass(PackageName), ParentClasses);
+	for (const FTopLevelAssetPath& ParentClass : ParentClasses)
+	{
+		OutPackages.AddUnique(ParentClass.GetPackageName());
+	}
+}
+
+void FValidatorXResultCache::GetChildPackages(FName PackageName, TArray<FName>& OutPackages) const
+{
+	const FBlueprintHierarchyIndex& HierarchyIndex = FValidatorXManager::Get().GetHierarchyIndex();
+
+	const FTopLevelAssetPath ClassPath = HierarchyIndex.FindGeneratedClass(PackageName);
+	if (!ClassPath.IsValid())
+	{
+		return;
+	}
+
+	TArray<FTopLevelAssetPath> DerivedClasses;
+	HierarchyIndex.GetDerivedClasses(ClassPath, DerivedClasses);
+
+	TArray<FName> ChildPackages;
+	for (const FTopLevelAssetPath& DerivedClass : DerivedClasses)
+	{
+		if (DerivedClass.GetPackageName() != PackageName)
+		{
+			ChildPackages.AddUnique(DerivedClass.GetPackageName());
+		}
+	}
+
+	ChildPackages.Sort(FNameLexicalLess());
+	OutPackages.Append(ChildPackages);
+}
+
+void FValidatorXResultCache::GetReferencedPackages(FName PackageName, TArray<FName>& OutPackages) const
+{
+	const IAssetRegistry& AssetRegistry = IAssetRegistry::GetChecked();
+	const FBlueprintHierarchyIndex& HierarchyIndex = FValidatorXManager::Get().GetHierarchyIndex();
+
+	TArray<FName> ReferencedPackages;
+	TSet<FName> Visited;
+	Visited.Add(PackageName);
+
+	// Breadth first, only through Blueprints: assets they reference cannot call back into them
+	TArray<FName> Queue;
+	Queue.Add(PackageName);
+	for (int32 QueueIndex = 0; QueueIndex < Queue.Num(); ++QueueIndex)
+	{
+		TArray<FName> Dependencies;
+		AssetRegistry.GetDependencies(Queue[QueueIndex], Dependencies, UE::AssetRegistry::EDependencyCategory::Package, UE::AssetRegistry::EDependencyQuery::Hard);
+
+		for (const FName Dependency : Dependencies)
+		{
+			bool bIsAlreadyVisited = false;
+			Visited.Add(Dependency, &bIsAlreadyVisited);
+			if (!bIsAlreadyVisited && (HierarchyIndex.FindGeneratedClass(Dependency).IsValid() || IsMacroLibraryPackage(AssetRegistry, Dependency)))
+			{
+				ReferencedPackages.Add(Dependency);
+				Queue.Add(Dependency);
+			}
+		}
+	}
+
+	ReferencedPackages.Sort(FNameLexicalLess());
+	OutPackages.Append(ReferencedPackages);
+}
@@ -0,0 +1,300 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "Commandlets/ValidatorXBenchmarkCommandlet.h"
+#include "Analysis/BlueprintGraphIndex.h"
+#include "Analysis/BlueprintSnapshot.h"
+#include "Benchmark/ValidatorXBlueprintGenerator.h"
+#include "BaseClasses/BlueprintValidatorBase.h"
+#include "Dom/JsonObject.h"
+#include "Engine/Blueprint.h"
+#include "HAL/PlatformMemory.h"
+#include "Misc/DataValidation.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "Serialization/JsonReader.h"
+#include "Serialization/JsonSerializer.h"
+#include "UObject/StrongObjectPtr.h"
+#include "UObject/UObjectIterator.h"
+#include "ValidatorXManager.h"
+
+DEFINE_LOG_CATEGORY_STATIC(LogValidatorXBenchmark, Log, All);
+
+namespace
+{
+	/** Exit codes of the benchmark commandlet. */
+	constexpr int32 BenchmarkExitCodeSuccess = 0;
+	constexpr int32 BenchmarkExitCodeRegression = 1;
+	constexpr int32 BenchmarkExitCodeUsage = 2;
+
+	/** Reads an integer command line value, keeping the default if it is missing. */
+	void ParseBenchmarkInt(const TMap<FString, FString>& ParamsMap, const TCHAR* Key, int32& InOutValue, int32 MinValue)
+	{
+		if (const FString* const Value = ParamsMap.Find(Key))
+		{
+			InOutValue = FMath::Max(FCString::Atoi(**Value), MinValue);
+		}
+	}
+} // namespace
+
+UValidatorXBenchmarkCommandlet::UValidatorXBenchmarkCommandlet()
+{
+	IsClient = false;
+	IsEditor = true;
+	IsServer = false;
+	LogToConsole = true;
+}
+
+int32 UValidatorXBenchmarkCommandlet::Main(const FString& Params)
+{
+	TArray<FString> Tokens;
+	TArray<FString> Switches;
+	TMap<FString, FString> ParamsMap;
+	ParseCommandLine(*Params, Tokens, Switches, ParamsMap);
+
+	FValidatorXBlueprintGeneratorSettings Settings;
+	ParseBenchmarkInt(ParamsMap, TEXT("Functions"), Settings.NumFunctions, 0);
+	ParseBenchmarkInt(ParamsMap, TEXT("Nodes"), Settings.NodesPerGraph, 0);
+	ParseBenchmarkInt(ParamsMap, TEXT("Comments"), Settings.CommentsPerGraph, 0);
+	ParseBenchmarkInt(ParamsMap, TEXT("Variables"), Settings.NumVariables, 0);
+	ParseBenchmarkInt(ParamsMap, TEXT("Dispatchers"), Settings.NumDispatchers, 0);
+	ParseBenchmarkInt(ParamsMap, TEXT("Depth"), Settings.InheritanceDepth, 1);
+	ParseBenchmarkInt(ParamsMap, TEXT("Seed"), Settings.Seed, 0);
+
+	int32 Iterations = 10;
+	ParseBenchmarkInt(ParamsMap, TEXT("Iterations"), Iterations, 1);
+
+	const FString* const OutputParam = ParamsMap.Find(TEXT("Output"));
+	const FString* const BaselineParam = ParamsMap.Find(TEXT("Baseline"));
+	const FString* const ThresholdParam = ParamsMap.Find(TEXT("Threshold"));
+	const FString* const MinDeltaParam = ParamsMap.Find(TEXT("MinDeltaMs"));
+	const FString OutputFilename = OutputParam ? *OutputParam : FPaths::ProjectSavedDir() / TEXT("ValidatorX") / TEXT("Benchmark.json");
+	const double Threshold = ThresholdParam ? FCString::Atod(**ThresholdParam) : 0.2;
+	const double MinDeltaMs = MinDeltaParam ? FCString::Atod(**MinDeltaParam) : 0.05;
+
+	// Read the baseline first, so a bad path fails before the benchmark runs
+	TSharedPtr<FJsonObject> Baseline;
+	if (BaselineParam)
+	{
+		FString BaselineString;
+		if (!FFileHelper::LoadFileToString(BaselineString, **BaselineParam) || !FJsonSerializer::Deserialize(TJsonReaderFactory<>::Create(BaselineString), Baseline) || !Baseline.IsValid())
+		{
+			UE_LOG(LogValidatorXBenchmark, Error, TEXT("Failed to read baseline '%s'."), **BaselineParam);
+			return BenchmarkExitCodeUsage;
+		}
+	}
+
+	// Every validator, enabled or not
+	TArray<TStrongObjectPtr<UBlueprintValidatorBase>> Validators;
+	for (TObjectIterator<UClass> It; It; ++It)
+	{
+		if (It->IsChildOf(UBlueprintValidatorBase::StaticClass()) && !It->HasAnyClassFlags(CLASS_Abstract | CLASS_Deprecated | CLASS_NewerVersionExists))
+		{
+			Validators.Emplace(NewObject<UBlueprintValidatorBase>(GetTransientPackage(), *It));
+		}
+	}
+	Validators.Sort([](const TStrongObjectPtr<UBlueprintValidatorBase>& A, const TStrongObjectPtr<UBlueprintValidatorBase>& B) { return A->GetClass()->GetFName().LexicalLess(B->GetClass()->GetFName()); });
+
+	UE_LOG(LogValidatorXBenchmark, Display, TEXT("Generating %d Blueprint(s): %d functions of %d nodes and %d comments, %d variables, %d dispatchers."),
+		Settings.InheritanceDepth, Settings.NumFunctions, Settings.NodesPerGraph, Settings.CommentsPerGraph, Settings.NumVariables, Settings.NumDispatchers);
+
+	TArray<TStrongObjectPtr<UBlueprint>> Blueprints;
+	TArray<FAssetData> AssetDatas;
+	for (UBlueprint* const Blueprint : FValidatorXBlueprintGenerator::Generate(Settings))
+	{
+		Blueprints.Emplace(Blueprint);
+		AssetDatas.Emplace(Blueprint);
+	}
+
+	FValidatorXManager& Manager = FValidatorXManager::Get();
+	Manager.BeginValidationRun();
+
+	TArray<FBenchmarkResult> Results;
+
+	// Shared analysis steps, built by the first validator of a validation run
+	TArray<TSharedRef<const FBlueprintGraphIndex>> GraphIndices;
+	for (const TStrongObjectPtr<UBlueprint>& Blueprint : Blueprints)
+	{
+		GraphIndices.Add(MakeShared<const FBlueprintGraphIndex>(Blueprint.Get()));
+	}
+
+	Results.Add(RunBenchmark(TEXT("FBlueprintGraphIndex"), Iterations, [&Blueprints]()
+	{
+		for (const TStrongObjectPtr<UBlueprint>& Blueprint : Blueprints)
+		{
+			const FBlueprintGraphIndex GraphIndex(Blueprint.Get());
+		}
+	}));
+
+	Results.Add(RunBenchmark(TEXT("FBlueprintSnapshot"), Iterations, [&GraphIndices]()
+	{
+		for (const TSharedRef<const FBlueprintGraphIndex>& GraphIndex : GraphIndices)
+		{
+			FBlueprintSnapshot::Create(*GraphIndex);
+		}
+	}));
+
+	for (const TStrongObjectPtr<UBlueprint>& Blueprint : Blueprints)
+	{
+		Manager.GetSnapshot(Blueprint.Get());
+	}
+
+	for (const TStrongObjectPtr<UBlueprintValidatorBase>& Validator : Validators)
+	{
+		Results.Add(RunBenchmark(Validator->GetClass()->GetName(), Iterations, [&Validator, &Blueprints, &AssetDatas]()
+		{
+			for (int32 Index = 0; Index < Blueprints.Num(); ++Index)
+			{
+				FDataValidationContext Context;
+				if (Validator->CanValidateAsset(AssetDatas[Index], Blueprints[Index].Get(), Context))
+				{
+					Validator->ValidateLoadedAsset(AssetDatas[Index], Blueprints[Index].Get(), Context);
+				}
+			}
+		}));
+	}
+
+	Manager.EndValidationRun();
+
+	for (const FBenchmarkResult& Result : Results)
+	{
+		UE_LOG(LogValidatorXBenchmark, Display, TEXT("%-40s median %9.3f ms, min %9.3f ms, max %9.3f ms, memory %+lld KiB"),
+			*Result.Name, Result.GetMedianMs(), Result.Milliseconds[0], Result.Milliseconds.Last(), Result.UsedPhysicalDelta / 1024);
+	}
+
+	const TSharedRef<FJsonObject> Report = MakeJsonReport(Settings, Iterations, Results);
+
+	FString ReportString;
+	if (!FJsonSerializer::Serialize(Report, TJsonWriterFactory<>::Create(&ReportString)) || !FFileHelper::SaveStringToFile(ReportString, *OutputFilename, FFileHelper::EEncodingOptions::ForceUTF8WithoutBOM))
+	{
+		UE_LOG(LogValidatorXBenchmark, Error, TEXT("Failed to write benchmark report '%s'."), *OutputFilename);
+		return BenchmarkExitCodeUsage;
+	}
+	UE_LOG(LogValidatorXBenchmark, Display, TEXT("Benchmark report written to '%s'."), *OutputFilename);
+
+	if (!Baseline.IsValid())
+	{
+		return BenchmarkExitCodeSuccess;
+	}
+
+	int32 NumRegressions = 0;
+	if (!CompareWithBaseline(*Report, *Baseline, Threshold, MinDeltaMs, NumRegressions))
+	{
+		return BenchmarkExitCodeUsage;
+	}
+
+	UE_LOG(LogValidatorXBenchmark, Display, TEXT("%d regression(s) against '%s'."), NumRegressions, **BaselineParam);
+	return NumRegressions > 0 ? BenchmarkExitCodeRegression : BenchmarkExitCodeSuccess;
+}
+
+UValidatorXBenchmarkCommandlet::FBenchmarkResult UValidatorXBenchmarkCommandlet::RunBenchmark(const FString& Name, int32 Iterations, TFunctionRef<void()> Run)
+{
+	FBenchmarkResult Result;
+	Result.Name = Name;
+
+	// Warm-up run, fills the caches shared by the validators of a validation run
+	Run();
+
+	const int64 UsedPhysicalBefore = int64(FPlatformMemory::GetStats().UsedPhysical);
+	for (int32 Iteration = 0; Iteration < Iterations; ++Iteration)
+	{
+		const uint64 StartCycles = FPlatformTime::Cycles64();
+		Run();
+		Result.Milliseconds.Add(FPlatformTime::ToMilliseconds64(FPlatformTime::Cycles64() - StartCycles));
+	}
+	Result.UsedPhysicalDelta = int64(FPlatformMemory::GetStats().UsedPhysical) - UsedPhysicalBefore;
+
+	Result.Milliseconds.Sort();
+	return Result;
+}
+
+TSharedRef<FJsonObject> UValidatorXBenchmarkCommandlet::MakeJsonReport(const FValidatorXBlueprintGeneratorSettings& Settings, int32 Iterations, TConstArrayView<FBenchmarkResult> Results)
+{
+	const TSharedRef<FJsonObject> Root = MakeShared<FJsonObject>();
+
+	const TSharedRef<FJsonObject> SettingsObject = MakeShared<FJsonObject>();
+	SettingsObject->SetNumberField(TEXT("functions"), Settings.NumFunctions);
+	SettingsObject->SetNumberField(TEXT("nodesPerGraph"), Settings.NodesPerGraph);
+	SettingsObject->SetNumberField(TEXT("commentsPerGraph"), Settings.CommentsPerGraph);
+	SettingsObject->SetNumberField(TEXT("variables"), Settings.NumVariables);
+	SettingsObject->SetNumberField(TEXT("dispatchers"), Settings.NumDispatchers);
+	SettingsObject->SetNumberField(TEXT("inheritanceDepth"), Settings.InheritanceDepth);
+	SettingsObject->SetNumberField(TEXT("seed"), Settings.Seed);
+	Root->SetObjectField(TEXT("settings"), SettingsObject);
+	Root->SetNumberField(TEXT("iterations"), Iterations);
+
+	TArray<TSharedPtr<FJsonValue>> ResultValues;
+	for (const FBenchmarkResult& Result : Results)
+	{
+		const TSharedRef<FJsonObject> ResultObject = MakeShared<FJsonObject>();
+		ResultObject->SetStringField(TEXT("name"), Result.Name);
+		ResultObject->SetNumberField(TEXT("medianMs"), Result.GetMedianMs());
+		ResultObject->SetNumberField(TEXT("minMs"), Result.Milliseconds.IsEmpty() ? 0.0 : Result.Milliseconds[0]);
+		ResultObject->SetNumberField(TEXT("maxMs"), Result.Milliseconds.IsEmpty() ? 0.0 : Result.Milliseconds.Last());
+		ResultObject->SetNumberField(TEXT("usedPhysicalDeltaBytes"), double(Result.UsedPhysicalDelta));
+		ResultValues.Add(MakeShared<FJsonValueObject>(ResultObject));
+	}
+	Root->SetArrayField(TEXT("results"), ResultValues);
+
+	Root->SetNumberField(TEXT("peakUsedPhysicalBytes"), double(FPlatformMemory::GetStats().PeakUsedPhysical));
+	return Root;
+}
+
+bool UValidatorXBenchmarkCommandlet::CompareWithBaseline(const FJsonObject& Report, const FJsonObject& Baseline, double Threshold, double MinDeltaMs, int32& OutNumRegressions)
+{
+	OutNumRegressions = 0;
+
+	// Timings only compare for the same generated Blueprints
+	const TSharedPtr<FJsonObject>* ReportSettings = nullptr;
+	const TSharedPtr<FJsonObject>* BaselineSettings = nullptr;
+	if (!Report.TryGetObjectField(TEXT("settings"), ReportSettings) || !Baseline.TryGetObjectField(TEXT("settings"), BaselineSettings))
+	{
+		UE_LOG(LogValidatorXBenchmark, Error, TEXT("The baseline has no generator settings."));
+		return false;
+	}
+
+	for (const TPair<FString, TSharedPtr<FJsonValue>>& Setting : (*ReportSettings)->Values)
+	{
+		double BaselineValue = 0.0;
+		if (!(*BaselineSettings)->TryGetNumberField(Setting.Key, BaselineValue) || BaselineValue != Setting.Value->AsNumber())
+		{
+			UE_LOG(LogValidatorXBenchmark, Error, TEXT("The baseline was measured with a different '%s' setting; run with the same settings or record a new baseline."), *Setting.Key);
+			return false;
+		}
+	}
+
+	TMap<FString, double> BaselineMedians;
+	const TArray<TSharedPtr<FJsonValue>>* BaselineResults = nullptr;
+	if (Baseline.TryGetArrayField(TEXT("results"), BaselineResults))
+	{
+		for (const TSharedPtr<FJsonValue>& Value : *BaselineResults)
+		{
+			const TSharedPtr<FJsonObject> ResultObject = Value->AsObject();
+			if (ResultObject.IsValid())
+			{
+				BaselineMedians.Add(ResultObject->GetStringField(TEXT("name")), ResultObject->GetNumberField(TEXT("medianMs")));
+			}
+		}
+	}
+
+	for (const TSharedPtr<FJsonValue>& Value : Report.GetArrayField(TEXT("results")))
+	{
+		const TSharedPtr<FJsonObject> ResultObject = Value->AsObject();
+		const FString Name = ResultObject->GetStringField(TEXT("name"));
+		const double MedianMs = ResultObject->GetNumberField(TEXT("medianMs"));
+
+		const double* const BaselineMs = BaselineMedians.Find(Name);
+		if (!BaselineMs)
+		{
+			UE_LOG(LogValidatorXBenchmark, Display, TEXT("%s is not in the baseline."), *Name);
+			continue;
+		}
+
+		if (MedianMs - *BaselineMs > MinDeltaMs && MedianMs > *BaselineMs * (1.0 + Threshold))
+		{
+			UE_LOG(LogValidatorXBenchmark, Error, TEXT("%s regressed: median %.3f ms, baseline %.3f ms (+%.0f%%)."), *Name, MedianMs, *BaselineMs, (MedianMs / FMath::Max(*BaselineMs, UE_DOUBLE_SMALL_NUMBER) - 1.0) * 100.0);
+			++OutNumRegressions;
+		}
+	}
+
+	return true;
+}
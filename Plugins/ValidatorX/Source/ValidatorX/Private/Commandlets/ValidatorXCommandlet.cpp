@@ -0,0 +1,667 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "Commandlets/ValidatorXCommandlet.h"
+#include "ValidatorXManager.h"
+#include "Algo/Count.h"
+#include "AssetRegistry/IAssetRegistry.h"
+#include "BaseClasses/BlueprintValidatorBase.h"
+#include "Dom/JsonObject.h"
+#include "Engine/Blueprint.h"
+#include "HAL/FileManager.h"
+#include "HAL/PlatformProcess.h"
+#include "Logging/TokenizedMessage.h"
+#include "Misc/FileHelper.h"
+#include "Misc/PackageName.h"
+#include "Misc/Paths.h"
+#include "Serialization/JsonSerializer.h"
+#include "UObject/UObjectIterator.h"
+
+DEFINE_LOG_CATEGORY_STATIC(LogValidatorXCommandlet, Log, All);
+
+namespace
+{
+	/** Exit codes of the commandlet. */
+	constexpr int32 ExitCodeSuccess = 0;
+	constexpr int32 ExitCodeIssues = 1;
+	constexpr int32 ExitCodeUsage = 2;
+	constexpr int32 ExitCodeWorkerFailed = 3;
+
+	/** Command line values forwarded from the coordinator to its shard workers. */
+	const TCHAR* const ForwardedShardParams[] = {TEXT("Paths"), TEXT("Class"), TEXT("Validators"), TEXT("BatchSize")};
+
+	const TCHAR* GetSeverityName(EMessageSeverity::Type Severity)
+	{
+		switch (Severity)
+		{
+			case EMessageSeverity::Error:
+				return TEXT("Error");
+			case EMessageSeverity::PerformanceWarning:
+				return TEXT("PerformanceWarning");
+			case EMessageSeverity::Warning:
+				return TEXT("Warning");
+			default:
+				return TEXT("Info");
+		}
+	}
+
+	EMessageSeverity::Type ParseSeverityName(const FString& Name)
+	{
+		if (Name == TEXT("Error"))
+		{
+			return EMessageSeverity::Error;
+		}
+		if (Name == TEXT("PerformanceWarning"))
+		{
+			return EMessageSeverity::PerformanceWarning;
+		}
+		return Name == TEXT("Warning") ? EMessageSeverity::Warning : EMessageSeverity::Info;
+	}
+
+	const TCHAR* GetResultName(EDataValidationResult Result)
+	{
+		switch (Result)
+		{
+			case EDataValidationResult::Valid:
+				return TEXT("Valid");
+			case EDataValidationResult::Invalid:
+				return TEXT("Invalid");
+			default:
+				return TEXT("NotValidated");
+		}
+	}
+
+	EDataValidationResult ParseResultName(const FString& Name)
+	{
+		if (Name == TEXT("Valid"))
+		{
+			return EDataValidationResult::Valid;
+		}
+		return Name == TEXT("Invalid") ? EDataValidationResult::Invalid : EDataValidationResult::NotValidated;
+	}
+
+	/** Parses `-Shard=Index/Count`, with a zero-based index. */
+	bool ParseShard(const FString& Value, int32& OutShardIndex, int32& OutNumShards)
+	{
+		FString IndexText;
+		FString CountText;
+		if (!Value.Split(TEXT("/"), &IndexText, &CountText) || !IndexText.IsNumeric() || !CountText.IsNumeric())
+		{
+			return false;
+		}
+
+		OutShardIndex = FCString::Atoi(*IndexText);
+		OutNumShards = FCString::Atoi(*CountText);
+		return OutNumShards > 0 && OutShardIndex >= 0 && OutShardIndex < OutNumShards;
+	}
+
+	/** Directory of the intermediate files of sharded runs. */
+	FString GetShardDirectory()
+	{
+		return FPaths::ProjectSavedDir() / TEXT("ValidatorX") / TEXT("Shards");
+	}
+
+	FString GetShardFilename(int32 ShardIndex, const TCHAR* Extension)
+	{
+		return GetShardDirectory() / FString::Printf(TEXT("Shard%d.%s"), ShardIndex, Extension);
+	}
+
+	/** Inserts the shard index before the extension of a file name. */
+	FString GetShardVariant(const FString& Filename, int32 ShardIndex)
+	{
+		return FPaths::GetBaseFilename(Filename, false) + FString::Printf(TEXT(".Shard%d"), ShardIndex) + FPaths::GetExtension(Filename, true);
+	}
+
+	/** Splits a `+` or `,` separated command line value. */
+	TArray<FString> SplitCommandletList(const FString& Value)
+	{
+		TArray<FString> Items;
+		const TCHAR* Delimiters[] = {TEXT("+"), TEXT(",")};
+		Value.ParseIntoArray(Items, Delimiters, UE_ARRAY_COUNT(Delimiters), true);
+		return Items;
+	}
+
+	FString EscapeXml(const FString& Text)
+	{
+		return Text.Replace(TEXT("&"), TEXT("&amp;"))
+			.Replace(TEXT("<"), TEXT("&lt;"))
+			.Replace(TEXT(">"), TEXT("&gt;"))
+			.Replace(TEXT("\""), TEXT("&quot;"))
+			.Replace(TEXT("'"), TEXT("&apos;"));
+	}
+} // namespace
+
+UValidatorXCommandlet::UValidatorXCommandlet()
+{
+	IsClient = false;
+	IsEditor = true;
+	IsServer = false;
+	LogToConsole = true;
+}
+
+int32 UValidatorXCommandlet::Main(const FString& Params)
+{
+	TArray<FString> Tokens;
+	TArray<FString> Switches;
+	TMap<FString, FString> ParamsMap;
+	ParseCommandLine(*Params, Tokens, Switches, ParamsMap);
+
+	const FString* const PathsParam = ParamsMap.Find(TEXT("Paths"));
+	const FString* const ClassParam = ParamsMap.Find(TEXT("Class"));
+	const FString* const ValidatorsParam = ParamsMap.Find(TEXT("Validators"));
+	const FString* const BatchSizeParam = ParamsMap.Find(TEXT("BatchSize"));
+	const FString* const ShardParam = ParamsMap.Find(TEXT("Shard"));
+	const FString* const WorkersParam = ParamsMap.Find(TEXT("Workers"));
+
+	int32 ShardIndex = 0;
+	int32 NumShards = 1;
+	if (ShardParam && !ParseShard(*ShardParam, ShardIndex, NumShards))
+	{
+		UE_LOG(LogValidatorXCommandlet, Error, TEXT("Invalid shard '%s', expected Index/Count with 0 <= Index < Count, e.g. -Shard=0/4."), **ShardParam);
+		return ExitCodeUsage;
+	}
+
+	int32 NumWorkers = 0;
+	if (WorkersParam)
+	{
+		NumWorkers = *WorkersParam == TEXT("Auto") ? FPlatformMisc::NumberOfCores() : FCString::Atoi(**WorkersParam);
+		if (NumWorkers < 1 || ShardParam)
+		{
+			UE_LOG(LogValidatorXCommandlet, Error, TEXT("Invalid -Workers='%s', expected a positive count or Auto, without -Shard."), **WorkersParam);
+			return ExitCodeUsage;
+		}
+	}
+
+	// Validators
+	TArray<TStrongObjectPtr<UBlueprintValidatorBase>> ValidatorObjects;
+	if (!CreateValidators(ValidatorsParam ? SplitCommandletList(*ValidatorsParam) : TArray<FString>(), ValidatorObjects))
+	{
+		return ExitCodeUsage;
+	}
+
+	TArray<UBlueprintValidatorBase*> Validators;
+	TArray<FName> ValidatorNames;
+	for (const TStrongObjectPtr<UBlueprintValidatorBase>& Validator : ValidatorObjects)
+	{
+		Validators.Add(Validator.Get());
+		ValidatorNames.Add(Validator->GetClass()->GetFName());
+	}
+
+	if (Validators.IsEmpty())
+	{
+		UE_LOG(LogValidatorXCommandlet, Error, TEXT("No validator is enabled."));
+		return ExitCodeUsage;
+	}
+
+	// Assets
+	FARFilter Filter;
+	Filter.bRecursivePaths = true;
+	Filter.bRecursiveClasses = true;
+	Filter.ClassPaths.Add(ClassParam ? FTopLevelAssetPath(*ClassParam) : UBlueprint::StaticClass()->GetClassPathName());
+	for (const FString& Path : PathsParam ? SplitCommandletList(*PathsParam) : TArray<FString>{TEXT("/Game")})
+	{
+		Filter.PackagePaths.Add(FName(*Path));
+	}
+
+	if (!Filter.ClassPaths[0].IsValid())
+	{
+		UE_LOG(LogValidatorXCommandlet, Error, TEXT("Invalid class path '%s', expected e.g. /Script/Engine.Blueprint."), ClassParam ? **ClassParam : TEXT(""));
+		return ExitCodeUsage;
+	}
+
+	IAssetRegistry& AssetRegistry = IAssetRegistry::GetChecked();
+	AssetRegistry.SearchAllAssets(true);
+
+	TArray<FAssetData> Assets;
+	AssetRegistry.GetAssets(Filter, Assets);
+	Assets.Sort([](const FAssetData& A, const FAssetData& B) { return A.PackageName.LexicalLess(B.PackageName); });
+
+	if (NumShards > 1)
+	{
+		TArray<TArray<FAssetData>> Shards;
+		PartitionAssets(Assets, NumShards, Shards);
+		Assets = MoveTemp(Shards[ShardIndex]);
+		UE_LOG(LogValidatorXCommandlet, Display, TEXT("Shard %d/%d."), ShardIndex, NumShards);
+	}
+
+	FValidatorXManager& Manager = FValidatorXManager::Get();
+
+	// Project-wide function references need every Blueprint indexed, not only the validated ones
+	if (Validators.ContainsByPredicate([](const UBlueprintValidatorBase* Validator) { return Validator->UsesFunctionReferenceIndex(); }))
+	{
+		FFunctionReferenceIndex& ReferenceIndex = Manager.GetFunctionReferenceIndex();
+		if (ReferenceIndex.GetNumPendingPackages() > 0)
+		{
+			UE_LOG(LogValidatorXCommandlet, Display, TEXT("Indexing the function calls of %d Blueprints."), ReferenceIndex.GetNumPendingPackages());
+			ReferenceIndex.IndexPendingPackages(false);
+			CollectGarbage(GARBAGE_COLLECTION_KEEPFLAGS);
+		}
+
+		// Shard workers load the saved index instead of each indexing the whole project again
+		if (NumWorkers > 1)
+		{
+			ReferenceIndex.Save();
+		}
+	}
+
+	if (NumWorkers > 1)
+	{
+		return RunShardWorkers(FMath::Min(NumWorkers, FMath::Max(Assets.Num(), 1)), Assets.Num(), ParamsMap, Switches);
+	}
+
+	UE_LOG(LogValidatorXCommandlet, Display, TEXT("Validating %d assets with %d validators."), Assets.Num(), Validators.Num());
+
+	// Validation, in bounded batches with garbage collection in between
+	FValidatorXBatchOptions Options;
+	Options.ChunkSize = BatchSizeParam ? FMath::Max(FCString::Atoi(**BatchSizeParam), 1) : Options.ChunkSize;
+	Options.bUseResultCache = !Switches.Contains(TEXT("NoResultCache"));
+
+	// Concurrent shards read the shared result cache, the coordinator merges what they add
+	if (ShardParam)
+	{
+		Manager.GetResultCache().SetSaveFilename(GetShardFilename(ShardIndex, TEXT("cache")));
+	}
+
+	const double StartTime = FPlatformTime::Seconds();
+	Manager.GetStats().Reset();
+
+	TArray<FValidatorXAssetReport> Reports;
+	Reports.Reserve(Assets.Num());
+	FValidatorXCacheStats CacheStats;
+
+	for (int32 BatchStart = 0; BatchStart < Assets.Num(); BatchStart += Options.ChunkSize)
+	{
+		const int32 BatchSize = FMath::Min(Options.ChunkSize, Assets.Num() - BatchStart);
+
+		TArray<FValidatorXAssetReport> BatchReports;
+		Manager.ValidateAssets(MakeArrayView(Assets).Slice(BatchStart, BatchSize), Validators, BatchReports, Options);
+		Reports.Append(MoveTemp(BatchReports));
+
+		const FValidatorXCacheStats& BatchStats = Manager.GetResultCache().GetStats();
+		CacheStats.Hits += BatchStats.Hits;
+		CacheStats.Misses += BatchStats.Misses;
+		CacheStats.SkippedLoads += BatchStats.SkippedLoads;
+
+		CollectGarbage(GARBAGE_COLLECTION_KEEPFLAGS);
+
+		UE_LOG(LogValidatorXCommandlet, Display, TEXT("Validated %d/%d assets."), BatchStart + BatchSize, Assets.Num());
+	}
+
+	const double Duration = FPlatformTime::Seconds() - StartTime;
+
+	const int32 ExitCode = ReportResults(Reports, ValidatorNames, Duration, ParamsMap);
+	UE_LOG(LogValidatorXCommandlet, Display, TEXT("Result cache: %d hits, %d misses, %d loads skipped."), CacheStats.Hits, CacheStats.Misses, CacheStats.SkippedLoads);
+	if (ExitCode == ExitCodeUsage)
+	{
+		return ExitCode;
+	}
+
+	if (const FString* const StatsCsvParam = ParamsMap.Find(TEXT("StatsCsv")))
+	{
+		if (!Manager.GetStats().ExportCsv(*StatsCsvParam))
+		{
+			UE_LOG(LogValidatorXCommandlet, Error, TEXT("Failed to write validator stats '%s'."), **StatsCsvParam);
+			return ExitCodeUsage;
+		}
+		UE_LOG(LogValidatorXCommandlet, Display, TEXT("Validator stats written to '%s'."), **StatsCsvParam);
+	}
+
+	return ExitCode;
+}
+
+int32 UValidatorXCommandlet::ReportResults(TConstArrayView<FValidatorXAssetReport> Reports, TConstArrayView<FName> ValidatorNames, double Duration, const TMap<FString, FString>& ParamsMap)
+{
+	// Summary
+	int32 NumInvalidAssets = 0;
+	for (const FValidatorXAssetReport& Report : Reports)
+	{
+		if (Report.Result != EDataValidationResult::Invalid)
+		{
+			continue;
+		}
+
+		++NumInvalidAssets;
+		for (const FValidatorXMessage& Message : Report.Messages)
+		{
+			UE_LOG(LogValidatorXCommandlet, Warning, TEXT("%s: [%s] %s"), *Report.AssetData.PackageName.ToString(), *Message.ValidatorName.ToString(), *Message.Message->ToText().ToString());
+		}
+	}
+
+	UE_LOG(LogValidatorXCommandlet, Display, TEXT("Validated %d assets in %.2f s, %d with issues."), Reports.Num(), Duration, NumInvalidAssets);
+
+	const FString* const JsonParam = ParamsMap.Find(TEXT("Json"));
+	if (JsonParam && !WriteJsonReport(*JsonParam, Reports, ValidatorNames))
+	{
+		return ExitCodeUsage;
+	}
+
+	const FString* const JUnitParam = ParamsMap.Find(TEXT("JUnit"));
+	if (JUnitParam && !WriteJUnitReport(*JUnitParam, Reports, Duration))
+	{
+		return ExitCodeUsage;
+	}
+
+	return NumInvalidAssets > 0 ? ExitCodeIssues : ExitCodeSuccess;
+}
+
+int32 UValidatorXCommandlet::RunShardWorkers(int32 NumWorkers, int32 NumAssets, const TMap<FString, FString>& ParamsMap, const TArray<FString>& Switches)
+{
+	const double StartTime = FPlatformTime::Seconds();
+
+	// Files left by an earlier run must not be merged into this one
+	IFileManager& FileManager = IFileManager::Get();
+	FileManager.DeleteDirectory(*GetShardDirectory(), false, true);
+	FileManager.MakeDirectory(*GetShardDirectory(), true);
+
+	const FString ProjectFile = FPaths::ConvertRelativePathToFull(FPaths::GetProjectFilePath());
+	const FString* const StatsCsvParam = ParamsMap.Find(TEXT("StatsCsv"));
+
+	FString CommonArgs;
+	for (const TCHAR* const Key : ForwardedShardParams)
+	{
+		if (const FString* const Value = ParamsMap.Find(Key))
+		{
+			CommonArgs += FString::Printf(TEXT(" -%s=\"%s\""), Key, **Value);
+		}
+	}
+	if (Switches.Contains(TEXT("NoResultCache")))
+	{
+		CommonArgs += TEXT(" -NoResultCache");
+	}
+	CommonArgs += TEXT(" -nullrhi -unattended -nosplash -nopause");
+
+	UE_LOG(LogValidatorXCommandlet, Display, TEXT("Validating %d assets in %d shard workers."), NumAssets, NumWorkers);
+
+	TArray<FProcHandle> Workers;
+	for (int32 ShardIndex = 0; ShardIndex < NumWorkers; ++ShardIndex)
+	{
+		FString Args = FString::Printf(TEXT("\"%s\" -run=ValidatorX -Shard=%d/%d -Json=\"%s\" -abslog=\"%s\""),
+			*ProjectFile, ShardIndex, NumWorkers, *GetShardFilename(ShardIndex, TEXT("json")), *GetShardFilename(ShardIndex, TEXT("log")));
+		if (StatsCsvParam)
+		{
+			Args += FString::Printf(TEXT(" -StatsCsv=\"%s\""), *GetShardVariant(*StatsCsvParam, ShardIndex));
+		}
+		Args += CommonArgs;
+
+		FProcHandle Worker = FPlatformProcess::CreateProc(FPlatformProcess::ExecutablePath(), *Args, false, true, true, nullptr, 0, nullptr, nullptr);
+		if (!Worker.IsValid())
+		{
+			UE_LOG(LogValidatorXCommandlet, Error, TEXT("Failed to start shard worker %d."), ShardIndex);
+		}
+		Workers.Add(Worker);
+	}
+
+	for (int32 NumRunning = NumWorkers; NumRunning > 0;)
+	{
+		FPlatformProcess::Sleep(1.0f);
+
+		const int32 NumStillRunning = Algo::CountIf(Workers, [](FProcHandle& Worker) { return Worker.IsValid() && FPlatformProcess::IsProcRunning(Worker); });
+		if (NumStillRunning != NumRunning)
+		{
+			NumRunning = NumStillRunning;
+			UE_LOG(LogValidatorXCommandlet, Display, TEXT("%d/%d shard workers finished."), NumWorkers - NumRunning, NumWorkers);
+		}
+	}
+
+	// Merge the shards, in the order a single process would have reported the assets
+	bool bAllWorkersSucceeded = true;
+	TArray<FValidatorXAssetReport> Reports;
+	TArray<FName> ValidatorNames;
+	FValidatorXResultCache& ResultCache = FValidatorXManager::Get().GetResultCache();
+	ResultCache.Load();
+
+	for (int32 ShardIndex = 0; ShardIndex < NumWorkers; ++ShardIndex)
+	{
+		int32 ReturnCode = ExitCodeWorkerFailed;
+		if (Workers[ShardIndex].IsValid())
+		{
+			FPlatformProcess::GetProcReturnCode(Workers[ShardIndex], &ReturnCode);
+			FPlatformProcess::CloseProc(Workers[ShardIndex]);
+		}
+
+		if ((ReturnCode != ExitCodeSuccess && ReturnCode != ExitCodeIssues) || !ReadJsonReport(GetShardFilename(ShardIndex, TEXT("json")), Reports, ValidatorNames))
+		{
+			UE_LOG(LogValidatorXCommandlet, Error, TEXT("Shard worker %d failed with exit code %d, see '%s'."), ShardIndex, ReturnCode, *GetShardFilename(ShardIndex, TEXT("log")));
+			bAllWorkersSucceeded = false;
+		}
+
+		ResultCache.Merge(GetShardFilename(ShardIndex, TEXT("cache")));
+	}
+	ResultCache.Save();
+
+	Reports.StableSort([](const FValidatorXAssetReport& A, const FValidatorXAssetReport& B) { return A.AssetData.PackageName.LexicalLess(B.AssetData.PackageName); });
+
+	const int32 ExitCode = ReportResults(Reports, ValidatorNames, FPlatformTime::Seconds() - StartTime, ParamsMap);
+	return bAllWorkersSucceeded ? ExitCode : ExitCodeWorkerFailed;
+}
+
+void UValidatorXCommandlet::PartitionAssets(TConstArrayView<FAssetData> Assets, int32 NumShards, TArray<TArray<FAssetData>>& OutShards)
+{
+	const IAssetRegistry& AssetRegistry = IAssetRegistry::GetChecked();
+
+	struct FSizedAsset
+	{
+		int64 DiskSize;
+		int32 Index;
+	};
+
+	TArray<FSizedAsset> SizedAssets;
+	SizedAssets.Reserve(Assets.Num());
+	for (int32 Index = 0; Index < Assets.Num(); ++Index)
+	{
+		const TOptional<FAssetPackageData> PackageData = AssetRegistry.GetAssetPackageDataCopy(Assets[Index].PackageName);
+		SizedAssets.Add(FSizedAsset{PackageData.IsSet() ? FMath::Max<int64>(PackageData->DiskSize, 1) : 1, Index});
+	}
+
+	// Largest first, each to the lightest shard so far; ties are broken by input order and shard index
+	SizedAssets.Sort([](const FSizedAsset& A, const FSizedAsset& B)
+	{
+		return A.DiskSize != B.DiskSize ? A.DiskSize > B.DiskSize : A.Index < B.Index;
+	});
+
+	TArray<int64> ShardSizes;
+	ShardSizes.SetNumZeroed(NumShards);
+	TArray<TArray<int32>> ShardIndices;
+	ShardIndices.SetNum(NumShards);
+	for (const FSizedAsset& SizedAsset : SizedAssets)
+	{
+		int32 Lightest = 0;
+		for (int32 ShardIndex = 1; ShardIndex < NumShards; ++ShardIndex)
+		{
+			Lightest = ShardSizes[ShardIndex] < ShardSizes[Lightest] ? ShardIndex : Lightest;
+		}
+		ShardSizes[Lightest] += SizedAsset.DiskSize;
+		ShardIndices[Lightest].Add(SizedAsset.Index);
+	}
+
+	// Each shard keeps the input order
+	OutShards.Reset();
+	OutShards.SetNum(NumShards);
+	for (int32 ShardIndex = 0; ShardIndex < NumShards; ++ShardIndex)
+	{
+		ShardIndices[ShardIndex].Sort();
+		for (const int32 Index : ShardIndices[ShardIndex])
+		{
+			OutShards[ShardIndex].Add(Assets[Index]);
+		}
+	}
+}
+
+bool UValidatorXCommandlet::CreateValidators(const TArray<FString>& ValidatorNames, TArray<TStrongObjectPtr<UBlueprintValidatorBase>>& OutValidators) const
+{
+	TArray<UClass*> ValidatorClasses;
+	for (TObjectIterator<UClass> It; It; ++It)
+	{
+		if (It->IsChildOf(UBlueprintValidatorBase::StaticClass()) && !It->HasAnyClassFlags(CLASS_Abstract | CLASS_Deprecated | CLASS_NewerVersionExists))
+		{
+			ValidatorClasses.Add(*It);
+		}
+	}
+	ValidatorClasses.Sort([](const UClass& A, const UClass& B) { return A.GetFName().LexicalLess(B.GetFName()); });
+
+	for (const FString& ValidatorName : ValidatorNames)
+	{
+		const FString ClassName = ValidatorName.StartsWith(TEXT("U"), ESearchCase::CaseSensitive) ? ValidatorName.RightChop(1) : ValidatorName;
+		UClass* const* const ValidatorClass = ValidatorClasses.FindByPredicate([&ClassName](const UClass* Class) { return Class->GetName() == ClassName; });
+		if (!ValidatorClass)
+		{
+			UE_LOG(LogValidatorXCommandlet, Error, TEXT("Unknown validator '%s'."), *ValidatorName);
+			return false;
+		}
+		OutValidators.Emplace(NewObject<UBlueprintValidatorBase>(GetTransientPackage(), *ValidatorClass));
+	}
+
+	if (ValidatorNames.IsEmpty())
+	{
+		for (UClass* const ValidatorClass : ValidatorClasses)
+		{
+			UBlueprintValidatorBase* const Validator = NewObject<UBlueprintValidatorBase>(GetTransientPackage(), ValidatorClass);
+			if (Validator->IsEnabled())
+			{
+				OutValidators.Emplace(Validator);
+			}
+		}
+	}
+
+	return true;
+}
+
+bool UValidatorXCommandlet::WriteJsonReport(const FString& Filename, TConstArrayView<FValidatorXAssetReport> Reports, TConstArrayView<FName> ValidatorNames)
+{
+	const TSharedRef<FJsonObject> Root = MakeShared<FJsonObject>();
+
+	TArray<TSharedPtr<FJsonValue>> ValidatorValues;
+	for (const FName ValidatorName : ValidatorNames)
+	{
+		ValidatorValues.Add(MakeShared<FJsonValueString>(ValidatorName.ToString()));
+	}
+	Root->SetArrayField(TEXT("validators"), ValidatorValues);
+
+	int32 NumInvalidAssets = 0;
+	TArray<TSharedPtr<FJsonValue>> AssetValues;
+	for (const FValidatorXAssetReport& Report : Reports)
+	{
+		NumInvalidAssets += Report.Result == EDataValidationResult::Invalid ? 1 : 0;
+
+		const TSharedRef<FJsonObject> AssetObject = MakeShared<FJsonObject>();
+		AssetObject->SetStringField(TEXT("path"), Report.AssetData.GetObjectPathString());
+		AssetObject->SetStringField(TEXT("result"), GetResultName(Report.Result));
+
+		TArray<TSharedPtr<FJsonValue>> MessageValues;
+		for (const FValidatorXMessage& Message : Report.Messages)
+		{
+			const TSharedRef<FJsonObject> MessageObject = MakeShared<FJsonObject>();
+			MessageObject->SetStringField(TEXT("validator"), Message.ValidatorName.ToString());
+			MessageObject->SetStringField(TEXT("severity"), GetSeverityName(Message.Message->GetSeverity()));
+			MessageObject->SetStringField(TEXT("message"), Message.Message->ToText().ToString());
+			MessageValues.Add(MakeShared<FJsonValueObject>(MessageObject));
+		}
+		AssetObject->SetArrayField(TEXT("messages"), MessageValues);
+
+		AssetValues.Add(MakeShared<FJsonValueObject>(AssetObject));
+	}
+	Root->SetArrayField(TEXT("assets"), AssetValues);
+
+	const TSharedRef<FJsonObject> Summary = MakeShared<FJsonObject>();
+	Summary->SetNumberField(TEXT("assets"), Reports.Num());
+	Summary->SetNumberField(TEXT("invalid"), NumInvalidAssets);
+	Root->SetObjectField(TEXT("summary"), Summary);
+
+	FString JsonString;
+	const TSharedRef<TJsonWriter<>> Writer = TJsonWriterFactory<>::Create(&JsonString);
+	if (!FJsonSerializer::Serialize(Root, Writer) || !FFileHelper::SaveStringToFile(JsonString, *Filename, FFileHelper::EEncodingOptions::ForceUTF8WithoutBOM))
+	{
+		UE_LOG(LogValidatorXCommandlet, Error, TEXT("Failed to write JSON report '%s'."), *Filename);
+		return false;
+	}
+
+	UE_LOG(LogValidatorXCommandlet, Display, TEXT("JSON report written to '%s'."), *Filename);
+	return true;
+}
+
+bool UValidatorXCommandlet::ReadJsonReport(const FString& Filename, TArray<FValidatorXAssetReport>& OutReports, TArray<FName>& OutValidatorNames)
+{
+	FString JsonString;
+	TSharedPtr<FJsonObject> Root;
+	if (!FFileHelper::LoadFileToString(JsonString, *Filename) || !FJsonSerializer::Deserialize(TJsonReaderFactory<>::Create(JsonString), Root) || !Root.IsValid())
+	{
+		UE_LOG(LogValidatorXCommandlet, Error, TEXT("Failed to read JSON report '%s'."), *Filename);
+		return false;
+	}
+
+	if (OutValidatorNames.IsEmpty())
+	{
+		for (const TSharedPtr<FJsonValue>& ValidatorValue : Root->GetArrayField(TEXT("validators")))
+		{
+			OutValidatorNames.Add(FName(ValidatorValue->AsString()));
+		}
+	}
+
+	for (const TSharedPtr<FJsonValue>& AssetValue : Root->GetArrayField(TEXT("assets")))
+	{
+		const TSharedPtr<FJsonObject>& AssetObject = AssetValue->AsObject();
+
+		// Only the names are reported, so the asset data is rebuilt from the object path
+		const FSoftObjectPath ObjectPath(AssetObject->GetStringField(TEXT("path")));
+		const FName PackageName = ObjectPath.GetLongPackageFName();
+
+		FValidatorXAssetReport& Report = OutReports.AddDefaulted_GetRef();
+		Report.AssetData = FAssetData(PackageName, FName(FPackageName::GetLongPackagePath(PackageName.ToString())), ObjectPath.GetAssetFName(), FTopLevelAssetPath());
+		Report.Result = ParseResultName(AssetObject->GetStringField(TEXT("result")));
+
+		for (const TSharedPtr<FJsonValue>& MessageValue : AssetObject->GetArrayField(TEXT("messages")))
+		{
+			const TSharedPtr<FJsonObject>& MessageObject = MessageValue->AsObject();
+			Report.Messages.Add(FValidatorXMessage{
+				FName(MessageObject->GetStringField(TEXT("validator"))),
+				FTokenizedMessage::Create(ParseSeverityName(MessageObject->GetStringField(TEXT("severity"))), FText::FromString(MessageObject->GetStringField(TEXT("message"))))});
+		}
+	}
+
+	return true;
+}
+
+bool UValidatorXCommandlet::WriteJUnitReport(const FString& Filename, TConstArrayView<FValidatorXAssetReport> Reports, double Duration)
+{
+	int32 NumFailures = 0;
+	FString TestCases;
+	for (const FValidatorXAssetReport& Report : Reports)
+	{
+		TestCases += FString::Printf(TEXT("\t\t<testcase classname=\"%s\" name=\"%s\">\n"),
+			*EscapeXml(Report.AssetData.PackagePath.ToString()),
+			*EscapeXml(Report.AssetData.AssetName.ToString()));
+
+		if (Report.Result == EDataValidationResult::Invalid)
+		{
+			++NumFailures;
+
+			FString Details;
+			for (const FValidatorXMessage& Message : Report.Messages)
+			{
+				Details += FString::Printf(TEXT("%s [%s] %s\n"), GetSeverityName(Message.Message->GetSeverity()), *Message.ValidatorName.ToString(), *Message.Message->ToText().ToString());
+			}
+
+			TestCases += FString::Printf(TEXT("\t\t\t<failure message=\"%d issue(s)\">%s</failure>\n"), Report.Messages.Num(), *EscapeXml(Details));
+		}
+		else if (Report.Result == EDataValidationResult::NotValidated)
+		{
+			TestCases += TEXT("\t\t\t<skipped/>\n");
+		}
+
+		TestCases += TEXT("\t\t</testcase>\n");
+	}
+
+	FString Xml = TEXT("<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n");
+	Xml += FString::Printf(TEXT("<testsuites tests=\"%d\" failures=\"%d\" time=\"%.3f\">\n"), Reports.Num(), NumFailures, Duration);
+	Xml += FString::Printf(TEXT("\t<testsuite name=\"ValidatorX\" tests=\"%d\" failures=\"%d\" time=\"%.3f\">\n"), Reports.Num(), NumFailures, Duration);
+	Xml += TestCases;
+	Xml += TEXT("\t</testsuite>\n</testsuites>\n");
+
+	if (!FFileHelper::SaveStringToFile(Xml, *Filename, FFileHelper::EEncodingOptions::ForceUTF8WithoutBOM))
+	{
+		UE_LOG(LogValidatorXCommandlet, Error, TEXT("Failed to write JUnit report '%s'."), *Filename);
+		return false;
+	}
+
+	UE_LOG(LogValidatorXCommandlet, Display, TEXT("JUnit report written to '%s'."), *Filename);
+	return true;
+}
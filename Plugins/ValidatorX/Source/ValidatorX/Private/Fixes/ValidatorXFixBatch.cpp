@@ -0,0 +1,88 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "Fixes/ValidatorXFixBatch.h"
+#include "ValidatorXManager.h"
+#include "BaseClasses/BlueprintValidatorBase.h"
+#include "Engine/Blueprint.h"
+#include "Kismet2/BlueprintEditorUtils.h"
+#include "Misc/ScopedSlowTask.h"
+#include "ScopedTransaction.h"
+
+DEFINE_LOG_CATEGORY_STATIC(LogValidatorXFixBatch, Log, All);
+
+void FValidatorXFixBatch::AddFix(UBlueprintValidatorBase* Validator, UBlueprint* Blueprint, const FValidatorXIssue& Issue)
+{
+	check(Validator && Blueprint);
+
+	int32* BlueprintIndex = BlueprintIndices.Find(Blueprint);
+	if (!BlueprintIndex)
+	{
+		BlueprintIndex = &BlueprintIndices.Add(Blueprint, Blueprints.Num());
+		Blueprints.Add(FBlueprintFixes{Blueprint});
+	}
+
+	Blueprints[*BlueprintIndex].Fixes.Add(FFix{Validator, Issue});
+	++NumFixes;
+}
+
+FValidatorXFixBatch::FResult FValidatorXFixBatch::Apply()
+{
+	check(IsInGameThread());
+
+	FResult Result;
+	if (Blueprints.IsEmpty())
+	{
+		return Result;
+	}
+
+	FValidatorXManager& Manager = FValidatorXManager::Get();
+	const FScopedTransaction Transaction(FText::Format(INVTEXT("ValidatorX: Fix {0} Issues"), FText::AsNumber(NumFixes)));
+
+	FScopedSlowTask SlowTask(Blueprints.Num(), INVTEXT("Applying ValidatorX fixes..."));
+	SlowTask.MakeDialogDelayed(1.0f);
+
+	for (const FBlueprintFixes& Entry : Blueprints)
+	{
+		SlowTask.EnterProgressFrame();
+
+		UBlueprint* const Blueprint = Entry.Blueprint.Get();
+		if (!Blueprint)
+		{
+			Result.NumSkipped += Entry.Fixes.Num();
+			continue;
+		}
+
+		// Graph indexes cached earlier in the frame may predate edits made since the issues were reported
+		Manager.ResetGraphIndexCache();
+
+		int32 NumApplied = 0;
+		for (const FFix& Fix : Entry.Fixes)
+		{
+			UBlueprintValidatorBase* const Validator = Fix.Validator.Get();
+			if (Validator && Validator->ConfirmIssue(Blueprint, Fix.Issue) && Validator->ApplyIssueFix(Blueprint, Fix.Issue))
+			{
+				++NumApplied;
+			}
+			else
+			{
+				++Result.NumSkipped;
+			}
+		}
+
+		if (NumApplied > 0)
+		{
+			FBlueprintEditorUtils::MarkBlueprintAsStructurallyModified(Blueprint);
+			Result.NumFixed += NumApplied;
+			++Result.NumBlueprints;
+		}
+	}
+
+	Manager.ResetGraphIndexCache();
+
+	UE_LOG(LogValidatorXFixBatch, Display, TEXT("Applied %d fixes to %d Blueprints, %d skipped."), Result.NumFixed, Result.NumBlueprints, Result.NumSkipped);
+
+	Blueprints.Reset();
+	BlueprintIndices.Reset();
+	NumFixes = 0;
+	return Result;
+}
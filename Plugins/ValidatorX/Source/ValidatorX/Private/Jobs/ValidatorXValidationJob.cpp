@@ -0,0 +1,169 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "Jobs/ValidatorXValidationJob.h"
+#include "ValidatorXManager.h"
+#include "BaseClasses/BlueprintValidatorBase.h"
+#include "Editor.h"
+#include "HAL/IConsoleManager.h"
+
+namespace
+{
+	TAutoConsoleVariable<float> CVarValidationJobFrameBudgetMs(
+		TEXT("ValidatorX.ValidationJob.FrameBudgetMs"),
+		8.0f,
+		TEXT("Maximum time per frame spent by background validation jobs. At least one asset is validated per frame."));
+
+	/** Weight of the last slice in the smoothed time per asset. */
+	constexpr double ValidationJobSmoothing = 0.25;
+} // namespace
+
+FValidatorXValidationJob::FValidatorXValidationJob(TArray<FAssetData> InAssets, TConstArrayView<UBlueprintValidatorBase*> InValidators, const FValidatorXBatchOptions& InOptions)
+	: Assets(MoveTemp(InAssets))
+	, Options(InOptions)
+{
+	for (UBlueprintValidatorBase* const Validator : InValidators)
+	{
+		Validators.Add(Validator);
+	}
+	Options.bDeferIssueTokens = true;
+}
+
+FValidatorXValidationJob::~FValidatorXValidationJob()
+{
+	Cancel();
+}
+
+void FValidatorXValidationJob::Start()
+{
+	check(IsInGameThread());
+
+	if (IsRunning() || StartTime > 0.0)
+	{
+		return;
+	}
+
+	StartTime = FPlatformTime::Seconds();
+	if (Assets.IsEmpty())
+	{
+		EndTime = StartTime;
+		return;
+	}
+
+	if (Options.bUseResultCache)
+	{
+		FValidatorXResultCache& ResultCache = FValidatorXManager::Get().GetResultCache();
+		ResultCache.Load();
+		ResultCache.ResetPackageHashes();
+		ResultCache.ResetStats();
+	}
+
+	TickerHandle = FTSTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateRaw(this, &FValidatorXValidationJob::Tick));
+}
+
+void FValidatorXValidationJob::Cancel()
+{
+	if (IsRunning())
+	{
+		bIsCancelled = true;
+		Finish();
+	}
+}
+
+float FValidatorXValidationJob::GetProgress() const
+{
+	return Assets.IsEmpty() ? 1.0f : static_cast<float>(GetNumValidated()) / Assets.Num();
+}
+
+double FValidatorXValidationJob::GetElapsedSeconds() const
+{
+	if (StartTime == 0.0)
+	{
+		return 0.0;
+	}
+	return (EndTime > 0.0 ? EndTime : FPlatformTime::Seconds()) - StartTime;
+}
+
+double FValidatorXValidationJob::GetAssetsPerSecond() const
+{
+	const double ElapsedSeconds = GetElapsedSeconds();
+	return ElapsedSeconds > 0.0 ? GetNumValidated() / ElapsedSeconds : 0.0;
+}
+
+TOptional<double> FValidatorXValidationJob::GetRemainingSeconds() const
+{
+	const double AssetsPerSecond = GetAssetsPerSecond();
+	if (AssetsPerSecond <= 0.0)
+	{
+		return {};
+	}
+	return (Assets.Num() - GetNumValidated()) / AssetsPerSecond;
+}
+
+bool FValidatorXValidationJob::Tick(float DeltaTime)
+{
+	// Loading and validating Blueprints would hitch the game
+	if (GEditor && GEditor->PlayWorld)
+	{
+		return true;
+	}
+
+	TArray<UBlueprintValidatorBase*> ActiveValidators;
+	for (const TWeakObjectPtr<UBlueprintValidatorBase>& Validator : Validators)
+	{
+		if (Validator.IsValid())
+		{
+			ActiveValidators.Add(Validator.Get());
+		}
+	}
+
+	FValidatorXManager& Manager = FValidatorXManager::Get();
+	const double BudgetSeconds = CVarValidationJobFrameBudgetMs.GetValueOnGameThread() / 1000.0;
+	const double TickStartTime = FPlatformTime::Seconds();
+	const int32 MaxSliceSize = FMath::Max(Options.ChunkSize, 1);
+
+	TArray<FValidatorXAssetReport> SliceReports;
+	Manager.BeginValidationRun();
+	do
+	{
+		// Size the slice to the remaining budget, so cached assets go by the chunk and slow ones one by one
+		const double RemainingSeconds = BudgetSeconds - (FPlatformTime::Seconds() - TickStartTime);
+		const int32 SliceSize = SecondsPerAsset > 0.0 ? FMath::Clamp(static_cast<int32>(RemainingSeconds / SecondsPerAsset), 1, MaxSliceSize) : 1;
+		const int32 SliceStart = GetNumValidated();
+		const int32 NumSliceAssets = FMath::Min(SliceSize, Assets.Num() - SliceStart);
+
+		const double SliceStartTime = FPlatformTime::Seconds();
+		SliceReports.Reset();
+		Manager.ValidateAssetChunk(MakeArrayView(Assets).Slice(SliceStart, NumSliceAssets), ActiveValidators, SliceReports, Options);
+
+		const double SliceSecondsPerAsset = (FPlatformTime::Seconds() - SliceStartTime) / NumSliceAssets;
+		SecondsPerAsset = SecondsPerAsset > 0.0 ? FMath::Lerp(SecondsPerAsset, SliceSecondsPerAsset, ValidationJobSmoothing) : SliceSecondsPerAsset;
+
+		// The tokenized messages of the slice are dropped here, only the compact rows are kept
+		for (const FValidatorXAssetReport& Report : SliceReports)
+		{
+			IssueTable.AddReport(Report);
+		}
+	}
+	while (GetNumValidated() < Assets.Num() && FPlatformTime::Seconds() - TickStartTime < BudgetSeconds);
+	Manager.EndValidationRun();
+
+	if (GetNumValidated() < Assets.Num())
+	{
+		return true;
+	}
+
+	Finish();
+	return false;
+}
+
+void FValidatorXValidationJob::Finish()
+{
+	FTSTicker::GetCoreTicker().RemoveTicker(TickerHandle);
+	TickerHandle.Reset();
+	EndTime = FPlatformTime::Seconds();
+
+	if (Options.bUseResultCache)
+	{
+		FValidatorXManager::Get().GetResultCache().Save();
+	}
+}
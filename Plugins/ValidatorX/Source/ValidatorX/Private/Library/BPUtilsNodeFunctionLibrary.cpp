@@ -9,7 +9,11 @@
 #include "K2Node_MacroInstance.h"
 #include "EdGraphNode_Comment.h"
 #include "K2Node_IfThenElse.h"
-#include "AssetRegistry/AssetRegistryModule.h"
+#include "Analysis/BlueprintGraphIndex.h"
+#include "ValidatorXManager.h"
+#include "Misc/PackageName.h"
+#include "UObject/Package.h"
+#include "UObject/UObjectHash.h"
 
 DEFINE_LOG_CATEGORY_STATIC(NodeFunctionLibraryLog, All, All);
 
@@ -21,29 +25,23 @@ void UBPUtilsNodeFunctionLibrary::GetDerivedRegistryBlueprintClasses(const UClas
 		return;
 	}
 
-	FAssetRegistryModule& AssetRegistryModule = FModuleManager::LoadModuleChecked<FAssetRegistryModule>("AssetRegistry");
-
-	TArray<FAssetData> BlueprintAssets;
-	FARFilter		   Filter;
-	Filter.ClassPaths.Add(UBlueprint::StaticClass()->GetClassPathName());
-	Filter.bRecursiveClasses = true;
-
-	AssetRegistryModule.Get().GetAssets(Filter, BlueprintAssets);
+	TArray<FTopLevelAssetPath> DerivedClassPaths;
+	FValidatorXManager::Get().GetHierarchyIndex().GetDerivedClasses(ParentClass->GetClassPathName(), DerivedClassPaths);
 
 	int32 FoundCount = 0;
 
-	for (const FAssetData& Asset : BlueprintAssets)
+	for (const FTopLevelAssetPath& DerivedClassPath : DerivedClassPaths)
 	{
-		UBlueprint* LoadedBP = Cast<UBlueprint>(Asset.GetAsset());
-		if (!LoadedBP || !LoadedBP->GeneratedClass)
+		// Only the derived Blueprints themselves are loaded, if they are not already
+		UClass* DerivedClass = FindObject<UClass>(DerivedClassPath);
+		if (!DerivedClass)
 		{
-			continue;
+			DerivedClass = LoadObject<UClass>(nullptr, *DerivedClassPath.ToString(), nullptr, LOAD_NoWarn);
 		}
 
-		if (LoadedBP->GeneratedClass->IsChildOf(ParentClass) && LoadedBP->GeneratedClass != ParentClass)
+		if (DerivedClass && DerivedClass != ParentClass && DerivedClass->IsChildOf(ParentClass))
 		{
-			OutDerived.Add(LoadedBP->GeneratedClass);
-			UE_LOG(NodeFunctionLibraryLog, Display, TEXT("[DerivedBP] %s"), *LoadedBP->GetName());
+			OutDerived.AddUnique(DerivedClass);
 			++FoundCount;
 		}
 	}
@@ -53,11 +51,11 @@ void UBPUtilsNodeFunctionLibrary::GetDerivedRegistryBlueprintClasses(const UClas
 
 void UBPUtilsNodeFunctionLibrary::GetAllDerivedBlueprintClasses(const UClass* ParentClass, TArray<UClass*>& OutDerived, bool bSearchAssetRegistry)
 {
-	// 1. In-memory first
+	// 1. In-memory first, including Blueprints that have not been saved yet
 	UBPUtilsNodeFunctionLibrary::GetDerivedBlueprintClasses(ParentClass, OutDerived);
 
-	// 2. If none found, fallback to AssetRegistry
-	if (OutDerived.Num() == 0 && bSearchAssetRegistry)
+	// 2. Then every saved child known to the hierarchy index, loading only those
+	if (bSearchAssetRegistry)
 	{
 		UBPUtilsNodeFunctionLibrary::GetDerivedRegistryBlueprintClasses(ParentClass, OutDerived);
 	}
@@ -73,19 +71,14 @@ void UBPUtilsNodeFunctionLibrary::GetDerivedBlueprintClasses(const UClass* Paren
 
 	int32 FoundCount = 0;
 
-	for (TObjectIterator<UBlueprintGeneratedClass> It; It; ++It)
+	for (UClass* const Candidate : FValidatorXManager::Get().GetLoadedClassHierarchy().GetDerivedClasses(ParentClass))
 	{
-		UBlueprintGeneratedClass* Candidate = *It;
-
-		if (Candidate && Candidate->IsChildOf(ParentClass) && Candidate != ParentClass)
-		{
-			OutDerived.Add(Candidate);
-			UE_LOG(NodeFunctionLibraryLog, Display, TEXT("  [Derived] %s"), *Candidate->GetName());
-			++FoundCount;
-		}
+		OutDerived.AddUnique(Candidate);
+		UE_LOG(NodeFunctionLibraryLog, Verbose, TEXT("  [Derived] %s"), *Candidate->GetName());
+		++FoundCount;
 	}
 
-	UE_LOG(NodeFunctionLibraryLog, Display, TEXT("Found %d derived classes of %s"), FoundCount, *ParentClass->GetName());
+	UE_LOG(NodeFunctionLibraryLog, Verbose, TEXT("Found %d derived classes of %s"), FoundCount, *ParentClass->GetName());
 }
 
 bool UBPUtilsNodeFunctionLibrary::IsEmptyEvent(const UK2Node_Event* EventNode)
@@ -108,43 +101,7 @@ bool UBPUtilsNodeFunctionLibrary::IsEmptyEvent(const UK2Node_Event* EventNode)
 		return true;
 	}
 
-	const FName	  EventName = EventNode->GetFunctionName();
-	const UClass* ThisClass = Blueprint->GeneratedClass;
-
-	TArray<UClass*> DerivedClasses;
-	GetDerivedBlueprintClasses(ThisClass, DerivedClasses);
-
-	for (UClass* const DerivedClass : DerivedClasses)
-	{
-		if (!DerivedClass)
-		{
-			continue;
-		}
-
-		UBlueprint* const DerivedBP = Cast<UBlueprint>(DerivedClass->ClassGeneratedBy);
-		if (!DerivedBP)
-		{
-			continue;
-		}
-
-		for (UEdGraph* const Graph : DerivedBP->UbergraphPages)
-		{
-			for (UEdGraphNode* const Node : Graph->Nodes)
-			{
-				UK2Node_Event* ChildEvent = Cast<UK2Node_Event>(Node);
-				if (ChildEvent && ChildEvent->GetFunctionName() == EventName)
-				{
-					UEdGraphPin* ChildThen = ChildEvent->FindPin(UEdGraphSchema_K2::PN_Then);
-					if (ChildThen && !ChildThen->LinkedTo.IsEmpty())
-					{
-						return false;
-					}
-				}
-			}
-		}
-	}
-
-	return true;
+	return !FValidatorXManager::Get().GetLoadedClassHierarchy().IsEventImplementedByDerivedClass(Blueprint->GeneratedClass, EventNode->GetFunctionName());
 }
 
 bool UBPUtilsNodeFunctionLibrary::IsEmptyFunctions(const UK2Node_CallFunction* EventNode)
@@ -254,7 +211,7 @@ bool UBPUtilsNodeFunctionLibrary::IsUnusedVariableNode(UEdGraphNode* Node)
 	return false;
 }
 
-bool UBPUtilsNodeFunctionLibrary::IsNodeInsideComment(UEdGraphNode* Node, const TArray<UEdGraphNode_Comment*>& CommentNodes)
+bool UBPUtilsNodeFunctionLibrary::IsNodeInsideComment(UEdGraphNode* Node, TConstArrayView<UEdGraphNode_Comment*> CommentNodes)
 {
 	if (!Node)
 	{
@@ -271,9 +228,7 @@ bool UBPUtilsNodeFunctionLibrary::IsNodeInsideComment(UEdGraphNode* Node, const
 		const bool bIsInsideBounds =
 			NodePos.X >= CommentPos.X && NodePos.X <= CommentPos.X + CommentSize.X && NodePos.Y >= CommentPos.Y && NodePos.Y <= CommentPos.Y + CommentSize.Y;
 
-		const FString CommentText = Comment->NodeComment.ToLower();
-
-		if (bIsInsideBounds /*&& CommentText.Contains(TEXT("todo"))*/)
+		if (bIsInsideBounds)
 		{
 			return true;
 		}
@@ -324,57 +279,39 @@ bool UBPUtilsNodeFunctionLibrary::IsBoolVariableSetInThisOrParentBPs(UBlueprint*
 	UBlueprint* CurrentBP = Blueprint;
 	while (CurrentBP)
 	{
-		UE_LOG(NodeFunctionLibraryLog, Display, TEXT("[IsBoolVariableSet] Checking Blueprint: %s"), *CurrentBP->GetName());
+		UE_LOG(NodeFunctionLibraryLog, Verbose, TEXT("[IsBoolVariableSet] Checking Blueprint: %s"), *CurrentBP->GetName());
 
-		TArray<UEdGraph*> Graphs;
-		CurrentBP->GetAllGraphs(Graphs);
-
-		for (UEdGraph* const Graph : Graphs)
+		const TSharedRef<const FBlueprintGraphIndex> GraphIndex = FValidatorXManager::Get().GetGraphIndex(CurrentBP);
+		const TConstArrayView<UK2Node_VariableSet*> SetNodes = GraphIndex->FindVariableSets(VarName);
+		if (!SetNodes.IsEmpty())
 		{
-			if (!Graph)
-			{
-				continue;
-			}
+			const UEdGraph* const Graph = SetNodes[0]->GetGraph();
 
-			UE_LOG(NodeFunctionLibraryLog, VeryVerbose, TEXT("  [Graph] %s"), *Graph->GetName());
+			UE_LOG(NodeFunctionLibraryLog, Verbose, TEXT("Found SET for '%s' in BP '%s', Graph '%s'"),
+				*VarName.ToString(),
+				*CurrentBP->GetName(),
+				*GetNameSafe(Graph));
 
-			for (UEdGraphNode* const Node : Graph->Nodes)
+			if (OutSourceInfo)
 			{
-				if (UK2Node_VariableSet* SetNode = Cast<UK2Node_VariableSet>(Node))
-				{
-					const FName SetVarName = SetNode->GetVarName();
-					UE_LOG(NodeFunctionLibraryLog, Verbose, TEXT("[SetNode] Variable: %s"), *SetVarName.ToString());
-
-					if (SetVarName == VarName)
-					{
-						UE_LOG(NodeFunctionLibraryLog, Display, TEXT("Found SET for '%s' in BP '%s', Graph '%s'"),
-							*VarName.ToString(),
-							*CurrentBP->GetName(),
-							*Graph->GetName());
-
-						if (OutSourceInfo)
-						{
-							*OutSourceInfo = FString::Printf(TEXT("Set found in Blueprint: %s, Graph: %s"),
-								*CurrentBP->GetName(),
-								*Graph->GetName());
-						}
-						return true;
-					}
-				}
+				*OutSourceInfo = FString::Printf(TEXT("Set found in Blueprint: %s, Graph: %s"),
+					*CurrentBP->GetName(),
+					*GetNameSafe(Graph));
 			}
+			return true;
 		}
 
 		UClass* const ParentClass = CurrentBP->ParentClass;
 		if (!ParentClass)
 		{
-			UE_LOG(NodeFunctionLibraryLog, Display, TEXT("[IsBoolVariableSet] Reached top base class from %s"), *CurrentBP->GetName());
+			UE_LOG(NodeFunctionLibraryLog, Verbose, TEXT("[IsBoolVariableSet] Reached top base class from %s"), *CurrentBP->GetName());
 			break;
 		}
 
 		CurrentBP = UBlueprint::GetBlueprintFromClass(ParentClass);
 		if (!CurrentBP)
 		{
-			UE_LOG(NodeFunctionLibraryLog, Display, TEXT("[IsBoolVariableSet] No Blueprint found for ParentClass: %s"), *ParentClass->GetName());
+			UE_LOG(NodeFunctionLibraryLog, Verbose, TEXT("[IsBoolVariableSet] No Blueprint found for ParentClass: %s"), *ParentClass->GetName());
 		}
 	}
 
@@ -383,7 +320,7 @@ bool UBPUtilsNodeFunctionLibrary::IsBoolVariableSetInThisOrParentBPs(UBlueprint*
 		*OutSourceInfo = TEXT("No Set found in this Blueprint or any parent.");
 	}
 
-	UE_LOG(NodeFunctionLibraryLog, Display, TEXT("No SET found for variable '%s' in %s or parents."),
+	UE_LOG(NodeFunctionLibraryLog, Verbose, TEXT("No SET found for variable '%s' in %s or parents."),
 		*VarName.ToString(),
 		*Blueprint->GetName());
 
@@ -415,3 +352,27 @@ bool UBPUtilsNodeFunctionLibrary::AreAllBranchExecsDisconnected(const UK2Node_If
 
 	return true;
 }
+
+UBlueprint* UBPUtilsNodeFunctionLibrary::FindLoadedBlueprint(FName PackageName)
+{
+	// Native packages hold many objects and never a Blueprint
+	const FString PackageNameString = PackageName.ToString();
+	if (FPackageName::IsScriptPackage(PackageNameString))
+	{
+		return nullptr;
+	}
+
+	const UPackage* Package = FindPackage(nullptr, *PackageNameString);
+	if (!Package)
+	{
+		return nullptr;
+	}
+
+	UBlueprint* Blueprint = nullptr;
+	ForEachObjectWithPackage(Package, [&Blueprint](UObject* Object)
+	{
+		Blueprint = Cast<UBlueprint>(Object);
+		return Blueprint == nullptr;
+	}, false);
+	return Blueprint;
+}
@@ -0,0 +1,340 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "Live/ValidatorXLiveValidation.h"
+#include "ValidatorXManager.h"
+#include "Analysis/BlueprintSnapshot.h"
+#include "BaseClasses/BlueprintValidatorBase.h"
+#include "EdGraph/EdGraph.h"
+#include "EdGraph/EdGraphNode.h"
+#include "Editor.h"
+#include "Engine/Blueprint.h"
+#include "HAL/IConsoleManager.h"
+#include "Kismet2/BlueprintEditorUtils.h"
+#include "Logging/TokenizedMessage.h"
+#include "MessageLogModule.h"
+#include "Misc/DataValidation.h"
+#include "Subsystems/AssetEditorSubsystem.h"
+
+#define LOCTEXT_NAMESPACE "ValidatorXLiveValidation"
+
+const FName FValidatorXLiveValidation::MessageLogName(TEXT("ValidatorX"));
+
+namespace
+{
+	TAutoConsoleVariable<bool> CVarLiveValidationEnabled(
+		TEXT("ValidatorX.LiveValidation"),
+		true,
+		TEXT("Re-validates Blueprints open in an editor while they are being edited."));
+
+	TAutoConsoleVariable<float> CVarLiveValidationFrameBudgetMs(
+		TEXT("ValidatorX.LiveValidation.FrameBudgetMs"),
+		2.0f,
+		TEXT("Maximum time per frame spent re-validating edited graphs. At least one graph is processed per frame."));
+
+	UAssetEditorSubsystem* GetAssetEditorSubsystem()
+	{
+		return GEditor ? GEditor->GetEditorSubsystem<UAssetEditorSubsystem>() : nullptr;
+	}
+
+	/** Returns whether a Blueprint validator can run on a Blueprint. */
+	bool CanRunLiveValidator(UBlueprintValidatorBase& Validator, UBlueprint& Blueprint, FDataValidationContext& Context)
+	{
+		return Validator.CanValidateAsset(FAssetData(&Blueprint), &Blueprint, Context);
+	}
+} // namespace
+
+void FValidatorXLiveValidation::Initialize()
+{
+	if (IsRunningCommandlet())
+	{
+		return;
+	}
+
+	FMessageLogModule& MessageLogModule = FModuleManager::LoadModuleChecked<FMessageLogModule>("MessageLog");
+	FMessageLogInitializationOptions InitOptions;
+	InitOptions.bShowFilters = true;
+	InitOptions.bAllowClear = false;
+	MessageLogModule.RegisterLogListing(MessageLogName, LOCTEXT("MessageLogLabel", "ValidatorX"), InitOptions);
+
+	ObjectModifiedHandle = FCoreUObjectDelegates::OnObjectModified.AddRaw(this, &FValidatorXLiveValidation::HandleObjectModified);
+	TickerHandle = FTSTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateRaw(this, &FValidatorXLiveValidation::Tick));
+
+	// The asset editor subsystem only exists once the editor engine is up
+	PostEngineInitHandle = FCoreDelegates::OnPostEngineInit.AddLambda([this]()
+	{
+		if (UAssetEditorSubsystem* const AssetEditorSubsystem = GetAssetEditorSubsystem())
+		{
+			AssetOpenedHandle = AssetEditorSubsystem->OnAssetOpenedInEditor().AddRaw(this, &FValidatorXLiveValidation::HandleAssetOpenedInEditor);
+		}
+	});
+}
+
+void FValidatorXLiveValidation::Shutdown()
+{
+	FCoreDelegates::OnPostEngineInit.Remove(PostEngineInitHandle);
+	FCoreUObjectDelegates::OnObjectModified.Remove(ObjectModifiedHandle);
+	FTSTicker::GetCoreTicker().RemoveTicker(TickerHandle);
+
+	if (UAssetEditorSubsystem* const AssetEditorSubsystem = GetAssetEditorSubsystem())
+	{
+		AssetEditorSubsystem->OnAssetOpenedInEditor().Remove(AssetOpenedHandle);
+	}
+
+	for (const TPair<TWeakObjectPtr<UBlueprint>, FLiveBlueprint>& Pair : LiveBlueprints)
+	{
+		if (UBlueprint* const Blueprint = Pair.Key.Get())
+		{
+			Blueprint->OnCompiled().Remove(Pair.Value.CompiledHandle);
+		}
+	}
+
+	LiveBlueprints.Reset();
+	PendingWork.Reset();
+
+	if (FModuleManager::Get().IsModuleLoaded("MessageLog"))
+	{
+		FModuleManager::GetModuleChecked<FMessageLogModule>("MessageLog").UnregisterLogListing(MessageLogName);
+	}
+}
+
+void FValidatorXLiveValidation::TrackBlueprint(UBlueprint* Blueprint)
+{
+	if (!Blueprint || !CVarLiveValidationEnabled.GetValueOnGameThread())
+	{
+		return;
+	}
+
+	FLiveBlueprint* Live = LiveBlueprints.Find(Blueprint);
+	if (!Live)
+	{
+		Live = &LiveBlueprints.Add(Blueprint);
+		Live->CompiledHandle = Blueprint->OnCompiled().AddRaw(this, &FValidatorXLiveValidation::HandleBlueprintCompiled);
+	}
+
+	HandleBlueprintCompiled(Blueprint);
+}
+
+void FValidatorXLiveValidation::MarkGraphDirty(UBlueprint* Blueprint, FName GraphName)
+{
+	if (LiveBlueprints.Contains(Blueprint))
+	{
+		AddWork(Blueprint, GraphName);
+	}
+}
+
+void FValidatorXLiveValidation::HandleAssetOpenedInEditor(UObject* Asset, IAssetEditorInstance* EditorInstance)
+{
+	TrackBlueprint(Cast<UBlueprint>(Asset));
+}
+
+void FValidatorXLiveValidation::HandleObjectModified(UObject* Object)
+{
+	if (LiveBlueprints.IsEmpty())
+	{
+		return;
+	}
+
+	const UEdGraph* Graph = Cast<UEdGraph>(Object);
+	if (!Graph)
+	{
+		const UEdGraphNode* const Node = Cast<UEdGraphNode>(Object);
+		Graph = Node ? Node->GetGraph() : nullptr;
+	}
+
+	if (Graph)
+	{
+		MarkGraphDirty(FBlueprintEditorUtils::FindBlueprintForGraph(Graph), Graph->GetFName());
+	}
+}
+
+void FValidatorXLiveValidation::HandleBlueprintCompiled(UBlueprint* Blueprint)
+{
+	if (!LiveBlueprints.Contains(Blueprint))
+	{
+		return;
+	}
+
+	TArray<UEdGraph*> Graphs;
+	Blueprint->GetAllGraphs(Graphs);
+	for (const UEdGraph* const Graph : Graphs)
+	{
+		if (Graph)
+		{
+			AddWork(Blueprint, Graph->GetFName());
+		}
+	}
+	AddWork(Blueprint, NAME_None);
+}
+
+void FValidatorXLiveValidation::AddWork(UBlueprint* Blueprint, FName GraphName)
+{
+	PendingWork.AddUnique(FWorkItem{Blueprint, GraphName});
+}
+
+bool FValidatorXLiveValidation::Tick(float DeltaTime)
+{
+	bool bIsChanged = RemoveClosedBlueprints();
+
+	if (!PendingWork.IsEmpty() && !(GEditor && GEditor->PlayWorld))
+	{
+		const TArray<UBlueprintValidatorBase*> EnabledValidators = FValidatorXManager::Get().GetEnabledValidators();
+		const double BudgetSeconds = CVarLiveValidationFrameBudgetMs.GetValueOnGameThread() / 1000.0;
+		const double StartTime = FPlatformTime::Seconds();
+
+		int32 NumProcessed = 0;
+		do
+		{
+			const FWorkItem WorkItem = PendingWork[NumProcessed++];
+			UBlueprint* const Blueprint = WorkItem.Blueprint.Get();
+			FLiveBlueprint* const Live = Blueprint ? LiveBlueprints.Find(Blueprint) : nullptr;
+			if (!Live)
+			{
+				continue;
+			}
+
+			if (WorkItem.GraphName.IsNone())
+			{
+				ValidateBlueprint(*Blueprint, *Live, EnabledValidators);
+			}
+			else
+			{
+				ValidateGraph(*Blueprint, *Live, WorkItem.GraphName, EnabledValidators);
+			}
+			bIsChanged = true;
+		}
+		while (NumProcessed < PendingWork.Num() && FPlatformTime::Seconds() - StartTime < BudgetSeconds);
+
+		PendingWork.RemoveAt(0, NumProcessed);
+	}
+
+	if (bIsChanged)
+	{
+		PublishMessages();
+	}
+
+	return true;
+}
+
+bool FValidatorXLiveValidation::RemoveClosedBlueprints()
+{
+	const UAssetEditorSubsystem* const AssetEditorSubsystem = GetAssetEditorSubsystem();
+	const bool bIsEnabled = CVarLiveValidationEnabled.GetValueOnGameThread();
+
+	bool bIsRemoved = false;
+	for (auto It = LiveBlueprints.CreateIterator(); It; ++It)
+	{
+		UBlueprint* const Blueprint = It.Key().Get();
+		if (Blueprint && bIsEnabled && AssetEditorSubsystem && AssetEditorSubsystem->FindEditorForAsset(Blueprint, false))
+		{
+			continue;
+		}
+
+		if (Blueprint)
+		{
+			Blueprint->OnCompiled().Remove(It.Value().CompiledHandle);
+		}
+		It.RemoveCurrent();
+		bIsRemoved = true;
+	}
+	return bIsRemoved;
+}
+
+void FValidatorXLiveValidation::ValidateGraph(UBlueprint& Blueprint, FLiveBlueprint& Live, FName GraphName, TConstArrayView<UBlueprintValidatorBase*> InValidators)
+{
+	TArray<UEdGraph*> Graphs;
+	Blueprint.GetAllGraphs(Graphs);
+	UEdGraph* const* const Graph = Graphs.FindByPredicate([GraphName](const UEdGraph* Candidate) { return Candidate && Candidate->GetFName() == GraphName; });
+	if (!Graph)
+	{
+		// The graph was removed or renamed
+		Live.GraphMessages.Remove(GraphName);
+		return;
+	}
+
+	TArray<FValidatorXMessage>& Messages = Live.GraphMessages.FindOrAdd(GraphName);
+	Messages.Reset();
+
+	TSharedPtr<const FBlueprintSnapshot> Snapshot;
+	FDataValidationContext Context;
+	for (UBlueprintValidatorBase* const Validator : InValidators)
+	{
+		if (!Validator->SupportsSnapshotAnalysis() || !Validator->IsGraphLocal() || !CanRunLiveValidator(*Validator, Blueprint, Context))
+		{
+			continue;
+		}
+
+		if (!Snapshot.IsValid())
+		{
+			Snapshot = FBlueprintSnapshot::CreateForGraph(Blueprint, **Graph);
+		}
+
+		const int32 NumIssuesBefore = Context.GetIssues().Num();
+		TArray<FValidatorXIssue> Issues;
+		Validator->AnalyzeSnapshot(*Snapshot, Issues);
+		Validator->CommitIssues(&Blueprint, Issues, Context);
+		FValidatorXMessage::AppendFromContext(Context, NumIssuesBefore, Validator->GetClass()->GetFName(), Messages);
+	}
+}
+
+void FValidatorXLiveValidation::ValidateBlueprint(UBlueprint& Blueprint, FLiveBlueprint& Live, TConstArrayView<UBlueprintValidatorBase*> InValidators)
+{
+	Live.BlueprintMessages.Reset();
+
+	FDataValidationContext Context;
+	for (UBlueprintValidatorBase* const Validator : InValidators)
+	{
+		if ((Validator->SupportsSnapshotAnalysis() && Validator->IsGraphLocal()) || !CanRunLiveValidator(*Validator, Blueprint, Context))
+		{
+			continue;
+		}
+
+		const int32 NumIssuesBefore = Context.GetIssues().Num();
+		Validator->ValidateLoadedAsset(FAssetData(&Blueprint), &Blueprint, Context);
+		FValidatorXMessage::AppendFromContext(Context, NumIssuesBefore, Validator->GetClass()->GetFName(), Live.BlueprintMessages);
+	}
+}
+
+void FValidatorXLiveValidation::PublishMessages() const
+{
+	if (!FModuleManager::Get().IsModuleLoaded("MessageLog"))
+	{
+		return;
+	}
+
+	TArray<TSharedRef<FTokenizedMessage>> Messages;
+	auto AddMessages = [&Messages](UBlueprint* Blueprint, TConstArrayView<FValidatorXMessage> LiveMessages)
+	{
+		for (const FValidatorXMessage& LiveMessage : LiveMessages)
+		{
+			// Prefix with the Blueprint, since the listing mixes every tracked Blueprint
+			const TSharedRef<FTokenizedMessage> Message = FTokenizedMessage::Create(LiveMessage.Message->GetSeverity());
+			Message->AddToken(FUObjectToken::Create(Blueprint));
+			for (const TSharedRef<IMessageToken>& Token : LiveMessage.Message->GetMessageTokens())
+			{
+				Message->AddToken(Token);
+			}
+			Messages.Add(Message);
+		}
+	};
+
+	for (const TPair<TWeakObjectPtr<UBlueprint>, FLiveBlueprint>& Pair : LiveBlueprints)
+	{
+		UBlueprint* const Blueprint = Pair.Key.Get();
+		if (!Blueprint)
+		{
+			continue;
+		}
+
+		for (const TPair<FName, TArray<FValidatorXMessage>>& GraphPair : Pair.Value.GraphMessages)
+		{
+			AddMessages(Blueprint, GraphPair.Value);
+		}
+		AddMessages(Blueprint, Pair.Value.BlueprintMessages);
+	}
+
+	const TSharedRef<IMessageLogListing> Listing = FModuleManager::GetModuleChecked<FMessageLogModule>("MessageLog").GetLogListing(MessageLogName);
+	Listing->ClearMessages();
+	Listing->AddMessages(Messages, false);
+}
+
+#undef LOCTEXT_NAMESPACE
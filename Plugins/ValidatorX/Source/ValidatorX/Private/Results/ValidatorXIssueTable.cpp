@@ -0,0 +1,220 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "Results/ValidatorXIssueTable.h"
+#include "ValidatorXManager.h"
+#include "BaseClasses/BlueprintValidatorBase.h"
+#include "Fixes/ValidatorXFixBatch.h"
+#include "Engine/Blueprint.h"
+#include "Logging/TokenizedMessage.h"
+
+namespace
+{
+	/** Format of the messages without a snapshot issue, whose whole text is the only argument. */
+	const FTextFormat& GetPlainTextFormat()
+	{
+		static const FTextFormat PlainTextFormat(INVTEXT("{0}"));
+		return PlainTextFormat;
+	}
+} // namespace
+
+void FValidatorXIssueTable::AddReport(const FValidatorXAssetReport& Report)
+{
+	const int32 AssetIndex = Assets.Add(Report.AssetData);
+	NumInvalidAssets += Report.Result == EDataValidationResult::Invalid ? 1 : 0;
+
+	for (const FValidatorXMessage& Message : Report.Messages)
+	{
+		int32 ValidatorIndex = INDEX_NONE;
+		if (const int32* const ExistingIndex = ValidatorIndices.Find(Message.ValidatorName))
+		{
+			ValidatorIndex = *ExistingIndex;
+		}
+		else
+		{
+			ValidatorIndex = Validators.Add(Message.ValidatorName);
+			ValidatorIndices.Add(Message.ValidatorName, ValidatorIndex);
+		}
+
+		FRow& Row = Rows.AddDefaulted_GetRef();
+		Row.Asset = AssetIndex;
+		Row.Validator = ValidatorIndex;
+		Row.Severity = static_cast<uint8>(Message.Message->GetSeverity());
+		Row.FirstArgument = Arguments.Num();
+
+		if (const FValidatorXIssue* const Issue = Message.Issue.Get())
+		{
+			Row.Format = InternFormat(Issue->Format);
+			Arguments.Append(Issue->Arguments);
+			Row.bHasIssue = true;
+			Row.GraphName = Issue->GraphName;
+			Row.NodeGuid = Issue->NodeGuid;
+			Row.Subject = Issue->Subject;
+		}
+		else
+		{
+			Row.Format = InternFormat(GetPlainTextFormat());
+			Arguments.Emplace(Message.Message->ToText());
+		}
+
+		Row.NumArguments = Arguments.Num() - Row.FirstArgument;
+	}
+}
+
+void FValidatorXIssueTable::Reset()
+{
+	Rows.Reset();
+	Assets.Reset();
+	NumInvalidAssets = 0;
+	Validators.Reset();
+	ValidatorIndices.Reset();
+	Formats.Reset();
+	FormatIndices.Reset();
+	Arguments.Reset();
+}
+
+FText FValidatorXIssueTable::GetMessage(int32 RowIndex) const
+{
+	const FRow& Row = Rows[RowIndex];
+	return FText::Format(Formats[Row.Format], FFormatOrderedArguments(Arguments.GetData() + Row.FirstArgument, Row.NumArguments));
+}
+
+TSharedRef<FTokenizedMessage> FValidatorXIssueTable::CreateMessage(int32 RowIndex) const
+{
+	check(IsInGameThread());
+
+	const FRow& Row = Rows[RowIndex];
+	const TSharedRef<FTokenizedMessage> Message = FTokenizedMessage::Create(static_cast<EMessageSeverity::Type>(Row.Severity), GetMessage(RowIndex));
+	if (!Row.bHasIssue)
+	{
+		return Message;
+	}
+
+	UBlueprintValidatorBase* const Validator = FindValidator(Row);
+	UBlueprint* const Blueprint = Validator ? Cast<UBlueprint>(Assets[Row.Asset].GetAsset()) : nullptr;
+	if (!Blueprint)
+	{
+		return Message;
+	}
+
+	Validator->AddIssueTokens(Blueprint, MakeIssue(Row), Message);
+	return Message;
+}
+
+int32 FValidatorXIssueTable::AddFixes(TConstArrayView<int32> RowIndices, FValidatorXFixBatch& OutBatch) const
+{
+	check(IsInGameThread());
+
+	const int32 NumFixesBefore = OutBatch.Num();
+	for (const int32 RowIndex : RowIndices)
+	{
+		const FRow& Row = Rows[RowIndex];
+		if (!Row.bHasIssue)
+		{
+			continue;
+		}
+
+		UBlueprintValidatorBase* const Validator = FindValidator(Row);
+		UBlueprint* const Blueprint = Validator ? Cast<UBlueprint>(Assets[Row.Asset].GetAsset()) : nullptr;
+		if (Blueprint)
+		{
+			OutBatch.AddFix(Validator, Blueprint, MakeIssue(Row));
+		}
+	}
+	return OutBatch.Num() - NumFixesBefore;
+}
+
+void FValidatorXIssueTable::FilterRows(const FString& FilterText, int32 FirstRow, TArray<int32>& OutRows) const
+{
+	if (FilterText.IsEmpty())
+	{
+		for (int32 RowIndex = FirstRow; RowIndex < Rows.Num(); ++RowIndex)
+		{
+			OutRows.Add(RowIndex);
+		}
+		return;
+	}
+
+	auto Contains = [&FilterText](const FString& Text)
+	{
+		return Text.Contains(FilterText, ESearchCase::IgnoreCase);
+	};
+
+	// Interned values are tested the first time a row refers to them: -1 untested, 0 no match, 1 match
+	TArray<int8> AssetMatches;
+	TArray<int8> ValidatorMatches;
+	TArray<int8> FormatMatches;
+	AssetMatches.Init(-1, Assets.Num());
+	ValidatorMatches.Init(-1, Validators.Num());
+	FormatMatches.Init(-1, Formats.Num());
+
+	FString ArgumentText;
+	for (int32 RowIndex = FirstRow; RowIndex < Rows.Num(); ++RowIndex)
+	{
+		const FRow& Row = Rows[RowIndex];
+
+		int8& AssetMatch = AssetMatches[Row.Asset];
+		if (AssetMatch < 0)
+		{
+			AssetMatch = Contains(Assets[Row.Asset].AssetName.ToString()) || Contains(Assets[Row.Asset].PackagePath.ToString()) ? 1 : 0;
+		}
+
+		int8& ValidatorMatch = ValidatorMatches[Row.Validator];
+		if (ValidatorMatch < 0)
+		{
+			ValidatorMatch = Contains(Validators[Row.Validator].ToString()) ? 1 : 0;
+		}
+
+		int8& FormatMatch = FormatMatches[Row.Format];
+		if (FormatMatch < 0)
+		{
+			FormatMatch = Contains(Formats[Row.Format].GetSourceText().ToString()) ? 1 : 0;
+		}
+
+		bool bIsMatch = AssetMatch || ValidatorMatch || FormatMatch;
+		for (int32 ArgumentIndex = Row.FirstArgument; !bIsMatch && ArgumentIndex < Row.FirstArgument + Row.NumArguments; ++ArgumentIndex)
+		{
+			ArgumentText.Reset();
+			Arguments[ArgumentIndex].ToFormattedString(false, false, ArgumentText);
+			bIsMatch = Contains(ArgumentText);
+		}
+
+		if (bIsMatch)
+		{
+			OutRows.Add(RowIndex);
+		}
+	}
+}
+
+UBlueprintValidatorBase* FValidatorXIssueTable::FindValidator(const FRow& Row) const
+{
+	for (const TWeakObjectPtr<UBlueprintValidatorBase>& Validator : FValidatorXManager::Get().GetValidators())
+	{
+		if (Validator.IsValid() && Validator->GetClass()->GetFName() == Validators[Row.Validator])
+		{
+			return Validator.Get();
+		}
+	}
+	return nullptr;
+}
+
+FValidatorXIssue FValidatorXIssueTable::MakeIssue(const FRow& Row) const
+{
+	FValidatorXIssue Issue(static_cast<EMessageSeverity::Type>(Row.Severity), Formats[Row.Format], FFormatOrderedArguments(Arguments.GetData() + Row.FirstArgument, Row.NumArguments));
+	Issue.GraphName = Row.GraphName;
+	Issue.NodeGuid = Row.NodeGuid;
+	Issue.Subject = Row.Subject;
+	return Issue;
+}
+
+int32 FValidatorXIssueTable::InternFormat(const FTextFormat& Format)
+{
+	FString Source = Format.GetSourceText().ToString();
+	if (const int32* const FormatIndex = FormatIndices.Find(Source))
+	{
+		return *FormatIndex;
+	}
+
+	const int32 FormatIndex = Formats.Add(Format);
+	FormatIndices.Add(MoveTemp(Source), FormatIndex);
+	return FormatIndex;
+}
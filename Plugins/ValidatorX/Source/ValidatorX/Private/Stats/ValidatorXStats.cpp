@@ -0,0 +1,106 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "Stats/ValidatorXStats.h"
+#include "Algo/BinarySearch.h"
+#include "BaseClasses/BlueprintValidatorBase.h"
+#include "Misc/DataValidation.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "ValidatorXManager.h"
+
+DEFINE_STAT(STAT_ValidatorX_ValidateAsset);
+
+double FValidatorXValidatorStats::GetPercentileSeconds(double Percentile) const
+{
+	if (SortedSeconds.IsEmpty())
+	{
+		return 0.0;
+	}
+
+	const int32 Rank = FMath::CeilToInt(FMath::Clamp(Percentile, 0.0, 1.0) * SortedSeconds.Num());
+	return SortedSeconds[FMath::Clamp(Rank - 1, 0, SortedSeconds.Num() - 1)];
+}
+
+void FValidatorXStats::Record(FName ValidatorName, const FSoftObjectPath& AssetPath, uint64 Cycles, int32 NumMessages)
+{
+	check(IsInGameThread());
+
+	const double Seconds = FPlatformTime::ToSeconds64(Cycles);
+
+	FValidatorXValidatorStats& Stats = ValidatorStats.FindOrAdd(ValidatorName);
+	++Stats.NumAssets;
+	Stats.NumMessages += NumMessages;
+	Stats.TotalSeconds += Seconds;
+
+	// Kept sorted on insertion, so percentiles are plain lookups when the UI repaints
+	Stats.SortedSeconds.Insert(float(Seconds), Algo::UpperBound(Stats.SortedSeconds, float(Seconds)));
+
+	if (Stats.WorstAssets.Num() < MaxWorstAssets || Seconds > Stats.WorstAssets.Last().Seconds)
+	{
+		const int32 Position = Algo::UpperBoundBy(Stats.WorstAssets, -Seconds, [](const FValidatorXAssetTiming& Timing) { return -Timing.Seconds; });
+		Stats.WorstAssets.Insert(FValidatorXAssetTiming{AssetPath, Seconds, NumMessages}, Position);
+		if (Stats.WorstAssets.Num() > MaxWorstAssets)
+		{
+			Stats.WorstAssets.Pop();
+		}
+	}
+
+	++Revision;
+}
+
+void FValidatorXStats::Reset()
+{
+	ValidatorStats.Reset();
+	++Revision;
+}
+
+bool FValidatorXStats::ExportCsv(const FString& Filename) const
+{
+	TArray<TPair<FName, const FValidatorXValidatorStats*>> Rows;
+	for (const TPair<FName, FValidatorXValidatorStats>& Pair : ValidatorStats)
+	{
+		Rows.Emplace(Pair.Key, &Pair.Value);
+	}
+	Rows.Sort([](const TPair<FName, const FValidatorXValidatorStats*>& A, const TPair<FName, const FValidatorXValidatorStats*>& B)
+	{
+		return A.Value->TotalSeconds > B.Value->TotalSeconds;
+	});
+
+	FString Csv = TEXT("Validator,Assets,Messages,TotalMs,AverageMs,P50Ms,P95Ms,MaxMs,WorstAsset\n");
+	for (const TPair<FName, const FValidatorXValidatorStats*>& Row : Rows)
+	{
+		const FValidatorXValidatorStats& Stats = *Row.Value;
+		Csv += FString::Printf(TEXT("%s,%d,%d,%.3f,%.3f,%.3f,%.3f,%.3f,%s\n"),
+			*Row.Key.ToString(),
+			Stats.NumAssets,
+			Stats.NumMessages,
+			Stats.TotalSeconds * 1000.0,
+			Stats.NumAssets > 0 ? Stats.TotalSeconds * 1000.0 / Stats.NumAssets : 0.0,
+			Stats.GetPercentileSeconds(0.5) * 1000.0,
+			Stats.GetPercentileSeconds(0.95) * 1000.0,
+			Stats.GetMaxSeconds() * 1000.0,
+			Stats.WorstAssets.IsEmpty() ? TEXT("") : *Stats.WorstAssets[0].AssetPath.ToString());
+	}
+
+	return FFileHelper::SaveStringToFile(Csv, *Filename, FFileHelper::EEncodingOptions::ForceUTF8WithoutBOM);
+}
+
+FString FValidatorXStats::GetDefaultCsvFilename()
+{
+	return FPaths::ProjectSavedDir() / TEXT("ValidatorX") / TEXT("ValidatorStats.csv");
+}
+
+FValidatorXStatScope::FValidatorXStatScope(const UBlueprintValidatorBase& InValidator, const FAssetData& InAssetData, const FDataValidationContext& InContext)
+	: Validator(InValidator)
+	, AssetData(InAssetData)
+	, Context(InContext)
+	, NumIssuesBefore(InContext.GetIssues().Num())
+	, StartCycles(FPlatformTime::Cycles64())
+{
+}
+
+FValidatorXStatScope::~FValidatorXStatScope()
+{
+	const uint64 Cycles = FPlatformTime::Cycles64() - StartCycles;
+	FValidatorXManager::Get().GetStats().Record(Validator.GetClass()->GetFName(), AssetData.GetSoftObjectPath(), Cycles, Context.GetIssues().Num() - NumIssuesBefore);
+}
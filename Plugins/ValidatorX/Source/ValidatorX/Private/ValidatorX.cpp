@@ -16,8 +16,16 @@ const FName FValidatorXModule::ValidatorXTabName = "ValidatorX";
 
 void FValidatorXModule::StartupModule()
 {
+	FValidatorXManager::Get().Initialize();
+
 	FCoreDelegates::OnPostEngineInit.AddRaw(this, &FValidatorXModule::HandlePostEngineInit);
 
+	// Commandlets run headless, see UValidatorXCommandlet
+	if (IsRunningCommandlet())
+	{
+		return;
+	}
+
 	UToolMenus::Get()->RegisterStartupCallback(FSimpleMulticastDelegate::FDelegate::CreateRaw(this, &FValidatorXModule::RegisterMenus));
 
 	FGlobalTabmanager::Get()->RegisterNomadTabSpawner(ValidatorXTabName, FOnSpawnTab::CreateRaw(this, &FValidatorXModule::OnSpawnValidatorXTab)) //
@@ -44,8 +52,12 @@ void FValidatorXModule::RegisterMenus()
 
 void FValidatorXModule::ShutdownModule()
 {
-	FGlobalTabmanager::Get()->UnregisterNomadTabSpawner(ValidatorXTabName);
-	UToolMenus::UnregisterOwner(this);
+	if (!IsRunningCommandlet())
+	{
+		FGlobalTabmanager::Get()->UnregisterNomadTabSpawner(ValidatorXTabName);
+		UToolMenus::UnregisterOwner(this);
+	}
+	FValidatorXManager::Get().Shutdown();
 }
 
 ETabSpawnerMenuType::Type FValidatorXModule::GetVisibleModule() const
@@ -59,7 +71,8 @@ ETabSpawnerMenuType::Type FValidatorXModule::GetVisibleModule() const
 
 void FValidatorXModule::HandlePostEngineInit()
 {
-	if (GEditor)
+	// The commandlet creates its own validators; do not overwrite their saved enabled state
+	if (GEditor && !IsRunningCommandlet())
 	{
 		const UEditorValidatorSubsystem* const ValidatorSubsystem = GEditor->GetEditorSubsystem<UEditorValidatorSubsystem>();
 		if (ValidatorSubsystem)
@@ -2,4 +2,593 @@
 
 
 #include "ValidatorXManager.h"
+#include "Analysis/BlueprintGraphIndex.h"
+#include "Analysis/BlueprintSnapshot.h"
+#include "AssetRegistry/AssetRegistryModule.h"
+#include "Async/ParallelFor.h"
+#include "Editor.h"
+#include "Engine/Blueprint.h"
+#include "HAL/IConsoleManager.h"
+#include "Jobs/ValidatorXValidationJob.h"
+#include "Logging/MessageLog.h"
+#include "Misc/DataValidation.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "UObject/StrongObjectPtr.h"
 
+DEFINE_LOG_CATEGORY_STATIC(LogValidatorXManager, Log, All);
+
+namespace
+{
+	/** Validates every Blueprint under the given content paths with the enabled validators. */
+	void ValidatePathsCommand(const TArray<FString>& Args)
+	{
+		if (Args.IsEmpty())
+		{
+			UE_LOG(LogValidatorXManager, Warning, TEXT("Usage: ValidatorX.ValidatePaths /Game/Path [/Game/OtherPath ...]"));
+			return;
+		}
+
+		TArray<FName> PackagePaths;
+		for (const FString& Path : Args)
+		{
+			PackagePaths.Add(FName(*Path));
+		}
+
+		TArray<FAssetData> Assets;
+		FValidatorXManager::FindBlueprintAssets(PackagePaths, Assets);
+
+		FValidatorXManager& Manager = FValidatorXManager::Get();
+		TArray<FValidatorXAssetReport> Reports;
+		Manager.ValidateAssets(Assets, Manager.GetEnabledValidators(), Reports);
+
+		FMessageLog MessageLog("AssetCheck");
+		int32 NumInvalidAssets = 0;
+		for (const FValidatorXAssetReport& Report : Reports)
+		{
+			NumInvalidAssets += Report.Result == EDataValidationResult::Invalid ? 1 : 0;
+			for (const FValidatorXMessage& Message : Report.Messages)
+			{
+				MessageLog.AddMessage(Message.Message);
+			}
+		}
+		MessageLog.Open(EMessageSeverity::Info);
+
+		const FValidatorXCacheStats& CacheStats = Manager.GetResultCache().GetStats();
+		UE_LOG(LogValidatorXManager, Display, TEXT("Validated %d Blueprints, %d with issues."), Reports.Num(), NumInvalidAssets);
+		UE_LOG(LogValidatorXManager, Display, TEXT("Result cache: %d hits, %d misses, %d loads skipped."), CacheStats.Hits, CacheStats.Misses, CacheStats.SkippedLoads);
+	}
+
+	FAutoConsoleCommand ValidatePathsConsoleCommand(
+		TEXT("ValidatorX.ValidatePaths"),
+		TEXT("Validates every Blueprint under the given content paths with the enabled ValidatorX validators."),
+		FConsoleCommandWithArgsDelegate::CreateStatic(&ValidatePathsCommand));
+
+	FAutoConsoleCommand ClearResultCacheConsoleCommand(
+		TEXT("ValidatorX.ClearResultCache"),
+		TEXT("Deletes every cached ValidatorX result, so the next run validates every asset again."),
+		FConsoleCommandDelegate::CreateLambda([]()
+		{
+			FValidatorXManager::Get().GetResultCache().Clear();
+			UE_LOG(LogValidatorXManager, Display, TEXT("Cleared the ValidatorX result cache."));
+		}));
+
+	FAutoConsoleCommand ExportStatsConsoleCommand(
+		TEXT("ValidatorX.ExportStats"),
+		TEXT("Writes the per-validator execution counters as CSV, to the given file or to Saved/ValidatorX/ValidatorStats.csv."),
+		FConsoleCommandWithArgsDelegate::CreateLambda([](const TArray<FString>& Args)
+		{
+			const FString Filename = Args.IsEmpty() ? FValidatorXStats::GetDefaultCsvFilename() : Args[0];
+			if (FValidatorXManager::Get().GetStats().ExportCsv(Filename))
+			{
+				UE_LOG(LogValidatorXManager, Display, TEXT("Validator stats written to '%s'."), *Filename);
+			}
+			else
+			{
+				UE_LOG(LogValidatorXManager, Error, TEXT("Failed to write validator stats '%s'."), *Filename);
+			}
+		}));
+
+	FAutoConsoleCommand ResetStatsConsoleCommand(
+		TEXT("ValidatorX.ResetStats"),
+		TEXT("Drops the per-validator execution counters."),
+		FConsoleCommandDelegate::CreateLambda([]()
+		{
+			FValidatorXManager::Get().GetStats().Reset();
+		}));
+
+	/** Writes the snapshot of a Blueprint as JSON, to use it as an analysis fixture. */
+	void DumpSnapshotCommand(const TArray<FString>& Args)
+	{
+		if (Args.IsEmpty())
+		{
+			UE_LOG(LogValidatorXManager, Warning, TEXT("Usage: ValidatorX.DumpSnapshot /Game/Path/BP_Asset.BP_Asset [File]"));
+			return;
+		}
+
+		UBlueprint* const Blueprint = LoadObject<UBlueprint>(nullptr, *Args[0]);
+		if (!Blueprint)
+		{
+			UE_LOG(LogValidatorXManager, Error, TEXT("'%s' is not a Blueprint."), *Args[0]);
+			return;
+		}
+
+		const FString Filename = Args.Num() > 1
+			? Args[1]
+			: FPaths::ProjectSavedDir() / TEXT("ValidatorX/Snapshots") / Blueprint->GetName() + TEXT(".json");
+		if (FFileHelper::SaveStringToFile(FValidatorXManager::Get().GetSnapshot(Blueprint)->ToJson(), *Filename))
+		{
+			UE_LOG(LogValidatorXManager, Display, TEXT("Snapshot of '%s' written to '%s'."), *Blueprint->GetName(), *Filename);
+		}
+		else
+		{
+			UE_LOG(LogValidatorXManager, Error, TEXT("Failed to write snapshot '%s'."), *Filename);
+		}
+	}
+
+	FAutoConsoleCommand DumpSnapshotConsoleCommand(
+		TEXT("ValidatorX.DumpSnapshot"),
+		TEXT("Writes the analysis snapshot of a Blueprint as JSON, to the given file or to Saved/ValidatorX/Snapshots/<Name>.json."),
+		FConsoleCommandWithArgsDelegate::CreateStatic(&DumpSnapshotCommand));
+
+	FAutoConsoleCommand BuildFunctionReferenceIndexConsoleCommand(
+		TEXT("ValidatorX.BuildFunctionReferenceIndex"),
+		TEXT("Indexes the function calls of every Blueprint without an up to date record, loading them. Pass 'Rebuild' to index every Blueprint again."),
+		FConsoleCommandWithArgsDelegate::CreateLambda([](const TArray<FString>& Args)
+		{
+			FFunctionReferenceIndex& ReferenceIndex = FValidatorXManager::Get().GetFunctionReferenceIndex();
+			if (Args.Contains(TEXT("Rebuild")))
+			{
+				ReferenceIndex.Clear();
+			}
+			ReferenceIndex.IndexPendingPackages(true);
+		}));
+} // namespace
+
+void FValidatorXManager::Initialize()
+{
+	PreAssetValidationHandle = FEditorDelegates::OnPreAssetValidation.AddRaw(this, &FValidatorXManager::BeginValidationRun);
+	PostAssetValidationHandle = FEditorDelegates::OnPostAssetValidation.AddRaw(this, &FValidatorXManager::EndValidationRun);
+	LiveValidation.Initialize();
+
+	PostGarbageCollectHandle = FCoreUObjectDelegates::GetPostGarbageCollect().AddLambda([this]() { LoadedClassHierarchy.Reset(); });
+	ObjectsReplacedHandle = FCoreUObjectDelegates::OnObjectsReplaced.AddLambda([this](const TMap<UObject*, UObject*>&) { LoadedClassHierarchy.Reset(); });
+
+	// Compile events live on the editor engine, which does not exist yet during module startup
+	PostEngineInitHandle = FCoreDelegates::OnPostEngineInit.AddLambda([this]()
+	{
+		if (GEditor)
+		{
+			BlueprintCompiledHandle = GEditor->OnBlueprintCompiled().AddLambda([this]() { LoadedClassHierarchy.Reset(); });
+			BlueprintReinstancedHandle = GEditor->OnBlueprintReinstanced().AddLambda([this]() { LoadedClassHierarchy.Reset(); });
+		}
+	});
+}
+
+void FValidatorXManager::Shutdown()
+{
+	FEditorDelegates::OnPreAssetValidation.Remove(PreAssetValidationHandle);
+	FEditorDelegates::OnPostAssetValidation.Remove(PostAssetValidationHandle);
+	FCoreUObjectDelegates::GetPostGarbageCollect().Remove(PostGarbageCollectHandle);
+	FCoreUObjectDelegates::OnObjectsReplaced.Remove(ObjectsReplacedHandle);
+	FCoreDelegates::OnPostEngineInit.Remove(PostEngineInitHandle);
+	if (GEditor)
+	{
+		GEditor->OnBlueprintCompiled().Remove(BlueprintCompiledHandle);
+		GEditor->OnBlueprintReinstanced().Remove(BlueprintReinstancedHandle);
+	}
+
+	ValidationJob.Reset();
+	LiveValidation.Shutdown();
+	HierarchyIndex.Shutdown();
+	FunctionReferenceIndex.Shutdown();
+	LoadedClassHierarchy.Reset();
+	HardReferenceFootprint.Reset();
+	ValidationRunDepth = 0;
+	ResetGraphIndexCache();
+	ResultCache.Save();
+}
+
+void FValidatorXManager::BeginValidationRun()
+{
+	if (ValidationRunDepth++ == 0)
+	{
+		ResetGraphIndexCache();
+		LoadedClassHierarchy.Reset();
+		HardReferenceFootprint.Reset();
+	}
+}
+
+void FValidatorXManager::EndValidationRun()
+{
+	if (ValidationRunDepth > 0 && --ValidationRunDepth == 0)
+	{
+		ResetGraphIndexCache();
+		LoadedClassHierarchy.Reset();
+		HardReferenceFootprint.Reset();
+	}
+}
+
+FValidatorXManager::FCachedBlueprint& FValidatorXManager::FindOrAddCachedBlueprint(UBlueprint* Blueprint)
+{
+	check(IsInGameThread());
+
+	if (ValidationRunDepth == 0 && CachedGraphIndexFrame != GFrameCounter)
+	{
+		ResetGraphIndexCache();
+	}
+	CachedGraphIndexFrame = GFrameCounter;
+
+	const int32 CachedIndex = CachedBlueprints.IndexOfByPredicate([Blueprint](const FCachedBlueprint& Entry) { return Entry.Blueprint.Get() == Blueprint; });
+	if (CachedIndex != INDEX_NONE)
+	{
+		if (CachedIndex != 0)
+		{
+			FCachedBlueprint Entry = CachedBlueprints[CachedIndex];
+			CachedBlueprints.RemoveAt(CachedIndex);
+			CachedBlueprints.Insert(MoveTemp(Entry), 0);
+		}
+		return CachedBlueprints[0];
+	}
+
+	if (CachedBlueprints.Num() >= MaxCachedBlueprints)
+	{
+		CachedBlueprints.Pop();
+	}
+
+	CachedBlueprints.Insert(FCachedBlueprint{Blueprint, MakeShared<const FBlueprintGraphIndex>(Blueprint), nullptr}, 0);
+	return CachedBlueprints[0];
+}
+
+TSharedRef<const FBlueprintGraphIndex> FValidatorXManager::GetGraphIndex(UBlueprint* Blueprint)
+{
+	return FindOrAddCachedBlueprint(Blueprint).GraphIndex;
+}
+
+TSharedRef<const FBlueprintSnapshot> FValidatorXManager::GetSnapshot(UBlueprint* Blueprint)
+{
+	FCachedBlueprint& Entry = FindOrAddCachedBlueprint(Blueprint);
+	if (!Entry.Snapshot.IsValid())
+	{
+		Entry.Snapshot = FBlueprintSnapshot::Create(*Entry.GraphIndex);
+	}
+	return Entry.Snapshot.ToSharedRef();
+}
+
+TSharedRef<const FValidatorXVariableWrites> FValidatorXManager::GetVariableWrites(UBlueprint* Blueprint)
+{
+	if (const TSharedPtr<const FValidatorXVariableWrites>& Cached = FindOrAddCachedBlueprint(Blueprint).VariableWrites)
+	{
+		return Cached.ToSharedRef();
+	}
+
+	// Summarizing the parent may move or evict cache entries, so it runs before the entry is looked up again
+	UBlueprint* const ParentBlueprint = Blueprint->ParentClass ? UBlueprint::GetBlueprintFromClass(Blueprint->ParentClass) : nullptr;
+	const TSharedRef<FValidatorXVariableWrites> VariableWrites = ParentBlueprint && ParentBlueprint != Blueprint
+		? MakeShared<FValidatorXVariableWrites>(*GetVariableWrites(ParentBlueprint))
+		: MakeShared<FValidatorXVariableWrites>();
+
+	const TSharedRef<const FBlueprintSnapshot> Snapshot = GetSnapshot(Blueprint);
+	for (int32 VariableIndex = 0; VariableIndex < Snapshot->Variables.Num(); ++VariableIndex)
+	{
+		const FBlueprintSnapshotVariable& Variable = Snapshot->Variables[VariableIndex];
+		if (Variable.Graph != INDEX_NONE)
+		{
+			continue;
+		}
+
+		if (Variable.bIsDeclared)
+		{
+			VariableWrites->Declared.Add(Variable.Name);
+		}
+		if (!Snapshot->FindVariableWrites(VariableIndex).IsEmpty())
+		{
+			VariableWrites->Written.Add(Variable.Name);
+		}
+	}
+
+	FindOrAddCachedBlueprint(Blueprint).VariableWrites = VariableWrites;
+	return VariableWrites;
+}
+
+void FValidatorXManager::ResetGraphIndexCache()
+{
+	CachedBlueprints.Reset();
+}
+
+FBlueprintHierarchyIndex& FValidatorXManager::GetHierarchyIndex()
+{
+	check(IsInGameThread());
+
+	HierarchyIndex.Initialize();
+	return HierarchyIndex;
+}
+
+FLoadedClassHierarchy& FValidatorXManager::GetLoadedClassHierarchy()
+{
+	check(IsInGameThread());
+
+	if (ValidationRunDepth == 0 && LoadedClassHierarchyFrame != GFrameCounter)
+	{
+		LoadedClassHierarchy.Reset();
+	}
+	LoadedClassHierarchyFrame = GFrameCounter;
+
+	return LoadedClassHierarchy;
+}
+
+FHardReferenceFootprint& FValidatorXManager::GetHardReferenceFootprint(bool bIncludeEngineContent, const TMap<FName, float>& ClassSizeFactors)
+{
+	check(IsInGameThread());
+
+	if (ValidationRunDepth == 0 && HardReferenceFootprintFrame != GFrameCounter)
+	{
+		HardReferenceFootprint.Reset();
+	}
+	HardReferenceFootprintFrame = GFrameCounter;
+
+	if (!HardReferenceFootprint.IsSet() || !HardReferenceFootprint->HasSettings(bIncludeEngineContent, ClassSizeFactors))
+	{
+		HardReferenceFootprint.Emplace(bIncludeEngineContent, ClassSizeFactors);
+	}
+	return HardReferenceFootprint.GetValue();
+}
+
+FFunctionReferenceIndex& FValidatorXManager::GetFunctionReferenceIndex()
+{
+	check(IsInGameThread());
+
+	FunctionReferenceIndex.Initialize();
+	FunctionReferenceIndex.Refresh();
+	return FunctionReferenceIndex;
+}
+
+TArray<UBlueprintValidatorBase*> FValidatorXManager::GetEnabledValidators() const
+{
+	TArray<UBlueprintValidatorBase*> EnabledValidators;
+	for (const TWeakObjectPtr<UBlueprintValidatorBase>& Validator : Validators)
+	{
+		if (Validator.IsValid() && Validator->IsEnabled())
+		{
+			EnabledValidators.Add(Validator.Get());
+		}
+	}
+	return EnabledValidators;
+}
+
+void FValidatorXManager::FindBlueprintAssets(TConstArrayView<FName> PackagePaths, TArray<FAssetData>& OutAssets)
+{
+	FARFilter Filter;
+	Filter.bRecursivePaths = true;
+	Filter.bRecursiveClasses = true;
+	Filter.ClassPaths.Add(UBlueprint::StaticClass()->GetClassPathName());
+	Filter.PackagePaths.Append(PackagePaths.GetData(), PackagePaths.Num());
+
+	OutAssets.Reset();
+	FModuleManager::LoadModuleChecked<FAssetRegistryModule>("AssetRegistry").Get().GetAssets(Filter, OutAssets);
+	OutAssets.Sort([](const FAssetData& A, const FAssetData& B) { return A.PackageName.LexicalLess(B.PackageName); });
+}
+
+void FValidatorXManager::ValidateAssets(TConstArrayView<FAssetData> Assets, TConstArrayView<UBlueprintValidatorBase*> InValidators, TArray<FValidatorXAssetReport>& OutReports, const FValidatorXBatchOptions& Options)
+{
+	check(IsInGameThread());
+
+	OutReports.Reset(Assets.Num());
+	const int32 ChunkSize = FMath::Max(Options.ChunkSize, 1);
+
+	BeginValidationRun();
+
+	if (Options.bUseResultCache)
+	{
+		ResultCache.Load();
+		ResultCache.ResetPackageHashes();
+		ResultCache.ResetStats();
+	}
+
+	for (int32 ChunkStart = 0; ChunkStart < Assets.Num(); ChunkStart += ChunkSize)
+	{
+		ValidateAssetChunk(Assets.Slice(ChunkStart, FMath::Min(ChunkSize, Assets.Num() - ChunkStart)), InValidators, OutReports, Options);
+	}
+
+	if (Options.bUseResultCache)
+	{
+		ResultCache.Save();
+	}
+
+	EndValidationRun();
+}
+
+TSharedRef<FValidatorXValidationJob> FValidatorXManager::StartValidationJob(TArray<FAssetData> Assets, const FValidatorXBatchOptions& Options)
+{
+	check(IsInGameThread());
+
+	if (ValidationJob.IsValid())
+	{
+		ValidationJob->Cancel();
+	}
+
+	const TSharedRef<FValidatorXValidationJob> Job = MakeShared<FValidatorXValidationJob>(MoveTemp(Assets), GetEnabledValidators(), Options);
+	ValidationJob = Job;
+	Job->Start();
+	return Job;
+}
+
+void FValidatorXManager::ValidateAssetChunk(TConstArrayView<FAssetData> Assets, TConstArrayView<UBlueprintValidatorBase*> InValidators, TArray<FValidatorXAssetReport>& OutReports, const FValidatorXBatchOptions& Options)
+{
+	check(IsInGameThread());
+	check(ValidationRunDepth > 0);
+
+	const int32 NumValidators = InValidators.Num();
+	const int32 NumChunkAssets = Assets.Num();
+	const int32 FirstReport = OutReports.Num();
+
+	/** Snapshot analysis of one asset by one validator. */
+	struct FAnalysisJob
+	{
+		int32 ValidatorIndex = INDEX_NONE;
+		TSharedPtr<const FBlueprintSnapshot> Snapshot;
+		TArray<FValidatorXIssue> Issues;
+		uint64 Cycles = 0;
+	};
+
+	/** State of one validator on one asset of the chunk. */
+	struct FValidatorSlot
+	{
+		int32 JobIndex = INDEX_NONE;
+		bool bHasInputsHash = false;
+		bool bIsCached = false;
+		FSHAHash InputsHash;
+		EDataValidationResult CachedResult = EDataValidationResult::NotValidated;
+		TArray<FValidatorXMessage> CachedMessages;
+	};
+
+	TArray<TStrongObjectPtr<UBlueprint>> Blueprints;
+	TArray<FDataValidationContext> Contexts;
+	TArray<FAnalysisJob> Jobs;
+	TArray<FValidatorSlot> Slots;
+	Blueprints.Reserve(NumChunkAssets);
+	Contexts.Reserve(NumChunkAssets);
+	Slots.SetNum(NumChunkAssets * NumValidators);
+
+	// Cache lookup, load and snapshot phase, game thread
+	for (int32 ChunkIndex = 0; ChunkIndex < NumChunkAssets; ++ChunkIndex)
+	{
+		FValidatorXAssetReport& Report = OutReports.AddDefaulted_GetRef();
+		Report.AssetData = Assets[ChunkIndex];
+		FDataValidationContext& Context = Contexts.Emplace_GetRef();
+
+		bool bNeedsLoad = !Options.bUseResultCache;
+		if (Options.bUseResultCache)
+		{
+			for (int32 ValidatorIndex = 0; ValidatorIndex < NumValidators; ++ValidatorIndex)
+			{
+				UBlueprintValidatorBase* const Validator = InValidators[ValidatorIndex];
+				FValidatorSlot& Slot = Slots[ChunkIndex * NumValidators + ValidatorIndex];
+
+				Slot.bHasInputsHash = ResultCache.ComputeInputsHash(Report.AssetData.PackageName, *Validator, Slot.InputsHash);
+				const FValidatorXResultCache::FEntry* const Entry = Slot.bHasInputsHash
+					? ResultCache.Find(Report.AssetData.PackageName, Validator->GetClass()->GetFName(), Slot.InputsHash)
+					: nullptr;
+				if (Entry)
+				{
+					Slot.bIsCached = true;
+					Slot.CachedResult = Entry->Result;
+					FValidatorXResultCache::ReplayMessages(*Entry, Report.AssetData, Validator->GetClass()->GetFName(), Slot.CachedMessages);
+				}
+				else
+				{
+					bNeedsLoad = true;
+				}
+			}
+		}
+
+		if (!bNeedsLoad)
+		{
+			ResultCache.AddSkippedLoad();
+			Blueprints.Emplace(nullptr);
+			continue;
+		}
+
+		UBlueprint* const Blueprint = Cast<UBlueprint>(Report.AssetData.GetAsset());
+		Blueprints.Emplace(Blueprint);
+
+		if (!Blueprint)
+		{
+			continue;
+		}
+
+		TSharedPtr<const FBlueprintSnapshot> Snapshot;
+		for (int32 ValidatorIndex = 0; ValidatorIndex < NumValidators; ++ValidatorIndex)
+		{
+			UBlueprintValidatorBase* const Validator = InValidators[ValidatorIndex];
+			FValidatorSlot& Slot = Slots[ChunkIndex * NumValidators + ValidatorIndex];
+			if (Slot.bIsCached || !Validator->SupportsSnapshotAnalysis() || !Validator->CanValidateAsset(Report.AssetData, Blueprint, Context))
+			{
+				continue;
+			}
+
+			if (!Snapshot.IsValid())
+			{
+				Snapshot = GetSnapshot(Blueprint);
+			}
+
+			Slot.JobIndex = Jobs.Num();
+			Jobs.Add(FAnalysisJob{ValidatorIndex, Snapshot});
+		}
+	}
+
+	// Analysis phase, worker threads
+	ParallelFor(Jobs.Num(), [&Jobs, InValidators](int32 JobIndex)
+	{
+		FAnalysisJob& Job = Jobs[JobIndex];
+		const UBlueprintValidatorBase* const Validator = InValidators[Job.ValidatorIndex];
+		TRACE_CPUPROFILER_EVENT_SCOPE_TEXT(*Validator->GetClass()->GetName());
+
+		const uint64 StartCycles = FPlatformTime::Cycles64();
+		Validator->AnalyzeSnapshot(*Job.Snapshot, Job.Issues);
+		Job.Cycles = FPlatformTime::Cycles64() - StartCycles;
+	});
+
+	// Commit phase, game thread
+	for (int32 ChunkIndex = 0; ChunkIndex < NumChunkAssets; ++ChunkIndex)
+	{
+		UBlueprint* const Blueprint = Blueprints[ChunkIndex].Get();
+		FValidatorXAssetReport& Report = OutReports[FirstReport + ChunkIndex];
+		FDataValidationContext& Context = Contexts[ChunkIndex];
+
+		for (int32 ValidatorIndex = 0; ValidatorIndex < NumValidators; ++ValidatorIndex)
+		{
+			UBlueprintValidatorBase* const Validator = InValidators[ValidatorIndex];
+			const FName ValidatorName = Validator->GetClass()->GetFName();
+			FValidatorSlot& Slot = Slots[ChunkIndex * NumValidators + ValidatorIndex];
+
+			if (Slot.bIsCached)
+			{
+				Report.Result = CombineDataValidationResults(Report.Result, Slot.CachedResult);
+				Report.Messages.Append(MoveTemp(Slot.CachedMessages));
+				continue;
+			}
+
+			if (!Blueprint)
+			{
+				continue;
+			}
+
+			const int32 NumIssuesBefore = Context.GetIssues().Num();
+			const int32 NumMessagesBefore = Report.Messages.Num();
+
+			EDataValidationResult Result = EDataValidationResult::NotValidated;
+			TArray<FValidatorXIssue> CommittedIssues;
+			if (Slot.JobIndex != INDEX_NONE)
+			{
+				const FAnalysisJob& Job = Jobs[Slot.JobIndex];
+				const uint64 StartCycles = FPlatformTime::Cycles64();
+				Result = Validator->CommitIssues(Blueprint, Job.Issues, Context, &CommittedIssues, !Options.bDeferIssueTokens);
+
+				// Validators running through ValidateLoadedAsset record their own stats
+				const uint64 Cycles = Job.Cycles + FPlatformTime::Cycles64() - StartCycles;
+				Stats.Record(ValidatorName, Report.AssetData.GetSoftObjectPath(), Cycles, Context.GetIssues().Num() - NumIssuesBefore);
+			}
+			else if (!Validator->SupportsSnapshotAnalysis() && Validator->CanValidateAsset(Report.AssetData, Blueprint, Context))
+			{
+				Result = Validator->ValidateLoadedAsset(Report.AssetData, Blueprint, Context);
+			}
+
+			Report.Result = CombineDataValidationResults(Report.Result, Result);
+
+			FValidatorXMessage::AppendFromContext(Context, NumIssuesBefore, ValidatorName, Report.Messages);
+
+			// Committed issues map one to one to the messages they were committed as
+			for (int32 IssueIndex = 0; IssueIndex < CommittedIssues.Num(); ++IssueIndex)
+			{
+				Report.Messages[NumMessagesBefore + IssueIndex].Issue = MakeShared<const FValidatorXIssue>(MoveTemp(CommittedIssues[IssueIndex]));
+			}
+
+			if (Slot.bHasInputsHash)
+			{
+				const TConstArrayView<FValidatorXMessage> NewMessages = MakeArrayView(Report.Messages).RightChop(NumMessagesBefore);
+				ResultCache.Store(Report.AssetData.PackageName, ValidatorName, Slot.InputsHash, Result, NewMessages);
+			}
+		}
+	}
+}
@@ -3,3 +3,15 @@
 
 #include "ValidatorXTypes.h"
 
+void FValidatorXMessage::AppendFromContext(const FDataValidationContext& Context, int32 FirstIssue, FName InValidatorName, TArray<FValidatorXMessage>& OutMessages)
+{
+	const TConstArrayView<FDataValidationContext::FIssue> Issues = Context.GetIssues();
+	for (int32 IssueIndex = FirstIssue; IssueIndex < Issues.Num(); ++IssueIndex)
+	{
+		const FDataValidationContext::FIssue& Issue = Issues[IssueIndex];
+		const TSharedRef<FTokenizedMessage> Message = Issue.TokenizedMessage.IsValid()
+														  ? Issue.TokenizedMessage.ToSharedRef()
+														  : FTokenizedMessage::Create(Issue.Severity, Issue.Message);
+		OutMessages.Add(FValidatorXMessage{InValidatorName, Message});
+	}
+}
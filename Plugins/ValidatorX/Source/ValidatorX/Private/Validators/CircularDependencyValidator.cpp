@@ -3,8 +3,6 @@
 
 #include "Validators/CircularDependencyValidator.h"
 #include "EdGraph/EdGraph.h"
-#include "K2Node_CallFunction.h"
-#include "K2Node_MacroInstance.h"
 #include "Kismet2/BlueprintEditorUtils.h"
 #include "Editor/EditorEngine.h"
 #include "Subsystems/AssetEditorSubsystem.h"
@@ -12,8 +10,12 @@
 #include "EdGraphSchema_K2.h"
 #include "Misc/DataValidation.h"
 #include "BlueprintEditor.h"
+#include "Analysis/BlueprintSnapshot.h"
+#include "Library/BPUtilsNodeFunctionLibrary.h"
+#include "ValidatorXTypes.h"
+#include "Stats/ValidatorXStats.h"
 
-UEdGraph* UCircularDependencyValidator::FindGraphByName(UBlueprint* Blueprint, const FName& GraphName)
+UEdGraph* UCircularDependencyValidator::FindGraphByName(UBlueprint* Blueprint, const FName& GraphName) const
 {
 	auto FindInArray = [&GraphName] (const TArray<UEdGraph*>& Graphs) -> UEdGraph*
 		{
@@ -65,121 +67,236 @@ bool UCircularDependencyValidator::CanValidateAsset_Implementation(const FAssetD
 
 EDataValidationResult UCircularDependencyValidator::ValidateLoadedAsset_Implementation(const FAssetData& InAssetData, UObject* InAsset, FDataValidationContext& Context)
 {
+	VALIDATORX_SCOPE_VALIDATE(InAssetData, Context);
 	bIsError = false;
 
-	if(UBlueprint* Blueprint = Cast<UBlueprint>(InAsset))
+	UBlueprint* Blueprint = Cast<UBlueprint>(InAsset);
+	if(!Blueprint)
 	{
-		if(HasCircularDependency(Blueprint, Context))
+		return EDataValidationResult::Valid;
+	}
+
+	if(!bFollowExternalCalls)
+	{
+		return ValidateSnapshot(Blueprint, Context);
+	}
+
+	// Capture the loaded Blueprints reachable through calls, breadth first
+	TArray<TSharedRef<const FBlueprintSnapshot>> Snapshots;
+	Snapshots.Add(GetSnapshot(Blueprint));
+	TSet<FName> VisitedPackages;
+	VisitedPackages.Add(Snapshots[0]->PackageName);
+
+	for(int32 SnapshotIndex = 0; SnapshotIndex < Snapshots.Num(); ++SnapshotIndex)
+	{
+		const TSharedRef<const FBlueprintSnapshot> Snapshot = Snapshots[SnapshotIndex];
+		for(const FBlueprintSnapshotNode& Node : Snapshot->Nodes)
 		{
-			bIsError = true;
+			if(Node.Kind != EValidatorXNodeKind::CallFunction && Node.Kind != EValidatorXNodeKind::MacroInstance) continue;
+			if(Node.MemberPackage.IsNone()) continue;
+
+			bool bIsAlreadyVisited = false;
+			VisitedPackages.Add(Node.MemberPackage, &bIsAlreadyVisited);
+			if(bIsAlreadyVisited) continue;
+
+			if(UBlueprint* CalledBlueprint = UBPUtilsNodeFunctionLibrary::FindLoadedBlueprint(Node.MemberPackage))
+			{
+				Snapshots.Add(GetSnapshot(CalledBlueprint));
+			}
 		}
 	}
 
-	return bIsError ? EDataValidationResult::Invalid : EDataValidationResult::Valid;
+	TArray<const FBlueprintSnapshot*> SnapshotPtrs;
+	for(const TSharedRef<const FBlueprintSnapshot>& Snapshot : Snapshots)
+	{
+		SnapshotPtrs.Add(&Snapshot.Get());
+	}
+
+	TArray<FValidatorXIssue> Issues;
+	AnalyzeCallGraph(SnapshotPtrs, Issues);
+	return CommitIssues(Blueprint, Issues, Context);
+}
+
+void UCircularDependencyValidator::AnalyzeSnapshot(const FBlueprintSnapshot& Snapshot, TArray<FValidatorXIssue>& OutIssues) const
+{
+	const FBlueprintSnapshot* Snapshots[] = {&Snapshot};
+	AnalyzeCallGraph(Snapshots, OutIssues);
 }
 
-bool UCircularDependencyValidator::HasCircularDependency(UBlueprint* Blueprint, FDataValidationContext& Context)
+void UCircularDependencyValidator::AnalyzeCallGraph(TConstArrayView<const FBlueprintSnapshot*> Snapshots, TArray<FValidatorXIssue>& OutIssues)
 {
-	TMap<FName, TArray<FName>> CallGraph;
+	// 1. Dense ids, one per function and macro graph
+	struct FCallVertex
+	{
+		int32 Snapshot;
+		int32 Graph;
+	};
 
-	auto CollectGraphCalls = [&] (const TArray<UEdGraph*>& Graphs)
+	TArray<FCallVertex> Vertices;
+	TMap<TPair<FName, FName>, int32> VertexIds;
+
+	for(int32 SnapshotIndex = 0; SnapshotIndex < Snapshots.Num(); ++SnapshotIndex)
+	{
+		const FBlueprintSnapshot& Snapshot = *Snapshots[SnapshotIndex];
+		for(int32 GraphIndex = 0; GraphIndex < Snapshot.Graphs.Num(); ++GraphIndex)
 		{
-			for(UEdGraph* Graph : Graphs)
-			{
-				if(!Graph) continue;
+			const FBlueprintSnapshotGraph& Graph = Snapshot.Graphs[GraphIndex];
+			if(Graph.Type != EValidatorXGraphType::Function && Graph.Type != EValidatorXGraphType::Macro) continue;
 
-				FName ThisGraphName = Graph->GetFName();
-				TArray<FName>& Called = CallGraph.FindOrAdd(ThisGraphName);
+			VertexIds.Add(TPair<FName, FName>(Snapshot.PackageName, Graph.Name), Vertices.Add(FCallVertex{SnapshotIndex, GraphIndex}));
+		}
+	}
 
-				for(UEdGraphNode* Node : Graph->Nodes)
-				{
-					if(UK2Node_CallFunction* CallFunction = Cast<UK2Node_CallFunction>(Node))
-					{
-						Called.Add(CallFunction->FunctionReference.GetMemberName());
-					}
-					else if(UK2Node_MacroInstance* Macro = Cast<UK2Node_MacroInstance>(Node))
-					{
-						Called.Add(Macro->GetMacroGraph()->GetFName());
-					}
-				}
-			}
-		};
+	const int32 NumVertices = Vertices.Num();
 
-	CollectGraphCalls(Blueprint->FunctionGraphs);
-	CollectGraphCalls(Blueprint->MacroGraphs);
+	// 2. Call edges, stored contiguously per vertex
+	TArray<int32> FirstEdge;
+	TArray<int32> Edges;
+	FirstEdge.Reserve(NumVertices + 1);
 
-	for(const auto& Pair : CallGraph)
+	for(const FCallVertex& Vertex : Vertices)
 	{
-		const FName& Start = Pair.Key;
-		TSet<FName> Visited;
-		TSet<FName> Stack;
-		TArray<FName> CyclePath;
+		FirstEdge.Add(Edges.Num());
 
-		if(DetectCycle(Start, CallGraph, Visited, Stack, CyclePath))
+		const FBlueprintSnapshot& Snapshot = *Snapshots[Vertex.Snapshot];
+		for(const FBlueprintSnapshotNode& Node : Snapshot.GetNodes(Vertex.Graph))
 		{
-			FString CycleStr = FString::JoinBy(CyclePath, TEXT(" - "), [] (const FName& Name) { return Name.ToString(); });
-			const FText MessageText = FText::FromString(FString::Printf(TEXT("Circular call detected: %s"), *CycleStr));
+			if(Node.Kind != EValidatorXNodeKind::CallFunction && Node.Kind != EValidatorXNodeKind::MacroInstance) continue;
+			if(Node.MemberName.IsNone()) continue;
 
-			TSharedRef<FTokenizedMessage> Message = Context.AddMessage(EMessageSeverity::Error, MessageText);
-			if(UEdGraph* TargetGraph = FindGraphByName(Blueprint, CyclePath[0]))
+			const FName CalledPackage = Node.MemberPackage.IsNone() ? Snapshot.PackageName : Node.MemberPackage;
+			if(const int32* CalledVertex = VertexIds.Find(TPair<FName, FName>(CalledPackage, Node.MemberName)))
 			{
-				Message->AddToken(FActionToken::Create(
-					FText::FromString("Jump to graph"),
-					FText::FromString("Opens the first function or macro involved in the circular call"),
-					FSimpleDelegate::CreateLambda([Blueprint, TargetGraph] ()
-						{
-							if(UAssetEditorSubsystem* Subsystem = GEditor->GetEditorSubsystem<UAssetEditorSubsystem>())
-							{
-								Subsystem->OpenEditorForAsset(Blueprint);
-								if(IAssetEditorInstance* EditorInstance = Subsystem->FindEditorForAsset(Blueprint, false))
-								{
-									if(IBlueprintEditor* BPEditor = StaticCast<IBlueprintEditor*>(EditorInstance))
-									{
-										BPEditor->OpenGraphAndBringToFront(TargetGraph, true);
-									}
-								}
-							}
-						})
-				));
+				Edges.Add(*CalledVertex);
 			}
-
-			return true;
 		}
 	}
+	FirstEdge.Add(Edges.Num());
 
-	return false;
-}
-
-bool UCircularDependencyValidator::DetectCycle(const FName& StartName, TMap<FName, TArray<FName>>& GraphMap, TSet<FName>& Visited, TSet<FName>& Stack, TArray<FName>& OutCyclePath)
-{
-	if(Stack.Contains(StartName))
+	// 3. Tarjan's strongly connected components, iterative so deep call chains cannot overflow the stack
+	struct FVisitFrame
 	{
-		OutCyclePath.Add(StartName);
-		return true;
-	}
+		int32 Vertex;
+		int32 NextEdge;
+	};
 
-	if(Visited.Contains(StartName))
-	{
-		return false;
-	}
+	TArray<int32> VisitIndex;
+	TArray<int32> LowLink;
+	TArray<bool> bIsOnStack;
+	VisitIndex.Init(INDEX_NONE, NumVertices);
+	LowLink.Init(0, NumVertices);
+	bIsOnStack.Init(false, NumVertices);
 
-	Visited.Add(StartName);
-	Stack.Add(StartName);
+	TArray<int32> ComponentStack;
+	TArray<FVisitFrame> VisitStack;
+	TArray<TArray<int32>> Cycles;
+	int32 NextVisitIndex = 0;
+
+	auto Visit = [&](int32 Vertex)
+		{
+			VisitIndex[Vertex] = LowLink[Vertex] = NextVisitIndex++;
+			ComponentStack.Push(Vertex);
+			bIsOnStack[Vertex] = true;
+			VisitStack.Push(FVisitFrame{Vertex, FirstEdge[Vertex]});
+		};
 
-	if(TArray<FName>* CalledList = GraphMap.Find(StartName))
+	for(int32 Root = 0; Root < NumVertices; ++Root)
 	{
-		for(const FName& Next : *CalledList)
+		if(VisitIndex[Root] != INDEX_NONE) continue;
+
+		Visit(Root);
+		while(!VisitStack.IsEmpty())
 		{
-			if(DetectCycle(Next, GraphMap, Visited, Stack, OutCyclePath))
+			FVisitFrame& Frame = VisitStack.Last();
+			const int32 Vertex = Frame.Vertex;
+
+			if(Frame.NextEdge < FirstEdge[Vertex + 1])
+			{
+				const int32 Called = Edges[Frame.NextEdge++];
+				if(VisitIndex[Called] == INDEX_NONE)
+				{
+					Visit(Called);
+				}
+				else if(bIsOnStack[Called])
+				{
+					LowLink[Vertex] = FMath::Min(LowLink[Vertex], VisitIndex[Called]);
+				}
+				continue;
+			}
+
+			VisitStack.Pop();
+			if(!VisitStack.IsEmpty())
 			{
-				OutCyclePath.Insert(StartName, 0);
-				return true;
+				const int32 Caller = VisitStack.Last().Vertex;
+				LowLink[Caller] = FMath::Min(LowLink[Caller], LowLink[Vertex]);
+			}
+
+			if(LowLink[Vertex] != VisitIndex[Vertex]) continue;
+
+			TArray<int32> Component;
+			int32 Member;
+			do
+			{
+				Member = ComponentStack.Pop();
+				bIsOnStack[Member] = false;
+				Component.Add(Member);
+			}
+			while(Member != Vertex);
+
+			const bool bIsRecursive = Component.Num() > 1
+				|| MakeArrayView(Edges).Slice(FirstEdge[Vertex], FirstEdge[Vertex + 1] - FirstEdge[Vertex]).Contains(Vertex);
+			if(bIsRecursive)
+			{
+				Component.Sort();
+				Cycles.Add(MoveTemp(Component));
 			}
 		}
 	}
 
-	Stack.Remove(StartName);
-	return false;
-}
+	// 4. One issue per cycle group involving the validated Blueprint, in graph order
+	Cycles.Sort([](const TArray<int32>& A, const TArray<int32>& B) { return A[0] < B[0]; });
+
+	for(const TArray<int32>& Cycle : Cycles)
+	{
+		// Vertices of the validated Blueprint come first
+		if(Vertices[Cycle[0]].Snapshot != 0) continue;
 
+		FString CycleStr = FString::JoinBy(Cycle, TEXT(" - "), [&Vertices, Snapshots] (int32 VertexId)
+			{
+				const FCallVertex& Vertex = Vertices[VertexId];
+				const FBlueprintSnapshot& Snapshot = *Snapshots[Vertex.Snapshot];
+				const FName GraphName = Snapshot.Graphs[Vertex.Graph].Name;
+				return Vertex.Snapshot == 0 ? GraphName.ToString() : FString::Printf(TEXT("%s.%s"), *Snapshot.BlueprintName.ToString(), *GraphName.ToString());
+			});
 
+		FValidatorXIssue& Issue = OutIssues.Emplace_GetRef(EMessageSeverity::Error,
+			INVTEXT("Circular call detected: {0}"),
+			FFormatOrderedArguments{FText::FromString(MoveTemp(CycleStr))});
+		Issue.GraphName = Snapshots[0]->Graphs[Vertices[Cycle[0]].Graph].Name;
+	}
+}
+
+void UCircularDependencyValidator::AddIssueTokens(UBlueprint* Blueprint, const FValidatorXIssue& Issue, const TSharedRef<FTokenizedMessage>& Message) const
+{
+	if(UEdGraph* TargetGraph = FindGraphByName(Blueprint, Issue.GraphName))
+	{
+		Message->AddToken(FActionToken::Create(
+			FText::FromString("Jump to graph"),
+			FText::FromString("Opens the first function or macro involved in the circular call"),
+			FSimpleDelegate::CreateLambda([Blueprint, TargetGraph] ()
+				{
+					if(UAssetEditorSubsystem* Subsystem = GEditor->GetEditorSubsystem<UAssetEditorSubsystem>())
+					{
+						Subsystem->OpenEditorForAsset(Blueprint);
+						if(IAssetEditorInstance* EditorInstance = Subsystem->FindEditorForAsset(Blueprint, false))
+						{
+							if(IBlueprintEditor* BPEditor = StaticCast<IBlueprintEditor*>(EditorInstance))
+							{
+								BPEditor->OpenGraphAndBringToFront(TargetGraph, true);
+							}
+						}
+					}
+				})
+		));
+	}
+}
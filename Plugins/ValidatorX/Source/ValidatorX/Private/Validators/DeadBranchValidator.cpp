@@ -3,15 +3,16 @@
 
 #include "Validators/DeadBranchValidator.h"
 
-#include "K2Node_IfThenElse.h"
-#include "K2Node_VariableGet.h"
-#include "K2Node_VariableSet.h"
 #include "EdGraph/EdGraph.h"
-#include "Kismet2/BlueprintEditorUtils.h"
+#include "EdGraphSchema_K2.h"
 #include "Kismet2/BlueprintEditorUtils.h"
 #include "Misc/DataValidation.h"
 #include "SMyBlueprint.h"
-#include "Library/BPUtilsNodeFunctionLibrary.h"
+#include "Analysis/BlueprintConstantFolder.h"
+#include "Analysis/BlueprintSnapshot.h"
+#include "ValidatorXManager.h"
+#include "ValidatorXTypes.h"
+#include "Stats/ValidatorXStats.h"
 #define LOCTEXT_NAMESPACE "ValidatorX"
 
 
@@ -35,162 +36,140 @@ bool UDeadBranchValidator::CanValidateAsset_Implementation(const FAssetData& InA
 
 EDataValidationResult UDeadBranchValidator::ValidateLoadedAsset_Implementation(const FAssetData& InAssetData, UObject* InAsset, FDataValidationContext& Context)
 {
+	VALIDATORX_SCOPE_VALIDATE(InAssetData, Context);
 	bIsError = false;
 
 	if(UBlueprint* Blueprint = Cast<UBlueprint>(InAsset))
 	{
-		TArray<UEdGraph*> Graphs;
-		Blueprint->GetAllGraphs(Graphs);
+		FValidatorXManager& Manager = FValidatorXManager::Get();
+
+		TArray<FValidatorXIssue> Issues;
+		FindDeadBranches(*GetSnapshot(Blueprint), *Manager.GetVariableWrites(Blueprint), Issues);
+		return CommitIssues(Blueprint, Issues, Context);
+	}
 
-		for(UEdGraph* Graph : Graphs)
+	return EDataValidationResult::Valid;
+}
+
+void UDeadBranchValidator::FindDeadBranches(const FBlueprintSnapshot& Snapshot, const FValidatorXVariableWrites& VariableWrites, TArray<FValidatorXIssue>& OutIssues)
+{
+	FBlueprintConstantFolder Folder(Snapshot, [&VariableWrites](const FBlueprintSnapshotVariable& Variable)
 		{
-			if(!Graph) continue;
+			// Values set per instance, by the engine or from outside of the Blueprint graphs are not constant
+			if(Variable.PropertyFlags & (CPF_ExposeOnSpawn | CPF_Config | CPF_Interp | CPF_Net | CPF_SaveGame)) return false;
+			if((Variable.PropertyFlags & CPF_Edit) && !(Variable.PropertyFlags & CPF_DisableEditOnInstance)) return false;
 
-			for(UEdGraphNode* Node : Graph->Nodes)
+			return VariableWrites.Declared.Contains(Variable.Name) && !VariableWrites.Written.Contains(Variable.Name);
+		});
+
+	for(int32 NodeIndex = 0; NodeIndex < Snapshot.Nodes.Num(); ++NodeIndex)
+	{
+		const FBlueprintSnapshotNode& Branch = Snapshot.Nodes[NodeIndex];
+		if(Branch.Kind != EValidatorXNodeKind::Branch) continue;
+
+		const int32 CondIndex = Snapshot.FindPinIndex(NodeIndex, UEdGraphSchema_K2::PN_Condition);
+		if(CondIndex == INDEX_NONE) continue;
+
+		const FBlueprintSnapshotPin& Cond = Snapshot.Pins[CondIndex];
+		FString Info;
+
+		// Case 1: Literal condition
+		// Case 2: Condition folded from literals, operators and variables that are never set
+		if(const TOptional<double> Value = Folder.FoldInput(CondIndex))
+		{
+			const TCHAR* const ValueText = *Value != 0.0 ? TEXT("true") : TEXT("false");
+			Info = Cond.NumLinks == 0
+				? FString::Printf(TEXT("Branch with literal condition '%s'"), ValueText)
+				: FString::Printf(TEXT("Branch condition is always '%s', it only depends on literals and variables that are never set in this Blueprint or its parents"), ValueText);
+		}
+
+		// Case 3: No logic on Then/Else
+		if(Info.IsEmpty())
+		{
+			const FBlueprintSnapshotPin* ThenPin = Snapshot.FindPin(NodeIndex, UEdGraphSchema_K2::PN_Then);
+			const FBlueprintSnapshotPin* ElsePin = Snapshot.FindPin(NodeIndex, UEdGraphSchema_K2::PN_Else);
+			if((!ThenPin || ThenPin->NumLinks == 0) && (!ElsePin || ElsePin->NumLinks == 0))
 			{
-				if(UK2Node_IfThenElse* Branch = Cast<UK2Node_IfThenElse>(Node))
-				{
-					UEdGraphPin* Cond = Branch->GetConditionPin();
-					if(!Cond) continue;
+				Info = TEXT("Branch has no execution logic on either output (Then/Else not connected)");
+			}
+		}
 
-					bool bIsDead = false;
-					FString Info;
+		if(Info.IsEmpty()) continue;
 
-					// Case 1: Literal condition
-					if(Cond->LinkedTo.Num() == 0)
-					{
-						if(Cond->DefaultValue == "true" || Cond->DefaultValue == "false")
-						{
-							bIsDead = true;
-							Info = FString::Printf(TEXT("Branch with literal condition '%s'"), *Cond->DefaultValue);
-						}
-					}
+		const FName GraphName = Snapshot.Graphs[Branch.Graph].Name;
+		FValidatorXIssue& Issue = OutIssues.Emplace_GetRef(EMessageSeverity::Warning,
+			LOCTEXT("DeadBranch", "Dead branch detected in Graph '{0}': {1}"),
+			FFormatOrderedArguments{FText::FromName(GraphName), FText::FromString(Info)});
+		Issue.GraphName = GraphName;
+		Issue.NodeGuid = Branch.Guid;
+	}
+}
+
+void UDeadBranchValidator::AddIssueTokens(UBlueprint* Blueprint, const FValidatorXIssue& Issue, const TSharedRef<FTokenizedMessage>& Message) const
+{
+	UEdGraph* Graph = FindIssueGraph(Blueprint, Issue);
+	UEdGraphNode* Node = FindIssueNode(Blueprint, Issue);
+	if(!Graph || !Node) return;
+
+	// Action: Jump to node
+	Message->AddToken(FActionToken::Create(
+		INVTEXT("Jump to Branch"),
+		FText::GetEmpty(),
+		FSimpleDelegate::CreateLambda([=]
+			{
+				if(Blueprint && Graph && Node)
+				{
+					UAssetEditorSubsystem* AssetEditorSubsystem = GEditor->GetEditorSubsystem<UAssetEditorSubsystem>();
+					AssetEditorSubsystem->OpenEditorForAsset(Blueprint);
 
-					// Case 2: Variable condition (unused)
-					else if(Cond->LinkedTo.Num() == 1)
+					if(IAssetEditorInstance* EditorInstance = AssetEditorSubsystem->FindEditorForAsset(Blueprint, false))
 					{
-						if(UK2Node_VariableGet* GetNode = Cast<UK2Node_VariableGet>(Cond->LinkedTo[0]->GetOwningNode()))
+						if(FBlueprintEditor* BPEditor = StaticCast<FBlueprintEditor*>(EditorInstance))
 						{
-							FName VarName = GetNode->GetVarName();
-							FString SourceInfo;
-							bool bFoundSet = UBPUtilsNodeFunctionLibrary::IsBoolVariableSetInThisOrParentBPs(Blueprint, VarName, &SourceInfo);
-
-							// Not found in this BP
-							if(!bFoundSet)
+							if(TSharedPtr<SGraphEditor> GraphEditor = BPEditor->OpenGraphAndBringToFront(Graph, true))
 							{
-								bool bCDOValue = false;
-
-								if(UClass* GeneratedClass = Blueprint->GeneratedClass)
-								{
-									if(UObject* CDO = GeneratedClass->GetDefaultObject())
-									{
-										if(FProperty* Property = GeneratedClass->FindPropertyByName(VarName))
-										{
-											if(FBoolProperty* BoolProp = CastField<FBoolProperty>(Property))
-											{
-												bCDOValue = BoolProp->GetPropertyValue_InContainer(CDO);
-											}
-										}
-									}
-								}
-
-								bIsDead = true;
-								Info = FString::Printf(TEXT("Branch with variable '%s' that is never modified in this Blueprint (checked parents). %s"),
-									*VarName.ToString(),
-									SourceInfo.IsEmpty() ? TEXT("No Set found.") : *SourceInfo);
+								GraphEditor->JumpToNode(Node, false);
 							}
 						}
 					}
+				}
+			})
+	));
+
+	// Action: Delete branch node
+	Message->AddToken(FActionToken::Create(
+		FText::FromString(FString::Printf(TEXT("Fix: Delete Branch node in '%s'"), *Graph->GetName())),
+		FText::GetEmpty(),
+		FSimpleDelegate::CreateLambda([=]
+			{
+				if(Blueprint && Graph && Node)
+				{
+					const FText ConfirmText = FText::Format(
+						INVTEXT("Are you sure you want to delete this Branch node from Graph '{0}'?"),
+						FText::FromString(Graph->GetName())
+					);
 
-					// Case 3: No logic on Then/Else
-					auto AreAllBranchExecsDisconnected = [] (UK2Node_IfThenElse* BranchNode)
-						{
-							for(UEdGraphPin* Pin : BranchNode->Pins)
-							{
-								if(Pin->Direction == EGPD_Output && Pin->PinType.PinCategory == UEdGraphSchema_K2::PC_Exec)
-								{
-									if((Pin->PinName == "Then" || Pin->PinName == "Else") && Pin->LinkedTo.Num() > 0)
-									{
-										return false;
-									}
-								}
-							}
-							return true;
-						};
-
-					if(!bIsDead && AreAllBranchExecsDisconnected(Branch))
-					{
-						bIsDead = true;
-						Info = TEXT("Branch has no execution logic on either output (Then/Else not connected)");
-					}
-
-					if(bIsDead)
+					if(FMessageDialog::Open(EAppMsgType::YesNo, ConfirmText) == EAppReturnType::Yes)
 					{
-						const FText Msg = FText::Format(
-							LOCTEXT("DeadBranch", "Dead branch detected in Graph '{0}': {1}"),
-							FText::FromString(Graph->GetName()),
-							FText::FromString(Info)
-						);
-
-						const TSharedRef<FTokenizedMessage> Message = Context.AddMessage(EMessageSeverity::Warning, Msg);
-
-						// Action: Jump to node
-						Message->AddToken(FActionToken::Create(
-							INVTEXT("Jump to Branch"),
-							FText::GetEmpty(),
-							FSimpleDelegate::CreateLambda([=]
-								{
-									if(Blueprint && Graph && Node)
-									{
-										UAssetEditorSubsystem* AssetEditorSubsystem = GEditor->GetEditorSubsystem<UAssetEditorSubsystem>();
-										AssetEditorSubsystem->OpenEditorForAsset(Blueprint);
-
-										if(IAssetEditorInstance* EditorInstance = AssetEditorSubsystem->FindEditorForAsset(Blueprint, false))
-										{
-											if(FBlueprintEditor* BPEditor = StaticCast<FBlueprintEditor*>(EditorInstance))
-											{
-												if(TSharedPtr<SGraphEditor> GraphEditor = BPEditor->OpenGraphAndBringToFront(Graph, true))
-												{
-													GraphEditor->JumpToNode(Node, false);
-												}
-											}
-										}
-									}
-								})
-						));
-
-						// Action: Delete branch node
-						Message->AddToken(FActionToken::Create(
-							FText::FromString(FString::Printf(TEXT("Fix: Delete Branch node in '%s'"), *Graph->GetName())),
-							FText::GetEmpty(),
-							FSimpleDelegate::CreateLambda([=]
-								{
-									if(Blueprint && Graph && Node)
-									{
-										const FText ConfirmText = FText::Format(
-											INVTEXT("Are you sure you want to delete this Branch node from Graph '{0}'?"),
-											FText::FromString(Graph->GetName())
-										);
-
-										if(FMessageDialog::Open(EAppMsgType::YesNo, ConfirmText) == EAppReturnType::Yes)
-										{
-											Graph->RemoveNode(Node);
-											FBlueprintEditorUtils::MarkBlueprintAsStructurallyModified(Blueprint);
-										}
-									}
-								})
-						));
-
-						Node->NodeComment = TEXT("Dead branch detected");
-						Node->bCommentBubbleVisible = true;
-						bIsError = true;
+						Graph->RemoveNode(Node);
+						FBlueprintEditorUtils::MarkBlueprintAsStructurallyModified(Blueprint);
 					}
 				}
-			}
-		}
-	}
+			})
+	));
+
+	Node->NodeComment = TEXT("Dead branch detected");
+	Node->bCommentBubbleVisible = true;
+}
+
+bool UDeadBranchValidator::ApplyIssueFix(UBlueprint* Blueprint, const FValidatorXIssue& Issue) const
+{
+	UEdGraph* Graph = FindIssueGraph(Blueprint, Issue);
+	UEdGraphNode* Node = FindIssueNode(Blueprint, Issue);
+	if(!Graph || !Node || !Graph->Nodes.Contains(Node)) return false;
 
-	return bIsError ? EDataValidationResult::Invalid : EDataValidationResult::Valid;
+	FBlueprintEditorUtils::RemoveNode(Blueprint, Node, /*bDontRecompile=*/true);
+	return true;
 }
 
 
@@ -2,9 +2,11 @@
 
 
 #include "Validators/DefaultAssignmentValidator.h"
-#include "K2Node_VariableSet.h"
 #include "Misc/DataValidation.h"
 #include "BlueprintEditor.h"
+#include "Analysis/BlueprintSnapshot.h"
+#include "ValidatorXTypes.h"
+#include "Stats/ValidatorXStats.h"
 
 UDefaultAssignmentValidator::UDefaultAssignmentValidator()
 {
@@ -24,86 +26,73 @@ bool UDefaultAssignmentValidator::IsEnabled() const
 
 EDataValidationResult UDefaultAssignmentValidator::ValidateLoadedAsset_Implementation(const FAssetData& InAssetData, UObject* InAsset, FDataValidationContext& Context)
 {
+	VALIDATORX_SCOPE_VALIDATE(InAssetData, Context);
 	bIsError = false;
 
 	if(UBlueprint* Blueprint = Cast<UBlueprint>(InAsset))
 	{
-		TArray<UEdGraph*> AllGraphs;
-		Blueprint->GetAllGraphs(AllGraphs);
+		return ValidateSnapshot(Blueprint, Context);
+	}
+
+	return EDataValidationResult::Valid;
+}
+
+void UDefaultAssignmentValidator::AnalyzeSnapshot(const FBlueprintSnapshot& Snapshot, TArray<FValidatorXIssue>& OutIssues) const
+{
+	for(int32 NodeIndex = 0; NodeIndex < Snapshot.Nodes.Num(); ++NodeIndex)
+	{
+		const FBlueprintSnapshotNode& VarSetNode = Snapshot.Nodes[NodeIndex];
+		if(VarSetNode.Kind != EValidatorXNodeKind::VariableSet) continue;
+
+		const FName VarName = VarSetNode.MemberName;
+		const FBlueprintSnapshotVariable* Variable = Snapshot.FindMemberVariable(VarName);
+		if(!Variable || !Variable->bHasProperty)
+		{
+			continue;
+		}
 
-		for(UEdGraph* Graph : AllGraphs)
+		const FBlueprintSnapshotPin* ValuePin = Snapshot.FindPin(NodeIndex, VarName);
+		if(ValuePin && ValuePin->NumLinks == 0 && ValuePin->DefaultValue == Variable->DefaultValue)
 		{
-			for(UEdGraphNode* Node : Graph->Nodes)
+			FValidatorXIssue& Issue = OutIssues.Emplace_GetRef(EMessageSeverity::Warning,
+				INVTEXT("Redundant assignment detected: variable '{0}' in Blueprint '{1}' is assigned its default value."),
+				FFormatOrderedArguments{FText::FromName(VarName), FText::FromName(Snapshot.BlueprintName)});
+			Issue.GraphName = Snapshot.Graphs[VarSetNode.Graph].Name;
+			Issue.NodeGuid = VarSetNode.Guid;
+			Issue.Subject = VarName;
+		}
+	}
+}
+
+void UDefaultAssignmentValidator::AddIssueTokens(UBlueprint* Blueprint, const FValidatorXIssue& Issue, const TSharedRef<FTokenizedMessage>& Message) const
+{
+	UEdGraph* Graph = FindIssueGraph(Blueprint, Issue);
+	UEdGraphNode* VarSetNode = FindIssueNode(Blueprint, Issue);
+	if(!Graph || !VarSetNode)
+	{
+		return;
+	}
+
+	Message->AddToken(FActionToken::Create(FText::FromString("Jump to Node"), FText::GetEmpty(),
+		FSimpleDelegate::CreateLambda([=]
 			{
-				if(UK2Node_VariableSet* VarSetNode = Cast<UK2Node_VariableSet>(Node))
+				if(Blueprint && Graph)
 				{
-					const FName VarName = VarSetNode->GetVarName();
-					const FProperty* Property = FindFProperty<FProperty>(Blueprint->GeneratedClass, VarName);
-					if(!Property)
+					if(UAssetEditorSubsystem* AssetEditorSubsystem = GEditor->GetEditorSubsystem<UAssetEditorSubsystem>())
 					{
-						continue;
-					}
-
-					if(UEdGraphPin* ValuePin = VarSetNode->FindPin(VarName))
-					{
-						if(!ValuePin->HasAnyConnections())
+						AssetEditorSubsystem->OpenEditorForAsset(Blueprint);
+						if(IAssetEditorInstance* EditorInstance = AssetEditorSubsystem->FindEditorForAsset(Blueprint, false))
 						{
-							const FString PinDefaultValue = ValuePin->DefaultValue;
-
-							FString PropertyDefaultValue;
-
-							if(const auto DefaultObjectPtr = Blueprint->GeneratedClass->GetDefaultObject(false))
+							if(IBlueprintEditor* BlueprintEditor = StaticCast<IBlueprintEditor*>(EditorInstance))
 							{
-								FString Temp;
-								Property->ExportText_InContainer(0, Temp, DefaultObjectPtr, DefaultObjectPtr, nullptr, PPF_None);
-								PropertyDefaultValue = Temp;
-							}
-
-							if(PinDefaultValue == PropertyDefaultValue)
-							{
-								const FText MessageText = FText::Format(
-									INVTEXT("Redundant assignment detected: variable '{0}' in Blueprint '{1}' is assigned its default value."),
-									FText::FromString(Graph->GetName()),
-									FText::FromString(Blueprint->GetName())
-								);
-
-								TSharedRef<FTokenizedMessage> Message = Context.AddMessage(EMessageSeverity::Warning, MessageText);
-								Message->AddToken(FActionToken::Create(FText::FromString("Jump to Node"), FText::GetEmpty(),
-									FSimpleDelegate::CreateLambda([=]
-										{
-											if(Blueprint && Graph)
-											{
-												if(UAssetEditorSubsystem* AssetEditorSubsystem = GEditor->GetEditorSubsystem<UAssetEditorSubsystem>())
-												{
-													AssetEditorSubsystem->OpenEditorForAsset(Blueprint);
-													if(IAssetEditorInstance* EditorInstance = AssetEditorSubsystem->FindEditorForAsset(Blueprint, false))
-													{
-														if(IBlueprintEditor* BlueprintEditor = StaticCast<IBlueprintEditor*>(EditorInstance))
-														{
-															if(TSharedPtr<SGraphEditor> GraphEditor = BlueprintEditor->OpenGraphAndBringToFront(Graph, true))
-															{
-																GraphEditor->JumpToNode(VarSetNode, false);
-															}
-														}
-													}
-												}
-											}
-										}))
-								);
-
-
-								bIsError = true;
-
-
-
+								if(TSharedPtr<SGraphEditor> GraphEditor = BlueprintEditor->OpenGraphAndBringToFront(Graph, true))
+								{
+									GraphEditor->JumpToNode(VarSetNode, false);
+								}
 							}
 						}
 					}
 				}
-			}
-		}
-	}
-
-	return bIsError ? EDataValidationResult::Invalid : EDataValidationResult::Valid;
+			}))
+	);
 }
-
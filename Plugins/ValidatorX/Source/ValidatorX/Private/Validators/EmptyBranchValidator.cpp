@@ -2,9 +2,12 @@
 
 
 #include "Validators/EmptyBranchValidator.h"
-#include "K2Node_IfThenElse.h"
+#include "EdGraphSchema_K2.h"
 #include "Misc/DataValidation.h"
 #include "BlueprintEditorModule.h"
+#include "Analysis/BlueprintSnapshot.h"
+#include "ValidatorXTypes.h"
+#include "Stats/ValidatorXStats.h"
 
 UEmptyBranchValidator::UEmptyBranchValidator()
 {
@@ -18,65 +21,72 @@ bool UEmptyBranchValidator::CanValidateAsset_Implementation(const FAssetData& In
 
 EDataValidationResult UEmptyBranchValidator::ValidateLoadedAsset_Implementation(const FAssetData& InAssetData, UObject* InAsset, FDataValidationContext& Context)
 {
+	VALIDATORX_SCOPE_VALIDATE(InAssetData, Context);
 	bIsError = false;
 
 	if(UBlueprint* Blueprint = Cast<UBlueprint>(InAsset))
 	{
-		TArray<UEdGraph*> AllGraphs;
-		Blueprint->GetAllGraphs(AllGraphs);
+		return ValidateSnapshot(Blueprint, Context);
+	}
 
-		for(UEdGraph* Graph : AllGraphs)
-		{
-			for(UEdGraphNode* Node : Graph->Nodes)
-			{
-				if(UK2Node_IfThenElse* Branch = Cast<UK2Node_IfThenElse>(Node))
-				{
-					const UEdGraphPin* ThenPin = Branch->GetThenPin();
-					const UEdGraphPin* ElsePin = Branch->GetElsePin();
+	return EDataValidationResult::Valid;
+}
 
-					const bool bThenUnconnected = ThenPin && ThenPin->LinkedTo.Num() == 0;
-					const bool bElseUnconnected = ElsePin && ElsePin->LinkedTo.Num() == 0;
+void UEmptyBranchValidator::AnalyzeSnapshot(const FBlueprintSnapshot& Snapshot, TArray<FValidatorXIssue>& OutIssues) const
+{
+	for(int32 NodeIndex = 0; NodeIndex < Snapshot.Nodes.Num(); ++NodeIndex)
+	{
+		const FBlueprintSnapshotNode& Branch = Snapshot.Nodes[NodeIndex];
+		if(Branch.Kind != EValidatorXNodeKind::Branch) continue;
 
-					// Only if BOTH branches are not connected
-					if(bThenUnconnected && bElseUnconnected)
-					{
-						const FText MessageText = FText::Format(
-							INVTEXT("Branch node in graph '{0}' has both 'Then' and 'Else' execution pins unconnected."),
-							FText::FromString(Graph->GetName())
-						);
+		const FBlueprintSnapshotPin* ThenPin = Snapshot.FindPin(NodeIndex, UEdGraphSchema_K2::PN_Then);
+		const FBlueprintSnapshotPin* ElsePin = Snapshot.FindPin(NodeIndex, UEdGraphSchema_K2::PN_Else);
 
-						TSharedRef<FTokenizedMessage> Message = Context.AddMessage(EMessageSeverity::Warning, MessageText);
-						Message->AddToken(FActionToken::Create(FText::FromString("Jump to Branch"), FText::GetEmpty(),
-							FSimpleDelegate::CreateLambda([=]
-								{
-									if(Blueprint && Graph)
-									{
-										if(UAssetEditorSubsystem* AssetEditorSubsystem = GEditor->GetEditorSubsystem<UAssetEditorSubsystem>())
-										{
-											AssetEditorSubsystem->OpenEditorForAsset(Blueprint);
-											if(IAssetEditorInstance* EditorInstance = AssetEditorSubsystem->FindEditorForAsset(Blueprint, false))
-											{
-												if(IBlueprintEditor* BlueprintEditor = StaticCast<IBlueprintEditor*>(EditorInstance))
-												{
-													if(TSharedPtr<SGraphEditor> GraphEditor = BlueprintEditor->OpenGraphAndBringToFront(Graph, true))
-													{
-														GraphEditor->JumpToNode(Branch, false);
-													}
-												}
-											}
-										}
-									}
-								}))
-						);
+		const bool bThenUnconnected = ThenPin && ThenPin->NumLinks == 0;
+		const bool bElseUnconnected = ElsePin && ElsePin->NumLinks == 0;
 
-						bIsError = true;
-					}
-				}
-			}
+		// Only if BOTH branches are not connected
+		if(bThenUnconnected && bElseUnconnected)
+		{
+			const FName GraphName = Snapshot.Graphs[Branch.Graph].Name;
+
+			FValidatorXIssue& Issue = OutIssues.Emplace_GetRef(EMessageSeverity::Warning,
+				INVTEXT("Branch node in graph '{0}' has both 'Then' and 'Else' execution pins unconnected."),
+				FFormatOrderedArguments{FText::FromName(GraphName)});
+			Issue.GraphName = GraphName;
+			Issue.NodeGuid = Branch.Guid;
 		}
 	}
+}
 
-	return bIsError ? EDataValidationResult::Invalid : EDataValidationResult::Valid;
+void UEmptyBranchValidator::AddIssueTokens(UBlueprint* Blueprint, const FValidatorXIssue& Issue, const TSharedRef<FTokenizedMessage>& Message) const
+{
+	UEdGraph* Graph = FindIssueGraph(Blueprint, Issue);
+	UEdGraphNode* Branch = FindIssueNode(Blueprint, Issue);
+	if(!Graph || !Branch) return;
+
+	Message->AddToken(FActionToken::Create(FText::FromString("Jump to Branch"), FText::GetEmpty(),
+		FSimpleDelegate::CreateLambda([=]
+			{
+				if(Blueprint && Graph)
+				{
+					if(UAssetEditorSubsystem* AssetEditorSubsystem = GEditor->GetEditorSubsystem<UAssetEditorSubsystem>())
+					{
+						AssetEditorSubsystem->OpenEditorForAsset(Blueprint);
+						if(IAssetEditorInstance* EditorInstance = AssetEditorSubsystem->FindEditorForAsset(Blueprint, false))
+						{
+							if(IBlueprintEditor* BlueprintEditor = StaticCast<IBlueprintEditor*>(EditorInstance))
+							{
+								if(TSharedPtr<SGraphEditor> GraphEditor = BlueprintEditor->OpenGraphAndBringToFront(Graph, true))
+								{
+									GraphEditor->JumpToNode(Branch, false);
+								}
+							}
+						}
+					}
+				}
+			}))
+	);
 }
 
 bool UEmptyBranchValidator::IsEnabled() const
@@ -2,11 +2,12 @@
 
 
 #include "Validators/EmptyFunctionValidator.h"
-#include "K2Node_FunctionEntry.h"
-#include "K2Node_FunctionResult.h"
 #include "Kismet2/BlueprintEditorUtils.h"
 #include "BlueprintEditor.h"
 #include "Misc/DataValidation.h"
+#include "Analysis/BlueprintSnapshot.h"
+#include "ValidatorXTypes.h"
+#include "Stats/ValidatorXStats.h"
 
 UEmptyFunctionValidator::UEmptyFunctionValidator()
 {
@@ -26,109 +27,123 @@ bool UEmptyFunctionValidator::IsEnabled() const
 
 EDataValidationResult UEmptyFunctionValidator::ValidateLoadedAsset_Implementation(const FAssetData& InAssetData, UObject* InAsset, FDataValidationContext& Context)
 {
+	VALIDATORX_SCOPE_VALIDATE(InAssetData, Context);
 	bIsError = false;
 
 	if (UBlueprint* Blueprint = Cast<UBlueprint>(InAsset))
 	{
-		for (UEdGraph* FunctionGraph : Blueprint->FunctionGraphs)
-		{
-			if(!FunctionGraph) continue;
-
-			if(FunctionGraph->GetFName() == UEdGraphSchema_K2::FN_UserConstructionScript) continue;
+		return ValidateSnapshot(Blueprint, Context);
+	}
+	return EDataValidationResult::Valid;
+}
 
-			int32 UsefulNodeCount = 0;
-			for (UEdGraphNode* Node : FunctionGraph->Nodes)
-			{
-				if(!Node) continue;
+void UEmptyFunctionValidator::AnalyzeSnapshot(const FBlueprintSnapshot& Snapshot, TArray<FValidatorXIssue>& OutIssues) const
+{
+	for(int32 GraphIndex = 0; GraphIndex < Snapshot.Graphs.Num(); ++GraphIndex)
+	{
+		const FBlueprintSnapshotGraph& FunctionGraph = Snapshot.Graphs[GraphIndex];
+		if(FunctionGraph.Type != EValidatorXGraphType::Function) continue;
 
-				if (Node->IsA<UK2Node_FunctionEntry>() || Node->IsA<UK2Node_FunctionResult>())
-				{
-					continue;
-				}
+		if(FunctionGraph.Name == UEdGraphSchema_K2::FN_UserConstructionScript) continue;
 
-				UsefulNodeCount++;
+		int32 UsefulNodeCount = 0;
+		for(const FBlueprintSnapshotNode& Node : Snapshot.GetNodes(GraphIndex))
+		{
+			if(Node.Kind == EValidatorXNodeKind::FunctionEntry || Node.Kind == EValidatorXNodeKind::FunctionResult)
+			{
+				continue;
 			}
 
-			if (UsefulNodeCount == 0)
-			{
-				const FText MessageText = FText::Format(
-					INVTEXT("Function '{0}' in Blueprint '{1}' is empty."),
-					FText::FromString(FunctionGraph->GetName()),
-					FText::FromString(Blueprint->GetName()));
+			UsefulNodeCount++;
+		}
 
-				const TSharedRef<FTokenizedMessage> Message = Context.AddMessage(EMessageSeverity::Warning, MessageText);
+		if(UsefulNodeCount == 0)
+		{
+			FValidatorXIssue& Issue = OutIssues.Emplace_GetRef(EMessageSeverity::Warning,
+				INVTEXT("Function '{0}' in Blueprint '{1}' is empty."),
+				FFormatOrderedArguments{FText::FromName(FunctionGraph.Name), FText::FromName(Snapshot.BlueprintName)});
+			Issue.GraphName = FunctionGraph.Name;
+		}
+	}
+}
 
-				const FText JumpToFunctionText = FText::Format(
-					INVTEXT("Jump to Function - '{0}'"),
-					FText::FromString(FunctionGraph->GetName()));
+void UEmptyFunctionValidator::AddIssueTokens(UBlueprint* Blueprint, const FValidatorXIssue& Issue, const TSharedRef<FTokenizedMessage>& Message) const
+{
+	UEdGraph* FunctionGraph = FindIssueGraph(Blueprint, Issue);
+	if(!FunctionGraph) return;
+
+	const FText JumpToFunctionText = FText::Format(
+		INVTEXT("Jump to Function - '{0}'"),
+		FText::FromString(FunctionGraph->GetName()));
 
-				Message->AddToken(FActionToken::Create(JumpToFunctionText, FText::GetEmpty(),
-					FSimpleDelegate::CreateLambda([=]
+	Message->AddToken(FActionToken::Create(JumpToFunctionText, FText::GetEmpty(),
+		FSimpleDelegate::CreateLambda([=]
+			{
+				if(Blueprint && FunctionGraph)
+				{
+					if(UAssetEditorSubsystem* AssetEditorSubsystem = GEditor->GetEditorSubsystem<UAssetEditorSubsystem>())
+					{
+						AssetEditorSubsystem->OpenEditorForAsset(Blueprint);
+						if(IAssetEditorInstance* EditorInstance = AssetEditorSubsystem->FindEditorForAsset(Blueprint, false))
 						{
-							if(Blueprint && FunctionGraph)
+							if(FBlueprintEditor* BlueprintEditor = StaticCast<FBlueprintEditor*>(EditorInstance))
 							{
-								if(UAssetEditorSubsystem* AssetEditorSubsystem = GEditor->GetEditorSubsystem<UAssetEditorSubsystem>())
-								{
-									AssetEditorSubsystem->OpenEditorForAsset(Blueprint);
-									if(IAssetEditorInstance* EditorInstance = AssetEditorSubsystem->FindEditorForAsset(Blueprint, false))
-									{
-										if(FBlueprintEditor* BlueprintEditor = StaticCast<FBlueprintEditor*>(EditorInstance))
-										{
-											BlueprintEditor->OpenGraphAndBringToFront(FunctionGraph, true);
-										}
-									}
-								}
+								BlueprintEditor->OpenGraphAndBringToFront(FunctionGraph, true);
 							}
-						})));
+						}
+					}
+				}
+			})));
 
-				const FText DeleteFunctionText = FText::Format(
-					INVTEXT("'Fix' - Delete Function - '{0}'"),
-					FText::FromString(FunctionGraph->GetName()));
+	const FText DeleteFunctionText = FText::Format(
+		INVTEXT("'Fix' - Delete Function - '{0}'"),
+		FText::FromString(FunctionGraph->GetName()));
 
-				Message->AddToken(FActionToken::Create(DeleteFunctionText, FText::GetEmpty(),
-					FSimpleDelegate::CreateLambda([=]
-						{
-							if(Blueprint && FunctionGraph)
+	Message->AddToken(FActionToken::Create(DeleteFunctionText, FText::GetEmpty(),
+		FSimpleDelegate::CreateLambda([=]
+			{
+				if(Blueprint && FunctionGraph)
+				{
+					if(UAssetEditorSubsystem* AssetEditorSubsystem = GEditor->GetEditorSubsystem<UAssetEditorSubsystem>())
+					{
+						AssetEditorSubsystem->OpenEditorForAsset(Blueprint);
+
+						FTSTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateLambda([=] (float DeltaTime)
 							{
-								if(UAssetEditorSubsystem* AssetEditorSubsystem = GEditor->GetEditorSubsystem<UAssetEditorSubsystem>())
+								if(IAssetEditorInstance* EditorInstance = AssetEditorSubsystem->FindEditorForAsset(Blueprint, /*bFocusIfOpen=*/false))
 								{
-									AssetEditorSubsystem->OpenEditorForAsset(Blueprint);
+									if(FBlueprintEditor* BlueprintEditor = StaticCast<FBlueprintEditor*>(EditorInstance))
+									{
+										const FText ConfirmText = FText::Format(
+											INVTEXT("Are you sure you want to delete the Function '{0}' from Blueprint '{1}'?"),
+											FText::FromString(FunctionGraph->GetName()),
+											FText::FromString(Blueprint->GetName())
+										);
 
-									FTSTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateLambda([=] (float DeltaTime)
+										if(FMessageDialog::Open(EAppMsgType::YesNo, ConfirmText) == EAppReturnType::Yes)
 										{
-											if(IAssetEditorInstance* EditorInstance = AssetEditorSubsystem->FindEditorForAsset(Blueprint, /*bFocusIfOpen=*/false))
-											{
-												if(FBlueprintEditor* BlueprintEditor = StaticCast<FBlueprintEditor*>(EditorInstance))
-												{
-													const FText ConfirmText = FText::Format(
-														INVTEXT("Are you sure you want to delete the Function '{0}' from Blueprint '{1}'?"),
-														FText::FromString(FunctionGraph->GetName()),
-														FText::FromString(Blueprint->GetName())
-													);
-
-													if(FMessageDialog::Open(EAppMsgType::YesNo, ConfirmText) == EAppReturnType::Yes)
-													{
-														Blueprint->Modify();
-														FunctionGraph->Modify();
-
-														Blueprint->FunctionGraphs.Remove(FunctionGraph);
-														FunctionGraph->MarkAsGarbage();
-
-														FBlueprintEditorUtils::MarkBlueprintAsStructurallyModified(Blueprint);
-													}
-												}
-											}
-											return false;
-										}));
+											Blueprint->Modify();
+											FunctionGraph->Modify();
+
+											Blueprint->FunctionGraphs.Remove(FunctionGraph);
+											FunctionGraph->MarkAsGarbage();
+
+											FBlueprintEditorUtils::MarkBlueprintAsStructurallyModified(Blueprint);
+										}
+									}
 								}
-							}
-						})));
-				
-				bIsError = true;
-			}
-		}
-	}
-	return bIsError ? EDataValidationResult::Invalid : EDataValidationResult::Valid;
+								return false;
+							}));
+					}
+				}
+			})));
 }
 
+bool UEmptyFunctionValidator::ApplyIssueFix(UBlueprint* Blueprint, const FValidatorXIssue& Issue) const
+{
+	UEdGraph* FunctionGraph = FindIssueGraph(Blueprint, Issue);
+	if(!FunctionGraph || !Blueprint->FunctionGraphs.Contains(FunctionGraph)) return false;
 
+	FBlueprintEditorUtils::RemoveGraph(Blueprint, FunctionGraph, EGraphRemoveFlags::MarkTransient);
+	return true;
+}
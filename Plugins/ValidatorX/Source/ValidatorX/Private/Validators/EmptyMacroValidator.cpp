@@ -2,12 +2,15 @@
 
 
 #include "Validators/EmptyMacroValidator.h"
-#include "K2Node_Tunnel.h"
 #include "K2Node_MacroInstance.h"
 
 #include "Kismet2/BlueprintEditorUtils.h"
 #include "BlueprintEditor.h"
 #include "Misc/DataValidation.h"
+#include "Analysis/BlueprintGraphIndex.h"
+#include "Analysis/BlueprintSnapshot.h"
+#include "ValidatorXTypes.h"
+#include "Stats/ValidatorXStats.h"
 
 UEmptyMacroValidator::UEmptyMacroValidator()
 {
@@ -27,132 +30,157 @@ bool UEmptyMacroValidator::IsEnabled() const
 
 EDataValidationResult UEmptyMacroValidator::ValidateLoadedAsset_Implementation(const FAssetData& InAssetData, UObject* InAsset, FDataValidationContext& Context)
 {
+	VALIDATORX_SCOPE_VALIDATE(InAssetData, Context);
 	bIsError = false;
 
 	if(UBlueprint* Blueprint = Cast<UBlueprint>(InAsset))
 	{
-		for(UEdGraph* MacroGraph : Blueprint->MacroGraphs)
-		{
-			if(!MacroGraph) continue;
+		return ValidateSnapshot(Blueprint, Context);
+	}
 
-			int32 UsefulNodeCount = 0;
-			for(UEdGraphNode* Node : MacroGraph->Nodes)
-			{
-				if(!Node) continue;
+	return EDataValidationResult::Valid;
+}
 
-				if(Node->IsA<UK2Node_Tunnel>())
-				{
-					continue;
-				}
+void UEmptyMacroValidator::AnalyzeSnapshot(const FBlueprintSnapshot& Snapshot, TArray<FValidatorXIssue>& OutIssues) const
+{
+	for(int32 GraphIndex = 0; GraphIndex < Snapshot.Graphs.Num(); ++GraphIndex)
+	{
+		const FBlueprintSnapshotGraph& MacroGraph = Snapshot.Graphs[GraphIndex];
+		if(MacroGraph.Type != EValidatorXGraphType::Macro) continue;
 
-				UsefulNodeCount++;
+		int32 UsefulNodeCount = 0;
+		for(const FBlueprintSnapshotNode& Node : Snapshot.GetNodes(GraphIndex))
+		{
+			if(Node.bIsTunnel)
+			{
+				continue;
 			}
 
-			if(UsefulNodeCount == 0)
-			{
-				const FText MessageText = FText::Format(
-					INVTEXT("Macro '{0}' in Blueprint '{1}' is empty."),
-					FText::FromString(MacroGraph->GetName()),
-					FText::FromString(Blueprint->GetName()));
+			UsefulNodeCount++;
+		}
 
-				const TSharedRef<FTokenizedMessage> Message = Context.AddMessage(EMessageSeverity::Warning, MessageText);
+		if(UsefulNodeCount == 0)
+		{
+			FValidatorXIssue& Issue = OutIssues.Emplace_GetRef(EMessageSeverity::Warning,
+				INVTEXT("Macro '{0}' in Blueprint '{1}' is empty."),
+				FFormatOrderedArguments{FText::FromName(MacroGraph.Name), FText::FromName(Snapshot.BlueprintName)});
+			Issue.GraphName = MacroGraph.Name;
+		}
+	}
+}
 
-				const FText JumpToMacroText = FText::Format(
-					INVTEXT("Jump to Macro - '{0}'"),
-					FText::FromString(MacroGraph->GetName()));
+void UEmptyMacroValidator::AddIssueTokens(UBlueprint* Blueprint, const FValidatorXIssue& Issue, const TSharedRef<FTokenizedMessage>& Message) const
+{
+	UEdGraph* MacroGraph = FindIssueGraph(Blueprint, Issue);
+	if(!MacroGraph) return;
+
+	const FText JumpToMacroText = FText::Format(
+		INVTEXT("Jump to Macro - '{0}'"),
+		FText::FromString(MacroGraph->GetName()));
 
-				Message->AddToken(FActionToken::Create(JumpToMacroText, FText::GetEmpty(),
-					FSimpleDelegate::CreateLambda([=]
+	Message->AddToken(FActionToken::Create(JumpToMacroText, FText::GetEmpty(),
+		FSimpleDelegate::CreateLambda([=]
+			{
+				if(Blueprint && MacroGraph)
+				{
+					if(UAssetEditorSubsystem* AssetEditorSubsystem = GEditor->GetEditorSubsystem<UAssetEditorSubsystem>())
+					{
+						AssetEditorSubsystem->OpenEditorForAsset(Blueprint);
+						if(IAssetEditorInstance* EditorInstance = AssetEditorSubsystem->FindEditorForAsset(Blueprint, false))
 						{
-							if(Blueprint && MacroGraph)
+							if(FBlueprintEditor* BlueprintEditor = StaticCast<FBlueprintEditor*>(EditorInstance))
 							{
-								if(UAssetEditorSubsystem* AssetEditorSubsystem = GEditor->GetEditorSubsystem<UAssetEditorSubsystem>())
-								{
-									AssetEditorSubsystem->OpenEditorForAsset(Blueprint);
-									if(IAssetEditorInstance* EditorInstance = AssetEditorSubsystem->FindEditorForAsset(Blueprint, false))
-									{
-										if(FBlueprintEditor* BlueprintEditor = StaticCast<FBlueprintEditor*>(EditorInstance))
-										{
-											BlueprintEditor->OpenGraphAndBringToFront(MacroGraph, true);
-										}
-									}
-								}
+								BlueprintEditor->OpenGraphAndBringToFront(MacroGraph, true);
 							}
-						})));
+						}
+					}
+				}
+			})));
 
-				const FText DeleteMacroText = FText::Format(
-					INVTEXT("'Fix' - Delete Macro - '{0}'"),
-					FText::FromString(MacroGraph->GetName()));
+	const FText DeleteMacroText = FText::Format(
+		INVTEXT("'Fix' - Delete Macro - '{0}'"),
+		FText::FromString(MacroGraph->GetName()));
 
-				Message->AddToken(FActionToken::Create(DeleteMacroText, FText::GetEmpty(),
-					FSimpleDelegate::CreateLambda([=]
-						{
-							if(Blueprint && MacroGraph)
+	Message->AddToken(FActionToken::Create(DeleteMacroText, FText::GetEmpty(),
+		FSimpleDelegate::CreateLambda([=]
+			{
+				if(Blueprint && MacroGraph)
+				{
+					if(UAssetEditorSubsystem* AssetEditorSubsystem = GEditor->GetEditorSubsystem<UAssetEditorSubsystem>())
+					{
+						AssetEditorSubsystem->OpenEditorForAsset(Blueprint);
+
+						FTSTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateLambda([=] (float DeltaTime)
 							{
-								if(UAssetEditorSubsystem* AssetEditorSubsystem = GEditor->GetEditorSubsystem<UAssetEditorSubsystem>())
+								if(IAssetEditorInstance* EditorInstance = AssetEditorSubsystem->FindEditorForAsset(Blueprint, /*bFocusIfOpen=*/false))
 								{
-									AssetEditorSubsystem->OpenEditorForAsset(Blueprint);
+									if(FBlueprintEditor* BlueprintEditor = StaticCast<FBlueprintEditor*>(EditorInstance))
+									{
+										const FText ConfirmText = FText::Format(
+											INVTEXT("Are you sure you want to delete the Macro '{0}' from Blueprint '{1}'?"),
+											FText::FromString(MacroGraph->GetName()),
+											FText::FromString(Blueprint->GetName())
+										);
 
-									FTSTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateLambda([=] (float DeltaTime)
+										if(FMessageDialog::Open(EAppMsgType::YesNo, ConfirmText) == EAppReturnType::Yes)
 										{
-											if(IAssetEditorInstance* EditorInstance = AssetEditorSubsystem->FindEditorForAsset(Blueprint, /*bFocusIfOpen=*/false))
-											{
-												if(FBlueprintEditor* BlueprintEditor = StaticCast<FBlueprintEditor*>(EditorInstance))
+											Blueprint->Modify();
+											auto RemoveMacroInstances = [=] (TArray<TObjectPtr<UEdGraph>>& Graphs)
 												{
-													const FText ConfirmText = FText::Format(
-														INVTEXT("Are you sure you want to delete the Macro '{0}' from Blueprint '{1}'?"),
-														FText::FromString(MacroGraph->GetName()),
-														FText::FromString(Blueprint->GetName())
-													);
-
-													if(FMessageDialog::Open(EAppMsgType::YesNo, ConfirmText) == EAppReturnType::Yes)
+													for(UEdGraph* Graph : Graphs)
 													{
-														Blueprint->Modify();
-														auto RemoveMacroInstances = [=] (TArray<TObjectPtr<UEdGraph>>& Graphs)
+														if(!Graph) continue;
+
+														TArray<UK2Node_MacroInstance*> MacroInstanceNodes;
+														Graph->GetNodesOfClass<UK2Node_MacroInstance>(MacroInstanceNodes);
+
+														for(UK2Node_MacroInstance* MacroInstanceNode : MacroInstanceNodes)
+														{
+															if(MacroInstanceNode && MacroInstanceNode->GetMacroGraph() == MacroGraph)
 															{
-																for(UEdGraph* Graph : Graphs)
-																{
-																	if(!Graph) continue;
-
-																	TArray<UK2Node_MacroInstance*> MacroInstanceNodes;
-																	Graph->GetNodesOfClass<UK2Node_MacroInstance>(MacroInstanceNodes);
-
-																	for(UK2Node_MacroInstance* MacroInstanceNode : MacroInstanceNodes)
-																	{
-																		if(MacroInstanceNode && MacroInstanceNode->GetMacroGraph() == MacroGraph)
-																		{
-																			Graph->Modify();
-																			MacroInstanceNode->DestroyNode();
-																		}
-																	}
-																}
-															};
-
-														
-														RemoveMacroInstances(Blueprint->UbergraphPages);
-														RemoveMacroInstances(Blueprint->FunctionGraphs);
-														RemoveMacroInstances(Blueprint->DelegateSignatureGraphs);
-														RemoveMacroInstances(Blueprint->IntermediateGeneratedGraphs);
-
-														Blueprint->MacroGraphs.Remove(MacroGraph);
-														MacroGraph->Modify();
-														MacroGraph->MarkAsGarbage();
-
-														FBlueprintEditorUtils::MarkBlueprintAsStructurallyModified(Blueprint);
+																Graph->Modify();
+																MacroInstanceNode->DestroyNode();
+															}
+														}
 													}
-												}
-											}
-											return false;
-										}));
+												};
+
+											
+											RemoveMacroInstances(Blueprint->UbergraphPages);
+											RemoveMacroInstances(Blueprint->FunctionGraphs);
+											RemoveMacroInstances(Blueprint->DelegateSignatureGraphs);
+											RemoveMacroInstances(Blueprint->IntermediateGeneratedGraphs);
+
+											Blueprint->MacroGraphs.Remove(MacroGraph);
+											MacroGraph->Modify();
+											MacroGraph->MarkAsGarbage();
+
+											FBlueprintEditorUtils::MarkBlueprintAsStructurallyModified(Blueprint);
+										}
+									}
 								}
-							}
-						})));
+								return false;
+							}));
+					}
+				}
+			})));
+}
 
-				bIsError = true;
-			}
+bool UEmptyMacroValidator::ApplyIssueFix(UBlueprint* Blueprint, const FValidatorXIssue& Issue) const
+{
+	UEdGraph* MacroGraph = FindIssueGraph(Blueprint, Issue);
+	if(!MacroGraph || !Blueprint->MacroGraphs.Contains(MacroGraph)) return false;
+
+	// Copied, removing nodes does not update the graph index
+	const TArray<UK2Node_MacroInstance*> MacroInstanceNodes(GetGraphIndex(Blueprint)->FindMacroInstances(MacroGraph));
+	for(UK2Node_MacroInstance* MacroInstanceNode : MacroInstanceNodes)
+	{
+		if(MacroInstanceNode->GetGraph())
+		{
+			FBlueprintEditorUtils::RemoveNode(Blueprint, MacroInstanceNode, /*bDontRecompile=*/true);
 		}
 	}
 
-	return bIsError ? EDataValidationResult::Invalid : EDataValidationResult::Valid;
+	FBlueprintEditorUtils::RemoveGraph(Blueprint, MacroGraph, EGraphRemoveFlags::MarkTransient);
+	return true;
 }
-
@@ -0,0 +1,104 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "Validators/ExpensiveLoopCallValidator.h"
+#include "Misc/DataValidation.h"
+#include "Analysis/BlueprintSnapshot.h"
+#include "Analysis/CostlyNodeClassifier.h"
+#include "Analysis/LoopBodyIndex.h"
+#include "ValidatorXTypes.h"
+#include "Stats/ValidatorXStats.h"
+
+namespace
+{
+	/** @return The advice given for a costly node run on every iteration, empty for the kinds that are fine in a loop. */
+	FText GetLoopOffenderAdvice(EValidatorXCostlyNode Offender)
+	{
+		switch(Offender)
+		{
+		case EValidatorXCostlyNode::WorldQuery:
+			return INVTEXT("It iterates over every actor or widget, so the loop is O(n^2): query once before the loop and reuse the result.");
+		case EValidatorXCostlyNode::Spawn:
+		case EValidatorXCostlyNode::Destroy:
+			return INVTEXT("Spawning and destroying actors or widgets one by one hitches: spread the work over several frames or reuse pooled objects.");
+		case EValidatorXCostlyNode::AddComponent:
+			return INVTEXT("Adding components one by one hitches: add them in the Construction Script or over several frames.");
+		case EValidatorXCostlyNode::LoadAsset:
+			return INVTEXT("Loading assets one by one stalls the game thread: load them together before the loop.");
+		default:
+			return FText::GetEmpty();
+		}
+	}
+} // namespace
+
+UExpensiveLoopCallValidator::UExpensiveLoopCallValidator()
+{
+	SetValidationEnabled(true);
+}
+
+bool UExpensiveLoopCallValidator::CanValidateAsset_Implementation(const FAssetData& InAssetData, UObject* InAsset, FDataValidationContext& InContext) const
+{
+	return InAsset && InAsset->IsA<UBlueprint>();
+}
+
+bool UExpensiveLoopCallValidator::IsEnabled() const
+{
+	static const UExpensiveLoopCallValidator* CDO = GetDefault<UExpensiveLoopCallValidator>();
+	return CDO->bIsEnabled && !bIsConfigDisabled;
+}
+
+EDataValidationResult UExpensiveLoopCallValidator::ValidateLoadedAsset_Implementation(const FAssetData& InAssetData, UObject* InAsset, FDataValidationContext& Context)
+{
+	VALIDATORX_SCOPE_VALIDATE(InAssetData, Context);
+	bIsError = false;
+
+	if(UBlueprint* Blueprint = Cast<UBlueprint>(InAsset))
+	{
+		return ValidateSnapshot(Blueprint, Context);
+	}
+
+	return EDataValidationResult::Valid;
+}
+
+void UExpensiveLoopCallValidator::AnalyzeSnapshot(const FBlueprintSnapshot& Snapshot, TArray<FValidatorXIssue>& OutIssues) const
+{
+	const FLoopBodyIndex LoopBodies(Snapshot);
+
+	for(int32 LoopIndex = 0; LoopIndex < LoopBodies.GetNumLoops(); ++LoopIndex)
+	{
+		const FBlueprintSnapshotNode& Loop = Snapshot.Nodes[LoopBodies.GetLoopNode(LoopIndex)];
+		const FName GraphName = Snapshot.Graphs[Loop.Graph].Name;
+
+		for(const int32 NodeIndex : LoopBodies.GetBody(LoopIndex))
+		{
+			// A node in nested loops is reported once, with the loop running it most often
+			if(LoopBodies.GetInnermostLoop(NodeIndex) != LoopIndex) continue;
+
+			const FBlueprintSnapshotNode& Node = Snapshot.Nodes[NodeIndex];
+			if(FLoopBodyIndex::IsLoopNode(Node))
+			{
+				const int32 Depth = LoopBodies.GetLoopDepth(NodeIndex) + 1;
+				FValidatorXIssue& Issue = OutIssues.Emplace_GetRef(EMessageSeverity::Warning,
+					INVTEXT("'{0}' is nested in '{1}' in '{2}', so its body runs O(n^{3}) times. Replace the inner loop with a Map or Set lookup, or compute it once before the outer loop."),
+					FFormatOrderedArguments{FText::FromName(Node.MemberName), FText::FromName(Loop.MemberName), FText::FromName(GraphName), Depth});
+				Issue.GraphName = GraphName;
+				Issue.NodeGuid = Node.Guid;
+				continue;
+			}
+
+			const FText Advice = GetLoopOffenderAdvice(ClassifyCostlyNode(Node));
+			if(Advice.IsEmpty()) continue;
+
+			FValidatorXIssue& Issue = OutIssues.Emplace_GetRef(EMessageSeverity::Warning,
+				INVTEXT("'{0}' runs on every iteration of '{1}' in '{2}'. {3}"),
+				FFormatOrderedArguments{FText::FromString(GetCostlyNodeDisplayName(Node)), FText::FromName(Loop.MemberName), FText::FromName(GraphName), Advice});
+			Issue.GraphName = GraphName;
+			Issue.NodeGuid = Node.Guid;
+		}
+	}
+}
+
+void UExpensiveLoopCallValidator::AddIssueTokens(UBlueprint* Blueprint, const FValidatorXIssue& Issue, const TSharedRef<FTokenizedMessage>& Message) const
+{
+	AddJumpToNodeToken(Blueprint, Issue, Message);
+}
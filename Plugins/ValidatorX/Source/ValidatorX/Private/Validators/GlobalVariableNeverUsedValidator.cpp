@@ -2,12 +2,17 @@
 
 
 #include "Validators/GlobalVariableNeverUsedValidator.h"
-#include "K2Node_VariableSet.h"
-#include "K2Node_VariableGet.h"
 #include "Misc/DataValidation.h"
 #include "BlueprintEditor.h"
 #include "SMyBlueprint.h"
 #include "Kismet2/BlueprintEditorUtils.h"
+#include "EdGraphSchema_K2.h"
+#include "K2Node_VariableSet.h"
+#include "Library/BPUtilsNodeFunctionLibrary.h"
+#include "Analysis/BlueprintGraphIndex.h"
+#include "Analysis/BlueprintSnapshot.h"
+#include "ValidatorXTypes.h"
+#include "Stats/ValidatorXStats.h"
 
 UGlobalVariableNeverUsedValidator::UGlobalVariableNeverUsedValidator()
 {
@@ -27,138 +32,160 @@ bool UGlobalVariableNeverUsedValidator::CanValidateAsset_Implementation(const FA
 
 EDataValidationResult UGlobalVariableNeverUsedValidator::ValidateLoadedAsset_Implementation(const FAssetData& InAssetData, UObject* InAsset, FDataValidationContext& Context)
 {
+	VALIDATORX_SCOPE_VALIDATE(InAssetData, Context);
 	bIsError = false;
 
 	if(UBlueprint* Blueprint = Cast<UBlueprint>(InAsset))
 	{
-		const TArray<FBPVariableDescription>& Variables = Blueprint->NewVariables;
+		return ValidateSnapshot(Blueprint, Context);
+	}
+
+	return EDataValidationResult::Valid;
+}
+
+void UGlobalVariableNeverUsedValidator::AnalyzeSnapshot(const FBlueprintSnapshot& Snapshot, TArray<FValidatorXIssue>& OutIssues) const
+{
+	for(int32 VariableIndex = 0; VariableIndex < Snapshot.Variables.Num(); ++VariableIndex)
+	{
+		const FBlueprintSnapshotVariable& Variable = Snapshot.Variables[VariableIndex];
+		if(Variable.Graph != INDEX_NONE || !Variable.bIsDeclared) continue;
+
+		// Use case 1: Exposed on spawn or Config flags
+		if(Variable.PropertyFlags & (CPF_ExposeOnSpawn | CPF_Config | CPF_Interp)) continue;
 
-		TArray<UEdGraph*> AllGraphs;
-		Blueprint->GetAllGraphs(AllGraphs);
+		// Use case 2: Read in graphs. Derived Blueprints are checked in ConfirmIssue.
+		if(Snapshot.IsVariableRead(VariableIndex)) continue;
 
-		for(const FBPVariableDescription& VarDesc : Variables)
+		if(Snapshot.FindVariableWrites(VariableIndex).IsEmpty())
 		{
-			bool bUsed = false;
+			// Unused variable
+			FValidatorXIssue& Issue = OutIssues.Emplace_GetRef(EMessageSeverity::Warning,
+				INVTEXT("Variable '{0}' in Blueprint '{1}' is never used."),
+				FFormatOrderedArguments{FText::FromName(Variable.Name), FText::FromName(Snapshot.BlueprintName)});
+			Issue.Subject = Variable.Name;
+		}
+		else if(!(Variable.PropertyFlags & (CPF_Net | CPF_RepNotify | CPF_SaveGame)))
+		{
+			// Written but never read; replicated and saved variables are read outside of the graphs,
+			// and public ones may be read by other Blueprints through a reference
+			FValidatorXIssue& Issue = OutIssues.Emplace_GetRef(Variable.bIsPrivate ? EMessageSeverity::Warning : EMessageSeverity::Info,
+				INVTEXT("Variable '{0}' in Blueprint '{1}' is set but never read."),
+				FFormatOrderedArguments{FText::FromName(Variable.Name), FText::FromName(Snapshot.BlueprintName)});
+			Issue.Subject = Variable.Name;
+		}
+	}
+}
 
-			// Use case 1: Exposed on spawn or Config flags
-			if(UClass* GenClass = Blueprint->GeneratedClass)
-			{
-				if(FProperty* Prop = GenClass->FindPropertyByName(VarDesc.VarName))
-				{
-					if(Prop->HasAnyPropertyFlags(CPF_ExposeOnSpawn | CPF_Config | CPF_Interp))
-					{
-						bUsed = true;
-					}
-				}
-			}
+bool UGlobalVariableNeverUsedValidator::ConfirmIssue(UBlueprint* Blueprint, const FValidatorXIssue& Issue) const
+{
+	// Private variables cannot be accessed by derived Blueprints
+	const int32 VarIndex = FBlueprintEditorUtils::FindNewVariableIndex(Blueprint, Issue.Subject);
+	if(VarIndex == INDEX_NONE || !Blueprint->GeneratedClass) return true;
+
+	const FBPVariableDescription& VarDesc = Blueprint->NewVariables[VarIndex];
+	if(VarDesc.HasMetaData(FBlueprintMetadata::MD_Private) && VarDesc.GetMetaData(FBlueprintMetadata::MD_Private).ToBool()) return true;
+
+	// Every saved child known to the asset registry, so the answer does not depend on what is loaded
+	TArray<UClass*> DerivedClasses;
+	UBPUtilsNodeFunctionLibrary::GetDerivedRegistryBlueprintClasses(Blueprint->GeneratedClass, DerivedClasses);
+
+	for(UClass* ChildClass : DerivedClasses)
+	{
+		UBlueprint* ChildBP = Cast<UBlueprint>(ChildClass->ClassGeneratedBy);
+		if(!ChildBP) continue;
+
+		const TSharedRef<const FBlueprintGraphIndex> ChildIndex = GetGraphIndex(ChildBP);
+		if(!ChildIndex->FindVariableGets(Issue.Subject).IsEmpty()) return false;
+
+		// The value output of a Set node reads the variable as well
+		for(const UK2Node_VariableSet* SetNode : ChildIndex->FindVariableSets(Issue.Subject))
+		{
+			const UEdGraphPin* ValuePin = SetNode->FindPin(Issue.Subject, EGPD_Output);
+			if(ValuePin && !ValuePin->LinkedTo.IsEmpty()) return false;
+		}
+	}
+
+	return true;
+}
+
+void UGlobalVariableNeverUsedValidator::AddIssueTokens(UBlueprint* Blueprint, const FValidatorXIssue& Issue, const TSharedRef<FTokenizedMessage>& Message) const
+{
+	const FName VarName = Issue.Subject;
 
-			// Use case 2: Explicitly used in graphs
-			if(!bUsed)
+	// Jump to variable
+	Message->AddToken(FActionToken::Create(
+		FText::Format(INVTEXT("Jump to Variable - '{0}'"), FText::FromName(VarName)),
+		FText::GetEmpty(),
+		FSimpleDelegate::CreateLambda([=]
 			{
-				for(UEdGraph* Graph : AllGraphs)
+				if(Blueprint)
 				{
-					if(!Graph) continue;
+					UAssetEditorSubsystem* AssetEditorSubsystem = GEditor->GetEditorSubsystem<UAssetEditorSubsystem>();
+					AssetEditorSubsystem->OpenEditorForAsset(Blueprint);
 
-					for(UEdGraphNode* Node : Graph->Nodes)
+					if(IAssetEditorInstance* EditorInstance = AssetEditorSubsystem->FindEditorForAsset(Blueprint, false))
 					{
-						if(const UK2Node_VariableGet* VarGet = Cast<UK2Node_VariableGet>(Node))
+						if(FBlueprintEditor* BlueprintEditor = StaticCast<FBlueprintEditor*>(EditorInstance))
 						{
-							if(VarGet->GetVarName() == VarDesc.VarName)
+							if(TSharedPtr<SMyBlueprint> MyBlueprintWidget = BlueprintEditor->GetMyBlueprintWidget())
 							{
-								bUsed = true;
-								break;
-							}
-						}
-						else if(const UK2Node_VariableSet* VarSet = Cast<UK2Node_VariableSet>(Node))
-						{
-							if(VarSet->GetVarName() == VarDesc.VarName)
-							{
-								bUsed = true;
-								break;
+								MyBlueprintWidget->SelectItemByName(VarName, ESelectInfo::Direct, INDEX_NONE, false);
 							}
 						}
 					}
-
-					if(bUsed) break;
 				}
-			}
+			}))
+	);
 
-			// Unused variable
-			if(!bUsed)
+	// Deleting a variable also deletes its Set nodes, which would break their execution chains
+	if(GetGraphIndex(Blueprint)->IsVariableReferenced(VarName)) return;
+
+	// Fix: delete variable
+	Message->AddToken(FActionToken::Create(
+		FText::Format(INVTEXT("Fix - Delete Variable - '{0}'"), FText::FromName(VarName)),
+		FText::GetEmpty(),
+		FSimpleDelegate::CreateLambda([=]
 			{
-				const FText MessageText = FText::Format(
-					INVTEXT("Variable '{0}' in Blueprint '{1}' is never used."),
-					FText::FromName(VarDesc.VarName),
-					FText::FromString(Blueprint->GetName())
-				);
-
-				const TSharedRef<FTokenizedMessage> Message = Context.AddMessage(EMessageSeverity::Warning, MessageText);
-
-				// Jump to variable
-				Message->AddToken(FActionToken::Create(
-					FText::Format(INVTEXT("Jump to Variable - '{0}'"), FText::FromName(VarDesc.VarName)),
-					FText::GetEmpty(),
-					FSimpleDelegate::CreateLambda([=]
+				if(Blueprint)
+				{
+					UAssetEditorSubsystem* AssetEditorSubsystem = GEditor->GetEditorSubsystem<UAssetEditorSubsystem>();
+					AssetEditorSubsystem->OpenEditorForAsset(Blueprint);
+
+					FTSTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateLambda([=] (float)
 						{
-							if(Blueprint)
+							if(IAssetEditorInstance* EditorInstance = AssetEditorSubsystem->FindEditorForAsset(Blueprint, false))
 							{
-								UAssetEditorSubsystem* AssetEditorSubsystem = GEditor->GetEditorSubsystem<UAssetEditorSubsystem>();
-								AssetEditorSubsystem->OpenEditorForAsset(Blueprint);
-
-								if(IAssetEditorInstance* EditorInstance = AssetEditorSubsystem->FindEditorForAsset(Blueprint, false))
+								if(FBlueprintEditor* BlueprintEditor = StaticCast<FBlueprintEditor*>(EditorInstance))
 								{
-									if(FBlueprintEditor* BlueprintEditor = StaticCast<FBlueprintEditor*>(EditorInstance))
+									const FText ConfirmText = FText::Format(
+										INVTEXT("Are you sure you want to delete variable '{0}' from Blueprint '{1}'?"),
+										FText::FromName(VarName),
+										FText::FromString(Blueprint->GetName())
+									);
+
+									if(FMessageDialog::Open(EAppMsgType::YesNo, ConfirmText) == EAppReturnType::Yes)
 									{
-										if(TSharedPtr<SMyBlueprint> MyBlueprintWidget = BlueprintEditor->GetMyBlueprintWidget())
-										{
-											MyBlueprintWidget->SelectItemByName(VarDesc.VarName, ESelectInfo::Direct, INDEX_NONE, false);
-										}
+										FBlueprintEditorUtils::RemoveMemberVariable(Blueprint, VarName);
+										FBlueprintEditorUtils::MarkBlueprintAsStructurallyModified(Blueprint);
 									}
 								}
 							}
-						}))
-				);
-
-				// Fix: delete variable
-				Message->AddToken(FActionToken::Create(
-					FText::Format(INVTEXT("Fix - Delete Variable - '{0}'"), FText::FromName(VarDesc.VarName)),
-					FText::GetEmpty(),
-					FSimpleDelegate::CreateLambda([=]
-						{
-							if(Blueprint)
-							{
-								UAssetEditorSubsystem* AssetEditorSubsystem = GEditor->GetEditorSubsystem<UAssetEditorSubsystem>();
-								AssetEditorSubsystem->OpenEditorForAsset(Blueprint);
+							return false;
+						}));
+				}
+			}))
+	);
+}
 
-								FTSTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateLambda([=] (float)
-									{
-										if(IAssetEditorInstance* EditorInstance = AssetEditorSubsystem->FindEditorForAsset(Blueprint, false))
-										{
-											if(FBlueprintEditor* BlueprintEditor = StaticCast<FBlueprintEditor*>(EditorInstance))
-											{
-												const FText ConfirmText = FText::Format(
-													INVTEXT("Are you sure you want to delete variable '{0}' from Blueprint '{1}'?"),
-													FText::FromName(VarDesc.VarName),
-													FText::FromString(Blueprint->GetName())
-												);
-
-												if(FMessageDialog::Open(EAppMsgType::YesNo, ConfirmText) == EAppReturnType::Yes)
-												{
-													FBlueprintEditorUtils::RemoveMemberVariable(Blueprint, VarDesc.VarName);
-													FBlueprintEditorUtils::MarkBlueprintAsStructurallyModified(Blueprint);
-												}
-											}
-										}
-										return false;
-									}));
-							}
-						}))
-				);
+bool UGlobalVariableNeverUsedValidator::ApplyIssueFix(UBlueprint* Blueprint, const FValidatorXIssue& Issue) const
+{
+	// Same rule as the fix token: Set nodes would be deleted along with the variable
+	if(GetGraphIndex(Blueprint)->IsVariableReferenced(Issue.Subject)) return false;
 
-				bIsError = true;
-			}
-		}
-	}
+	const int32 VarIndex = FBlueprintEditorUtils::FindNewVariableIndex(Blueprint, Issue.Subject);
+	if(VarIndex == INDEX_NONE) return false;
 
-	return bIsError ? EDataValidationResult::Invalid : EDataValidationResult::Valid;
+	Blueprint->Modify();
+	Blueprint->NewVariables.RemoveAt(VarIndex);
+	return true;
 }
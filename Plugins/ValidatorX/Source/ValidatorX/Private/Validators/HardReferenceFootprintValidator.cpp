@@ -0,0 +1,270 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "Validators/HardReferenceFootprintValidator.h"
+#include "Engine/SCS_Node.h"
+#include "Engine/SimpleConstructionScript.h"
+#include "Misc/DataValidation.h"
+#include "Analysis/HardReferenceFootprint.h"
+#include "ValidatorXManager.h"
+#include "ValidatorXTypes.h"
+#include "Stats/ValidatorXStats.h"
+
+namespace
+{
+	/** A node, variable or component of a Blueprint creating a hard reference. */
+	struct FHardReferencer
+	{
+		FString Label;
+		FName GraphName;
+		FGuid NodeGuid;
+		FName Subject;
+	};
+
+	/** Referencers listed in a message before the rest is summed up. */
+	constexpr int32 MaxListedReferencers = 3;
+
+	/** Hard referencers of a Blueprint, keyed by referenced package. */
+	class FHardReferencerCollector
+	{
+	public:
+		explicit FHardReferencerCollector(const UBlueprint& Blueprint)
+			: BlueprintPackage(Blueprint.GetOutermost()->GetFName())
+		{
+		}
+
+		void Add(const UObject* Object, const FHardReferencer& Referencer)
+		{
+			if(!Object) return;
+
+			const FName Package = Object->GetOutermost()->GetFName();
+			if(Package == BlueprintPackage) return;
+
+			TArray<FHardReferencer>& PackageReferencers = Referencers.FindOrAdd(Package);
+			if(!PackageReferencers.ContainsByPredicate([&Referencer](const FHardReferencer& Other) { return Other.Label == Referencer.Label; }))
+			{
+				PackageReferencers.Add(Referencer);
+			}
+		}
+
+		/** Adds the objects held by a hard object property, or by an array of them. */
+		void AddProperty(const FProperty* Property, const void* Container, const FHardReferencer& Referencer)
+		{
+			// Soft, weak and lazy object properties are not FObjectProperty
+			if(const FObjectProperty* ObjectProperty = CastField<FObjectProperty>(Property))
+			{
+				Add(ObjectProperty->GetObjectPropertyValue_InContainer(Container), Referencer);
+			}
+			else if(const FArrayProperty* ArrayProperty = CastField<FArrayProperty>(Property))
+			{
+				if(const FObjectProperty* InnerProperty = CastField<FObjectProperty>(ArrayProperty->Inner))
+				{
+					FScriptArrayHelper_InContainer Array(ArrayProperty, Container);
+					for(int32 Index = 0; Index < Array.Num(); ++Index)
+					{
+						Add(InnerProperty->GetObjectPropertyValue(Array.GetRawPtr(Index)), Referencer);
+					}
+				}
+			}
+		}
+
+		const TArray<FHardReferencer>* Find(FName Package) const { return Referencers.Find(Package); }
+
+	private:
+		FName BlueprintPackage;
+		TMap<FName, TArray<FHardReferencer>> Referencers;
+	};
+
+	void CollectHardReferencers(UBlueprint& Blueprint, FHardReferencerCollector& Collector)
+	{
+		Collector.Add(Blueprint.ParentClass, FHardReferencer{TEXT("the parent class")});
+
+		// Cast nodes, class pins and calls into other Blueprints all show up as pin types and defaults
+		TArray<UEdGraph*> Graphs;
+		Blueprint.GetAllGraphs(Graphs);
+		for(const UEdGraph* Graph : Graphs)
+		{
+			for(const UEdGraphNode* Node : Graph->Nodes)
+			{
+				if(!Node) continue;
+
+				const FHardReferencer Referencer{
+					FString::Printf(TEXT("node '%s' in '%s'"), *Node->GetNodeTitle(ENodeTitleType::ListView).ToString(), *Graph->GetName()),
+					Graph->GetFName(),
+					Node->NodeGuid};
+				for(const UEdGraphPin* Pin : Node->Pins)
+				{
+					if(!Pin) continue;
+
+					Collector.Add(Pin->PinType.PinSubCategoryObject.Get(), Referencer);
+					Collector.Add(Pin->DefaultObject, Referencer);
+				}
+			}
+		}
+
+		for(const FBPVariableDescription& Variable : Blueprint.NewVariables)
+		{
+			FHardReferencer Referencer{FString::Printf(TEXT("the type of variable '%s'"), *Variable.VarName.ToString())};
+			Referencer.Subject = Variable.VarName;
+			Collector.Add(Variable.VarType.PinSubCategoryObject.Get(), Referencer);
+		}
+
+		if(const UClass* GeneratedClass = Blueprint.GeneratedClass)
+		{
+			if(const UObject* ClassDefaults = GeneratedClass->GetDefaultObject(false))
+			{
+				for(TFieldIterator<FProperty> It(GeneratedClass, EFieldIteratorFlags::ExcludeSuper); It; ++It)
+				{
+					FHardReferencer Referencer{FString::Printf(TEXT("the default value of '%s'"), *It->GetName())};
+					Referencer.Subject = It->GetFName();
+
+					Collector.AddProperty(*It, ClassDefaults, Referencer);
+				}
+			}
+		}
+
+		if(const USimpleConstructionScript* ConstructionScript = Blueprint.SimpleConstructionScript)
+		{
+			for(const USCS_Node* ScsNode : ConstructionScript->GetAllNodes())
+			{
+				if(!ScsNode) continue;
+
+				FHardReferencer Referencer{FString::Printf(TEXT("component '%s'"), *ScsNode->GetVariableName().ToString())};
+				Referencer.Subject = ScsNode->GetVariableName();
+				Collector.Add(ScsNode->ComponentClass, Referencer);
+				if(const UActorComponent* Template = ScsNode->ComponentTemplate)
+				{
+					for(TFieldIterator<FProperty> It(Template->GetClass()); It; ++It)
+					{
+						Collector.AddProperty(*It, Template, Referencer);
+					}
+				}
+			}
+		}
+	}
+
+	FText JoinHardReferencers(const TArray<FHardReferencer>* Referencers)
+	{
+		if(!Referencers || Referencers->IsEmpty())
+		{
+			return INVTEXT("references the graphs do not show");
+		}
+
+		TArray<FString> Labels;
+		for(int32 Index = 0; Index < FMath::Min(Referencers->Num(), MaxListedReferencers); ++Index)
+		{
+			Labels.Add((*Referencers)[Index].Label);
+		}
+
+		FString Joined = FString::Join(Labels, TEXT(", "));
+		if(Referencers->Num() > MaxListedReferencers)
+		{
+			Joined += FString::Printf(TEXT(" and %d more"), Referencers->Num() - MaxListedReferencers);
+		}
+		return FText::FromString(Joined);
+	}
+} // namespace
+
+UHardReferenceFootprintValidator::UHardReferenceFootprintValidator()
+{
+	SetValidationEnabled(true);
+}
+
+bool UHardReferenceFootprintValidator::CanValidateAsset_Implementation(const FAssetData& InAssetData, UObject* InAsset, FDataValidationContext& InContext) const
+{
+	return InAsset && InAsset->IsA<UBlueprint>();
+}
+
+bool UHardReferenceFootprintValidator::IsEnabled() const
+{
+	static const UHardReferenceFootprintValidator* CDO = GetDefault<UHardReferenceFootprintValidator>();
+	return CDO->bIsEnabled && !bIsConfigDisabled;
+}
+
+EDataValidationResult UHardReferenceFootprintValidator::ValidateLoadedAsset_Implementation(const FAssetData& InAssetData, UObject* InAsset, FDataValidationContext& Context)
+{
+	VALIDATORX_SCOPE_VALIDATE(InAssetData, Context);
+	bIsError = false;
+
+	UBlueprint* Blueprint = Cast<UBlueprint>(InAsset);
+	if(!Blueprint)
+	{
+		return EDataValidationResult::Valid;
+	}
+
+	const FName BlueprintPackage = Blueprint->GetOutermost()->GetFName();
+	FHardReferenceFootprint& Footprint = FValidatorXManager::Get().GetHardReferenceFootprint(bIncludeEngineContent, ClassSizeFactors);
+
+	const FHardReferenceFootprint::FSize TotalSize = Footprint.GetClosureSize(BlueprintPackage);
+	const int64 BudgetBytes = static_cast<int64>(FootprintBudgetMegabytes * 1024.0 * 1024.0);
+	if(TotalSize.EstimatedSize <= BudgetBytes)
+	{
+		return EDataValidationResult::Valid;
+	}
+
+	TArray<FValidatorXIssue> Issues;
+	Issues.Emplace(EMessageSeverity::Warning,
+		INVTEXT("'{0}' loads an estimated {1} with its hard references ({2} packages, {3} on disk), over the budget of {4}."),
+		FFormatOrderedArguments{FText::FromName(Blueprint->GetFName()), FText::AsMemory(TotalSize.EstimatedSize), TotalSize.NumPackages, FText::AsMemory(TotalSize.DiskSize), FText::AsMemory(BudgetBytes)});
+
+	// Each direct reference is weighed with everything it pulls in, shared packages included
+	const TArray<FName> Dependencies(Footprint.GetDependencies(BlueprintPackage));
+	TArray<TPair<FName, FHardReferenceFootprint::FSize>> References;
+	for(const FName Dependency : Dependencies)
+	{
+		References.Emplace(Dependency, Footprint.GetClosureSize(Dependency));
+	}
+	References.Sort([](const TPair<FName, FHardReferenceFootprint::FSize>& A, const TPair<FName, FHardReferenceFootprint::FSize>& B)
+		{
+			return A.Value.EstimatedSize > B.Value.EstimatedSize;
+		});
+
+	FHardReferencerCollector Collector(*Blueprint);
+	CollectHardReferencers(*Blueprint, Collector);
+
+	for(int32 Index = 0; Index < FMath::Min(References.Num(), MaxReportedReferences); ++Index)
+	{
+		const FName Package = References[Index].Key;
+		const FHardReferenceFootprint::FSize& Size = References[Index].Value;
+		const TArray<FHardReferencer>* Referencers = Collector.Find(Package);
+
+		FValidatorXIssue& Issue = Issues.Emplace_GetRef(EMessageSeverity::Warning,
+			INVTEXT("'{0}' pulls in an estimated {1} ({2} packages) through {3}. Use a soft reference or an interface instead."),
+			FFormatOrderedArguments{FText::FromName(Package), FText::AsMemory(Size.EstimatedSize), Size.NumPackages, JoinHardReferencers(Referencers)});
+
+		if(Referencers)
+		{
+			// Jump to the first node creating the reference, or name the first variable or component
+			for(const FHardReferencer& Referencer : *Referencers)
+			{
+				if(Referencer.NodeGuid.IsValid())
+				{
+					Issue.GraphName = Referencer.GraphName;
+					Issue.NodeGuid = Referencer.NodeGuid;
+					break;
+				}
+				if(Issue.Subject.IsNone())
+				{
+					Issue.Subject = Referencer.Subject;
+				}
+			}
+		}
+	}
+
+	return CommitIssues(Blueprint, Issues, Context);
+}
+
+void UHardReferenceFootprintValidator::AddIssueTokens(UBlueprint* Blueprint, const FValidatorXIssue& Issue, const TSharedRef<FTokenizedMessage>& Message) const
+{
+	AddJumpToNodeToken(Blueprint, Issue, Message);
+}
+
+int32 UHardReferenceFootprintValidator::GetCacheVersion() const
+{
+	return FValidatorXSettingsHash()
+		.Add(FootprintBudgetMegabytes)
+		.Add(MaxReportedReferences)
+		.Add(bIncludeEngineContent)
+		.AddNameMap(ClassSizeFactors)
+		.GetCacheVersion(1);
+}
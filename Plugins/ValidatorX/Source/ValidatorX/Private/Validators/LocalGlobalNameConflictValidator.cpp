@@ -7,6 +7,10 @@
 #include "BlueprintEditor.h"
 #include "Kismet2/BlueprintEditorUtils.h"
 #include "SMyBlueprint.h"
+#include "Analysis/BlueprintGraphIndex.h"
+#include "Analysis/BlueprintSnapshot.h"
+#include "ValidatorXTypes.h"
+#include "Stats/ValidatorXStats.h"
 
 ULocalGlobalNameConflictValidator::ULocalGlobalNameConflictValidator()
 {
@@ -27,71 +31,137 @@ bool ULocalGlobalNameConflictValidator::IsEnabled() const
 
 EDataValidationResult ULocalGlobalNameConflictValidator::ValidateLoadedAsset_Implementation(const FAssetData& InAssetData, UObject* InAsset, FDataValidationContext& Context)
 {
+	VALIDATORX_SCOPE_VALIDATE(InAssetData, Context);
 	bIsError = false;
 
 	if(UBlueprint* Blueprint = Cast<UBlueprint>(InAsset))
 	{
-		TArray<UEdGraph*> AllGraphs = Blueprint->UbergraphPages;
-		AllGraphs.Append(Blueprint->FunctionGraphs);
-		AllGraphs.Append(Blueprint->MacroGraphs);
-		AllGraphs.Append(Blueprint->DelegateSignatureGraphs);
-		AllGraphs.Append(Blueprint->IntermediateGeneratedGraphs);
-		Blueprint->GetAllGraphs(AllGraphs);
-
-		for(UEdGraph* Graph : AllGraphs)
+		return ValidateSnapshot(Blueprint, Context);
+	}
+
+	return EDataValidationResult::Valid;
+}
+
+void ULocalGlobalNameConflictValidator::AnalyzeSnapshot(const FBlueprintSnapshot& Snapshot, TArray<FValidatorXIssue>& OutIssues) const
+{
+	for(const FBlueprintSnapshotVariable& LocalVar : Snapshot.Variables)
+	{
+		if(LocalVar.Graph == INDEX_NONE)
 		{
-			UK2Node_FunctionEntry* EntryNode = nullptr;
+			continue;
+		}
 
-			for(UEdGraphNode* Node : Graph->Nodes)
-			{
-				if(UK2Node_FunctionEntry* Entry = Cast<UK2Node_FunctionEntry>(Node))
-				{
-					EntryNode = Entry;
-					break;
-				}
-			}
+		const FBlueprintSnapshotVariable* GlobalVar = Snapshot.FindMemberVariable(LocalVar.Name);
+		if(GlobalVar && GlobalVar->bIsDeclared)
+		{
+			const FName GraphName = Snapshot.Graphs[LocalVar.Graph].Name;
 
-			if(!EntryNode)
-			{
-				continue;
-			}
+			FValidatorXIssue& Issue = OutIssues.Emplace_GetRef(EMessageSeverity::Warning,
+				INVTEXT("Local variable '{0}' in function '{1}' has the same name as a global variable."),
+				FFormatOrderedArguments{FText::FromName(LocalVar.Name), FText::FromName(GraphName)});
+			Issue.GraphName = GraphName;
+			Issue.Subject = LocalVar.Name;
+		}
+	}
+}
 
-			for(const FBPVariableDescription& LocalVar : EntryNode->LocalVariables)
+void ULocalGlobalNameConflictValidator::AddIssueTokens(UBlueprint* Blueprint, const FValidatorXIssue& Issue, const TSharedRef<FTokenizedMessage>& Message) const
+{
+	UEdGraph* Graph = FindIssueGraph(Blueprint, Issue);
+	UK2Node_FunctionEntry* EntryNode = Graph ? GetGraphIndex(Blueprint)->FindFunctionEntry(Graph) : nullptr;
+	if(!EntryNode)
+	{
+		return;
+	}
+
+	const FName VarName = Issue.Subject;
+
+	const FText JumpToVariableText = FText::Format(
+		INVTEXT("Jump to variable - '{0}'"),
+		FText::FromName(VarName));
+
+	Message->AddToken(FActionToken::Create(JumpToVariableText, FText::FromString(""), 
+		FSimpleDelegate::CreateLambda([=]
+		{
+			if(Blueprint && EntryNode)
 			{
-				for(const FBPVariableDescription& GlobalVar : Blueprint->NewVariables)
+				UAssetEditorSubsystem* AssetEditorSubsystem = GEditor->GetEditorSubsystem<UAssetEditorSubsystem>();
+				AssetEditorSubsystem->OpenEditorForAsset(Blueprint);
+
+				if(IAssetEditorInstance* EditorInstance = AssetEditorSubsystem->FindEditorForAsset(Blueprint, /*bFocusIfOpen=*/false))
 				{
-					if(LocalVar.VarName == GlobalVar.VarName)
+					if(FBlueprintEditor* BlueprintEditor = StaticCast<FBlueprintEditor*>(EditorInstance))
 					{
-						const FText MessageText = FText::Format(
-							INVTEXT("Local variable '{0}' in function '{1}' has the same name as a global variable."),
-							FText::FromName(LocalVar.VarName),
-							FText::FromString(Graph->GetName()));
+						if(TSharedPtr<SGraphEditor> GraphEditor = BlueprintEditor->OpenGraphAndBringToFront(Graph, true))
+						{
+							if(TSharedPtr<SMyBlueprint> MyBlueprintWidget = BlueprintEditor->GetMyBlueprintWidget())
+							{
+								if (MyBlueprintWidget->SelectionAsLocalVar())
+								{
+									MyBlueprintWidget->SelectItemByName(VarName,
+										ESelectInfo::Direct,
+										INDEX_NONE,
+										false);
+								}
+							}
+						}
+					}
+				}
+			}
+		})));
 
-						const TSharedRef<FTokenizedMessage> Message = Context.AddMessage(EMessageSeverity::Warning, MessageText);
+	const FText DeleteVariableText = FText::Format(
+		INVTEXT("'Fix' - Rename Local Variable - '{0}'"),
+		FText::FromName(VarName));
 
-						const FText JumpToVariableText = FText::Format(
-							INVTEXT("Jump to variable - '{0}'"),
-							FText::FromName(LocalVar.VarName));
+	Message->AddToken(FActionToken::Create(DeleteVariableText, FText::FromString(""), 
+		FSimpleDelegate::CreateLambda([=]
+		{
+			if(Blueprint && EntryNode)
+			{
+				UAssetEditorSubsystem* AssetEditorSubsystem = GEditor->GetEditorSubsystem<UAssetEditorSubsystem>();
+				AssetEditorSubsystem->OpenEditorForAsset(Blueprint);
 
-						Message->AddToken(FActionToken::Create(JumpToVariableText, FText::FromString(""), 
-							FSimpleDelegate::CreateLambda([=]
+				FTSTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateLambda([=] (float DeltaTime)
+					{
+						if(IAssetEditorInstance* EditorInstance = AssetEditorSubsystem->FindEditorForAsset(Blueprint, /*bFocusIfOpen=*/false))
+						{
+							if(FBlueprintEditor* BlueprintEditor = StaticCast<FBlueprintEditor*>(EditorInstance))
 							{
-								if(Blueprint && EntryNode)
+								if(TSharedPtr<SGraphEditor> GraphEditor = BlueprintEditor->OpenGraphAndBringToFront(Graph, true))
 								{
-									UAssetEditorSubsystem* AssetEditorSubsystem = GEditor->GetEditorSubsystem<UAssetEditorSubsystem>();
-									AssetEditorSubsystem->OpenEditorForAsset(Blueprint);
-
-									if(IAssetEditorInstance* EditorInstance = AssetEditorSubsystem->FindEditorForAsset(Blueprint, /*bFocusIfOpen=*/false))
+									if(BlueprintEditor->GetMyBlueprintWidget().IsValid())
 									{
-										if(FBlueprintEditor* BlueprintEditor = StaticCast<FBlueprintEditor*>(EditorInstance))
+										int32 IndexToRename = INDEX_NONE;
+
+										for(int32 i = 0; i < EntryNode->LocalVariables.Num(); ++i)
 										{
-											if(TSharedPtr<SGraphEditor> GraphEditor = BlueprintEditor->OpenGraphAndBringToFront(Graph, true))
+											if(EntryNode->LocalVariables[i].VarName == VarName)
 											{
+												IndexToRename = i;
+												break;
+											}
+										}
+
+										if(IndexToRename != INDEX_NONE)
+										{
+											const FText ConfirmText = FText::Format(
+												INVTEXT("Are you sure you want to rename the local variable '{0}' in function '{1}' to '{2}'?"),
+												FText::FromName(VarName),
+												FText::FromString(Graph->GetName()),
+												FText::FromName(FName(*FString("Local") + VarName.ToString())));
+											FName NewName = FName(*FString("Local") + VarName.ToString());
+											if(FMessageDialog::Open(EAppMsgType::YesNo, ConfirmText) == EAppReturnType::Yes)
+											{
+												EntryNode->Modify();
+												EntryNode->LocalVariables[IndexToRename].VarName = NewName;
+												FBlueprintEditorUtils::MarkBlueprintAsStructurallyModified(Blueprint);
+
 												if(TSharedPtr<SMyBlueprint> MyBlueprintWidget = BlueprintEditor->GetMyBlueprintWidget())
 												{
-													if (MyBlueprintWidget->SelectionAsLocalVar())
+													if(MyBlueprintWidget->SelectionAsLocalVar())
 													{
-														MyBlueprintWidget->SelectItemByName(LocalVar.VarName,
+														MyBlueprintWidget->SelectItemByName(NewName,
 															ESelectInfo::Direct,
 															INDEX_NONE,
 															false);
@@ -99,87 +169,51 @@ EDataValidationResult ULocalGlobalNameConflictValidator::ValidateLoadedAsset_Imp
 												}
 											}
 										}
+
+										return false;
 									}
 								}
-							})));
-
-						const FText DeleteVariableText = FText::Format(
-							INVTEXT("'Fix' - Rename Local Variable - '{0}'"),
-							FText::FromName(LocalVar.VarName));
+							}
+						}
 
-						Message->AddToken(FActionToken::Create(DeleteVariableText, FText::FromString(""), 
-							FSimpleDelegate::CreateLambda([=]
-							{
-								if(Blueprint && EntryNode)
-								{
-									UAssetEditorSubsystem* AssetEditorSubsystem = GEditor->GetEditorSubsystem<UAssetEditorSubsystem>();
-									AssetEditorSubsystem->OpenEditorForAsset(Blueprint);
+						return true;
+					}));
+			}
+		})));
+}
 
-									FTSTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateLambda([=] (float DeltaTime)
-										{
-											if(IAssetEditorInstance* EditorInstance = AssetEditorSubsystem->FindEditorForAsset(Blueprint, /*bFocusIfOpen=*/false))
-											{
-												if(FBlueprintEditor* BlueprintEditor = StaticCast<FBlueprintEditor*>(EditorInstance))
-												{
-													if(TSharedPtr<SGraphEditor> GraphEditor = BlueprintEditor->OpenGraphAndBringToFront(Graph, true))
-													{
-														if(BlueprintEditor->GetMyBlueprintWidget().IsValid())
-														{
-															int32 IndexToRename = INDEX_NONE;
-
-															for(int32 i = 0; i < EntryNode->LocalVariables.Num(); ++i)
-															{
-																if(EntryNode->LocalVariables[i].VarName == LocalVar.VarName)
-																{
-																	IndexToRename = i;
-																	break;
-																}
-															}
-
-															if(IndexToRename != INDEX_NONE)
-															{
-																const FText ConfirmText = FText::Format(
-																	INVTEXT("Are you sure you want to rename the local variable '{0}' in function '{1}' to '{2}'?"),
-																	FText::FromName(LocalVar.VarName),
-																	FText::FromString(Graph->GetName()),
-																	FText::FromName(FName(*FString("Local") + LocalVar.VarName.ToString())));
-																FName NewName = FName(*FString("Local") + LocalVar.VarName.ToString());
-																if(FMessageDialog::Open(EAppMsgType::YesNo, ConfirmText) == EAppReturnType::Yes)
-																{
-																	EntryNode->Modify();
-																	EntryNode->LocalVariables[IndexToRename].VarName = NewName;
-																	FBlueprintEditorUtils::MarkBlueprintAsStructurallyModified(Blueprint);
-
-																	if(TSharedPtr<SMyBlueprint> MyBlueprintWidget = BlueprintEditor->GetMyBlueprintWidget())
-																	{
-																		if(MyBlueprintWidget->SelectionAsLocalVar())
-																		{
-																			MyBlueprintWidget->SelectItemByName(NewName,
-																				ESelectInfo::Direct,
-																				INDEX_NONE,
-																				false);
-																		}
-																	}
-																}
-															}
-
-															return false;
-														}
-													}
-												}
-											}
+bool ULocalGlobalNameConflictValidator::ApplyIssueFix(UBlueprint* Blueprint, const FValidatorXIssue& Issue) const
+{
+	UEdGraph* Graph = FindIssueGraph(Blueprint, Issue);
+	UK2Node_FunctionEntry* EntryNode = Graph ? GetGraphIndex(Blueprint)->FindFunctionEntry(Graph) : nullptr;
+	if(!EntryNode)
+	{
+		return false;
+	}
 
-											return true;
-										}));
-								}
-							})));
+	const FName VarName = Issue.Subject;
+	const FName NewName = FName(*FString("Local") + VarName.ToString());
 
-						bIsError = true;
-					}
-				}
-			}
+	FBPVariableDescription* LocalVar = nullptr;
+	for(FBPVariableDescription& Candidate : EntryNode->LocalVariables)
+	{
+		if(Candidate.VarName == NewName)
+		{
+			// Renaming would create another conflict
+			return false;
+		}
+		if(Candidate.VarName == VarName)
+		{
+			LocalVar = &Candidate;
 		}
 	}
 
-	return bIsError ? EDataValidationResult::Invalid : EDataValidationResult::Valid;
+	if(!LocalVar || FBlueprintEditorUtils::FindNewVariableIndex(Blueprint, NewName) != INDEX_NONE)
+	{
+		return false;
+	}
+
+	EntryNode->Modify();
+	LocalVar->VarName = NewName;
+	return true;
 }
@@ -18,6 +18,11 @@
 #include "BlueprintEditor.h"
 #include "SMyBlueprint.h"
 #include "Kismet2/BlueprintEditorUtils.h"
+#include "Analysis/BlueprintGraphIndex.h"
+#include "Analysis/BlueprintSnapshot.h"
+#include "Analysis/VariableLiveness.h"
+#include "ValidatorXTypes.h"
+#include "Stats/ValidatorXStats.h"
 
 
 ULocalVariableNeverUsedValidator::ULocalVariableNeverUsedValidator()
@@ -38,145 +43,216 @@ bool ULocalVariableNeverUsedValidator::IsEnabled() const
 
 EDataValidationResult ULocalVariableNeverUsedValidator::ValidateLoadedAsset_Implementation(const FAssetData& InAssetData, UObject* InAsset, FDataValidationContext& Context)
 {
+    VALIDATORX_SCOPE_VALIDATE(InAssetData, Context);
     bIsError = false;
   
     if(UBlueprint* Blueprint = Cast<UBlueprint>(InAsset))
     {
-        const auto AllGraphs = Blueprint->FunctionGraphs;
-    
-        for(UEdGraph* Graph : AllGraphs)
+        return ValidateSnapshot(Blueprint, Context);
+    }
+   
+    return EDataValidationResult::Valid;
+}
+
+void ULocalVariableNeverUsedValidator::AnalyzeSnapshot(const FBlueprintSnapshot& Snapshot, TArray<FValidatorXIssue>& OutIssues) const
+{
+    TBitArray<> NeverRead(false, Snapshot.Variables.Num());
+
+    for(int32 VariableIndex = 0; VariableIndex < Snapshot.Variables.Num(); ++VariableIndex)
+    {
+        const FBlueprintSnapshotVariable& LocalVar = Snapshot.Variables[VariableIndex];
+        if(LocalVar.Graph == INDEX_NONE) continue;
+
+        const FBlueprintSnapshotGraph& Graph = Snapshot.Graphs[LocalVar.Graph];
+        if(Graph.Type != EValidatorXGraphType::Function) continue;
+
+        // A Set node whose value output is linked reads the local as well
+        if(Snapshot.IsVariableRead(VariableIndex)) continue;
+        NeverRead[VariableIndex] = true;
+
+        const bool bUsed = !Snapshot.FindVariableWrites(VariableIndex).IsEmpty();
+        FValidatorXIssue& Issue = bUsed
+            ? OutIssues.Emplace_GetRef(EMessageSeverity::Warning,
+                INVTEXT("Local variable '{0}' in function '{1}' is set but never read."),
+                FFormatOrderedArguments{FText::FromName(LocalVar.Name), FText::FromName(Graph.Name)})
+            : OutIssues.Emplace_GetRef(EMessageSeverity::Warning,
+                INVTEXT("Local variable '{0}' in function '{1}' is never used."),
+                FFormatOrderedArguments{FText::FromName(LocalVar.Name), FText::FromName(Graph.Name)});
+        Issue.GraphName = Graph.Name;
+        Issue.Subject = LocalVar.Name;
+    }
+
+    for(int32 GraphIndex = 0; GraphIndex < Snapshot.Graphs.Num(); ++GraphIndex)
+    {
+        const FBlueprintSnapshotGraph& Graph = Snapshot.Graphs[GraphIndex];
+        if(Graph.Type != EValidatorXGraphType::Function) continue;
+
+        const FVariableLiveness Liveness(Snapshot, GraphIndex);
+
+        for(const int32 SetNode : Liveness.GetDeadStores())
         {
-            UK2Node_FunctionEntry* EntryNode = nullptr;
+            const FBlueprintSnapshotNode& Set = Snapshot.Nodes[SetNode];
+
+            // Every Set of a local that is never read is dead, it is reported once above
+            const int32 VariableIndex = Snapshot.FindNodeVariable(SetNode);
+            if(VariableIndex == INDEX_NONE || NeverRead[VariableIndex]) continue;
+
+            FValidatorXIssue& Issue = OutIssues.Emplace_GetRef(EMessageSeverity::Warning,
+                INVTEXT("Value set to local variable '{0}' in function '{1}' is overwritten or discarded before it is read."),
+                FFormatOrderedArguments{FText::FromName(Set.MemberName), FText::FromName(Graph.Name)});
+            Issue.GraphName = Graph.Name;
+            Issue.NodeGuid = Set.Guid;
+            Issue.Subject = Set.MemberName;
+        }
+
+        for(const int32 VariableIndex : Liveness.GetLocalsReadBeforeAssigned())
+        {
+            const FBlueprintSnapshotVariable& LocalVar = Snapshot.Variables[VariableIndex];
+
+            // Reading an explicit default value is intended
+            if(!LocalVar.DefaultValue.IsEmpty()) continue;
+
+            FValidatorXIssue& Issue = OutIssues.Emplace_GetRef(EMessageSeverity::Warning,
+                INVTEXT("Local variable '{0}' in function '{1}' may be read before it is set."),
+                FFormatOrderedArguments{FText::FromName(LocalVar.Name), FText::FromName(Graph.Name)});
+            Issue.GraphName = Graph.Name;
+            Issue.Subject = LocalVar.Name;
+        }
+    }
+}
+
+void ULocalVariableNeverUsedValidator::AddIssueTokens(UBlueprint* Blueprint, const FValidatorXIssue& Issue, const TSharedRef<FTokenizedMessage>& Message) const
+{
+    UEdGraph* Graph = FindIssueGraph(Blueprint, Issue);
+    UK2Node_FunctionEntry* EntryNode = Graph ? GetGraphIndex(Blueprint)->FindFunctionEntry(Graph) : nullptr;
+    if(!EntryNode) return;
+
+    const FName VarName = Issue.Subject;
 
-            for(UEdGraphNode* Node : Graph->Nodes)
+    if(Issue.NodeGuid.IsValid())
+    {
+        UEdGraphNode* SetNode = FindIssueNode(Blueprint, Issue);
+        if(!SetNode) return;
+
+        Message->AddToken(FActionToken::Create(INVTEXT("Jump to Set node"), FText::FromString(""), FSimpleDelegate::CreateLambda([=]
             {
-                if(UK2Node_FunctionEntry* Entry = Cast<UK2Node_FunctionEntry>(Node))
+                if(Blueprint && Graph)
                 {
-                    EntryNode = Entry;
-                    break;
+                    UAssetEditorSubsystem* AssetEditorSubsystem = GEditor->GetEditorSubsystem<UAssetEditorSubsystem>();
+                    AssetEditorSubsystem->OpenEditorForAsset(Blueprint);
+                    if(IAssetEditorInstance* EditorInstance = AssetEditorSubsystem->FindEditorForAsset(Blueprint, false))
+                    {
+                        if(FBlueprintEditor* BlueprintEditor = StaticCast<FBlueprintEditor*>(EditorInstance))
+                        {
+                            if(TSharedPtr<SGraphEditor> GraphEditor = BlueprintEditor->OpenGraphAndBringToFront(Graph, true))
+                            {
+                                GraphEditor->JumpToNode(SetNode, false);
+                            }
+                        }
+                    }
                 }
-            }
-   
-             if(!EntryNode)  continue;
-     
-             for(const FBPVariableDescription& LocalVar : EntryNode->LocalVariables)
-             {
-                 bool bUsed = false;
-
-                 for(UEdGraphNode* Node : Graph->Nodes)
-                 {
-                     if(const UK2Node_VariableGet* VarGet = Cast<UK2Node_VariableGet>(Node))
-                     {
-                         if(VarGet->GetVarName() == LocalVar.VarName)
-                         {
-                             
-                             bUsed = true;
-                             break;
-                         }
-                     }
-                     else if(const UK2Node_VariableSet* VarSet = Cast<UK2Node_VariableSet>(Node))
-                     {
-                         if(VarSet->GetVarName() == LocalVar.VarName)
-                         {
-                             
-                             bUsed = true;
-                             break;
-                         }
-                     }
-                 }
-     
-                 if(!bUsed)
-                 {
-                     const FText MessageText = FText::Format(
-                         INVTEXT("Local variable '{0}' in function '{1}' is never used."),
-                         FText::FromName(LocalVar.VarName),
-                         FText::FromString(Graph->GetName()));
-
-                     const TSharedRef<FTokenizedMessage> Message = Context.AddMessage(EMessageSeverity::Warning, MessageText);
-                     const FText JumpToVariableText = FText::Format(INVTEXT("Jump to variable  - '{0}'"), FText::FromName(LocalVar.VarName));
-                     Message->AddToken(FActionToken::Create(JumpToVariableText, FText::FromString(""), FSimpleDelegate::CreateLambda([=]
-                         {
-                             if(Blueprint && EntryNode)
-                             {
-                                 UAssetEditorSubsystem* AssetEditorSubsystem = GEditor->GetEditorSubsystem<UAssetEditorSubsystem>();
-                                 AssetEditorSubsystem->OpenEditorForAsset(Blueprint);
-                                 if(IAssetEditorInstance* EditorInstance = AssetEditorSubsystem->FindEditorForAsset(Blueprint, false))
-                                 {
-                                     if(FBlueprintEditor* BlueprintEditor = StaticCast<FBlueprintEditor*>(EditorInstance))
-                                     {
-                                         if (TSharedPtr<SGraphEditor> GraphEditor = BlueprintEditor->OpenGraphAndBringToFront(Graph, true))
-                                         {
-                                             if(TSharedPtr<SMyBlueprint> MyBlueprintWidget = BlueprintEditor->GetMyBlueprintWidget())
-                                             {
-                                                 MyBlueprintWidget->SelectItemByName(LocalVar.VarName,
-                                                     ESelectInfo::Direct,
-                                                     INDEX_NONE,
-                                                     false);
-                                             }
-                                         }
-                                     }
-                                 }
-                             }
-                         })));
-
-                     const FText DeleteVariableText = FText::Format(INVTEXT("'Fix' - Delete Local Variable - '{0}'"), FText::FromName(LocalVar.VarName));
-                     Message->AddToken(FActionToken::Create(DeleteVariableText, FText::FromString(""),
-                         FSimpleDelegate::CreateLambda([=]
-                             {
-                                 if (Blueprint && EntryNode)
-                                 {
-                                     UAssetEditorSubsystem* AssetEditorSubsystem = GEditor->GetEditorSubsystem<UAssetEditorSubsystem>();
-                                     AssetEditorSubsystem->OpenEditorForAsset(Blueprint);
-                                     FTSTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateLambda([=] (float DeltaTime)
-                                         {
-                                             if(IAssetEditorInstance* EditorInstance = AssetEditorSubsystem->FindEditorForAsset(Blueprint, /*bFocusIfOpen=*/false))
-                                             {
-                                                 if(FBlueprintEditor* BlueprintEditor = StaticCast<FBlueprintEditor*>(EditorInstance))
-                                                 {
-                                                     if(BlueprintEditor->GetMyBlueprintWidget().IsValid())
-                                                     {
-                                                         int32 IndexToRemove = INDEX_NONE;
-                                                         for(int32 i = 0; i < EntryNode->LocalVariables.Num(); ++i)
-                                                         {
-                                                             if(EntryNode->LocalVariables[i].VarName == LocalVar.VarName)
-                                                             {
-                                                                 IndexToRemove = i;
-                                                                 break;
-                                                             }
-                                                         }
-
-                                                         if(IndexToRemove != INDEX_NONE)
-                                                         {
-                                                             const FText ConfirmText = FText::Format(
-                                                                 INVTEXT("Are you sure you want to delete the dispatcher '{0}' from Blueprint '{1}'?"),
-                                                                 FText::FromName(LocalVar.VarName),
-                                                                 FText::FromString(Blueprint->GetName())
-                                                             );
-
-                                                             if(FMessageDialog::Open(EAppMsgType::YesNo, ConfirmText) == EAppReturnType::Yes)
-                                                             {
-                                                                 EntryNode->Modify();
-                                                                 EntryNode->LocalVariables.RemoveAt(IndexToRemove);
-                                                                 FBlueprintEditorUtils::MarkBlueprintAsStructurallyModified(Blueprint);
-                                                             }
-                                                         }
-
-                                                         return false;
-                                                     }
-                                                 }
-                                             }
-
-                                             return true;
-                                         }));
-                                 }
-                             })));
-
-
-                     bIsError = true;
-                 }
-             }
-        }
+            })));
+        return;
     }
-   
-    return bIsError ? EDataValidationResult::Invalid : EDataValidationResult::Valid;
+
+    const FText JumpToVariableText = FText::Format(INVTEXT("Jump to variable  - '{0}'"), FText::FromName(VarName));
+    Message->AddToken(FActionToken::Create(JumpToVariableText, FText::FromString(""), FSimpleDelegate::CreateLambda([=]
+        {
+            if(Blueprint && EntryNode)
+            {
+                UAssetEditorSubsystem* AssetEditorSubsystem = GEditor->GetEditorSubsystem<UAssetEditorSubsystem>();
+                AssetEditorSubsystem->OpenEditorForAsset(Blueprint);
+                if(IAssetEditorInstance* EditorInstance = AssetEditorSubsystem->FindEditorForAsset(Blueprint, false))
+                {
+                    if(FBlueprintEditor* BlueprintEditor = StaticCast<FBlueprintEditor*>(EditorInstance))
+                    {
+                        if (TSharedPtr<SGraphEditor> GraphEditor = BlueprintEditor->OpenGraphAndBringToFront(Graph, true))
+                        {
+                            if(TSharedPtr<SMyBlueprint> MyBlueprintWidget = BlueprintEditor->GetMyBlueprintWidget())
+                            {
+                                MyBlueprintWidget->SelectItemByName(VarName,
+                                    ESelectInfo::Direct,
+                                    INDEX_NONE,
+                                    false);
+                            }
+                        }
+                    }
+                }
+            }
+        })));
+
+    // Only offer to delete locals no node references anymore
+    if(GetGraphIndex(Blueprint)->IsVariableReferenced(VarName, Graph)) return;
+
+    const FText DeleteVariableText = FText::Format(INVTEXT("'Fix' - Delete Local Variable - '{0}'"), FText::FromName(VarName));
+    Message->AddToken(FActionToken::Create(DeleteVariableText, FText::FromString(""),
+        FSimpleDelegate::CreateLambda([=]
+            {
+                if (Blueprint && EntryNode)
+                {
+                    UAssetEditorSubsystem* AssetEditorSubsystem = GEditor->GetEditorSubsystem<UAssetEditorSubsystem>();
+                    AssetEditorSubsystem->OpenEditorForAsset(Blueprint);
+                    FTSTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateLambda([=] (float DeltaTime)
+                        {
+                            if(IAssetEditorInstance* EditorInstance = AssetEditorSubsystem->FindEditorForAsset(Blueprint, /*bFocusIfOpen=*/false))
+                            {
+                                if(FBlueprintEditor* BlueprintEditor = StaticCast<FBlueprintEditor*>(EditorInstance))
+                                {
+                                    if(BlueprintEditor->GetMyBlueprintWidget().IsValid())
+                                    {
+                                        int32 IndexToRemove = INDEX_NONE;
+                                        for(int32 i = 0; i < EntryNode->LocalVariables.Num(); ++i)
+                                        {
+                                            if(EntryNode->LocalVariables[i].VarName == VarName)
+                                            {
+                                                IndexToRemove = i;
+                                                break;
+                                            }
+                                        }
+
+                                        if(IndexToRemove != INDEX_NONE)
+                                        {
+                                            const FText ConfirmText = FText::Format(
+                                                INVTEXT("Are you sure you want to delete the dispatcher '{0}' from Blueprint '{1}'?"),
+                                                FText::FromName(VarName),
+                                                FText::FromString(Blueprint->GetName())
+                                            );
+
+                                            if(FMessageDialog::Open(EAppMsgType::YesNo, ConfirmText) == EAppReturnType::Yes)
+                                            {
+                                                EntryNode->Modify();
+                                                EntryNode->LocalVariables.RemoveAt(IndexToRemove);
+                                                FBlueprintEditorUtils::MarkBlueprintAsStructurallyModified(Blueprint);
+                                            }
+                                        }
+
+                                        return false;
+                                    }
+                                }
+                            }
+
+                            return true;
+                        }));
+                }
+            })));
+}
+
+bool ULocalVariableNeverUsedValidator::ApplyIssueFix(UBlueprint* Blueprint, const FValidatorXIssue& Issue) const
+{
+    // Issues about a Set node have no fix
+    if(Issue.NodeGuid.IsValid()) return false;
+
+    UEdGraph* Graph = FindIssueGraph(Blueprint, Issue);
+    UK2Node_FunctionEntry* EntryNode = Graph ? GetGraphIndex(Blueprint)->FindFunctionEntry(Graph) : nullptr;
+    if(!EntryNode || GetGraphIndex(Blueprint)->IsVariableReferenced(Issue.Subject, Graph)) return false;
+
+    const int32 IndexToRemove = EntryNode->LocalVariables.IndexOfByPredicate([&Issue] (const FBPVariableDescription& LocalVar)
+        {
+            return LocalVar.VarName == Issue.Subject;
+        });
+    if(IndexToRemove == INDEX_NONE) return false;
+
+    EntryNode->Modify();
+    EntryNode->LocalVariables.RemoveAt(IndexToRemove);
+    return true;
 }
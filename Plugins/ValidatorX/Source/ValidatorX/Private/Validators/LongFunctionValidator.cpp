@@ -2,12 +2,13 @@
 
 
 #include "Validators/LongFunctionValidator.h"
-#include "K2Node_FunctionEntry.h"
-#include "K2Node_FunctionResult.h"
 #include "Subsystems/AssetEditorSubsystem.h"
 #include "BlueprintEditorModule.h"
 #include "Misc/DataValidation.h"
 #include "Library/BPUtilsNodeFunctionLibrary.h"
+#include "Analysis/BlueprintSnapshot.h"
+#include "ValidatorXTypes.h"
+#include "Stats/ValidatorXStats.h"
 
 ULongFunctionValidator::ULongFunctionValidator()
 {
@@ -27,71 +28,72 @@ bool ULongFunctionValidator::IsEnabled() const
 
 EDataValidationResult ULongFunctionValidator::ValidateLoadedAsset_Implementation(const FAssetData& InAssetData, UObject* InAsset, FDataValidationContext& Context)
 {
-	constexpr int32 NodeLimit = 200;
+	VALIDATORX_SCOPE_VALIDATE(InAssetData, Context);
 	bIsError = false;
 
 	if(UBlueprint* Blueprint = Cast<UBlueprint>(InAsset))
 	{
+		return ValidateSnapshot(Blueprint, Context);
+	}
 
-		TArray<UEdGraph*> AllGraphs = Blueprint->UbergraphPages;
-		AllGraphs.Append(Blueprint->FunctionGraphs);
-		AllGraphs.Append(Blueprint->MacroGraphs);
-		AllGraphs.Append(Blueprint->DelegateSignatureGraphs);
-		AllGraphs.Append(Blueprint->IntermediateGeneratedGraphs);
+	return EDataValidationResult::Valid;
+}
 
-		for(UEdGraph* Graph : AllGraphs)
-		{
-			if(!Graph) continue;
+void ULongFunctionValidator::AnalyzeSnapshot(const FBlueprintSnapshot& Snapshot, TArray<FValidatorXIssue>& OutIssues) const
+{
+	constexpr int32 NodeLimit = 200;
 
-			int32 NodeCount = 0;
-			for(UEdGraphNode* Node : Graph->Nodes)
+	for(int32 GraphIndex = 0; GraphIndex < Snapshot.Graphs.Num(); ++GraphIndex)
+	{
+		const FBlueprintSnapshotGraph& Graph = Snapshot.Graphs[GraphIndex];
+		if(Graph.Type == EValidatorXGraphType::Nested) continue;
+
+		int32 NodeCount = 0;
+		for(const FBlueprintSnapshotNode& Node : Snapshot.GetNodes(GraphIndex))
+		{
+			if(Node.Kind != EValidatorXNodeKind::FunctionEntry && Node.Kind != EValidatorXNodeKind::FunctionResult)
 			{
-				if(Node && !Node->IsA<UK2Node_FunctionEntry>() && !Node->IsA<UK2Node_FunctionResult>())
-				{
-					NodeCount++;
-				}
+				NodeCount++;
 			}
+		}
 
+		if(NodeCount > NodeLimit)
+		{
+			FValidatorXIssue& Issue = OutIssues.Emplace_GetRef(EMessageSeverity::Warning,
+				INVTEXT("'{0}' - '{1}' contains {2} nodes, which exceeds the recommended limit of {3}. Consider splitting it into smaller functions."),
+				FFormatOrderedArguments{FText::FromString(LexToString(Graph.Type)), FText::FromName(Graph.Name), NodeCount, NodeLimit});
+			Issue.GraphName = Graph.Name;
+		}
+	}
+}
 
+void ULongFunctionValidator::AddIssueTokens(UBlueprint* Blueprint, const FValidatorXIssue& Issue, const TSharedRef<FTokenizedMessage>& Message) const
+{
+	UEdGraph* Graph = FindIssueGraph(Blueprint, Issue);
+	if(!Graph) return;
+
+	const FString GraphType = UBPUtilsNodeFunctionLibrary::GetGraphType(Blueprint, Graph);
+	const FText JumpText = FText::Format(INVTEXT("Jump to '{0}' - {1}"), FText::FromString(Graph->GetName()), FText::FromString(GraphType));
 
-			if(NodeCount > NodeLimit)
+	Message->AddToken(FActionToken::Create(
+		JumpText,
+		FText::FromString(""),
+		FSimpleDelegate::CreateLambda([=]
 			{
-				const FString GraphType = UBPUtilsNodeFunctionLibrary::GetGraphType(Blueprint, Graph);
-				const FText MessageText = FText::Format(
-					INVTEXT("'{0}' - '{1}' contains {2} nodes, which exceeds the recommended limit of {3}. Consider splitting it into smaller functions."),
-					FText::FromString(GraphType),
-					FText::FromString(Graph->GetName()),
-					FText::AsNumber(NodeCount),
-					FText::AsNumber(NodeLimit)
-				);
-				const FText JumpText = FText::Format(INVTEXT("Jump to '{0}' - {1}"), FText::FromString(Graph->GetName()), FText::FromString(GraphType));
-
-				TSharedRef<FTokenizedMessage> Message = Context.AddMessage(EMessageSeverity::Warning, MessageText);
-				Message->AddToken(FActionToken::Create(
-					JumpText,
-					FText::FromString(""),
-					FSimpleDelegate::CreateLambda([=]
+				if(Blueprint && Graph)
+				{
+					if(UAssetEditorSubsystem* AssetEditorSubsystem = GEditor->GetEditorSubsystem<UAssetEditorSubsystem>())
+					{
+						AssetEditorSubsystem->OpenEditorForAsset(Blueprint);
+
+						if(IAssetEditorInstance* EditorInstance = AssetEditorSubsystem->FindEditorForAsset(Blueprint, false))
 						{
-							if(Blueprint && Graph)
+							if(IBlueprintEditor* BlueprintEditor = StaticCast<IBlueprintEditor*>(EditorInstance))
 							{
-								if(UAssetEditorSubsystem* AssetEditorSubsystem = GEditor->GetEditorSubsystem<UAssetEditorSubsystem>())
-								{
-									AssetEditorSubsystem->OpenEditorForAsset(Blueprint);
-
-									if(IAssetEditorInstance* EditorInstance = AssetEditorSubsystem->FindEditorForAsset(Blueprint, false))
-									{
-										if(IBlueprintEditor* BlueprintEditor = StaticCast<IBlueprintEditor*>(EditorInstance))
-										{
-											BlueprintEditor->OpenGraphAndBringToFront(Graph, true);
-										}
-									}
-								}
+								BlueprintEditor->OpenGraphAndBringToFront(Graph, true);
 							}
-						})));
-				bIsError = true;
-			}
-		}
-	}
-
-	return bIsError ? EDataValidationResult::Invalid : EDataValidationResult::Valid;
+						}
+					}
+				}
+			})));
 }
@@ -0,0 +1,415 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "Validators/PureNodeReevaluationValidator.h"
+#include "BlueprintEditorModule.h"
+#include "EdGraphSchema_K2.h"
+#include "K2Node_CallFunction.h"
+#include "K2Node_FunctionEntry.h"
+#include "K2Node_VariableGet.h"
+#include "K2Node_VariableSet.h"
+#include "Kismet2/BlueprintEditorUtils.h"
+#include "ScopedTransaction.h"
+#include "Misc/DataValidation.h"
+#include "Analysis/BlueprintGraphIndex.h"
+#include "Analysis/BlueprintSnapshot.h"
+#include "Analysis/ExecReachability.h"
+#include "Analysis/LoopBodyIndex.h"
+#include "ValidatorXTypes.h"
+#include "Stats/ValidatorXStats.h"
+
+namespace
+{
+	/** Where the result of a pure node is cached: in a local variable set just before its first reader. */
+	struct FPureResultCachePlacement
+	{
+		/** The single linked output of the pure node. */
+		UEdGraphPin* ResultPin = nullptr;
+
+		/** The impure reader every other reader runs after, which evaluates the node first. */
+		UEdGraphNode* FirstReader = nullptr;
+
+		/** The linked execution input of the first reader, where the Set node goes. */
+		UEdGraphPin* FirstReaderExecPin = nullptr;
+	};
+
+	/** Collects the nodes execution reaches from a node, without going through a blocked node. */
+	void CollectExecSuccessors(UEdGraphNode* Start, const UEdGraphNode* Blocked, TSet<const UEdGraphNode*>& OutReached)
+	{
+		TArray<UEdGraphNode*> Stack;
+		Stack.Add(Start);
+		OutReached.Add(Start);
+		while(!Stack.IsEmpty())
+		{
+			UEdGraphNode* Node = Stack.Pop(EAllowShrinking::No);
+			for(UEdGraphPin* Pin : Node->Pins)
+			{
+				if(!Pin || Pin->Direction != EGPD_Output || Pin->PinType.PinCategory != UEdGraphSchema_K2::PC_Exec) continue;
+
+				for(UEdGraphPin* LinkedPin : Pin->LinkedTo)
+				{
+					UEdGraphNode* Next = LinkedPin ? LinkedPin->GetOwningNode() : nullptr;
+					if(Next && Next != Blocked && !OutReached.Contains(Next))
+					{
+						OutReached.Add(Next);
+						Stack.Add(Next);
+					}
+				}
+			}
+		}
+	}
+
+	/**
+	 * Finds where the result of a pure node can be cached without changing what its function does.
+	 *
+	 * The node needs a single linked data output, and one of the impure nodes reading it, directly or
+	 * through other pure nodes, must run on every execution path leading to the others. The Set node
+	 * goes right before that reader, where the node was evaluated first anyway, so the call never runs
+	 * on paths that did not evaluate it and still sees the state its first reader saw.
+	 *
+	 * @param PureNode      The node to cache
+	 * @param EntryNode     The entry of the function owning the node
+	 * @param OutPlacement  Receives the result pin and the reader to insert the Set node before
+	 * @return True if the result can be cached
+	 */
+	bool FindPureResultCachePlacement(UK2Node_CallFunction& PureNode, UK2Node_FunctionEntry& EntryNode, FPureResultCachePlacement& OutPlacement)
+	{
+		if(!PureNode.IsNodePure()) return false;
+
+		UEdGraphPin* ResultPin = nullptr;
+		for(UEdGraphPin* Pin : PureNode.Pins)
+		{
+			if(Pin && Pin->Direction == EGPD_Output && !Pin->LinkedTo.IsEmpty())
+			{
+				if(ResultPin) return false;
+				ResultPin = Pin;
+			}
+		}
+		if(!ResultPin) return false;
+
+		// Impure readers, found through the pure nodes in between
+		TArray<UEdGraphNode*> Readers;
+		TSet<UEdGraphNode*> Visited;
+		TArray<UEdGraphPin*> Stack(ResultPin->LinkedTo);
+		while(!Stack.IsEmpty())
+		{
+			UEdGraphPin* LinkedPin = Stack.Pop(EAllowShrinking::No);
+			UEdGraphNode* Node = LinkedPin ? LinkedPin->GetOwningNode() : nullptr;
+			if(!Node || Visited.Contains(Node)) continue;
+			Visited.Add(Node);
+
+			const UK2Node* K2Node = Cast<UK2Node>(Node);
+			if(!K2Node || !K2Node->IsNodePure())
+			{
+				Readers.Add(Node);
+				continue;
+			}
+			for(UEdGraphPin* Pin : Node->Pins)
+			{
+				if(Pin && Pin->Direction == EGPD_Output)
+				{
+					Stack.Append(Pin->LinkedTo);
+				}
+			}
+		}
+
+		TSet<const UEdGraphNode*> Reachable;
+		CollectExecSuccessors(&EntryNode, nullptr, Reachable);
+
+		for(UEdGraphNode* Candidate : Readers)
+		{
+			if(!Reachable.Contains(Candidate)) continue;
+
+			UEdGraphPin* ExecPin = nullptr;
+			bool bHasSeveralExecInputs = false;
+			for(UEdGraphPin* Pin : Candidate->Pins)
+			{
+				if(Pin && Pin->Direction == EGPD_Input && Pin->PinType.PinCategory == UEdGraphSchema_K2::PC_Exec && !Pin->LinkedTo.IsEmpty())
+				{
+					bHasSeveralExecInputs |= ExecPin != nullptr;
+					ExecPin = Pin;
+				}
+			}
+			if(!ExecPin || bHasSeveralExecInputs) continue;
+
+			// The candidate runs first on every path if no other reader can be reached without it
+			TSet<const UEdGraphNode*> ReachableWithout;
+			CollectExecSuccessors(&EntryNode, Candidate, ReachableWithout);
+			const bool bRunsFirst = !Readers.ContainsByPredicate([Candidate, &ReachableWithout](const UEdGraphNode* Reader)
+				{
+					return Reader != Candidate && ReachableWithout.Contains(Reader);
+				});
+			if(bRunsFirst)
+			{
+				OutPlacement.ResultPin = ResultPin;
+				OutPlacement.FirstReader = Candidate;
+				OutPlacement.FirstReaderExecPin = ExecPin;
+				return true;
+			}
+		}
+		return false;
+	}
+} // namespace
+
+UPureNodeReevaluationValidator::UPureNodeReevaluationValidator()
+{
+	ExpensivePureFunctions = {
+		TEXT("GetOverlappingActors"),
+		TEXT("GetOverlappingComponents"),
+		TEXT("K2_GetComponentsByClass"),
+		TEXT("GetComponentsByTag"),
+		TEXT("GetComponentsByInterface"),
+		TEXT("GetAllChildActors"),
+		TEXT("GetAttachedActors"),
+		TEXT("FindLookAtRotation"),
+		TEXT("Array_Find"),
+		TEXT("Array_Contains"),
+		TEXT("Array_Identical"),
+		TEXT("Map_Keys"),
+		TEXT("Map_Values"),
+		TEXT("Set_ToArray"),
+		TEXT("MaxOfIntArray"),
+		TEXT("MinOfIntArray"),
+		TEXT("MaxOfFloatArray"),
+		TEXT("MinOfFloatArray"),
+	};
+
+	SetValidationEnabled(true);
+}
+
+bool UPureNodeReevaluationValidator::CanValidateAsset_Implementation(const FAssetData& InAssetData, UObject* InAsset, FDataValidationContext& InContext) const
+{
+	return InAsset && InAsset->IsA<UBlueprint>();
+}
+
+bool UPureNodeReevaluationValidator::IsEnabled() const
+{
+	static const UPureNodeReevaluationValidator* CDO = GetDefault<UPureNodeReevaluationValidator>();
+	return CDO->bIsEnabled && !bIsConfigDisabled;
+}
+
+EDataValidationResult UPureNodeReevaluationValidator::ValidateLoadedAsset_Implementation(const FAssetData& InAssetData, UObject* InAsset, FDataValidationContext& Context)
+{
+	VALIDATORX_SCOPE_VALIDATE(InAssetData, Context);
+	bIsError = false;
+
+	if(UBlueprint* Blueprint = Cast<UBlueprint>(InAsset))
+	{
+		return ValidateSnapshot(Blueprint, Context);
+	}
+
+	return EDataValidationResult::Valid;
+}
+
+void UPureNodeReevaluationValidator::AnalyzeSnapshot(const FBlueprintSnapshot& Snapshot, TArray<FValidatorXIssue>& OutIssues) const
+{
+	const FExecReachability Reachability(Snapshot);
+	const FLoopBodyIndex LoopBodies(Snapshot);
+
+	TArray<int32> Evaluations;
+	Evaluations.Init(0, Snapshot.Nodes.Num());
+
+	// Stamped with the consumer being walked, so a pure node read by several pins of a node counts once
+	TArray<int32> VisitStamps;
+	VisitStamps.Init(INDEX_NONE, Snapshot.Nodes.Num());
+	TArray<int32> Stack;
+
+	for(int32 ConsumerIndex = 0; ConsumerIndex < Snapshot.Nodes.Num(); ++ConsumerIndex)
+	{
+		const FBlueprintSnapshotNode& Consumer = Snapshot.Nodes[ConsumerIndex];
+		if(Consumer.bIsPure || Consumer.Kind == EValidatorXNodeKind::Comment || !Reachability.IsReachable(ConsumerIndex)) continue;
+
+		Stack.Add(ConsumerIndex);
+		while(!Stack.IsEmpty())
+		{
+			const FBlueprintSnapshotNode& Node = Snapshot.Nodes[Stack.Pop(EAllowShrinking::No)];
+			for(int32 PinIndex = Node.FirstPin; PinIndex < Node.FirstPin + Node.NumPins; ++PinIndex)
+			{
+				const FBlueprintSnapshotPin& Pin = Snapshot.Pins[PinIndex];
+				if(Pin.Direction != EGPD_Input || Pin.Category == UEdGraphSchema_K2::PC_Exec) continue;
+
+				for(const FBlueprintSnapshotLink& Link : Snapshot.GetLinks(PinIndex))
+				{
+					const int32 SourceIndex = Snapshot.Pins[Link.ToPin].Node;
+					if(Snapshot.Nodes[SourceIndex].bIsPure && VisitStamps[SourceIndex] != ConsumerIndex)
+					{
+						VisitStamps[SourceIndex] = ConsumerIndex;
+						++Evaluations[SourceIndex];
+						Stack.Add(SourceIndex);
+					}
+				}
+			}
+		}
+	}
+
+	for(int32 NodeIndex = 0; NodeIndex < Snapshot.Nodes.Num(); ++NodeIndex)
+	{
+		const FBlueprintSnapshotNode& Node = Snapshot.Nodes[NodeIndex];
+		if(!Node.bIsPure || Node.Kind != EValidatorXNodeKind::CallFunction || Evaluations[NodeIndex] == 0) continue;
+
+		const bool bIsExpensive = ExpensivePureFunctions.Contains(Node.MemberName)
+			|| (bIncludeBlueprintPureFunctions && Node.MemberPackage == Snapshot.PackageName);
+		if(!bIsExpensive) continue;
+
+		const FName GraphName = Snapshot.Graphs[Node.Graph].Name;
+		FValidatorXIssue* Issue = nullptr;
+
+		const int32 LoopIndex = LoopBodies.GetInnermostLoop(NodeIndex);
+		if(LoopIndex != INDEX_NONE)
+		{
+			const FBlueprintSnapshotNode& Loop = Snapshot.Nodes[LoopBodies.GetLoopNode(LoopIndex)];
+			Issue = &OutIssues.Emplace_GetRef(EMessageSeverity::Warning,
+				INVTEXT("Pure '{0}' in '{1}' is evaluated on every iteration of '{2}'. Compute it once before the loop if it does not depend on the loop."),
+				FFormatOrderedArguments{FText::FromName(Node.MemberName), FText::FromName(GraphName), FText::FromName(Loop.MemberName)});
+		}
+		else if(Evaluations[NodeIndex] >= MinEvaluations)
+		{
+			Issue = &OutIssues.Emplace_GetRef(EMessageSeverity::Warning,
+				INVTEXT("Pure '{0}' in '{1}' is evaluated {2} times, once for each node reading it. Cache its result in a local variable."),
+				FFormatOrderedArguments{FText::FromName(Node.MemberName), FText::FromName(GraphName), Evaluations[NodeIndex]});
+		}
+
+		if(Issue)
+		{
+			Issue->GraphName = GraphName;
+			Issue->NodeGuid = Node.Guid;
+			Issue->Subject = Node.MemberName;
+		}
+	}
+}
+
+void UPureNodeReevaluationValidator::AddIssueTokens(UBlueprint* Blueprint, const FValidatorXIssue& Issue, const TSharedRef<FTokenizedMessage>& Message) const
+{
+	UEdGraph* Graph = FindIssueGraph(Blueprint, Issue);
+	UEdGraphNode* Node = FindIssueNode(Blueprint, Issue);
+	if(!Graph || !Node) return;
+
+	AddJumpToNodeToken(Blueprint, Issue, Message);
+
+	UK2Node_CallFunction* CallNode = Cast<UK2Node_CallFunction>(Node);
+	UK2Node_FunctionEntry* EntryNode = GetGraphIndex(Blueprint)->FindFunctionEntry(Graph);
+	FPureResultCachePlacement Placement;
+	if(!CallNode || !EntryNode || !FindPureResultCachePlacement(*CallNode, *EntryNode, Placement)) return;
+
+	const FText FirstReaderTitle = Placement.FirstReader->GetNodeTitle(ENodeTitleType::ListView);
+
+	const TWeakObjectPtr<const UPureNodeReevaluationValidator> WeakThis(this);
+	Message->AddToken(FActionToken::Create(
+		FText::Format(INVTEXT("Fix: Cache '{0}' in a local variable"), FText::FromName(Issue.Subject)),
+		FText::GetEmpty(),
+		FSimpleDelegate::CreateLambda([=]
+			{
+				if(!WeakThis.IsValid() || !Blueprint) return;
+
+				const FText ConfirmText = FText::Format(
+					INVTEXT("Evaluate '{0}' once, just before '{1}' in '{2}', and read its result from a local variable?"),
+					FText::FromName(Issue.Subject), FirstReaderTitle, FText::FromName(Issue.GraphName));
+				if(FMessageDialog::Open(EAppMsgType::YesNo, ConfirmText) != EAppReturnType::Yes) return;
+
+				const FScopedTransaction Transaction(INVTEXT("ValidatorX: Cache Pure Node Result"));
+				if(WeakThis->ApplyIssueFix(Blueprint, Issue))
+				{
+					FBlueprintEditorUtils::MarkBlueprintAsStructurallyModified(Blueprint);
+				}
+			})));
+}
+
+bool UPureNodeReevaluationValidator::ApplyIssueFix(UBlueprint* Blueprint, const FValidatorXIssue& Issue) const
+{
+	UEdGraph* Graph = FindIssueGraph(Blueprint, Issue);
+	UK2Node_CallFunction* PureNode = Cast<UK2Node_CallFunction>(FindIssueNode(Blueprint, Issue));
+	UK2Node_FunctionEntry* EntryNode = Graph ? GetGraphIndex(Blueprint)->FindFunctionEntry(Graph) : nullptr;
+	if(!PureNode || !EntryNode || !Graph->Nodes.Contains(PureNode)) return false;
+
+	FPureResultCachePlacement Placement;
+	if(!FindPureResultCachePlacement(*PureNode, *EntryNode, Placement)) return false;
+	UEdGraphPin* ResultPin = Placement.ResultPin;
+	UEdGraphNode* FirstReader = Placement.FirstReader;
+
+	// Local variables share the namespace of member variables
+	const FString BaseName = FString::Printf(TEXT("Cached%s"), *PureNode->FunctionReference.GetMemberName().ToString());
+	FName VarName(*BaseName);
+	auto IsNameTaken = [Blueprint, EntryNode](FName Name)
+	{
+		return FBlueprintEditorUtils::FindNewVariableIndex(Blueprint, Name) != INDEX_NONE
+			|| EntryNode->LocalVariables.ContainsByPredicate([Name](const FBPVariableDescription& Variable) { return Variable.VarName == Name; });
+	};
+	for(int32 Suffix = 1; IsNameTaken(VarName); ++Suffix)
+	{
+		VarName = FName(*FString::Printf(TEXT("%s_%d"), *BaseName, Suffix));
+	}
+
+	Graph->Modify();
+	EntryNode->Modify();
+	PureNode->Modify();
+	FirstReader->Modify();
+
+	FBPVariableDescription& CachedVariable = EntryNode->LocalVariables.AddDefaulted_GetRef();
+	CachedVariable.VarName = VarName;
+	CachedVariable.VarGuid = FGuid::NewGuid();
+	CachedVariable.VarType = ResultPin->PinType;
+	CachedVariable.FriendlyName = FName::NameToDisplayString(VarName.ToString(), ResultPin->PinType.PinCategory == UEdGraphSchema_K2::PC_Boolean);
+	CachedVariable.Category = UEdGraphSchema_K2::VR_DefaultCategory;
+	CachedVariable.PropertyFlags |= CPF_BlueprintVisible;
+	const FGuid VarGuid = CachedVariable.VarGuid;
+
+	FGraphNodeCreator<UK2Node_VariableSet> SetCreator(*Graph);
+	UK2Node_VariableSet* SetNode = SetCreator.CreateNode(false);
+	SetNode->VariableReference.SetLocalMember(VarName, Graph->GetName(), VarGuid);
+	SetNode->NodePosX = FirstReader->NodePosX - 250;
+	SetNode->NodePosY = FirstReader->NodePosY + 150;
+	SetCreator.Finalize();
+
+	// The value pin only exists once the node is created: without it, take the node and variable back out before anything is relinked
+	UEdGraphPin* ValuePin = SetNode->FindPin(VarName, EGPD_Input);
+	if(!ValuePin)
+	{
+		Graph->RemoveNode(SetNode);
+		EntryNode->LocalVariables.RemoveAll([&VarGuid](const FBPVariableDescription& Variable) { return Variable.VarGuid == VarGuid; });
+		return false;
+	}
+
+	// Set the variable right before the first reader
+	UEdGraphPin* ReaderExecPin = Placement.FirstReaderExecPin;
+	const TArray<UEdGraphPin*> PreviousPins = ReaderExecPin->LinkedTo;
+	ReaderExecPin->BreakAllPinLinks();
+	for(UEdGraphPin* PreviousPin : PreviousPins)
+	{
+		PreviousPin->MakeLinkTo(SetNode->GetExecPin());
+	}
+	SetNode->GetThenPin()->MakeLinkTo(ReaderExecPin);
+
+	// Read the variable everywhere the result was read
+	const TArray<UEdGraphPin*> ConsumerPins = ResultPin->LinkedTo;
+	ResultPin->BreakAllPinLinks();
+	ResultPin->MakeLinkTo(ValuePin);
+
+	for(UEdGraphPin* ConsumerPin : ConsumerPins)
+	{
+		UEdGraphNode* Consumer = ConsumerPin->GetOwningNode();
+		Consumer->Modify();
+
+		FGraphNodeCreator<UK2Node_VariableGet> GetCreator(*Graph);
+		UK2Node_VariableGet* GetNode = GetCreator.CreateNode(false);
+		GetNode->VariableReference.SetLocalMember(VarName, Graph->GetName(), VarGuid);
+		GetNode->NodePosX = Consumer->NodePosX - 200;
+		GetNode->NodePosY = Consumer->NodePosY + 100;
+		GetCreator.Finalize();
+
+		if(UEdGraphPin* GetValuePin = GetNode->GetValuePin())
+		{
+			GetValuePin->MakeLinkTo(ConsumerPin);
+		}
+	}
+
+	return true;
+}
+
+int32 UPureNodeReevaluationValidator::GetCacheVersion() const
+{
+	return FValidatorXSettingsHash()
+		.Add(bIncludeBlueprintPureFunctions)
+		.Add(MinEvaluations)
+		.AddNames(ExpensivePureFunctions)
+		.GetCacheVersion(1);
+}
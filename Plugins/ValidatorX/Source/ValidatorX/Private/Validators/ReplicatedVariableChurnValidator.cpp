@@ -0,0 +1,328 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "Validators/ReplicatedVariableChurnValidator.h"
+#include "EdGraphSchema_K2.h"
+#include "Misc/DataValidation.h"
+#include "Analysis/BlueprintSnapshot.h"
+#include "Analysis/ExecReachability.h"
+#include "ValidatorXTypes.h"
+#include "Stats/ValidatorXStats.h"
+
+namespace
+{
+	const FName SetTimerByEventFunction(TEXT("K2_SetTimerDelegate"));
+	const FName SetTimerByNameFunction(TEXT("K2_SetTimer"));
+
+	/** @return The event nodes of the snapshot keyed by function name, custom events included. */
+	TMap<FName, int32> IndexChurnEvents(const FBlueprintSnapshot& Snapshot)
+	{
+		TMap<FName, int32> Events;
+		for(int32 NodeIndex = 0; NodeIndex < Snapshot.Nodes.Num(); ++NodeIndex)
+		{
+			const FBlueprintSnapshotNode& Node = Snapshot.Nodes[NodeIndex];
+			if(Node.Kind == EValidatorXNodeKind::Event && !Node.MemberName.IsNone())
+			{
+				Events.FindOrAdd(Node.MemberName, NodeIndex);
+			}
+		}
+		return Events;
+	}
+
+	/** @return The entry node of the function or custom event of the Blueprint with the given name, or `INDEX_NONE`. */
+	int32 FindChurnCallee(const FBlueprintSnapshot& Snapshot, const TMap<FName, int32>& Events, FName FunctionName)
+	{
+		const int32 GraphIndex = Snapshot.FindGraph(FunctionName);
+		if(GraphIndex != INDEX_NONE && Snapshot.Graphs[GraphIndex].Type == EValidatorXGraphType::Function)
+		{
+			return Snapshot.Graphs[GraphIndex].EntryNode;
+		}
+
+		const int32* EventIndex = Events.Find(FunctionName);
+		return EventIndex ? *EventIndex : INDEX_NONE;
+	}
+
+	/** @return Whether a pin is linked, or holds the given literal otherwise. */
+	bool IsChurnPinLinkedOr(const FBlueprintSnapshotPin* Pin, const TCHAR* DefaultValue)
+	{
+		return Pin && (Pin->NumLinks > 0 || Pin->DefaultValue == DefaultValue);
+	}
+
+	/**
+	 * Collects the nodes run by an entry point: its execution chain, continued into the functions
+	 * and custom events of the Blueprint it calls.
+	 *
+	 * @param Snapshot      Snapshot of the validated Blueprint
+	 * @param Events        Event nodes keyed by function name
+	 * @param EntryIndex    Index of the entry node
+	 * @param Stamp         Stamp marking the nodes visited by this walk
+	 * @param VisitStamps   Stamp of the last walk that visited each node
+	 * @param OutNodes      Receives the collected nodes, entry included
+	 */
+	void CollectChurnChain(const FBlueprintSnapshot& Snapshot, const TMap<FName, int32>& Events, int32 EntryIndex, int32 Stamp, TArray<int32>& VisitStamps, TArray<int32>& OutNodes)
+	{
+		TArray<int32> Stack;
+		Stack.Add(EntryIndex);
+		VisitStamps[EntryIndex] = Stamp;
+
+		auto Visit = [&](int32 NodeIndex)
+		{
+			if(NodeIndex != INDEX_NONE && VisitStamps[NodeIndex] != Stamp)
+			{
+				VisitStamps[NodeIndex] = Stamp;
+				Stack.Add(NodeIndex);
+			}
+		};
+
+		while(!Stack.IsEmpty())
+		{
+			const int32 NodeIndex = Stack.Pop(EAllowShrinking::No);
+			OutNodes.Add(NodeIndex);
+
+			const FBlueprintSnapshotNode& Node = Snapshot.Nodes[NodeIndex];
+			if(Node.Kind == EValidatorXNodeKind::CallFunction && Node.MemberPackage == Snapshot.PackageName)
+			{
+				Visit(FindChurnCallee(Snapshot, Events, Node.MemberName));
+			}
+
+			for(int32 PinIndex = Node.FirstPin; PinIndex < Node.FirstPin + Node.NumPins; ++PinIndex)
+			{
+				const FBlueprintSnapshotPin& Pin = Snapshot.Pins[PinIndex];
+				if(Pin.Category != UEdGraphSchema_K2::PC_Exec || Pin.Direction != EGPD_Output) continue;
+
+				for(const FBlueprintSnapshotLink& Link : Snapshot.GetLinks(PinIndex))
+				{
+					Visit(Snapshot.Pins[Link.ToPin].Node);
+				}
+			}
+		}
+	}
+
+	/** @return The name shown for an entry node: the event, or the node class without its prefix. */
+	FString GetChurnEntryDisplayName(const FBlueprintSnapshot& Snapshot, int32 NodeIndex)
+	{
+		const FBlueprintSnapshotNode& Node = Snapshot.Nodes[NodeIndex];
+		if(Node.Kind == EValidatorXNodeKind::FunctionEntry) return Snapshot.Graphs[Node.Graph].Name.ToString();
+		if(!Node.MemberName.IsNone()) return Node.MemberName.ToString();
+
+		FString ClassName = Node.NodeClass.ToString();
+		ClassName.RemoveFromStart(TEXT("K2Node_"));
+		return ClassName;
+	}
+} // namespace
+
+UReplicatedVariableChurnValidator::UReplicatedVariableChurnValidator()
+{
+	// Input events only fire on the owning client, where a Set of a replicated variable is never sent
+	EveryFrameEvents = {
+		TEXT("ReceiveTick"),
+	};
+
+	SetValidationEnabled(true);
+}
+
+bool UReplicatedVariableChurnValidator::CanValidateAsset_Implementation(const FAssetData& InAssetData, UObject* InAsset, FDataValidationContext& InContext) const
+{
+	return InAsset && InAsset->IsA<UBlueprint>();
+}
+
+bool UReplicatedVariableChurnValidator::IsEnabled() const
+{
+	static const UReplicatedVariableChurnValidator* CDO = GetDefault<UReplicatedVariableChurnValidator>();
+	return CDO->bIsEnabled && !bIsConfigDisabled;
+}
+
+EDataValidationResult UReplicatedVariableChurnValidator::ValidateLoadedAsset_Implementation(const FAssetData& InAssetData, UObject* InAsset, FDataValidationContext& Context)
+{
+	VALIDATORX_SCOPE_VALIDATE(InAssetData, Context);
+	bIsError = false;
+
+	if(UBlueprint* Blueprint = Cast<UBlueprint>(InAsset))
+	{
+		return ValidateSnapshot(Blueprint, Context);
+	}
+
+	return EDataValidationResult::Valid;
+}
+
+void UReplicatedVariableChurnValidator::AnalyzeSnapshot(const FBlueprintSnapshot& Snapshot, TArray<FValidatorXIssue>& OutIssues) const
+{
+	const TMap<FName, int32> Events = IndexChurnEvents(Snapshot);
+
+	TArray<float> EntryRates;
+	CollectEntryRates(Snapshot, Events, EntryRates);
+
+	// Every Set node sums the rates of the entry points running it and remembers the first of them
+	TArray<float> WriteRates;
+	WriteRates.SetNumZeroed(Snapshot.Nodes.Num());
+	TArray<int32> WriteEntries;
+	WriteEntries.Init(INDEX_NONE, Snapshot.Nodes.Num());
+	TArray<int32> VisitStamps;
+	VisitStamps.Init(INDEX_NONE, Snapshot.Nodes.Num());
+	TArray<int32> ChainNodes;
+
+	for(int32 EntryIndex = 0; EntryIndex < EntryRates.Num(); ++EntryIndex)
+	{
+		if(EntryRates[EntryIndex] <= 0.0f) continue;
+
+		ChainNodes.Reset();
+		CollectChurnChain(Snapshot, Events, EntryIndex, EntryIndex, VisitStamps, ChainNodes);
+		for(const int32 NodeIndex : ChainNodes)
+		{
+			if(Snapshot.Nodes[NodeIndex].Kind != EValidatorXNodeKind::VariableSet) continue;
+
+			WriteRates[NodeIndex] += EntryRates[EntryIndex];
+			if(WriteEntries[NodeIndex] == INDEX_NONE)
+			{
+				WriteEntries[NodeIndex] = EntryIndex;
+			}
+		}
+	}
+
+	int64 TotalBytesPerSecond = 0;
+	int32 NumChurnedVariables = 0;
+	for(int32 VariableIndex = 0; VariableIndex < Snapshot.Variables.Num(); ++VariableIndex)
+	{
+		const FBlueprintSnapshotVariable& Variable = Snapshot.Variables[VariableIndex];
+		if(Variable.Graph != INDEX_NONE || !(Variable.PropertyFlags & CPF_Net)) continue;
+
+		const int64 ValueSize = GetValueSize(Variable);
+		const FText VariableText = FText::FromName(Variable.Name);
+
+		const bool bIsStructOrContainer = Variable.ContainerType != EPinContainerType::None || Variable.Category == UEdGraphSchema_K2::PC_Struct;
+		if(Variable.bIsDeclared && bIsStructOrContainer && ValueSize >= LargeValueSize)
+		{
+			FValidatorXIssue& Issue = OutIssues.Emplace_GetRef(EMessageSeverity::Warning,
+				INVTEXT("'{0}' is a replicated {1} of about {2}. The server compares all of it on every net update and sends all of it to every client it becomes relevant to: replicate a smaller summary, or split it into variables that change separately."),
+				FFormatOrderedArguments{VariableText, Variable.ContainerType != EPinContainerType::None ? INVTEXT("array") : INVTEXT("struct"), FText::AsMemory(ValueSize)});
+			Issue.Subject = Variable.Name;
+		}
+
+		// A variable is sent at most once per net update, however often it is set
+		float Rate = 0.0f;
+		int32 FirstWrite = INDEX_NONE;
+		for(const int32 NodeIndex : Snapshot.FindVariableWrites(VariableIndex))
+		{
+			if(WriteRates[NodeIndex] <= 0.0f) continue;
+
+			Rate += WriteRates[NodeIndex];
+			if(FirstWrite == INDEX_NONE)
+			{
+				FirstWrite = NodeIndex;
+			}
+		}
+		Rate = FMath::Min(Rate, MaxNetUpdateRate);
+		if(FirstWrite == INDEX_NONE || Rate < MinChurnRate) continue;
+
+		TotalBytesPerSecond += static_cast<int64>(ValueSize * Rate);
+		++NumChurnedVariables;
+
+		const FBlueprintSnapshotNode& Write = Snapshot.Nodes[FirstWrite];
+		const FName GraphName = Snapshot.Graphs[Write.Graph].Name;
+		FValidatorXIssue& Issue = OutIssues.Emplace_GetRef(EMessageSeverity::Warning,
+			INVTEXT("'{0}' is replicated and set from '{1}' in '{2}', so it can be sent up to {3} times a second with about {4} each time{5}. Set it only when the value actually changes, or from a slower timer."),
+			FFormatOrderedArguments{
+				VariableText,
+				FText::FromString(GetChurnEntryDisplayName(Snapshot, WriteEntries[FirstWrite])),
+				FText::FromName(GraphName),
+				FMath::RoundToInt(Rate),
+				FText::AsMemory(ValueSize),
+				(Variable.PropertyFlags & CPF_RepNotify) ? INVTEXT(", running its RepNotify function on every client") : FText::GetEmpty()});
+		Issue.GraphName = GraphName;
+		Issue.NodeGuid = Write.Guid;
+	}
+
+	if(NumChurnedVariables > 0)
+	{
+		OutIssues.Emplace(EMessageSeverity::Warning,
+			INVTEXT("'{0}' can send up to {1} a second to every relevant client through {2} replicated variables set every frame or from fast timers (arrays counted with at least {3} elements)."),
+			FFormatOrderedArguments{FText::FromName(Snapshot.BlueprintName), FText::AsMemory(TotalBytesPerSecond), NumChurnedVariables, AssumedArrayLength});
+	}
+}
+
+void UReplicatedVariableChurnValidator::CollectEntryRates(const FBlueprintSnapshot& Snapshot, const TMap<FName, int32>& Events, TArray<float>& OutRates) const
+{
+	OutRates.SetNumZeroed(Snapshot.Nodes.Num());
+
+	// Timers set from code that never runs do not count
+	const FExecReachability Reachability(Snapshot);
+
+	for(int32 NodeIndex = 0; NodeIndex < Snapshot.Nodes.Num(); ++NodeIndex)
+	{
+		const FBlueprintSnapshotNode& Node = Snapshot.Nodes[NodeIndex];
+		if(EveryFrameEvents.Contains(Node.NodeClass) || (Node.Kind == EValidatorXNodeKind::Event && EveryFrameEvents.Contains(Node.MemberName)))
+		{
+			OutRates[NodeIndex] = MaxNetUpdateRate;
+			continue;
+		}
+
+		if(Node.Kind != EValidatorXNodeKind::CallFunction || !Reachability.IsReachable(NodeIndex)) continue;
+		if(Node.MemberName != SetTimerByEventFunction && Node.MemberName != SetTimerByNameFunction) continue;
+
+		// A timer that does not loop runs once, and one whose loop is decided at runtime is assumed to
+		if(!IsChurnPinLinkedOr(Snapshot.FindPin(NodeIndex, TEXT("bLooping")), TEXT("true"))) continue;
+
+		int32 TimerEntry = INDEX_NONE;
+		if(Node.MemberName == SetTimerByEventFunction)
+		{
+			const int32 DelegatePin = Snapshot.FindPinIndex(NodeIndex, TEXT("Delegate"));
+			if(DelegatePin != INDEX_NONE)
+			{
+				for(const FBlueprintSnapshotLink& Link : Snapshot.GetLinks(DelegatePin))
+				{
+					const int32 LinkedIndex = Snapshot.Pins[Link.ToPin].Node;
+					if(Snapshot.Nodes[LinkedIndex].Kind == EValidatorXNodeKind::Event)
+					{
+						TimerEntry = LinkedIndex;
+					}
+				}
+			}
+		}
+		else
+		{
+			// Only timers on self name a function of this Blueprint
+			const FBlueprintSnapshotPin* ObjectPin = Snapshot.FindPin(NodeIndex, TEXT("Object"));
+			const FBlueprintSnapshotPin* NamePin = Snapshot.FindPin(NodeIndex, TEXT("FunctionName"));
+			if((!ObjectPin || ObjectPin->NumLinks == 0) && NamePin && NamePin->NumLinks == 0 && !NamePin->DefaultValue.IsEmpty())
+			{
+				TimerEntry = FindChurnCallee(Snapshot, Events, FName(*NamePin->DefaultValue));
+			}
+		}
+		if(TimerEntry == INDEX_NONE) continue;
+
+		// A time computed at runtime may be as short as a frame; zero or less clears the timer
+		float Rate = MaxNetUpdateRate;
+		const FBlueprintSnapshotPin* TimePin = Snapshot.FindPin(NodeIndex, TEXT("Time"));
+		if(TimePin && TimePin->NumLinks == 0)
+		{
+			const float Time = FCString::Atof(*TimePin->DefaultValue);
+			Rate = Time > 0.0f ? FMath::Min(1.0f / Time, MaxNetUpdateRate) : 0.0f;
+		}
+		OutRates[TimerEntry] = FMath::Max(OutRates[TimerEntry], Rate);
+	}
+}
+
+int64 UReplicatedVariableChurnValidator::GetValueSize(const FBlueprintSnapshotVariable& Variable) const
+{
+	if(Variable.ContainerType == EPinContainerType::None)
+	{
+		return Variable.ElementSize;
+	}
+	return static_cast<int64>(Variable.ElementSize) * FMath::Max(Variable.NumElements, AssumedArrayLength);
+}
+
+int32 UReplicatedVariableChurnValidator::GetCacheVersion() const
+{
+	return FValidatorXSettingsHash()
+		.Add(MaxNetUpdateRate)
+		.Add(MinChurnRate)
+		.Add(AssumedArrayLength)
+		.Add(LargeValueSize)
+		.AddNames(EveryFrameEvents)
+		.GetCacheVersion(1);
+}
+
+void UReplicatedVariableChurnValidator::AddIssueTokens(UBlueprint* Blueprint, const FValidatorXIssue& Issue, const TSharedRef<FTokenizedMessage>& Message) const
+{
+	AddJumpToNodeToken(Blueprint, Issue, Message);
+}
@@ -0,0 +1,249 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "Validators/TickCostValidator.h"
+#include "EdGraphSchema_K2.h"
+#include "Misc/DataValidation.h"
+#include "Analysis/BlueprintSnapshot.h"
+#include "Analysis/CostlyNodeClassifier.h"
+#include "ValidatorXTypes.h"
+#include "Stats/ValidatorXStats.h"
+
+namespace
+{
+	/** @return The advice given for a costly node run every frame, empty for the kinds that are not reported on their own. */
+	FText GetTickOffenderAdvice(EValidatorXCostlyNode Offender)
+	{
+		switch(Offender)
+		{
+		case EValidatorXCostlyNode::WorldQuery:
+			return INVTEXT("It iterates over every actor or widget: find them once in BeginPlay and keep them in a variable.");
+		case EValidatorXCostlyNode::Trace:
+			return INVTEXT("Run it from a timer (Set Timer by Event) or raise the tick interval (Set Actor Tick Interval) unless it must be exact every frame.");
+		case EValidatorXCostlyNode::Spawn:
+		case EValidatorXCostlyNode::Destroy:
+		case EValidatorXCostlyNode::AddComponent:
+			return INVTEXT("Spawn from a timer or gameplay event, or reuse pooled objects, instead of every frame.");
+		case EValidatorXCostlyNode::LoadAsset:
+			return INVTEXT("Loading an asset stalls the game thread: load it once in BeginPlay and keep it in a variable.");
+		case EValidatorXCostlyNode::StringFormat:
+			return INVTEXT("Build the string when its inputs change, or from a timer, instead of every frame.");
+		default:
+			return FText::GetEmpty();
+		}
+	}
+
+	/**
+	 * Collects the nodes run by an event: its execution chain and the pure nodes feeding it.
+	 *
+	 * @param Snapshot      Snapshot of the validated Blueprint
+	 * @param EventIndex    Index of the event node
+	 * @param Visited       One bit per snapshot node, cleared again for the collected nodes by the caller
+	 * @param OutNodes      Receives the collected nodes, without the event
+	 */
+	void CollectTickChain(const FBlueprintSnapshot& Snapshot, int32 EventIndex, TBitArray<>& Visited, TArray<int32>& OutNodes)
+	{
+		TArray<int32> Stack;
+		Stack.Add(EventIndex);
+		Visited[EventIndex] = true;
+
+		while(!Stack.IsEmpty())
+		{
+			const int32 NodeIndex = Stack.Pop(EAllowShrinking::No);
+			if(NodeIndex != EventIndex)
+			{
+				OutNodes.Add(NodeIndex);
+			}
+
+			const FBlueprintSnapshotNode& Node = Snapshot.Nodes[NodeIndex];
+			for(int32 PinIndex = Node.FirstPin; PinIndex < Node.FirstPin + Node.NumPins; ++PinIndex)
+			{
+				const FBlueprintSnapshotPin& Pin = Snapshot.Pins[PinIndex];
+				const bool bIsExec = Pin.Category == UEdGraphSchema_K2::PC_Exec;
+				if(bIsExec != (Pin.Direction == EGPD_Output)) continue;
+
+				// Execution outputs lead to the next nodes; data inputs to the pure nodes evaluated for this one
+				for(const FBlueprintSnapshotLink& Link : Snapshot.GetLinks(PinIndex))
+				{
+					const int32 LinkedIndex = Snapshot.Pins[Link.ToPin].Node;
+					if(!Visited[LinkedIndex] && (bIsExec || Snapshot.Nodes[LinkedIndex].bIsPure))
+					{
+						Visited[LinkedIndex] = true;
+						Stack.Add(LinkedIndex);
+					}
+				}
+			}
+		}
+	}
+} // namespace
+
+UTickCostValidator::UTickCostValidator()
+{
+	TickEventNames = { TEXT("ReceiveTick"), TEXT("Tick") };
+
+	NodeCosts = {
+		{ TEXT("GetAllActorsOfClass"), 50.0f },
+		{ TEXT("GetAllActorsOfClassWithTag"), 50.0f },
+		{ TEXT("GetAllActorsWithTag"), 50.0f },
+		{ TEXT("GetAllActorsWithInterface"), 50.0f },
+		{ TEXT("GetActorOfClass"), 20.0f },
+		{ TEXT("GetAllWidgetsOfClass"), 40.0f },
+		{ TEXT("GetAllWidgetsWithInterface"), 40.0f },
+		{ TEXT("LineTraceSingle"), 8.0f },
+		{ TEXT("LineTraceMulti"), 12.0f },
+		{ TEXT("LineTraceSingleForObjects"), 8.0f },
+		{ TEXT("LineTraceMultiForObjects"), 12.0f },
+		{ TEXT("SphereTraceSingle"), 10.0f },
+		{ TEXT("SphereTraceMulti"), 15.0f },
+		{ TEXT("BoxTraceSingle"), 10.0f },
+		{ TEXT("BoxTraceMulti"), 15.0f },
+		{ TEXT("CapsuleTraceSingle"), 10.0f },
+		{ TEXT("CapsuleTraceMulti"), 15.0f },
+		{ TEXT("SphereOverlapActors"), 12.0f },
+		{ TEXT("BoxOverlapActors"), 12.0f },
+		{ TEXT("K2Node_SpawnActorFromClass"), 40.0f },
+		{ TEXT("BeginDeferredActorSpawnFromClass"), 40.0f },
+		{ TEXT("K2Node_CreateWidget"), 30.0f },
+		{ TEXT("K2Node_FormatText"), 6.0f },
+		{ TEXT("Concat_StrStr"), 3.0f },
+		{ TEXT("PrintString"), 5.0f },
+		{ TEXT("PrintText"), 5.0f },
+		{ TEXT("K2Node_DynamicCast"), 2.0f },
+		{ TEXT("K2Node_ClassDynamicCast"), 2.0f },
+		{ TEXT("ForEachLoop"), 10.0f },
+		{ TEXT("ForEachLoopWithBreak"), 10.0f },
+		{ TEXT("ForLoop"), 10.0f },
+		{ TEXT("ForLoopWithBreak"), 10.0f },
+		{ TEXT("WhileLoop"), 10.0f },
+		{ TEXT("K2Node_VariableGet"), 0.25f },
+		{ TEXT("K2Node_Knot"), 0.0f },
+	};
+
+	SetValidationEnabled(true);
+}
+
+bool UTickCostValidator::CanValidateAsset_Implementation(const FAssetData& InAssetData, UObject* InAsset, FDataValidationContext& InContext) const
+{
+	return InAsset && InAsset->IsA<UBlueprint>();
+}
+
+bool UTickCostValidator::IsEnabled() const
+{
+	static const UTickCostValidator* CDO = GetDefault<UTickCostValidator>();
+	return CDO->bIsEnabled && !bIsConfigDisabled;
+}
+
+EDataValidationResult UTickCostValidator::ValidateLoadedAsset_Implementation(const FAssetData& InAssetData, UObject* InAsset, FDataValidationContext& Context)
+{
+	VALIDATORX_SCOPE_VALIDATE(InAssetData, Context);
+	bIsError = false;
+
+	if(UBlueprint* Blueprint = Cast<UBlueprint>(InAsset))
+	{
+		return ValidateSnapshot(Blueprint, Context);
+	}
+
+	return EDataValidationResult::Valid;
+}
+
+void UTickCostValidator::AnalyzeSnapshot(const FBlueprintSnapshot& Snapshot, TArray<FValidatorXIssue>& OutIssues) const
+{
+	TBitArray<> Visited(false, Snapshot.Nodes.Num());
+	TArray<int32> ChainNodes;
+
+	for(int32 EventIndex = 0; EventIndex < Snapshot.Nodes.Num(); ++EventIndex)
+	{
+		const FBlueprintSnapshotNode& Event = Snapshot.Nodes[EventIndex];
+		if(Event.Kind != EValidatorXNodeKind::Event || !TickEventNames.Contains(Event.MemberName)) continue;
+
+		ChainNodes.Reset();
+		CollectTickChain(Snapshot, EventIndex, Visited, ChainNodes);
+
+		// Report in graph order, not in walk order
+		ChainNodes.Sort();
+
+		const FName GraphName = Snapshot.Graphs[Event.Graph].Name;
+		const FText EventText = FText::FromName(Event.MemberName);
+		const FText GraphText = FText::FromName(GraphName);
+
+		float ChainCost = 0.0f;
+		int32 NumCasts = 0;
+		for(const int32 NodeIndex : ChainNodes)
+		{
+			const FBlueprintSnapshotNode& Node = Snapshot.Nodes[NodeIndex];
+			ChainCost += GetNodeCost(Snapshot, NodeIndex);
+
+			const EValidatorXCostlyNode Offender = ClassifyCostlyNode(Node);
+			if(Offender == EValidatorXCostlyNode::Cast)
+			{
+				++NumCasts;
+			}
+			else if(Offender != EValidatorXCostlyNode::None)
+			{
+				FValidatorXIssue& Issue = OutIssues.Emplace_GetRef(EMessageSeverity::Warning,
+					INVTEXT("'{0}' runs every frame from '{1}' in '{2}'. {3}"),
+					FFormatOrderedArguments{FText::FromString(GetCostlyNodeDisplayName(Node)), EventText, GraphText, GetTickOffenderAdvice(Offender)});
+				Issue.GraphName = GraphName;
+				Issue.NodeGuid = Node.Guid;
+			}
+		}
+
+		if(NumCasts >= CastChainLength)
+		{
+			FValidatorXIssue& Issue = OutIssues.Emplace_GetRef(EMessageSeverity::Warning,
+				INVTEXT("'{0}' in '{1}' runs {2} casts every frame. Cast once in BeginPlay and keep the results in variables."),
+				FFormatOrderedArguments{EventText, GraphText, NumCasts});
+			Issue.GraphName = GraphName;
+			Issue.NodeGuid = Event.Guid;
+		}
+
+		if(ChainCost > TickCostBudget)
+		{
+			FValidatorXIssue& Issue = OutIssues.Emplace_GetRef(EMessageSeverity::Warning,
+				INVTEXT("'{0}' in '{1}' runs {2} nodes every frame with a cost of {3}, over the budget of {4}. Move the work that does not need every frame to a timer (Set Timer by Event) or raise the tick interval (Set Actor Tick Interval)."),
+				FFormatOrderedArguments{EventText, GraphText, ChainNodes.Num(), FMath::RoundToInt(ChainCost), FMath::RoundToInt(TickCostBudget)});
+			Issue.GraphName = GraphName;
+			Issue.NodeGuid = Event.Guid;
+		}
+
+		for(const int32 NodeIndex : ChainNodes)
+		{
+			Visited[NodeIndex] = false;
+		}
+		Visited[EventIndex] = false;
+	}
+}
+
+float UTickCostValidator::GetNodeCost(const FBlueprintSnapshot& Snapshot, int32 NodeIndex) const
+{
+	const FBlueprintSnapshotNode& Node = Snapshot.Nodes[NodeIndex];
+	if(Node.Kind == EValidatorXNodeKind::CallFunction || Node.Kind == EValidatorXNodeKind::MacroInstance)
+	{
+		if(const float* Cost = NodeCosts.Find(Node.MemberName))
+		{
+			return *Cost;
+		}
+	}
+
+	if(const float* Cost = NodeCosts.Find(Node.NodeClass))
+	{
+		return *Cost;
+	}
+	return DefaultNodeCost;
+}
+
+int32 UTickCostValidator::GetCacheVersion() const
+{
+	return FValidatorXSettingsHash()
+		.Add(TickCostBudget)
+		.Add(DefaultNodeCost)
+		.Add(CastChainLength)
+		.AddNames(TickEventNames)
+		.AddNameMap(NodeCosts)
+		.GetCacheVersion(2);
+}
+
+void UTickCostValidator::AddIssueTokens(UBlueprint* Blueprint, const FValidatorXIssue& Issue, const TSharedRef<FTokenizedMessage>& Message) const
+{
+	AddJumpToNodeToken(Blueprint, Issue, Message);
+}
@@ -3,10 +3,6 @@
 
 #include "Validators/UnboundEventDispatcherValidator.h"
 #include "Kismet2/BlueprintEditorUtils.h"
-#include "K2Node_AddDelegate.h"
-#include "K2Node_RemoveDelegate.h"
-#include "K2Node_CallDelegate.h"
-#include "K2Node_AssignDelegate.h"
 #include "AssetRegistry/AssetData.h"
 #include "Editor.h"
 #include "EdGraph/EdGraph.h"
@@ -18,6 +14,10 @@
 #include "BlueprintEditorModule.h"
 #include "BlueprintEditor.h"
 #include "SMyBlueprint.h"
+#include "Analysis/BlueprintGraphIndex.h"
+#include "Analysis/BlueprintSnapshot.h"
+#include "ValidatorXTypes.h"
+#include "Stats/ValidatorXStats.h"
 
 UUnboundEventDispatcherValidator::UUnboundEventDispatcherValidator()
 {
@@ -37,153 +37,146 @@ bool UUnboundEventDispatcherValidator::IsEnabled() const
 
 EDataValidationResult UUnboundEventDispatcherValidator::ValidateLoadedAsset_Implementation(const FAssetData& InAssetData, UObject* InAsset, FDataValidationContext& Context)
 {
+	VALIDATORX_SCOPE_VALIDATE(InAssetData, Context);
 	bIsError = false;
 
 	if(UBlueprint* Blueprint = Cast<UBlueprint>(InAsset))
 	{
-		TSet<FName> AllDispatchers;
+		return ValidateSnapshot(Blueprint, Context);
+	}
+
+	return EDataValidationResult::Valid;
+}
 
-		for(const FBPVariableDescription& Variable : Blueprint->NewVariables)
+void UUnboundEventDispatcherValidator::AnalyzeSnapshot(const FBlueprintSnapshot& Snapshot, TArray<FValidatorXIssue>& OutIssues) const
+{
+	auto IsDispatcherUsed = [&Snapshot] (const FName& Dispatcher)
 		{
-			if(Variable.VarType.PinCategory == UEdGraphSchema_K2::PC_MCDelegate || Variable.VarType.PinCategory == UEdGraphSchema_K2::PC_Delegate)
+			for(const int32 NodeIndex : Snapshot.FindDelegateNodes(Dispatcher))
 			{
-				AllDispatchers.Add(Variable.VarName);
+				const EValidatorXNodeKind Kind = Snapshot.Nodes[NodeIndex].Kind;
+				if(Kind == EValidatorXNodeKind::AddDelegate || Kind == EValidatorXNodeKind::RemoveDelegate || Kind == EValidatorXNodeKind::CallDelegate)
+				{
+					return true;
+				}
 			}
-		}
+			return false;
+		};
 
-		if(AllDispatchers.Num() == 0)
+	for(const FBlueprintSnapshotVariable& Variable : Snapshot.Variables)
+	{
+		if(Variable.Graph != INDEX_NONE || !Variable.bIsDeclared) continue;
+
+		if(Variable.Category != UEdGraphSchema_K2::PC_MCDelegate && Variable.Category != UEdGraphSchema_K2::PC_Delegate) continue;
+
+		if(!IsDispatcherUsed(Variable.Name))
 		{
-			return EDataValidationResult::Valid;
+			FValidatorXIssue& Issue = OutIssues.Emplace_GetRef(EMessageSeverity::Warning,
+				INVTEXT("Event Dispatcher '{0}' is never bound, assigned or called in Blueprint '{1}'."),
+				FFormatOrderedArguments{FText::FromName(Variable.Name), FText::FromName(Snapshot.BlueprintName)});
+			Issue.Subject = Variable.Name;
 		}
+	}
+}
 
-		TSet<FName> UsedDispatchers;
-
+void UUnboundEventDispatcherValidator::AddIssueTokens(UBlueprint* Blueprint, const FValidatorXIssue& Issue, const TSharedRef<FTokenizedMessage>& Message) const
+{
+	const FName Dispatcher = Issue.Subject;
 
-		auto GatherUsed = [&UsedDispatchers] (const UEdGraph* Graph)
+	FText JumpToDispatcherText = FText::Format(INVTEXT("Jump to Dispatcher - '{0}'    "), FText::FromName(Dispatcher));
+	Message->AddToken(FActionToken::Create(JumpToDispatcherText, FText::FromString(""),
+		FSimpleDelegate::CreateLambda([=]
 			{
-				for(UEdGraphNode* Node : Graph->Nodes)
+				if(Blueprint)
 				{
-					if(UK2Node* K2Node = Cast<UK2Node>(Node))
+					UAssetEditorSubsystem* AssetEditorSubsystem = GEditor->GetEditorSubsystem<UAssetEditorSubsystem>();
+					AssetEditorSubsystem->OpenEditorForAsset(Blueprint);
+					if(IAssetEditorInstance* EditorInstance = AssetEditorSubsystem->FindEditorForAsset(Blueprint, false))
 					{
-						if(UK2Node_AddDelegate* Add = Cast<UK2Node_AddDelegate>(K2Node))
-						{
-							UsedDispatchers.Add(Add->GetPropertyName());
-						}
-						else if(UK2Node_RemoveDelegate* Remove = Cast<UK2Node_RemoveDelegate>(K2Node))
-						{
-							UsedDispatchers.Add(Remove->GetPropertyName());
-						}
-						else if(UK2Node_CallDelegate* Call = Cast<UK2Node_CallDelegate>(K2Node))
-						{
-							UsedDispatchers.Add(Call->GetPropertyName());
-						}
-						else if(UK2Node_AssignDelegate* Assign = Cast<UK2Node_AssignDelegate>(K2Node))
+						if(FBlueprintEditor* BlueprintEditor = StaticCast<FBlueprintEditor*>(EditorInstance))
 						{
-							UsedDispatchers.Add(Assign->GetPropertyName());
+							if(TSharedPtr<SMyBlueprint> MyBlueprintWidget = BlueprintEditor->GetMyBlueprintWidget())
+							{
+								MyBlueprintWidget->SelectItemByName(Dispatcher,
+									ESelectInfo::Direct,
+									INDEX_NONE,
+									false);
+							}
 						}
 					}
 				}
-			};
-
-		TArray<UEdGraph*> AllGraphs;
-		Blueprint->GetAllGraphs(AllGraphs);
-
-		for(UEdGraph* Graph : AllGraphs)
-		{
-			GatherUsed(Graph);
-		}
+			})
+	));
 
-		for(const FName& Dispatcher : AllDispatchers)
-		{
-			if(!UsedDispatchers.Contains(Dispatcher))
+	FText DeleteDispatcherText = FText::Format(INVTEXT("'Fix' - Delete Dispatcher - '{0}'"), FText::FromName(Dispatcher));
+	Message->AddToken(FActionToken::Create(DeleteDispatcherText, FText::FromString(""),
+		FSimpleDelegate::CreateLambda([=]
 			{
-				const FText MessageText = FText::Format(
-					INVTEXT("Event Dispatcher '{0}' is never bound, assigned or called in Blueprint '{1}'."),
-					FText::FromName(Dispatcher),
-					FText::FromString(Blueprint->GetName())
-				);
-
-				TSharedRef<FTokenizedMessage> Message = Context.AddMessage(EMessageSeverity::Warning, MessageText);
-				FText JumpToDispatcherText = FText::Format(INVTEXT("Jump to Dispatcher - '{0}'    "), FText::FromName(Dispatcher));
-				Message->AddToken(FActionToken::Create(JumpToDispatcherText, FText::FromString(""),
-					FSimpleDelegate::CreateLambda([=]
+				if(Blueprint)
+				{
+					UAssetEditorSubsystem* AssetEditorSubsystem = GEditor->GetEditorSubsystem<UAssetEditorSubsystem>();
+					AssetEditorSubsystem->OpenEditorForAsset(Blueprint);
+					FTSTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateLambda([=] (float DeltaTime)
 						{
-							if(Blueprint)
+							if(IAssetEditorInstance* EditorInstance = AssetEditorSubsystem->FindEditorForAsset(Blueprint, /*bFocusIfOpen=*/false))
 							{
-								UAssetEditorSubsystem* AssetEditorSubsystem = GEditor->GetEditorSubsystem<UAssetEditorSubsystem>();
-								AssetEditorSubsystem->OpenEditorForAsset(Blueprint);
-								if(IAssetEditorInstance* EditorInstance = AssetEditorSubsystem->FindEditorForAsset(Blueprint, false))
+								if(FBlueprintEditor* BlueprintEditor = StaticCast<FBlueprintEditor*>(EditorInstance))
 								{
-									if(FBlueprintEditor* BlueprintEditor = StaticCast<FBlueprintEditor*>(EditorInstance))
+									if(BlueprintEditor->GetMyBlueprintWidget().IsValid())
 									{
-										if(TSharedPtr<SMyBlueprint> MyBlueprintWidget = BlueprintEditor->GetMyBlueprintWidget())
+										int32 IndexToRemove = INDEX_NONE;
+										for(int32 i = 0; i < Blueprint->NewVariables.Num(); ++i)
 										{
-											MyBlueprintWidget->SelectItemByName(Dispatcher,
-												ESelectInfo::Direct,
-												INDEX_NONE,
-												false);
+											if(Blueprint->NewVariables[i].VarName == Dispatcher)
+											{
+												IndexToRemove = i;
+												break;
+											}
 										}
-									}
-								}
-							}
-						})
-				));
 
-				FText DeleteDispatcherText = FText::Format(INVTEXT("'Fix' - Delete Dispatcher - '{0}'"), FText::FromName(Dispatcher));
-				Message->AddToken(FActionToken::Create(DeleteDispatcherText, FText::FromString(""),
-					FSimpleDelegate::CreateLambda([=]
-						{
-							if(Blueprint)
-							{
-								UAssetEditorSubsystem* AssetEditorSubsystem = GEditor->GetEditorSubsystem<UAssetEditorSubsystem>();
-								AssetEditorSubsystem->OpenEditorForAsset(Blueprint);
-								FTSTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateLambda([=] (float DeltaTime)
-									{
-										if(IAssetEditorInstance* EditorInstance = AssetEditorSubsystem->FindEditorForAsset(Blueprint, /*bFocusIfOpen=*/false))
+										if(IndexToRemove != INDEX_NONE)
 										{
-											if(FBlueprintEditor* BlueprintEditor = StaticCast<FBlueprintEditor*>(EditorInstance))
+											const FText ConfirmText = FText::Format(
+												INVTEXT("Are you sure you want to delete the dispatcher '{0}' from Blueprint '{1}'?"),
+												FText::FromName(Dispatcher),
+												FText::FromString(Blueprint->GetName())
+											);
+
+											if(FMessageDialog::Open(EAppMsgType::YesNo, ConfirmText) == EAppReturnType::Yes)
 											{
-												if(BlueprintEditor->GetMyBlueprintWidget().IsValid())
-												{
-													int32 IndexToRemove = INDEX_NONE;
-													for(int32 i = 0; i < Blueprint->NewVariables.Num(); ++i)
-													{
-														if(Blueprint->NewVariables[i].VarName == Dispatcher)
-														{
-															IndexToRemove = i;
-															break;
-														}
-													}
-
-													if(IndexToRemove != INDEX_NONE)
-													{
-														const FText ConfirmText = FText::Format(
-															INVTEXT("Are you sure you want to delete the dispatcher '{0}' from Blueprint '{1}'?"),
-															FText::FromName(Dispatcher),
-															FText::FromString(Blueprint->GetName())
-														);
-
-														if(FMessageDialog::Open(EAppMsgType::YesNo, ConfirmText) == EAppReturnType::Yes)
-														{
-															Blueprint->Modify();
-															Blueprint->NewVariables.RemoveAt(IndexToRemove);
-															FBlueprintEditorUtils::MarkBlueprintAsStructurallyModified(Blueprint);
-														}
-													}
-
-													return false;
-												}
+												Blueprint->Modify();
+												Blueprint->NewVariables.RemoveAt(IndexToRemove);
+												FBlueprintEditorUtils::MarkBlueprintAsStructurallyModified(Blueprint);
 											}
 										}
-										return true;
-									}));
+
+										return false;
+									}
+								}
 							}
-						})
-				));
-				bIsError = true;
-			}
-		}
-	}
+							return true;
+						}));
+				}
+			})
+	));
+}
 
-	return bIsError ? EDataValidationResult::Invalid : EDataValidationResult::Valid;
+bool UUnboundEventDispatcherValidator::ApplyIssueFix(UBlueprint* Blueprint, const FValidatorXIssue& Issue) const
+{
+	const FName Dispatcher = Issue.Subject;
+
+	// The dispatcher may have been bound or called since the issue was reported
+	if(!GetGraphIndex(Blueprint)->FindDelegateNodes(Dispatcher).IsEmpty()) return false;
+
+	const int32 VarIndex = FBlueprintEditorUtils::FindNewVariableIndex(Blueprint, Dispatcher);
+	if(VarIndex == INDEX_NONE) return false;
+
+	Blueprint->Modify();
+	Blueprint->NewVariables.RemoveAt(VarIndex);
+
+	if(UEdGraph* SignatureGraph = FBlueprintEditorUtils::GetDelegateSignatureGraphByName(Blueprint, Dispatcher))
+	{
+		FBlueprintEditorUtils::RemoveGraph(Blueprint, SignatureGraph, EGraphRemoveFlags::MarkTransient);
+	}
+	return true;
 }
@@ -2,12 +2,18 @@
 
 
 #include "Validators/UnusedFunctionValidator.h"
-#include "K2Node_CallFunction.h"
 #include "Kismet2/BlueprintEditorUtils.h"
+#include "K2Node_CallFunction.h"
 #include "BlueprintEditor.h"
 #include "Misc/DataValidation.h"
 #include "SMyBlueprint.h"
 #include "Library/BPUtilsNodeFunctionLibrary.h"
+#include "Analysis/BlueprintGraphIndex.h"
+#include "Analysis/BlueprintSnapshot.h"
+#include "Analysis/FunctionReferenceIndex.h"
+#include "ValidatorXManager.h"
+#include "ValidatorXTypes.h"
+#include "Stats/ValidatorXStats.h"
 
 
 UUnusedFunctionValidator::UUnusedFunctionValidator()
@@ -28,162 +34,192 @@ bool UUnusedFunctionValidator::IsEnabled() const
 
 EDataValidationResult UUnusedFunctionValidator::ValidateLoadedAsset_Implementation(const FAssetData& InAssetData, UObject* InAsset, FDataValidationContext& Context)
 {
+	VALIDATORX_SCOPE_VALIDATE(InAssetData, Context);
 	bIsError = false;
 
 	if(UBlueprint* Blueprint = Cast<UBlueprint>(InAsset))
 	{
-		TArray<UEdGraph*> AllGraphs;
-		Blueprint->GetAllGraphs(AllGraphs);
+		return ValidateSnapshot(Blueprint, Context);
+	}
 
-		for(UEdGraph* FunctionGraph : Blueprint->FunctionGraphs)
-		{
-			if(!FunctionGraph) continue;
+	return EDataValidationResult::Valid;
+}
 
-			const FName FunctionName = FunctionGraph->GetFName();
-			if(FunctionName == UEdGraphSchema_K2::FN_UserConstructionScript) continue;
+void UUnusedFunctionValidator::AnalyzeSnapshot(const FBlueprintSnapshot& Snapshot, TArray<FValidatorXIssue>& OutIssues) const
+{
+	for(int32 GraphIndex = 0; GraphIndex < Snapshot.Graphs.Num(); ++GraphIndex)
+	{
+		const FBlueprintSnapshotGraph& FunctionGraph = Snapshot.Graphs[GraphIndex];
+		if(FunctionGraph.Type != EValidatorXGraphType::Function) continue;
 
-			bool bIsFunctionUsed = false;
+		const FName FunctionName = FunctionGraph.Name;
+		if(FunctionName == UEdGraphSchema_K2::FN_UserConstructionScript) continue;
 
-			// 1. Search in this blueprint
-			for(UEdGraph* Graph : AllGraphs)
+		// 1. Search in this blueprint. Child blueprints are checked in ConfirmIssue.
+		bool bIsFunctionUsed = false;
+		for(const int32 NodeIndex : Snapshot.FindFunctionCalls(FunctionName))
+		{
+			if(Snapshot.Nodes[NodeIndex].Graph != GraphIndex)
 			{
-				if(!Graph || Graph == FunctionGraph) continue;
+				bIsFunctionUsed = true;
+				break;
+			}
+		}
 
-				for(UEdGraphNode* Node : Graph->Nodes)
-				{
-					if(const UK2Node_CallFunction* CallFunctionNode = Cast<UK2Node_CallFunction>(Node))
-					{
-						if(CallFunctionNode->FunctionReference.GetMemberName() == FunctionName)
-						{
-							bIsFunctionUsed = true;
-							break;
-						}
-					}
-				}
-				if(bIsFunctionUsed) break;
+		if(!bIsFunctionUsed)
+		{
+			FValidatorXIssue& Issue = OutIssues.Emplace_GetRef(EMessageSeverity::Warning,
+				INVTEXT("Function '{0}' in Blueprint '{1}' is never used."),
+				FFormatOrderedArguments{FText::FromName(FunctionName), FText::FromName(Snapshot.BlueprintName)});
+			Issue.GraphName = FunctionName;
+			Issue.Subject = FunctionName;
+		}
+	}
+}
+
+bool UUnusedFunctionValidator::ConfirmIssue(UBlueprint* Blueprint, const FValidatorXIssue& Issue) const
+{
+	// 2. Search every Blueprint of the project, once all of them are indexed
+	FFunctionReferenceIndex& ReferenceIndex = FValidatorXManager::Get().GetFunctionReferenceIndex();
+	const UFunction* Function = Blueprint->GeneratedClass ? Blueprint->GeneratedClass->FindFunctionByName(Issue.Subject) : nullptr;
+	if(Function && ReferenceIndex.IsComplete())
+	{
+		const FValidatorXFunctionKey Key = FFunctionReferenceIndex::GetFunctionKey(*Function);
+
+		// Overrides of native functions may be called from C++
+		const UClass* DeclaringClass = FindObject<UClass>(Key.OwnerClass);
+		if(!DeclaringClass || !Cast<UBlueprint>(DeclaringClass->ClassGeneratedBy))
+		{
+			return false;
+		}
+
+		const FName PackageName = Blueprint->GetPackage()->GetFName();
+		for(const FValidatorXFunctionCallSite& CallSite : ReferenceIndex.FindCallSites(Key))
+		{
+			// Recursive calls do not count
+			if(CallSite.PackageName != PackageName || CallSite.GraphName != Issue.Subject)
+			{
+				return false;
 			}
+		}
 
-			// 2. Search in child blueprints 
-			if(!bIsFunctionUsed && Blueprint->GeneratedClass)
+		return true;
+	}
+
+	// 3. Search in child blueprints
+	if(Blueprint->GeneratedClass)
+	{
+		TArray<UClass*> DerivedClasses;
+		UBPUtilsNodeFunctionLibrary::GetAllDerivedBlueprintClasses(Blueprint->GeneratedClass, DerivedClasses, true);
+
+		for(UClass* ChildClass : DerivedClasses)
+		{
+			UBlueprint* ChildBP = Cast<UBlueprint>(ChildClass->ClassGeneratedBy);
+			if(!ChildBP) continue;
+
+			if(!GetGraphIndex(ChildBP)->FindFunctionCalls(Issue.Subject).IsEmpty())
 			{
-				TArray<UClass*> DerivedClasses;
-				UBPUtilsNodeFunctionLibrary::GetAllDerivedBlueprintClasses(Blueprint->GeneratedClass, DerivedClasses, true);
+				return false;
+			}
+		}
+	}
 
-				for(UClass* ChildClass : DerivedClasses)
-				{
-					UBlueprint* ChildBP = Cast<UBlueprint>(ChildClass->ClassGeneratedBy);
-					if(!ChildBP) continue;
+	return true;
+}
 
-					TArray<UEdGraph*> ChildGraphs;
-					ChildBP->GetAllGraphs(ChildGraphs);
+void UUnusedFunctionValidator::AddIssueTokens(UBlueprint* Blueprint, const FValidatorXIssue& Issue, const TSharedRef<FTokenizedMessage>& Message) const
+{
+	UEdGraph* FunctionGraph = FindIssueGraph(Blueprint, Issue);
+	if(!FunctionGraph) return;
 
-					for(UEdGraph* Graph : ChildGraphs)
+	const FName FunctionName = Issue.Subject;
+
+	const FText JumpToFunctionText = FText::Format(
+		INVTEXT("Jump to Function - '{0}'"),
+		FText::FromName(FunctionName));
+
+	Message->AddToken(FActionToken::Create(JumpToFunctionText, FText::GetEmpty(),
+		FSimpleDelegate::CreateLambda([=]
+			{
+				if(Blueprint && FunctionGraph)
+				{
+					if(UAssetEditorSubsystem* AssetEditorSubsystem = GEditor->GetEditorSubsystem<UAssetEditorSubsystem>())
 					{
-						for(UEdGraphNode* Node : Graph->Nodes)
+						AssetEditorSubsystem->OpenEditorForAsset(Blueprint);
+						if(IAssetEditorInstance* EditorInstance = AssetEditorSubsystem->FindEditorForAsset(Blueprint, false))
 						{
-							if(const UK2Node_CallFunction* CallFunctionNode = Cast<UK2Node_CallFunction>(Node))
+							if(FBlueprintEditor* BlueprintEditor = StaticCast<FBlueprintEditor*>(EditorInstance))
 							{
-								if(CallFunctionNode->FunctionReference.GetMemberName() == FunctionName)
+								BlueprintEditor->OpenGraphAndBringToFront(FunctionGraph, true);
+
+								if(TSharedPtr<SMyBlueprint> MyBlueprintWidget = BlueprintEditor->GetMyBlueprintWidget())
 								{
-									bIsFunctionUsed = true;
-									break;
+									MyBlueprintWidget->SelectItemByName(FunctionGraph->GetFName(),
+										ESelectInfo::Direct,
+										INDEX_NONE,
+										false);
 								}
 							}
 						}
-						if(bIsFunctionUsed) break;
 					}
-					if(bIsFunctionUsed) break;
 				}
-			}
+			})));
 
-			if(!bIsFunctionUsed)
-			{
-				const FText MessageText = FText::Format(
-					INVTEXT("Function '{0}' in Blueprint '{1}' is never used."),
-					FText::FromName(FunctionName),
-					FText::FromString(Blueprint->GetName())
-				);
+	const FText DeleteFunctionText = FText::Format(
+		INVTEXT("'Fix' - Delete Function - '{0}'"),
+		FText::FromName(FunctionName));
 
-				const TSharedRef<FTokenizedMessage> Message = Context.AddMessage(EMessageSeverity::Warning, MessageText);
-
-				const FText JumpToFunctionText = FText::Format(
-					INVTEXT("Jump to Function - '{0}'"),
-					FText::FromName(FunctionName));
+	Message->AddToken(FActionToken::Create(DeleteFunctionText, FText::GetEmpty(),
+		FSimpleDelegate::CreateLambda([=]
+			{
+				if(Blueprint && FunctionGraph)
+				{
+					if(UAssetEditorSubsystem* AssetEditorSubsystem = GEditor->GetEditorSubsystem<UAssetEditorSubsystem>())
+					{
+						AssetEditorSubsystem->OpenEditorForAsset(Blueprint);
 
-				Message->AddToken(FActionToken::Create(JumpToFunctionText, FText::GetEmpty(),
-					FSimpleDelegate::CreateLambda([=]
-						{
-							if(Blueprint && FunctionGraph)
+						FTSTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateLambda([=] (float DeltaTime)
 							{
-								if(UAssetEditorSubsystem* AssetEditorSubsystem = GEditor->GetEditorSubsystem<UAssetEditorSubsystem>())
+								if(IAssetEditorInstance* EditorInstance = AssetEditorSubsystem->FindEditorForAsset(Blueprint, false))
 								{
-									AssetEditorSubsystem->OpenEditorForAsset(Blueprint);
-									if(IAssetEditorInstance* EditorInstance = AssetEditorSubsystem->FindEditorForAsset(Blueprint, false))
+									if(FBlueprintEditor* BlueprintEditor = StaticCast<FBlueprintEditor*>(EditorInstance))
 									{
-										if(FBlueprintEditor* BlueprintEditor = StaticCast<FBlueprintEditor*>(EditorInstance))
+										const FText ConfirmText = FText::Format(
+											INVTEXT("Are you sure you want to delete the unused Function '{0}' from Blueprint '{1}'?"),
+											FText::FromName(FunctionName),
+											FText::FromString(Blueprint->GetName())
+										);
+
+										if(FMessageDialog::Open(EAppMsgType::YesNo, ConfirmText) == EAppReturnType::Yes)
 										{
-											BlueprintEditor->OpenGraphAndBringToFront(FunctionGraph, true);
-
-											if(TSharedPtr<SMyBlueprint> MyBlueprintWidget = BlueprintEditor->GetMyBlueprintWidget())
-											{
-												MyBlueprintWidget->SelectItemByName(FunctionGraph->GetFName(),
-													ESelectInfo::Direct,
-													INDEX_NONE,
-													false);
-											}
+											Blueprint->Modify();
+
+											Blueprint->FunctionGraphs.Remove(FunctionGraph);
+											FunctionGraph->Modify();
+											FunctionGraph->MarkAsGarbage();
+
+											FBlueprintEditorUtils::MarkBlueprintAsStructurallyModified(Blueprint);
 										}
 									}
 								}
-							}
-						})));
-
-				const FText DeleteFunctionText = FText::Format(
-					INVTEXT("'Fix' - Delete Function - '{0}'"),
-					FText::FromName(FunctionName));
-
-				Message->AddToken(FActionToken::Create(DeleteFunctionText, FText::GetEmpty(),
-					FSimpleDelegate::CreateLambda([=]
-						{
-							if(Blueprint && FunctionGraph)
-							{
-								if(UAssetEditorSubsystem* AssetEditorSubsystem = GEditor->GetEditorSubsystem<UAssetEditorSubsystem>())
-								{
-									AssetEditorSubsystem->OpenEditorForAsset(Blueprint);
+								return false;
+							}));
+					}
+				}
+			})));
+}
 
-									FTSTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateLambda([=] (float DeltaTime)
-										{
-											if(IAssetEditorInstance* EditorInstance = AssetEditorSubsystem->FindEditorForAsset(Blueprint, false))
-											{
-												if(FBlueprintEditor* BlueprintEditor = StaticCast<FBlueprintEditor*>(EditorInstance))
-												{
-													const FText ConfirmText = FText::Format(
-														INVTEXT("Are you sure you want to delete the unused Function '{0}' from Blueprint '{1}'?"),
-														FText::FromName(FunctionName),
-														FText::FromString(Blueprint->GetName())
-													);
-
-													if(FMessageDialog::Open(EAppMsgType::YesNo, ConfirmText) == EAppReturnType::Yes)
-													{
-														Blueprint->Modify();
-
-														Blueprint->FunctionGraphs.Remove(FunctionGraph);
-														FunctionGraph->Modify();
-														FunctionGraph->MarkAsGarbage();
-
-														FBlueprintEditorUtils::MarkBlueprintAsStructurallyModified(Blueprint);
-													}
-												}
-											}
-											return false;
-										}));
-								}
-							}
-						})));
+bool UUnusedFunctionValidator::ApplyIssueFix(UBlueprint* Blueprint, const FValidatorXIssue& Issue) const
+{
+	UEdGraph* FunctionGraph = FindIssueGraph(Blueprint, Issue);
+	if(!FunctionGraph || !Blueprint->FunctionGraphs.Contains(FunctionGraph)) return false;
 
-				bIsError = true;
-			}
-		}
+	// The function may have been called since the issue was reported; recursive calls do not count
+	for(const UK2Node_CallFunction* CallNode : GetGraphIndex(Blueprint)->FindFunctionCalls(Issue.Subject))
+	{
+		if(CallNode->GetGraph() != FunctionGraph) return false;
 	}
 
-	return bIsError ? EDataValidationResult::Invalid : EDataValidationResult::Valid;
+	FBlueprintEditorUtils::RemoveGraph(Blueprint, FunctionGraph, EGraphRemoveFlags::MarkTransient);
+	return true;
 }
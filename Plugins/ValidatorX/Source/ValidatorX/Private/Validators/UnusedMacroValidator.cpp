@@ -2,11 +2,14 @@
 
 
 #include "Validators/UnusedMacroValidator.h"
-#include "K2Node_MacroInstance.h"
 #include "Kismet2/BlueprintEditorUtils.h"
 #include "BlueprintEditor.h"
 #include "Misc/DataValidation.h"
 #include "SMyBlueprint.h"
+#include "Analysis/BlueprintGraphIndex.h"
+#include "Analysis/BlueprintSnapshot.h"
+#include "ValidatorXTypes.h"
+#include "Stats/ValidatorXStats.h"
 
 UUnusedMacroValidator::UUnusedMacroValidator()
 {
@@ -26,126 +29,132 @@ bool UUnusedMacroValidator::IsEnabled() const
 
 EDataValidationResult UUnusedMacroValidator::ValidateLoadedAsset_Implementation(const FAssetData& InAssetData, UObject* InAsset, FDataValidationContext& Context)
 {
+	VALIDATORX_SCOPE_VALIDATE(InAssetData, Context);
 	bIsError = false;
 
 	if (UBlueprint* Blueprint = Cast<UBlueprint>(InAsset))
 	{
-		TArray<UEdGraph*> AllGraphs;
-		Blueprint->GetAllGraphs(AllGraphs);
+		return ValidateSnapshot(Blueprint, Context);
+	}
+	return EDataValidationResult::Valid;
+}
 
-		for(UEdGraph* MacroGraph : Blueprint->MacroGraphs)
-		{
-			if(!MacroGraph) continue;
+void UUnusedMacroValidator::AnalyzeSnapshot(const FBlueprintSnapshot& Snapshot, TArray<FValidatorXIssue>& OutIssues) const
+{
+	for(int32 GraphIndex = 0; GraphIndex < Snapshot.Graphs.Num(); ++GraphIndex)
+	{
+		const FBlueprintSnapshotGraph& MacroGraph = Snapshot.Graphs[GraphIndex];
+		if(MacroGraph.Type != EValidatorXGraphType::Macro) continue;
 
-			const FName MacroName = MacroGraph->GetFName();
-			bool bIsMacroUsed = false;
+		const FName MacroName = MacroGraph.Name;
+		bool bIsMacroUsed = false;
 
-			for (UEdGraph* Graph : AllGraphs)
+		for (const int32 NodeIndex : Snapshot.FindMacroInstances(MacroName))
+		{
+			const FBlueprintSnapshotNode& MacroInstance = Snapshot.Nodes[NodeIndex];
+			if (MacroInstance.MemberPackage == Snapshot.PackageName && MacroInstance.Graph != GraphIndex)
 			{
-				if (!Graph || Graph == MacroGraph) continue;
+				bIsMacroUsed = true;
+				break;
+			}
+		}
 
-				for (UEdGraphNode* Node : Graph->Nodes)
-				{
-					if (const UK2Node_MacroInstance* MacroInstance = Cast<UK2Node_MacroInstance>(Node))
-					{
-						if (MacroInstance->GetMacroGraph() == MacroGraph)
-						{
-							bIsMacroUsed = true;
-							break;
-						}
-					}
-				}
+		if(!bIsMacroUsed)
+		{
+			FValidatorXIssue& Issue = OutIssues.Emplace_GetRef(EMessageSeverity::Warning,
+				INVTEXT("Macro '{0}' is never used."),
+				FFormatOrderedArguments{FText::FromName(MacroName)});
+			Issue.GraphName = MacroName;
+		}
+	}
+}
 
-				if (bIsMacroUsed)
-				{
-					break;
-				}
-			}
+void UUnusedMacroValidator::AddIssueTokens(UBlueprint* Blueprint, const FValidatorXIssue& Issue, const TSharedRef<FTokenizedMessage>& Message) const
+{
+	UEdGraph* MacroGraph = FindIssueGraph(Blueprint, Issue);
+	if(!MacroGraph) return;
 
+	const FName MacroName = MacroGraph->GetFName();
 
-			if(!bIsMacroUsed)
+	Message->AddToken(FActionToken::Create(FText::FromString("Jump to macro"), FText::GetEmpty(),
+		FSimpleDelegate::CreateLambda([=]
 			{
-				const FText MessageText = FText::Format(
-					INVTEXT("Macro '{0}' is never used."),
-					FText::FromName(MacroName)
-				);
-
-				TSharedRef<FTokenizedMessage> Message = Context.AddMessage(EMessageSeverity::Warning, MessageText);
-				Message->AddToken(FActionToken::Create(FText::FromString("Jump to macro"), FText::GetEmpty(),
-					FSimpleDelegate::CreateLambda([=]
+				if(Blueprint && MacroGraph)
+				{
+					if(UAssetEditorSubsystem* AssetEditorSubsystem = GEditor->GetEditorSubsystem<UAssetEditorSubsystem>())
+					{
+						AssetEditorSubsystem->OpenEditorForAsset(Blueprint);
+						if(IAssetEditorInstance* EditorInstance = AssetEditorSubsystem->FindEditorForAsset(Blueprint, false))
 						{
-							if(Blueprint && MacroGraph)
+							if(FBlueprintEditor* BlueprintEditor = StaticCast<FBlueprintEditor*>(EditorInstance))
 							{
-								if(UAssetEditorSubsystem* AssetEditorSubsystem = GEditor->GetEditorSubsystem<UAssetEditorSubsystem>())
+								BlueprintEditor->OpenGraphAndBringToFront(MacroGraph, true);
+								if(TSharedPtr<SMyBlueprint> MyBlueprintWidget = BlueprintEditor->GetMyBlueprintWidget())
 								{
-									AssetEditorSubsystem->OpenEditorForAsset(Blueprint);
-									if(IAssetEditorInstance* EditorInstance = AssetEditorSubsystem->FindEditorForAsset(Blueprint, false))
-									{
-										if(FBlueprintEditor* BlueprintEditor = StaticCast<FBlueprintEditor*>(EditorInstance))
-										{
-											BlueprintEditor->OpenGraphAndBringToFront(MacroGraph, true);
-											if(TSharedPtr<SMyBlueprint> MyBlueprintWidget = BlueprintEditor->GetMyBlueprintWidget())
-											{
-												MyBlueprintWidget->SelectItemByName(MacroGraph->GetFName(),
-													ESelectInfo::Direct,
-													INDEX_NONE,
-													false);
-											}
-										}
-									}
+									MyBlueprintWidget->SelectItemByName(MacroGraph->GetFName(),
+										ESelectInfo::Direct,
+										INDEX_NONE,
+										false);
 								}
 							}
-						})
-				));
+						}
+					}
+				}
+			})
+	));
 
-				const FText DeleteMacroText = FText::Format(
-					INVTEXT("'Fix' - Delete Macro - '{0}'"),
-					FText::FromName(MacroName));
+	const FText DeleteMacroText = FText::Format(
+		INVTEXT("'Fix' - Delete Macro - '{0}'"),
+		FText::FromName(MacroName));
 
-				Message->AddToken(FActionToken::Create(DeleteMacroText, FText::GetEmpty(),
-					FSimpleDelegate::CreateLambda([=]
-						{
-							if(Blueprint && MacroGraph)
+	Message->AddToken(FActionToken::Create(DeleteMacroText, FText::GetEmpty(),
+		FSimpleDelegate::CreateLambda([=]
+			{
+				if(Blueprint && MacroGraph)
+				{
+					if(UAssetEditorSubsystem* AssetEditorSubsystem = GEditor->GetEditorSubsystem<UAssetEditorSubsystem>())
+					{
+						AssetEditorSubsystem->OpenEditorForAsset(Blueprint);
+
+						FTSTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateLambda([=] (float DeltaTime)
 							{
-								if(UAssetEditorSubsystem* AssetEditorSubsystem = GEditor->GetEditorSubsystem<UAssetEditorSubsystem>())
+								if(IAssetEditorInstance* EditorInstance = AssetEditorSubsystem->FindEditorForAsset(Blueprint, false))
 								{
-									AssetEditorSubsystem->OpenEditorForAsset(Blueprint);
+									if(FBlueprintEditor* BlueprintEditor = StaticCast<FBlueprintEditor*>(EditorInstance))
+									{
+										const FText ConfirmText = FText::Format(
+											INVTEXT("Are you sure you want to delete the unused Macro '{0}' from Blueprint '{1}'?"),
+											FText::FromName(MacroName),
+											FText::FromString(Blueprint->GetName())
+										);
 
-									FTSTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateLambda([=] (float DeltaTime)
+										if(FMessageDialog::Open(EAppMsgType::YesNo, ConfirmText) == EAppReturnType::Yes)
 										{
-											if(IAssetEditorInstance* EditorInstance = AssetEditorSubsystem->FindEditorForAsset(Blueprint, false))
-											{
-												if(FBlueprintEditor* BlueprintEditor = StaticCast<FBlueprintEditor*>(EditorInstance))
-												{
-													const FText ConfirmText = FText::Format(
-														INVTEXT("Are you sure you want to delete the unused Macro '{0}' from Blueprint '{1}'?"),
-														FText::FromName(MacroName),
-														FText::FromString(Blueprint->GetName())
-													);
-
-													if(FMessageDialog::Open(EAppMsgType::YesNo, ConfirmText) == EAppReturnType::Yes)
-													{
-														Blueprint->Modify();
-
-														Blueprint->MacroGraphs.Remove(MacroGraph);
-														MacroGraph->Modify();
-														MacroGraph->MarkAsGarbage();
-
-														FBlueprintEditorUtils::MarkBlueprintAsStructurallyModified(Blueprint);
-													}
-												}
-											}
-											return false;
-										}));
+											Blueprint->Modify();
+
+											Blueprint->MacroGraphs.Remove(MacroGraph);
+											MacroGraph->Modify();
+											MacroGraph->MarkAsGarbage();
+
+											FBlueprintEditorUtils::MarkBlueprintAsStructurallyModified(Blueprint);
+										}
+									}
 								}
-							}
-						})));
+								return false;
+							}));
+					}
+				}
+			})));
+}
 
+bool UUnusedMacroValidator::ApplyIssueFix(UBlueprint* Blueprint, const FValidatorXIssue& Issue) const
+{
+	UEdGraph* MacroGraph = FindIssueGraph(Blueprint, Issue);
+	if(!MacroGraph || !Blueprint->MacroGraphs.Contains(MacroGraph)) return false;
 
-				bIsError = true;
-			}
+	// The macro may have been placed since the issue was reported
+	if(!GetGraphIndex(Blueprint)->FindMacroInstances(MacroGraph).IsEmpty()) return false;
 
-		}
-	}
-	return bIsError ? EDataValidationResult::Invalid : EDataValidationResult::Valid;
+	FBlueprintEditorUtils::RemoveGraph(Blueprint, MacroGraph, EGraphRemoveFlags::MarkTransient);
+	return true;
 }
@@ -3,19 +3,20 @@
 
 #include "Validators/UnusedNodeValidator.h"
 #include "Engine/Blueprint.h"
-
-#include "K2Node.h"
-#include "K2Node_CallFunction.h"
-#include "K2Node_Variable.h"
 #include "K2Node_Event.h"
-#include "K2Node_MacroInstance.h"
-#include "EdGraphNode_Comment.h"
+#include "Algo/AnyOf.h"
 
 #include "Misc/DataValidation.h"
 
 #include "BlueprintEditorModule.h"
 #include "Widgets/Notifications/SNotificationList.h"
 #include "Library/BPUtilsNodeFunctionLibrary.h"
+#include "Analysis/BlueprintGraphIndex.h"
+#include "Analysis/BlueprintSnapshot.h"
+#include "Analysis/CommentSpatialIndex.h"
+#include "Analysis/ExecReachability.h"
+#include "ValidatorXTypes.h"
+#include "Stats/ValidatorXStats.h"
 
 UUnusedNodeValidator::UUnusedNodeValidator()
 {
@@ -35,116 +36,159 @@ bool UUnusedNodeValidator::IsEnabled() const
 
 EDataValidationResult UUnusedNodeValidator::ValidateLoadedAsset_Implementation(const FAssetData& InAssetData, UObject* InAsset, FDataValidationContext& Context)
 {
+	VALIDATORX_SCOPE_VALIDATE(InAssetData, Context);
 	bIsError = false;
 
 	if(UBlueprint* Blueprint = Cast<UBlueprint>(InAsset))
 	{
-		TArray<UEdGraph*> AllGraphs;
-		Blueprint->GetAllGraphs(AllGraphs);
+		return ValidateSnapshot(Blueprint, Context);
+	}
 
-		for(UEdGraph* Graph : AllGraphs)
-		{
-			if(!Graph) continue;
+	return EDataValidationResult::Valid;
+}
+
+void UUnusedNodeValidator::AnalyzeSnapshot(const FBlueprintSnapshot& Snapshot, TArray<FValidatorXIssue>& OutIssues) const
+{
+	const FExecReachability Reachability(Snapshot);
 
-			TArray<UEdGraphNode_Comment*> CommentNodes;
-			for(UEdGraphNode* Node : Graph->Nodes)
+	// Chains never span graphs and are ordered by their first node, so the chains of a graph are consecutive
+	int32 CommentGraph = INDEX_NONE;
+	FCommentSpatialIndex CommentIndex;
+
+	for(int32 ChainIndex = 0; ChainIndex < Reachability.GetNumChains(); ++ChainIndex)
+	{
+		const TConstArrayView<int32> Chain = Reachability.GetChain(ChainIndex);
+		const int32 GraphIndex = Snapshot.Nodes[Chain[0]].Graph;
+
+		if(GraphIndex != CommentGraph)
+		{
+			TArray<FCommentSpatialIndex::FBox> Boxes;
+			for(const FBlueprintSnapshotNode& Node : Snapshot.GetNodes(GraphIndex))
 			{
-				if(UEdGraphNode_Comment* Comment = Cast<UEdGraphNode_Comment>(Node))
+				if(Node.Kind == EValidatorXNodeKind::Comment)
 				{
-					CommentNodes.Add(Comment);
+					Boxes.Add(FCommentSpatialIndex::FBox{Node.PosX, Node.PosY, Node.PosX + Node.Width, Node.PosY + Node.Height});
 				}
 			}
+			CommentIndex = FCommentSpatialIndex(MoveTemp(Boxes));
+			CommentGraph = GraphIndex;
+		}
 
-			for(UEdGraphNode* Node : Graph->Nodes)
+		// Code parked inside a comment box is kept on purpose
+		const bool bIsCommented = Algo::AnyOf(Chain, [&Snapshot, &CommentIndex](int32 NodeIndex)
+			{
+				const FBlueprintSnapshotNode& Node = Snapshot.Nodes[NodeIndex];
+				return CommentIndex.IsInsideAnyBox(Node.PosX, Node.PosY);
+			});
+		if(bIsCommented) continue;
+
+		// Report the chain at its leftmost node, where reading it starts
+		int32 HeadIndex = Chain[0];
+		for(const int32 NodeIndex : Chain)
+		{
+			if(Snapshot.Nodes[NodeIndex].PosX < Snapshot.Nodes[HeadIndex].PosX)
 			{
-				if(!Node || Node->IsA<UEdGraphNode_Comment>()) continue;
+				HeadIndex = NodeIndex;
+			}
+		}
 
-				if(UBPUtilsNodeFunctionLibrary::IsNodeInsideComment(Node, CommentNodes))
-				{
-					continue;
-				}
+		const FBlueprintSnapshotNode& Head = Snapshot.Nodes[HeadIndex];
+		const FName GraphName = Snapshot.Graphs[GraphIndex].Name;
+		const FText HeadName = FText::FromString(Head.Title.IsEmpty() ? Head.Name.ToString() : Head.Title);
 
-				bool bIsNodeUnused = false;
+		FValidatorXIssue* Issue = nullptr;
+		if(Chain.Num() == 1)
+		{
+			Issue = &OutIssues.Emplace_GetRef(EMessageSeverity::Warning,
+				INVTEXT("Node '{0}' in Graph '{1}' appears to be unused."),
+				FFormatOrderedArguments{HeadName, FText::FromName(GraphName)});
+		}
+		else
+		{
+			Issue = &OutIssues.Emplace_GetRef(EMessageSeverity::Warning,
+				INVTEXT("Chain of {2} nodes starting at '{0}' in Graph '{1}' can never be executed."),
+				FFormatOrderedArguments{HeadName, FText::FromName(GraphName), FText::AsNumber(Chain.Num())});
+		}
+		Issue->GraphName = GraphName;
+		Issue->NodeGuid = Head.Guid;
 
-				if(UK2Node_Event* Event = Cast<UK2Node_Event>(Node))
-				{
-					bIsNodeUnused = UBPUtilsNodeFunctionLibrary::IsEmptyEvent(Event);
-				}
-				else if(UK2Node_CallFunction* Function = Cast<UK2Node_CallFunction>(Node))
-				{
-					bIsNodeUnused = Function->IsNodePure()
-						? UBPUtilsNodeFunctionLibrary::IsEmptyPureFunction(Function)
-						: UBPUtilsNodeFunctionLibrary::IsEmptyFunctions(Function);
-				}
-				else if(UK2Node_MacroInstance* Macro = Cast<UK2Node_MacroInstance>(Node))
-				{
-					bIsNodeUnused = UBPUtilsNodeFunctionLibrary::IsUnusedMacroInstance(Macro);
-				}
-				else
-				{
-					bIsNodeUnused = UBPUtilsNodeFunctionLibrary::IsUnusedVariableNode(Node);
-				}
+		// Unlinked events are kept in ConfirmIssue when a derived Blueprint implements them
+		if(Chain.Num() == 1 && Head.Kind == EValidatorXNodeKind::Event)
+		{
+			Issue->Subject = Head.MemberName;
+		}
+	}
+}
 
-				if(bIsNodeUnused)
-				{
-					const FText MessageText = FText::Format(
-						INVTEXT("Node '{0}' in Graph '{1}' appears to be unused."),
-						FText::FromString(Node->GetNodeTitle(ENodeTitleType::FullTitle).ToString()),
-						FText::FromString(Graph->GetName())
-					);
+bool UUnusedNodeValidator::ConfirmIssue(UBlueprint* Blueprint, const FValidatorXIssue& Issue) const
+{
+	if(Issue.Subject.IsNone() || !Blueprint->GeneratedClass) return true;
 
-					TSharedRef<FTokenizedMessage> Message = Context.AddMessage(EMessageSeverity::Warning, MessageText);
+	// Every saved child known to the asset registry, so the answer does not depend on what is loaded
+	TArray<UClass*> DerivedClasses;
+	UBPUtilsNodeFunctionLibrary::GetDerivedRegistryBlueprintClasses(Blueprint->GeneratedClass, DerivedClasses);
 
-					Message->AddToken(FActionToken::Create(FText::FromString("Jump to graph"), FText::FromString(""),
-						FSimpleDelegate::CreateLambda([=]
-							{
-								if(Blueprint && Graph)
-								{
-									UAssetEditorSubsystem* AssetEditorSubsystem = GEditor->GetEditorSubsystem<UAssetEditorSubsystem>();
-									AssetEditorSubsystem->OpenEditorForAsset(Blueprint);
-									if(IAssetEditorInstance* EditorInstance = AssetEditorSubsystem->FindEditorForAsset(Blueprint, false))
-									{
-										if(IBlueprintEditor* BlueprintEditor = StaticCast<IBlueprintEditor*>(EditorInstance))
-										{
-											TSet<UObject*> NodesToSelect;
-											NodesToSelect.Add(Node);
-											if(TSharedPtr<SGraphEditor> GraphEditor = BlueprintEditor->OpenGraphAndBringToFront(Graph, true))
-											{
-												GraphEditor->JumpToNode(Node, false);
-
-
-												const bool bHasChain = UBPUtilsNodeFunctionLibrary::HasExecutionOutputConnections(Node);
-
-												FString Comment = bHasChain ? TEXT("Unused node chain") : TEXT("Unused node");
-												Node->NodeComment = Comment;
-												Node->bCommentBubbleVisible = true;
-
-												// TODO search Engine Implemetable functions create Comment Node !!!  
-												// FVector2D Position(Node->NodePosX - 50, Node->NodePosY - 50);
-												// FVector2D Size(Node->NodeWidth + 500, Node->NodeHeight + 500);
-												// AddCommentNode(Graph, Position, Size, TEXT("Unused node detected"));
-												// this idea create comment block for node width/height size 
-
-												FNotificationInfo Info(FText::FromString(Comment));
-												Info.ExpireDuration = 3.0f;
-												Info.bUseThrobber = false;
-												Info.bUseSuccessFailIcons = false;
-												Info.bFireAndForget = true;
-												GraphEditor->AddNotification(Info, true);
-											}
-										}
-									}
-								}
-							})
-					));
-					bIsError = true;
-				}
+	for(UClass* ChildClass : DerivedClasses)
+	{
+		UBlueprint* ChildBP = Cast<UBlueprint>(ChildClass->ClassGeneratedBy);
+		if(!ChildBP) continue;
+
+		for(const UK2Node_Event* ChildEvent : GetGraphIndex(ChildBP)->GetEvents())
+		{
+			const UEdGraphPin* ChildThen = ChildEvent->GetFunctionName() == Issue.Subject ? ChildEvent->FindPin(UEdGraphSchema_K2::PN_Then) : nullptr;
+			if(ChildThen && !ChildThen->LinkedTo.IsEmpty())
+			{
+				return false;
 			}
 		}
 	}
 
-	return bIsError ? EDataValidationResult::Invalid : EDataValidationResult::Valid;
+	return true;
 }
 
+void UUnusedNodeValidator::AddIssueTokens(UBlueprint* Blueprint, const FValidatorXIssue& Issue, const TSharedRef<FTokenizedMessage>& Message) const
+{
+	UEdGraph* Graph = FindIssueGraph(Blueprint, Issue);
+	UEdGraphNode* Node = FindIssueNode(Blueprint, Issue);
+	if(!Graph || !Node) return;
 
-
+	Message->AddToken(FActionToken::Create(FText::FromString("Jump to graph"), FText::FromString(""),
+		FSimpleDelegate::CreateLambda([=]
+			{
+				if(Blueprint && Graph)
+				{
+					UAssetEditorSubsystem* AssetEditorSubsystem = GEditor->GetEditorSubsystem<UAssetEditorSubsystem>();
+					AssetEditorSubsystem->OpenEditorForAsset(Blueprint);
+					if(IAssetEditorInstance* EditorInstance = AssetEditorSubsystem->FindEditorForAsset(Blueprint, false))
+					{
+						if(IBlueprintEditor* BlueprintEditor = StaticCast<IBlueprintEditor*>(EditorInstance))
+						{
+							if(TSharedPtr<SGraphEditor> GraphEditor = BlueprintEditor->OpenGraphAndBringToFront(Graph, true))
+							{
+								GraphEditor->JumpToNode(Node, false);
+
+								const bool bHasChain = UBPUtilsNodeFunctionLibrary::HasExecutionOutputConnections(Node);
+
+								FString Comment = bHasChain ? TEXT("Unused node chain") : TEXT("Unused node");
+								Node->NodeComment = Comment;
+								Node->bCommentBubbleVisible = true;
+
+								// TODO search Engine Implemetable functions create Comment Node !!!  
+								// FVector2D Position(Node->NodePosX - 50, Node->NodePosY - 50);
+								// FVector2D Size(Node->NodeWidth + 500, Node->NodeHeight + 500);
+								// AddCommentNode(Graph, Position, Size, TEXT("Unused node detected"));
+								// this idea create comment block for node width/height size 
+
+								FNotificationInfo Info(FText::FromString(Comment));
+								Info.ExpireDuration = 3.0f;
+								Info.bUseThrobber = false;
+								Info.bUseSuccessFailIcons = false;
+								Info.bFireAndForget = true;
+								GraphEditor->AddNotification(Info, true);
+							}
+						}
+					}
+				}
+			})
+	));
+}
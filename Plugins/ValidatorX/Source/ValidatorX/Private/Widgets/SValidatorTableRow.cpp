@@ -1,7 +1,12 @@
 ﻿// Fill out your copyright notice in the Description page of Project Settings.
 
 #include "Widgets/SValidatorTableRow.h"
+#include "AssetRegistry/IAssetRegistry.h"
+#include "Editor.h"
+#include "Framework/MultiBox/MultiBoxBuilder.h"
 #include "Library/UtilsFunctionLibrary.h"
+#include "Widgets/Input/SComboButton.h"
+#include "ValidatorXManager.h"
 #include "ValidatorXTypes.h"
 
 void SValidatorTableRow::Construct(const FArguments& InArgs, const TSharedRef<STableViewBase>& InOwnerTable)
@@ -29,6 +34,16 @@ TSharedRef<SWidget> SValidatorTableRow::GenerateWidgetForColumn(const FName& Col
 	{
 		return GetButtonBox();
 	}
+	else if (ColumnId == ValidatorListColumns::ColumnID_MaxTime)
+	{
+		return GetWorstAssetsBox();
+	}
+	else if (ColumnId == ValidatorListColumns::ColumnID_Assets || ColumnId == ValidatorListColumns::ColumnID_Messages
+		|| ColumnId == ValidatorListColumns::ColumnID_TotalTime || ColumnId == ValidatorListColumns::ColumnID_P50Time
+		|| ColumnId == ValidatorListColumns::ColumnID_P95Time)
+	{
+		return GetStatBox(ColumnId);
+	}
 
 	return SNullWidget::NullWidget;
 }
@@ -101,6 +116,111 @@ TSharedRef<SBox> SValidatorTableRow::GetButtonBox()
 
 	return ButtonBox;
 }
+double SValidatorTableRow::GetStatValue(const UBlueprintValidatorBase* InValidator, FName ColumnId)
+{
+	const FValidatorXValidatorStats* const Stats = InValidator ? FValidatorXManager::Get().GetStats().Find(InValidator->GetClass()->GetFName()) : nullptr;
+	if (!Stats)
+	{
+		return 0.0;
+	}
+
+	if (ColumnId == ValidatorListColumns::ColumnID_Assets)
+	{
+		return Stats->NumAssets;
+	}
+	else if (ColumnId == ValidatorListColumns::ColumnID_Messages)
+	{
+		return Stats->NumMessages;
+	}
+	else if (ColumnId == ValidatorListColumns::ColumnID_TotalTime)
+	{
+		return Stats->TotalSeconds * 1000.0;
+	}
+	else if (ColumnId == ValidatorListColumns::ColumnID_P50Time)
+	{
+		return Stats->GetPercentileSeconds(0.5) * 1000.0;
+	}
+	else if (ColumnId == ValidatorListColumns::ColumnID_P95Time)
+	{
+		return Stats->GetPercentileSeconds(0.95) * 1000.0;
+	}
+	else if (ColumnId == ValidatorListColumns::ColumnID_MaxTime)
+	{
+		return Stats->GetMaxSeconds() * 1000.0;
+	}
+
+	return 0.0;
+}
+
+TSharedRef<SBox> SValidatorTableRow::GetStatBox(FName ColumnId)
+{
+	const bool bIsCount = ColumnId == ValidatorListColumns::ColumnID_Assets || ColumnId == ValidatorListColumns::ColumnID_Messages;
+
+	TSharedRef<SBox> StatBox = WrapBox(SNew(STextBlock)
+			.Text_Lambda([WeakValidator = Validator, ColumnId, bIsCount]()
+			{
+				const double Value = GetStatValue(WeakValidator.Get(), ColumnId);
+				return bIsCount ? FText::AsNumber(int64(Value)) : FText::FromString(FString::Printf(TEXT("%.2f"), Value));
+			})
+			.Font(LocalFont)
+			.Justification(ETextJustify::Center));
+
+	return StatBox;
+}
+
+TSharedRef<SBox> SValidatorTableRow::GetWorstAssetsBox()
+{
+	TSharedRef<SBox> WorstAssetsBox = WrapBox(SNew(SComboButton)
+			.HasDownArrow(true)
+			.ToolTipText(FText::FromString("Slowest assets of this validator"))
+			.OnGetMenuContent(this, &SValidatorTableRow::GetWorstAssetsMenu)
+			.ButtonContent()
+			[
+				SNew(STextBlock)
+				.Text_Lambda([WeakValidator = Validator]()
+				{
+					return FText::FromString(FString::Printf(TEXT("%.2f"), GetStatValue(WeakValidator.Get(), ValidatorListColumns::ColumnID_MaxTime)));
+				})
+				.Font(LocalFont)
+			]);
+
+	return WorstAssetsBox;
+}
+
+TSharedRef<SWidget> SValidatorTableRow::GetWorstAssetsMenu() const
+{
+	FMenuBuilder MenuBuilder(true, nullptr);
+	MenuBuilder.BeginSection(NAME_None, FText::FromString("Slowest Assets"));
+
+	const FValidatorXValidatorStats* const Stats = Validator.IsValid() ? FValidatorXManager::Get().GetStats().Find(Validator->GetClass()->GetFName()) : nullptr;
+	if (!Stats || Stats->WorstAssets.IsEmpty())
+	{
+		MenuBuilder.AddMenuEntry(FText::FromString("The validator has not run yet"), FText::GetEmpty(), FSlateIcon(), FUIAction(FExecuteAction(), FCanExecuteAction::CreateLambda([]() { return false; })));
+	}
+	else
+	{
+		for (const FValidatorXAssetTiming& Timing : Stats->WorstAssets)
+		{
+			const FSoftObjectPath AssetPath = Timing.AssetPath;
+			MenuBuilder.AddMenuEntry(
+				FText::FromString(FString::Printf(TEXT("%s  %.2f ms, %d message(s)"), *AssetPath.GetAssetName(), Timing.Seconds * 1000.0, Timing.NumMessages)),
+				FText::FromString(AssetPath.ToString()),
+				FSlateIcon(),
+				FUIAction(FExecuteAction::CreateLambda([AssetPath]()
+				{
+					const FAssetData AssetData = IAssetRegistry::GetChecked().GetAssetByObjectPath(AssetPath);
+					if (AssetData.IsValid() && GEditor)
+					{
+						GEditor->SyncBrowserToObjects(TArray<FAssetData>{AssetData});
+					}
+				})));
+		}
+	}
+
+	MenuBuilder.EndSection();
+	return MenuBuilder.MakeWidget();
+}
+
 ECheckBoxState SValidatorTableRow::GetBoxButtonState() const
 {
 	if (Validator.IsValid())
@@ -2,14 +2,35 @@
 
 #include "Widgets/SValidatorWidget.h"
 #include "BaseClasses/BlueprintValidatorBase.h"
+#include "ContentBrowserModule.h"
+#include "Editor.h"
+#include "Algo/Unique.h"
+#include "Engine/Blueprint.h"
+#include "Fixes/ValidatorXFixBatch.h"
+#include "Framework/MultiBox/MultiBoxBuilder.h"
+#include "Framework/Notifications/NotificationManager.h"
+#include "HAL/PlatformProcess.h"
+#include "IContentBrowserSingleton.h"
+#include "Jobs/ValidatorXValidationJob.h"
+#include "Logging/TokenizedMessage.h"
+#include "Misc/Paths.h"
+#include "Results/ValidatorXIssueTable.h"
 #include "Styling/SlateStyleRegistry.h"
+#include "Subsystems/AssetEditorSubsystem.h"
+#include "Widgets/Input/SComboButton.h"
+#include "Widgets/Input/SSearchBox.h"
+#include "Widgets/Input/SSegmentedControl.h"
+#include "Widgets/Notifications/SNotificationList.h"
+#include "Widgets/Notifications/SProgressBar.h"
 #include "Widgets/SValidatorTableRow.h"
+#include "ValidatorXManager.h"
 #include "ValidatorXTypes.h"
 
 /* clang-format off */
 void SValidatorWidget::Construct(const FArguments& InArgs)
 {
 	LocalValidators = InArgs._Validators;
+	RegisteredValidators = LocalValidators;
 
 	FontInfo = FAppStyle::GetFontStyle("NormalFont");
 	FontInfo.Size = 15.0f;
@@ -31,11 +52,134 @@ void SValidatorWidget::Construct(const FArguments& InArgs)
 		.AreaTitleFont(FontInfo)
 		.BodyContent()
 		[
-			SAssignNew(ListViewWidget, SListView<TWeakObjectPtr<UBlueprintValidatorBase>>)
-			.ListItemsSource(&LocalValidators)
-			.OnGenerateRow(this, &SValidatorWidget::OnGenerateRowForList)
-			.SelectionMode(ESelectionMode::None)
-			.HeaderRow(GetValidatorHeaderRow())
+			SNew(SVerticalBox)
+			+ SVerticalBox::Slot()
+			.AutoHeight()
+			.Padding(0.0f, 0.0f, 0.0f, 4.0f)
+			[
+				SNew(SHorizontalBox)
+				+ SHorizontalBox::Slot()
+				.AutoWidth()
+				.Padding(0.0f, 0.0f, 4.0f, 0.0f)
+				[
+					SNew(SButton)
+					.Text(FText::FromString("Export Stats CSV"))
+					.ToolTipText(FText::FromString("Writes the per-validator execution counters to Saved/ValidatorX/ValidatorStats.csv"))
+					.OnClicked(this, &SValidatorWidget::OnExportStatsClicked)
+				]
+				+ SHorizontalBox::Slot()
+				.AutoWidth()
+				[
+					SNew(SButton)
+					.Text(FText::FromString("Reset Stats"))
+					.ToolTipText(FText::FromString("Drops the per-validator execution counters"))
+					.OnClicked(this, &SValidatorWidget::OnResetStatsClicked)
+				]
+				+ SHorizontalBox::Slot()
+				.AutoWidth()
+				.Padding(16.0f, 0.0f, 4.0f, 0.0f)
+				[
+					SNew(SButton)
+					.Text(FText::FromString("Validate Selection"))
+					.ToolTipText(FText::FromString("Validates the Blueprints selected in the Content Browser, or every Blueprint under its current folder, in the background"))
+					.IsEnabled_Lambda([this]() { return !IsValidationRunning(); })
+					.OnClicked(this, &SValidatorWidget::OnValidateSelectionClicked)
+				]
+				+ SHorizontalBox::Slot()
+				.AutoWidth()
+				.Padding(0.0f, 0.0f, 4.0f, 0.0f)
+				[
+					SNew(SButton)
+					.Text(FText::FromString("Cancel"))
+					.ToolTipText(FText::FromString("Stops the validation; results of the assets validated so far are kept"))
+					.IsEnabled(this, &SValidatorWidget::IsValidationRunning)
+					.OnClicked(this, &SValidatorWidget::OnCancelValidationClicked)
+				]
+				+ SHorizontalBox::Slot()
+				.FillWidth(1.0f)
+				.VAlign(VAlign_Center)
+				.Padding(0.0f, 0.0f, 8.0f, 0.0f)
+				[
+					SNew(SProgressBar)
+					.Percent(this, &SValidatorWidget::GetValidationProgress)
+				]
+				+ SHorizontalBox::Slot()
+				.AutoWidth()
+				.VAlign(VAlign_Center)
+				[
+					SNew(STextBlock)
+					.Text(this, &SValidatorWidget::GetValidationStatusText)
+				]
+			]
+
+			+ SVerticalBox::Slot()
+			[
+				SAssignNew(ListViewWidget, SListView<TWeakObjectPtr<UBlueprintValidatorBase>>)
+				.ListItemsSource(&LocalValidators)
+				.OnGenerateRow(this, &SValidatorWidget::OnGenerateRowForList)
+				.SelectionMode(ESelectionMode::None)
+				.HeaderRow(GetValidatorHeaderRow())
+			]
+		]
+	]
+
+	+ SVerticalBox::Slot()
+	.Padding(4)
+	[
+		SNew(SExpandableArea)
+		.InitiallyCollapsed(false)
+		.AreaTitle(FText::FromString("Validation Results"))
+		.AreaTitleFont(FontInfo)
+		.BodyContent()
+		[
+			SNew(SVerticalBox)
+			+ SVerticalBox::Slot()
+			.AutoHeight()
+			.Padding(0.0f, 0.0f, 0.0f, 4.0f)
+			[
+				SNew(SHorizontalBox)
+				+ SHorizontalBox::Slot()
+				.FillWidth(1.0f)
+				.Padding(0.0f, 0.0f, 8.0f, 0.0f)
+				[
+					SNew(SSearchBox)
+					.HintText(FText::FromString("Filter by asset, folder, validator or message"))
+					.OnTextChanged(this, &SValidatorWidget::OnResultFilterChanged)
+				]
+				+ SHorizontalBox::Slot()
+				.AutoWidth()
+				[
+					SNew(SSegmentedControl<EResultGrouping>)
+					.Value_Lambda([this]() { return ResultGrouping; })
+					.OnValueChanged(this, &SValidatorWidget::OnResultGroupingChanged)
+					+ SSegmentedControl<EResultGrouping>::Slot(EResultGrouping::Validator)
+					.Text(FText::FromString("Validator"))
+					+ SSegmentedControl<EResultGrouping>::Slot(EResultGrouping::Asset)
+					.Text(FText::FromString("Asset"))
+					+ SSegmentedControl<EResultGrouping>::Slot(EResultGrouping::Folder)
+					.Text(FText::FromString("Folder"))
+				]
+				+ SHorizontalBox::Slot()
+				.AutoWidth()
+				.Padding(8.0f, 0.0f, 0.0f, 0.0f)
+				[
+					SNew(SButton)
+					.Text(FText::FromString("Fix Selected"))
+					.ToolTipText(FText::FromString("Applies the fixes of the selected messages, or of every message of the selected groups, in one undoable transaction, then validates the same assets again"))
+					.IsEnabled_Lambda([this]() { return !IsValidationRunning() && ResultListWidget.IsValid() && ResultListWidget->GetNumItemsSelected() > 0; })
+					.OnClicked(this, &SValidatorWidget::OnFixSelectedClicked)
+				]
+			]
+
+			+ SVerticalBox::Slot()
+			[
+				SAssignNew(ResultListWidget, SListView<TSharedPtr<FResultEntry>>)
+				.ListItemsSource(&ResultEntries)
+				.OnGenerateRow(this, &SValidatorWidget::OnGenerateResultRow)
+				.OnMouseButtonClick(this, &SValidatorWidget::OnResultClicked)
+				.OnMouseButtonDoubleClick(this, &SValidatorWidget::OnResultDoubleClicked)
+				.SelectionMode(ESelectionMode::Multi)
+			]
 		]
 	];
 
@@ -105,5 +249,550 @@ TSharedRef<SHeaderRow> SValidatorWidget::GetValidatorHeaderRow()
 		]
 	];
 
+	struct FStatColumn
+	{
+		FName ColumnId;
+		const TCHAR* Label;
+		const TCHAR* ToolTip;
+	};
+
+	const FStatColumn StatColumns[] = {
+		{ValidatorListColumns::ColumnID_Assets, TEXT("Assets"), TEXT("Number of assets the validator ran on")},
+		{ValidatorListColumns::ColumnID_Messages, TEXT("Messages"), TEXT("Number of messages the validator reported")},
+		{ValidatorListColumns::ColumnID_TotalTime, TEXT("Total ms"), TEXT("Time spent by the validator across every asset")},
+		{ValidatorListColumns::ColumnID_P50Time, TEXT("p50 ms"), TEXT("Median time per asset")},
+		{ValidatorListColumns::ColumnID_P95Time, TEXT("p95 ms"), TEXT("95th percentile of the time per asset")},
+		{ValidatorListColumns::ColumnID_MaxTime, TEXT("Max ms"), TEXT("Slowest asset; click a value to list the slowest assets")},
+	};
+
+	for (const FStatColumn& StatColumn : StatColumns)
+	{
+		HeaderRow->AddColumn(SHeaderRow::Column(StatColumn.ColumnId)
+			.FixedWidth(110.0f)
+			.HAlignHeader(HAlign_Center)
+			.SortMode(this, &SValidatorWidget::GetColumnSortMode, StatColumn.ColumnId)
+			.OnSort(this, &SValidatorWidget::OnSortColumn)
+			[
+				SNew(STextBlock)
+				.Text(FText::FromString(StatColumn.Label))
+				.ToolTipText(FText::FromString(StatColumn.ToolTip))
+				.Justification(ETextJustify::Center).Font(FontInfo)
+			]);
+	}
+
 	return HeaderRow;
 }
+
+void SValidatorWidget::Tick(const FGeometry& AllottedGeometry, const double InCurrentTime, const float InDeltaTime)
+{
+	SCompoundWidget::Tick(AllottedGeometry, InCurrentTime, InDeltaTime);
+
+	if (SortMode != EColumnSortMode::None && SortedStatsRevision != FValidatorXManager::Get().GetStats().GetRevision())
+	{
+		SortValidators();
+	}
+
+	RefreshResults();
+}
+
+void SValidatorWidget::OnSortColumn(EColumnSortPriority::Type SortPriority, const FName& ColumnId, EColumnSortMode::Type NewSortMode)
+{
+	// Stats read best slowest first, so the first click sorts descending
+	if (SortColumn != ColumnId)
+	{
+		NewSortMode = EColumnSortMode::Descending;
+	}
+
+	SortColumn = ColumnId;
+	SortMode = NewSortMode;
+	SortValidators();
+}
+
+EColumnSortMode::Type SValidatorWidget::GetColumnSortMode(FName ColumnId) const
+{
+	return SortColumn == ColumnId ? SortMode : EColumnSortMode::None;
+}
+
+void SValidatorWidget::SortValidators()
+{
+	SortedStatsRevision = FValidatorXManager::Get().GetStats().GetRevision();
+
+	LocalValidators = RegisteredValidators;
+	if (SortMode != EColumnSortMode::None)
+	{
+		const bool bDescending = SortMode == EColumnSortMode::Descending;
+		LocalValidators.StableSort([this, bDescending](const TWeakObjectPtr<UBlueprintValidatorBase>& A, const TWeakObjectPtr<UBlueprintValidatorBase>& B)
+		{
+			const double ValueA = SValidatorTableRow::GetStatValue(A.Get(), SortColumn);
+			const double ValueB = SValidatorTableRow::GetStatValue(B.Get(), SortColumn);
+			return bDescending ? ValueA > ValueB : ValueA < ValueB;
+		});
+	}
+
+	if (ListViewWidget.IsValid())
+	{
+		ListViewWidget->RequestListRefresh();
+	}
+}
+
+FReply SValidatorWidget::OnExportStatsClicked()
+{
+	const FString Filename = FValidatorXStats::GetDefaultCsvFilename();
+	const bool bSuccess = FValidatorXManager::Get().GetStats().ExportCsv(Filename);
+
+	FNotificationInfo Info(FText::FromString(bSuccess ? FString::Printf(TEXT("Validator stats written to %s"), *Filename) : FString::Printf(TEXT("Failed to write %s"), *Filename)));
+	Info.ExpireDuration = 5.0f;
+	if (bSuccess)
+	{
+		Info.Hyperlink = FSimpleDelegate::CreateLambda([Filename]() { FPlatformProcess::ExploreFolder(*FPaths::GetPath(Filename)); });
+		Info.HyperlinkText = FText::FromString("Open Folder");
+	}
+	FSlateNotificationManager::Get().AddNotification(Info);
+
+	return FReply::Handled();
+}
+
+FReply SValidatorWidget::OnResetStatsClicked()
+{
+	FValidatorXManager::Get().GetStats().Reset();
+	SortValidators();
+	return FReply::Handled();
+}
+
+FReply SValidatorWidget::OnValidateSelectionClicked()
+{
+	IContentBrowserSingleton& ContentBrowser = FModuleManager::LoadModuleChecked<FContentBrowserModule>("ContentBrowser").Get();
+
+	TArray<FAssetData> SelectedAssets;
+	ContentBrowser.GetSelectedAssets(SelectedAssets);
+
+	TArray<FAssetData> Assets;
+	if (SelectedAssets.IsEmpty())
+	{
+		const FString CurrentPath = ContentBrowser.GetCurrentPath().GetInternalPathString();
+		if (!CurrentPath.IsEmpty())
+		{
+			FValidatorXManager::FindBlueprintAssets({FName(*CurrentPath)}, Assets);
+		}
+	}
+	else
+	{
+		for (const FAssetData& Asset : SelectedAssets)
+		{
+			if (Asset.IsInstanceOf<UBlueprint>())
+			{
+				Assets.Add(Asset);
+			}
+		}
+		Assets.Sort([](const FAssetData& A, const FAssetData& B) { return A.PackageName.LexicalLess(B.PackageName); });
+	}
+
+	if (Assets.IsEmpty())
+	{
+		FNotificationInfo Info(FText::FromString("No Blueprint is selected in the Content Browser"));
+		Info.ExpireDuration = 5.0f;
+		FSlateNotificationManager::Get().AddNotification(Info);
+		return FReply::Handled();
+	}
+
+	FValidatorXManager::Get().StartValidationJob(MoveTemp(Assets));
+	RefreshResults();
+	return FReply::Handled();
+}
+
+FReply SValidatorWidget::OnCancelValidationClicked()
+{
+	if (const TSharedPtr<FValidatorXValidationJob> Job = FValidatorXManager::Get().GetValidationJob())
+	{
+		Job->Cancel();
+	}
+	return FReply::Handled();
+}
+
+FReply SValidatorWidget::OnFixSelectedClicked()
+{
+	const TSharedPtr<FValidatorXValidationJob> Job = DisplayedJob.Pin();
+	if (!Job.IsValid() || Job->IsRunning() || !ResultListWidget.IsValid())
+	{
+		return FReply::Handled();
+	}
+
+	// A selected group stands for all of its messages, even collapsed
+	TArray<int32> Rows;
+	for (const TSharedPtr<FResultEntry>& Entry : ResultListWidget->GetSelectedItems())
+	{
+		if (Entry->Row == INDEX_NONE)
+		{
+			Rows.Append(ResultGroups[Entry->Group].Rows);
+		}
+		else
+		{
+			Rows.Add(Entry->Row);
+		}
+	}
+	Rows.Sort();
+	Rows.SetNum(Algo::Unique(Rows));
+
+	FValidatorXFixBatch Batch;
+	Job->GetIssueTable().AddFixes(Rows, Batch);
+	const FValidatorXFixBatch::FResult Result = Batch.Apply();
+
+	FNotificationInfo Info(FText::FromString(FString::Printf(TEXT("Fixed %d issues in %d Blueprints, %d could not be fixed"),
+		Result.NumFixed, Result.NumBlueprints, Rows.Num() - Result.NumFixed)));
+	Info.ExpireDuration = 5.0f;
+	FSlateNotificationManager::Get().AddNotification(Info);
+
+	// The messages are stale now, validating the same assets again replaces them
+	if (Result.NumFixed > 0)
+	{
+		FValidatorXManager::Get().StartValidationJob(Job->GetAssets());
+		RefreshResults();
+	}
+	return FReply::Handled();
+}
+
+bool SValidatorWidget::IsValidationRunning() const
+{
+	const TSharedPtr<FValidatorXValidationJob> Job = FValidatorXManager::Get().GetValidationJob();
+	return Job.IsValid() && Job->IsRunning();
+}
+
+TOptional<float> SValidatorWidget::GetValidationProgress() const
+{
+	const TSharedPtr<FValidatorXValidationJob> Job = FValidatorXManager::Get().GetValidationJob();
+	return Job.IsValid() ? Job->GetProgress() : 0.0f;
+}
+
+FText SValidatorWidget::GetValidationStatusText() const
+{
+	const TSharedPtr<FValidatorXValidationJob> Job = FValidatorXManager::Get().GetValidationJob();
+	if (!Job.IsValid())
+	{
+		return FText::GetEmpty();
+	}
+
+	auto FormatSeconds = [](double Seconds)
+	{
+		return FTimespan::FromSeconds(FMath::CeilToDouble(Seconds)).ToString(TEXT("%h:%m:%s"));
+	};
+
+	if (Job->IsRunning())
+	{
+		const TOptional<double> RemainingSeconds = Job->GetRemainingSeconds();
+		return FText::FromString(FString::Printf(TEXT("%d / %d assets, %.1f assets/s, %s remaining"),
+			Job->GetNumValidated(), Job->GetNumAssets(), Job->GetAssetsPerSecond(),
+			RemainingSeconds.IsSet() ? *FormatSeconds(RemainingSeconds.GetValue()) : TEXT("--:--:--")));
+	}
+
+	return FText::FromString(FString::Printf(TEXT("%s %d / %d assets in %s, %d with errors"),
+		Job->IsCancelled() ? TEXT("Cancelled after") : TEXT("Validated"),
+		Job->GetNumValidated(), Job->GetNumAssets(), *FormatSeconds(Job->GetElapsedSeconds()), Job->GetNumInvalid()));
+}
+
+void SValidatorWidget::RefreshResults()
+{
+	const TSharedPtr<FValidatorXValidationJob> Job = FValidatorXManager::Get().GetValidationJob();
+	if (DisplayedJob.Pin() != Job)
+	{
+		DisplayedJob = Job;
+		bWasJobRunning = false;
+		ResetResultGroups();
+		RebuildResultEntries();
+	}
+
+	if (!Job.IsValid())
+	{
+		return;
+	}
+
+	// Grouping is incremental, but regenerating the visible lines every frame is wasted work
+	const double CurrentTime = FPlatformTime::Seconds();
+	const bool bIsRunning = Job->IsRunning();
+	if (Job->GetIssueTable().Num() > NumGroupedRows && (!bIsRunning || CurrentTime - LastResultsUpdateTime >= 0.25))
+	{
+		LastResultsUpdateTime = CurrentTime;
+		UpdateResultGroups();
+		RebuildResultEntries();
+	}
+
+	if (bWasJobRunning && !bIsRunning && !Job->IsCancelled())
+	{
+		FNotificationInfo Info(GetValidationStatusText());
+		Info.ExpireDuration = 5.0f;
+		FSlateNotificationManager::Get().AddNotification(Info);
+	}
+	bWasJobRunning = bIsRunning;
+}
+
+const FValidatorXIssueTable* SValidatorWidget::GetDisplayedIssueTable() const
+{
+	const TSharedPtr<FValidatorXValidationJob> Job = DisplayedJob.Pin();
+	return Job.IsValid() ? &Job->GetIssueTable() : nullptr;
+}
+
+void SValidatorWidget::ResetResultGroups()
+{
+	ResultGroups.Reset();
+	ResultGroupIndices.Reset();
+	NumGroupedRows = 0;
+}
+
+void SValidatorWidget::UpdateResultGroups()
+{
+	const FValidatorXIssueTable* const IssueTable = GetDisplayedIssueTable();
+	if (!IssueTable)
+	{
+		return;
+	}
+
+	TArray<int32> FilteredRows;
+	IssueTable->FilterRows(ResultFilterText, NumGroupedRows, FilteredRows);
+	NumGroupedRows = IssueTable->Num();
+
+	for (const int32 Row : FilteredRows)
+	{
+		const FValidatorXIssueTable::FRow& IssueRow = IssueTable->GetRow(Row);
+		const FAssetData& AssetData = IssueTable->GetAsset(IssueRow.Asset);
+
+		FName Label;
+		switch (ResultGrouping)
+		{
+			case EResultGrouping::Validator:
+				Label = IssueTable->GetValidatorName(IssueRow.Validator);
+				break;
+			case EResultGrouping::Asset:
+				Label = AssetData.PackageName;
+				break;
+			case EResultGrouping::Folder:
+				Label = AssetData.PackagePath;
+				break;
+		}
+
+		int32* GroupIndex = ResultGroupIndices.Find(Label);
+		if (!GroupIndex)
+		{
+			GroupIndex = &ResultGroupIndices.Add(Label, ResultGroups.Num());
+			ResultGroups.Add(FResultGroup{Label});
+		}
+		ResultGroups[*GroupIndex].Rows.Add(Row);
+	}
+}
+
+void SValidatorWidget::RebuildResultEntries()
+{
+	TArray<int32> SortedGroups;
+	SortedGroups.Reserve(ResultGroups.Num());
+	for (int32 GroupIndex = 0; GroupIndex < ResultGroups.Num(); ++GroupIndex)
+	{
+		SortedGroups.Add(GroupIndex);
+	}
+	SortedGroups.Sort([this](int32 A, int32 B) { return ResultGroups[A].Label.LexicalLess(ResultGroups[B].Label); });
+
+	// Only expanded groups produce a line per message
+	ResultEntries.Reset();
+	for (const int32 GroupIndex : SortedGroups)
+	{
+		ResultEntries.Add(MakeShared<FResultEntry>(FResultEntry{GroupIndex}));
+		if (ExpandedResultGroups.Contains(ResultGroups[GroupIndex].Label))
+		{
+			for (const int32 Row : ResultGroups[GroupIndex].Rows)
+			{
+				ResultEntries.Add(MakeShared<FResultEntry>(FResultEntry{GroupIndex, Row}));
+			}
+		}
+	}
+
+	if (ResultListWidget.IsValid())
+	{
+		ResultListWidget->RequestListRefresh();
+	}
+}
+
+void SValidatorWidget::OnResultFilterChanged(const FText& InFilterText)
+{
+	ResultFilterText = InFilterText.ToString();
+	ResetResultGroups();
+	UpdateResultGroups();
+	RebuildResultEntries();
+}
+
+void SValidatorWidget::OnResultGroupingChanged(EResultGrouping InGrouping)
+{
+	ResultGrouping = InGrouping;
+	ResetResultGroups();
+	UpdateResultGroups();
+	RebuildResultEntries();
+}
+
+TSharedRef<ITableRow> SValidatorWidget::OnGenerateResultRow(TSharedPtr<FResultEntry> InEntry, const TSharedRef<STableViewBase>& OwnerTable)
+{
+	const FValidatorXIssueTable* const IssueTable = GetDisplayedIssueTable();
+	const FResultGroup& Group = ResultGroups[InEntry->Group];
+
+	if (InEntry->Row == INDEX_NONE || !IssueTable)
+	{
+		const bool bIsExpanded = ExpandedResultGroups.Contains(Group.Label);
+		return SNew(STableRow<TSharedPtr<FResultEntry>>, OwnerTable)
+		[
+			SNew(SHorizontalBox)
+			+ SHorizontalBox::Slot()
+			.AutoWidth()
+			.VAlign(VAlign_Center)
+			.Padding(2.0f, 0.0f)
+			[
+				SNew(SImage)
+				.Image(FAppStyle::GetBrush(bIsExpanded ? "TreeArrow_Expanded" : "TreeArrow_Collapsed"))
+			]
+			+ SHorizontalBox::Slot()
+			.FillWidth(1.0f)
+			.VAlign(VAlign_Center)
+			.Padding(4.0f, 2.0f)
+			[
+				SNew(STextBlock)
+				.Text(FText::FromString(FString::Printf(TEXT("%s (%d)"), *Group.Label.ToString(), Group.Rows.Num())))
+				.Font(FAppStyle::GetFontStyle("BoldFont"))
+			]
+		];
+	}
+
+	// Message text is formatted here, for the lines on screen only
+	const int32 Row = InEntry->Row;
+	const FValidatorXIssueTable::FRow& IssueRow = IssueTable->GetRow(Row);
+	const EMessageSeverity::Type Severity = static_cast<EMessageSeverity::Type>(IssueRow.Severity);
+	const FName IconName = Severity == EMessageSeverity::Error
+		? FName("Icons.ErrorWithColor")
+		: Severity == EMessageSeverity::Info ? FName("Icons.InfoWithColor") : FName("Icons.WarningWithColor");
+
+	const FAssetData& AssetData = IssueTable->GetAsset(IssueRow.Asset);
+	const FText ContextText = ResultGrouping == EResultGrouping::Validator
+		? FText::FromName(AssetData.AssetName)
+		: FText::FromName(IssueTable->GetValidatorName(IssueRow.Validator));
+
+	return SNew(STableRow<TSharedPtr<FResultEntry>>, OwnerTable)
+	[
+		SNew(SHorizontalBox)
+		+ SHorizontalBox::Slot()
+		.AutoWidth()
+		.VAlign(VAlign_Center)
+		.Padding(20.0f, 0.0f, 2.0f, 0.0f)
+		[
+			SNew(SImage)
+			.Image(FAppStyle::GetBrush(IconName))
+		]
+		+ SHorizontalBox::Slot()
+		.FillWidth(0.25f)
+		.VAlign(VAlign_Center)
+		.Padding(4.0f, 0.0f)
+		[
+			SNew(STextBlock)
+			.Text(ContextText)
+			.ToolTipText(FText::FromName(AssetData.PackageName))
+		]
+		+ SHorizontalBox::Slot()
+		.FillWidth(0.75f)
+		.VAlign(VAlign_Center)
+		.Padding(4.0f, 0.0f)
+		[
+			SNew(STextBlock)
+			.Text(IssueTable->GetMessage(Row))
+		]
+		+ SHorizontalBox::Slot()
+		.AutoWidth()
+		.VAlign(VAlign_Center)
+		.Padding(4.0f, 0.0f)
+		[
+			SNew(SComboButton)
+			.ButtonContent()
+			[
+				SNew(STextBlock)
+				.Text(FText::FromString("Actions"))
+			]
+			.OnGetMenuContent(this, &SValidatorWidget::MakeResultActionsMenu, Row)
+		]
+	];
+}
+
+void SValidatorWidget::OnResultClicked(TSharedPtr<FResultEntry> InEntry)
+{
+	if (!InEntry.IsValid() || InEntry->Row != INDEX_NONE)
+	{
+		return;
+	}
+
+	const FName Label = ResultGroups[InEntry->Group].Label;
+	if (ExpandedResultGroups.Remove(Label) == 0)
+	{
+		ExpandedResultGroups.Add(Label);
+	}
+	RebuildResultEntries();
+}
+
+void SValidatorWidget::OnResultDoubleClicked(TSharedPtr<FResultEntry> InEntry)
+{
+	const FValidatorXIssueTable* const IssueTable = GetDisplayedIssueTable();
+	if (!InEntry.IsValid() || InEntry->Row == INDEX_NONE || !IssueTable)
+	{
+		return;
+	}
+
+	const TSharedRef<FTokenizedMessage> Message = IssueTable->CreateMessage(InEntry->Row);
+	for (const TSharedRef<IMessageToken>& Token : Message->GetMessageTokens())
+	{
+		if (Token->GetType() == EMessageToken::Action)
+		{
+			StaticCastSharedRef<FActionToken>(Token)->ExecuteAction();
+			return;
+		}
+	}
+
+	UAssetEditorSubsystem* const AssetEditorSubsystem = GEditor ? GEditor->GetEditorSubsystem<UAssetEditorSubsystem>() : nullptr;
+	if (AssetEditorSubsystem)
+	{
+		AssetEditorSubsystem->OpenEditorForAsset(IssueTable->GetAsset(IssueTable->GetRow(InEntry->Row).Asset).GetAsset());
+	}
+}
+
+TSharedRef<SWidget> SValidatorWidget::MakeResultActionsMenu(int32 Row) const
+{
+	FMenuBuilder MenuBuilder(true, nullptr);
+
+	const FValidatorXIssueTable* const IssueTable = GetDisplayedIssueTable();
+	if (!IssueTable || Row >= IssueTable->Num())
+	{
+		return MenuBuilder.MakeWidget();
+	}
+
+	const FAssetData AssetData = IssueTable->GetAsset(IssueTable->GetRow(Row).Asset);
+	MenuBuilder.AddMenuEntry(
+		FText::FromString("Open Asset"),
+		FText::FromName(AssetData.PackageName),
+		FSlateIcon(),
+		FUIAction(FExecuteAction::CreateLambda([AssetData]()
+		{
+			if (UAssetEditorSubsystem* const AssetEditorSubsystem = GEditor ? GEditor->GetEditorSubsystem<UAssetEditorSubsystem>() : nullptr)
+			{
+				AssetEditorSubsystem->OpenEditorForAsset(AssetData.GetAsset());
+			}
+		})));
+
+	// The action tokens of this message only, created when its menu opens
+	const TSharedRef<FTokenizedMessage> Message = IssueTable->CreateMessage(Row);
+	for (const TSharedRef<IMessageToken>& Token : Message->GetMessageTokens())
+	{
+		if (Token->GetType() != EMessageToken::Action)
+		{
+			continue;
+		}
+
+		const TSharedRef<FActionToken> ActionToken = StaticCastSharedRef<FActionToken>(Token);
+		MenuBuilder.AddMenuEntry(
+			ActionToken->ToText(),
+			ActionToken->GetActionDescription(),
+			FSlateIcon(),
+			FUIAction(
+				FExecuteAction::CreateLambda([ActionToken]() { ActionToken->ExecuteAction(); }),
+				FCanExecuteAction::CreateLambda([ActionToken]() { return ActionToken->CanExecuteAction(); })));
+	}
+
+	return MenuBuilder.MakeWidget();
+}
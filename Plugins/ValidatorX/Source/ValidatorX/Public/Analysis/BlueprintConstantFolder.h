@@ -0,0 +1,78 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+struct FBlueprintSnapshot;
+struct FBlueprintSnapshotVariable;
+
+/**
+ * @brief Folds the pure data paths of a Blueprint snapshot into constants.
+ *
+ * Evaluates boolean and numeric pin literals, Gets of such variables that keep their default value,
+ * reroute nodes and the pure boolean and comparison operators of the Kismet libraries (NOT, AND,
+ * OR, XOR, NAND, NOR, ==, !=, <, <=, >, >=). Other types, such as objects, text and strings, are
+ * never folded. Values are numbers, booleans being 0 or 1. AND and OR short-circuit, so
+ * `X AND false` folds even when `X` does not.
+ *
+ * Folded output pins are memoized, so every pure node is evaluated at most once.
+ */
+class VALIDATORX_API FBlueprintConstantFolder
+{
+public:
+	/**
+	 * @brief Creates a folder.
+	 *
+	 * Locals that are never set keep their default value. Whether a member variable does depends
+	 * on other Blueprints, so the caller decides.
+	 *
+	 * @param InSnapshot The snapshot to fold. Must outlive the folder.
+	 * @param InIsConstantMember Returns whether a member variable always has its class default value.
+	 */
+	FBlueprintConstantFolder(const FBlueprintSnapshot& InSnapshot, TFunction<bool(const FBlueprintSnapshotVariable&)> InIsConstantMember);
+
+	/**
+	 * @brief Folds the value of an input pin.
+	 *
+	 * @param PinIndex Index of the input pin in `FBlueprintSnapshot::Pins`.
+	 * @return The value, or unset if it depends on runtime state.
+	 */
+	TOptional<double> FoldInput(int32 PinIndex);
+
+	/**
+	 * @brief Parses a pin or variable default value.
+	 *
+	 * Only meaningful for boolean and numeric types, which callers check first: other literals, such
+	 * as strings holding digits, would parse as numbers too.
+	 *
+	 * @param DefaultValue Exported text of the value; empty for the default of the type.
+	 * @return The value of a boolean or number, unset otherwise.
+	 */
+	static TOptional<double> ParseConstant(const FString& DefaultValue);
+
+private:
+	/** @return The memoized value of an output pin. */
+	TOptional<double> FoldOutput(int32 PinIndex);
+
+	/** @return The value of the output of a node. */
+	TOptional<double> FoldNode(int32 NodeIndex);
+
+	/** @return The value of a Get node. */
+	TOptional<double> FoldVariableGet(int32 NodeIndex);
+
+	/** @return The value of a pure Kismet library operator. */
+	TOptional<double> FoldOperator(int32 NodeIndex);
+
+	/** @brief The folded snapshot. */
+	const FBlueprintSnapshot& Snapshot;
+
+	/** @brief Decides which member variables keep their default value. */
+	TFunction<bool(const FBlueprintSnapshotVariable&)> IsConstantMember;
+
+	/** @brief Variable index of every Get node, from the def/use table of the snapshot. */
+	TMap<int32, int32> GetNodeVariables;
+
+	/** @brief Values of the output pins folded so far; unset while an output is being folded. */
+	TMap<int32, TOptional<double>> FoldedOutputs;
+};
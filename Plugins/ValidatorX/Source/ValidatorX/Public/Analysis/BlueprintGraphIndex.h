@@ -0,0 +1,149 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+class UBlueprint;
+class UEdGraph;
+class UEdGraphNode;
+class UEdGraphNode_Comment;
+class UK2Node_BaseMCDelegate;
+class UK2Node_CallFunction;
+class UK2Node_Event;
+class UK2Node_FunctionEntry;
+class UK2Node_IfThenElse;
+class UK2Node_MacroInstance;
+class UK2Node_VariableGet;
+class UK2Node_VariableSet;
+
+/**
+ * @brief Single-pass lookup index over every graph of a Blueprint.
+ *
+ * Walks `UBlueprint::GetAllGraphs` once and buckets the nodes validators are interested in
+ * by class, so each validator can do hashed lookups instead of re-walking `Graph->Nodes`
+ * with its own chain of `Cast<>` calls.
+ *
+ * The index stores raw node pointers and is only valid while the Blueprint is not edited.
+ * Validators should obtain it through `UBlueprintValidatorBase::GetGraphIndex`, which shares
+ * one instance between all validators of a validation run.
+ */
+class VALIDATORX_API FBlueprintGraphIndex
+{
+public:
+	/**
+	 * @brief Builds the index by walking every graph of the Blueprint once.
+	 *
+	 * @param InBlueprint The Blueprint to index. May be null, in which case the index is empty.
+	 */
+	explicit FBlueprintGraphIndex(UBlueprint* InBlueprint);
+
+	/** @return The indexed Blueprint, or null if it has been destroyed. */
+	UBlueprint* GetBlueprint() const { return Blueprint.Get(); }
+
+	/** @return Every non-null graph of the Blueprint, in `GetAllGraphs` order. */
+	const TArray<UEdGraph*>& GetGraphs() const { return Graphs; }
+
+	/** @return The total number of nodes across all indexed graphs. */
+	int32 GetNumNodes() const { return NumNodes; }
+
+	/** @return The graph with the given name, or null if there is none. */
+	UEdGraph* FindGraph(FName GraphName) const;
+
+	/** @return The node with the given guid, or null if there is none. */
+	UEdGraphNode* FindNode(const FGuid& NodeGuid) const;
+
+	/** @return All "Get" nodes reading the given variable. */
+	TConstArrayView<UK2Node_VariableGet*> FindVariableGets(FName VarName) const;
+
+	/** @return All "Set" nodes writing the given variable. */
+	TConstArrayView<UK2Node_VariableSet*> FindVariableSets(FName VarName) const;
+
+	/** @return All "Set" nodes, keyed by variable name. */
+	const TMap<FName, TArray<UK2Node_VariableSet*>>& GetVariableSets() const { return VariableSets; }
+
+	/**
+	 * @brief Checks whether a variable is read or written anywhere.
+	 *
+	 * @param VarName The variable name to look up.
+	 * @param InGraph Optional graph to restrict the lookup to (used for local variables).
+	 * @return true if at least one Get or Set node references the variable.
+	 */
+	bool IsVariableReferenced(FName VarName, const UEdGraph* InGraph = nullptr) const;
+
+	/** @return All call nodes whose function reference has the given member name. */
+	TConstArrayView<UK2Node_CallFunction*> FindFunctionCalls(FName MemberName) const;
+
+	/** @return All call nodes placed in the given graph. */
+	TConstArrayView<UK2Node_CallFunction*> FindFunctionCallsInGraph(const UEdGraph* Graph) const;
+
+	/** @return All instances of the given macro graph. */
+	TConstArrayView<UK2Node_MacroInstance*> FindMacroInstances(const UEdGraph* MacroGraph) const;
+
+	/** @return All macro instances placed in the given graph. */
+	TConstArrayView<UK2Node_MacroInstance*> FindMacroInstancesInGraph(const UEdGraph* Graph) const;
+
+	/** @return All bind/unbind/assign/call nodes referencing the given delegate property. */
+	TConstArrayView<UK2Node_BaseMCDelegate*> FindDelegateNodes(FName PropertyName) const;
+
+	/** @return All comment boxes placed in the given graph. */
+	TConstArrayView<UEdGraphNode_Comment*> FindComments(const UEdGraph* Graph) const;
+
+	/** @return The function entry node of the given graph, or null if it has none. */
+	UK2Node_FunctionEntry* FindFunctionEntry(const UEdGraph* Graph) const;
+
+	/** @return All Branch nodes of the Blueprint. */
+	const TArray<UK2Node_IfThenElse*>& GetBranches() const { return Branches; }
+
+	/** @return All event nodes of the Blueprint. */
+	const TArray<UK2Node_Event*>& GetEvents() const { return Events; }
+
+private:
+	/** @brief The indexed Blueprint. */
+	TWeakObjectPtr<UBlueprint> Blueprint;
+
+	/** @brief Every non-null graph of the Blueprint. */
+	TArray<UEdGraph*> Graphs;
+
+	/** @brief Total number of indexed nodes. */
+	int32 NumNodes = 0;
+
+	/** @brief Graphs keyed by name. */
+	TMap<FName, UEdGraph*> GraphsByName;
+
+	/** @brief Nodes keyed by guid. */
+	TMap<FGuid, UEdGraphNode*> NodesByGuid;
+
+	/** @brief Variable Get nodes keyed by variable name. */
+	TMap<FName, TArray<UK2Node_VariableGet*>> VariableGets;
+
+	/** @brief Variable Set nodes keyed by variable name. */
+	TMap<FName, TArray<UK2Node_VariableSet*>> VariableSets;
+
+	/** @brief Call function nodes keyed by member name. */
+	TMap<FName, TArray<UK2Node_CallFunction*>> FunctionCalls;
+
+	/** @brief Call function nodes keyed by owning graph. */
+	TMap<const UEdGraph*, TArray<UK2Node_CallFunction*>> FunctionCallsByGraph;
+
+	/** @brief Macro instances keyed by the instanced macro graph. */
+	TMap<const UEdGraph*, TArray<UK2Node_MacroInstance*>> MacroInstances;
+
+	/** @brief Macro instances keyed by owning graph. */
+	TMap<const UEdGraph*, TArray<UK2Node_MacroInstance*>> MacroInstancesByGraph;
+
+	/** @brief Delegate nodes keyed by delegate property name. */
+	TMap<FName, TArray<UK2Node_BaseMCDelegate*>> DelegateNodes;
+
+	/** @brief Comment boxes keyed by owning graph. */
+	TMap<const UEdGraph*, TArray<UEdGraphNode_Comment*>> Comments;
+
+	/** @brief First function entry node of each graph. */
+	TMap<const UEdGraph*, UK2Node_FunctionEntry*> FunctionEntries;
+
+	/** @brief All Branch nodes. */
+	TArray<UK2Node_IfThenElse*> Branches;
+
+	/** @brief All event nodes. */
+	TArray<UK2Node_Event*> Events;
+};
@@ -0,0 +1,101 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UObject/TopLevelAssetPath.h"
+
+struct FAssetData;
+
+/**
+ * @brief Blueprint class hierarchy built from asset registry tags, without loading any asset.
+ *
+ * Every Blueprint asset contributes one edge, read from its `GeneratedClass` and `ParentClass`
+ * tags. The index is built once from the asset registry and then kept up to date from the
+ * registry add, remove, rename and update events, so "all Blueprints derived from X" is a walk
+ * over an in-memory map instead of a load of every Blueprint in the project.
+ *
+ * Obtain it through `FValidatorXManager::GetHierarchyIndex`. Game thread only.
+ */
+class VALIDATORX_API FBlueprintHierarchyIndex
+{
+public:
+	FBlueprintHierarchyIndex() = default;
+	FBlueprintHierarchyIndex(const FBlueprintHierarchyIndex&) = delete;
+	FBlueprintHierarchyIndex& operator=(const FBlueprintHierarchyIndex&) = delete;
+	~FBlueprintHierarchyIndex();
+
+	/** @brief Builds the index from the asset registry and subscribes to its events. Does nothing if already initialized. */
+	void Initialize();
+
+	/** @brief Unsubscribes from the asset registry and drops the index. */
+	void Shutdown();
+
+	/** @return Whether the index has been built. */
+	bool IsInitialized() const { return bIsInitialized; }
+
+	/**
+	 * @brief Returns the generated class of the Blueprint saved in a package.
+	 *
+	 * @param PackageName The Blueprint package.
+	 * @return The generated class path, or an invalid path if the package holds no Blueprint.
+	 */
+	FTopLevelAssetPath FindGeneratedClass(FName PackageName) const;
+
+	/**
+	 * @brief Returns the parent class of a Blueprint generated class.
+	 *
+	 * @param ClassPath The Blueprint generated class.
+	 * @return The parent class path, which may be native, or an invalid path if the class is not indexed.
+	 */
+	FTopLevelAssetPath GetParentClass(const FTopLevelAssetPath& ClassPath) const;
+
+	/**
+	 * @brief Collects the Blueprint ancestors of a class, nearest first, stopping at the first native class.
+	 *
+	 * @param ClassPath The class to start from.
+	 * @param OutClassPaths Receives the Blueprint generated class paths of every ancestor.
+	 */
+	void GetParentClasses(const FTopLevelAssetPath& ClassPath, TArray<FTopLevelAssetPath>& OutClassPaths) const;
+
+	/**
+	 * @brief Collects every Blueprint generated class deriving from a class, recursively.
+	 *
+	 * @param ClassPath The parent class, Blueprint or native.
+	 * @param OutClassPaths Receives the derived Blueprint generated class paths, parents before children.
+	 */
+	void GetDerivedClasses(const FTopLevelAssetPath& ClassPath, TArray<FTopLevelAssetPath>& OutClassPaths) const;
+
+	/** @return The number of indexed Blueprints. */
+	int32 Num() const { return ParentClasses.Num(); }
+
+private:
+	/** @brief Adds or updates the edge of a Blueprint asset. */
+	void AddAsset(const FAssetData& AssetData);
+
+	/** @brief Removes the edge of the Blueprint saved in a package. */
+	void RemovePackage(FName PackageName);
+
+	/** @brief Asset registry event handlers. */
+	void HandleAssetAdded(const FAssetData& AssetData);
+	void HandleAssetRemoved(const FAssetData& AssetData);
+	void HandleAssetRenamed(const FAssetData& AssetData, const FString& OldObjectPath);
+
+	/** @brief Parent class keyed by Blueprint generated class. */
+	TMap<FTopLevelAssetPath, FTopLevelAssetPath> ParentClasses;
+
+	/** @brief Direct Blueprint children keyed by parent class, Blueprint or native. */
+	TMap<FTopLevelAssetPath, TArray<FTopLevelAssetPath>> ChildClasses;
+
+	/** @brief Blueprint generated class keyed by package. */
+	TMap<FName, FTopLevelAssetPath> ClassesByPackage;
+
+	/** @brief Whether the index has been built. */
+	bool bIsInitialized = false;
+
+	/** @brief Handles of the asset registry event bindings. */
+	FDelegateHandle AssetAddedHandle;
+	FDelegateHandle AssetRemovedHandle;
+	FDelegateHandle AssetRenamedHandle;
+	FDelegateHandle AssetUpdatedHandle;
+};
@@ -0,0 +1,354 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "EdGraph/EdGraphPin.h"
+
+class FBlueprintGraphIndex;
+class UBlueprint;
+class UEdGraph;
+
+/** @brief Kind of graph a snapshot graph was captured from. */
+enum class EValidatorXGraphType : uint8
+{
+	EventGraph,
+	Function,
+	Macro,
+	Delegate,
+	Intermediate,
+	/** Sub-graph of another graph (collapsed nodes, composite graphs). */
+	Nested,
+};
+
+/** @return Display name of a graph type, matching `UBPUtilsNodeFunctionLibrary::GetGraphType`. */
+VALIDATORX_API const TCHAR* LexToString(EValidatorXGraphType GraphType);
+
+/** @brief Coarse node class tag used by snapshot analysis instead of `Cast<>` chains. */
+enum class EValidatorXNodeKind : uint8
+{
+	Other,
+	Comment,
+	Event,
+	FunctionEntry,
+	FunctionResult,
+	Tunnel,
+	MacroInstance,
+	CallFunction,
+	VariableGet,
+	VariableSet,
+	Branch,
+	AddDelegate,
+	RemoveDelegate,
+	CallDelegate,
+	OtherDelegate,
+};
+
+/** @brief A single pin of a snapshot node. */
+struct FBlueprintSnapshotPin
+{
+	/** @brief Pin name. */
+	FName Name;
+
+	/** @brief Pin type category (`UEdGraphSchema_K2::PC_*`). */
+	FName Category;
+
+	/** @brief Whether a byte pin carries an enum, whose literal is an enumerator name. */
+	bool bIsEnum = false;
+
+	/** @brief Literal default value, used when the pin is not linked. */
+	FString DefaultValue;
+
+	/** @brief Whether this is an input or an output pin. */
+	TEnumAsByte<EEdGraphPinDirection> Direction = EGPD_Input;
+
+	/** @brief Index of the owning node in `FBlueprintSnapshot::Nodes`. */
+	int32 Node = INDEX_NONE;
+
+	/** @brief Index of the first link of this pin in `FBlueprintSnapshot::Links`. */
+	int32 FirstLink = 0;
+
+	/** @brief Number of pins this pin is linked to. */
+	int32 NumLinks = 0;
+};
+
+/** @brief One end of a connection between two snapshot pins, stored once from each side. */
+struct FBlueprintSnapshotLink
+{
+	/** @brief Index of the pin the link is stored for. */
+	int32 FromPin = INDEX_NONE;
+
+	/** @brief Index of the pin it is linked to. */
+	int32 ToPin = INDEX_NONE;
+};
+
+/** @brief A single node of a snapshot graph. */
+struct FBlueprintSnapshotNode
+{
+	/** @brief Coarse class tag of the node. */
+	EValidatorXNodeKind Kind = EValidatorXNodeKind::Other;
+
+	/** @brief Name of the node class, such as `K2Node_DynamicCast`, for nodes `Kind` does not tell apart. */
+	FName NodeClass;
+
+	/** @brief Index of the owning graph in `FBlueprintSnapshot::Graphs`. */
+	int32 Graph = INDEX_NONE;
+
+	/** @brief Guid of the source node, used to resolve it again on the game thread. */
+	FGuid Guid;
+
+	/** @brief Object name of the source node, unique within its graph. */
+	FName Name;
+
+	/** @brief Full title of the source node as shown in the graph editor, used in messages. */
+	FString Title;
+
+	/** @brief Position of the node in its graph. */
+	int32 PosX = 0;
+	int32 PosY = 0;
+
+	/** @brief Size of the node, only stored by resizable nodes such as comments. */
+	int32 Width = 0;
+	int32 Height = 0;
+
+	/**
+	 * @brief Name of the member the node refers to: variable name for Get/Set nodes, function name
+	 * for call and event nodes, macro graph name for macro instances, property name for delegate nodes.
+	 */
+	FName MemberName;
+
+	/** @brief Package owning the referenced member (function class or macro Blueprint), if any. */
+	FName MemberPackage;
+
+	/** @brief Index of the first pin of this node in `FBlueprintSnapshot::Pins`. */
+	int32 FirstPin = 0;
+
+	/** @brief Number of pins of this node. */
+	int32 NumPins = 0;
+
+	/** @brief Whether the node is pure (has no exec pins). */
+	bool bIsPure = false;
+
+	/** @brief Whether the node derives from `UK2Node_Tunnel` (tunnels, macro instances, composites). */
+	bool bIsTunnel = false;
+
+	/** @brief Whether the node is an event the editor placed automatically, such as BeginPlay in a new Actor Blueprint. */
+	bool bIsGhost = false;
+};
+
+/** @brief A single graph of a snapshot Blueprint. */
+struct FBlueprintSnapshotGraph
+{
+	/** @brief Graph name. */
+	FName Name;
+
+	/** @brief Which list of the Blueprint the graph belongs to. */
+	EValidatorXGraphType Type = EValidatorXGraphType::Nested;
+
+	/** @brief Index of the first node of this graph in `FBlueprintSnapshot::Nodes`. */
+	int32 FirstNode = 0;
+
+	/** @brief Number of nodes of this graph. */
+	int32 NumNodes = 0;
+
+	/** @brief Index of the function entry node, or `INDEX_NONE`. */
+	int32 EntryNode = INDEX_NONE;
+};
+
+/** @brief A member or local variable of a snapshot Blueprint. */
+struct FBlueprintSnapshotVariable
+{
+	/** @brief Variable name. */
+	FName Name;
+
+	/** @brief Pin type category of the variable (`UEdGraphSchema_K2::PC_*`). */
+	FName Category;
+
+	/** @brief Whether a byte variable holds an enum, whose default is an enumerator name. */
+	bool bIsEnum = false;
+
+	/** @brief Container of the variable, if any. */
+	EPinContainerType ContainerType = EPinContainerType::None;
+
+	/** @brief Size of one value of the generated property in bytes, of one element for containers; zero without a property. */
+	int32 ElementSize = 0;
+
+	/** @brief Number of elements of the class default value: one for single values, zero without a property. */
+	int32 NumElements = 0;
+
+	/** @brief Property flags of the generated property, or of the variable description if not compiled yet. */
+	uint64 PropertyFlags = 0;
+
+	/** @brief Class default value exported as text (member variables) or declared default (locals). */
+	FString DefaultValue;
+
+	/** @brief Owning function graph for local variables, `INDEX_NONE` for member variables. */
+	int32 Graph = INDEX_NONE;
+
+	/** @brief Whether the variable is declared by this Blueprint rather than inherited. */
+	bool bIsDeclared = false;
+
+	/** @brief Whether the generated class has a property for this member variable. */
+	bool bHasProperty = false;
+
+	/** @brief Whether a declared member variable is private, so other Blueprints cannot access it. */
+	bool bIsPrivate = false;
+};
+
+/**
+ * @brief Flat, UObject-free copy of the Blueprint data ValidatorX analysis needs.
+ *
+ * A snapshot is captured on the game thread from an `FBlueprintGraphIndex` and is immutable
+ * afterwards, so validators implementing `UBlueprintValidatorBase::AnalyzeSnapshot` can inspect
+ * it from any thread. Nodes and pins are stored in flat arrays grouped by graph and by node, and
+ * links as pin index pairs grouped by pin; results refer back to the source objects by graph name
+ * and node guid. Functions, macros and event dispatchers are the graphs of the matching type.
+ *
+ * Snapshots round-trip through JSON (`ToJson`, `CreateFromJson`), so an analysis can be run on a
+ * fixture without loading the Blueprint; see the `ValidatorX.DumpSnapshot` console command.
+ */
+struct VALIDATORX_API FBlueprintSnapshot
+{
+	/**
+	 * @brief Captures a snapshot of the Blueprint behind a graph index. Game thread only.
+	 *
+	 * @param GraphIndex Index of the Blueprint to capture.
+	 * @return The immutable snapshot.
+	 */
+	static TSharedRef<const FBlueprintSnapshot> Create(const FBlueprintGraphIndex& GraphIndex);
+
+	/**
+	 * @brief Captures a snapshot of a single graph of a Blueprint. Game thread only.
+	 *
+	 * The snapshot holds the graph, its local variables and the member variables of the Blueprint,
+	 * which is all graph-local validators (see `UBlueprintValidatorBase::IsGraphLocal`) look at.
+	 * Only the nodes of the given graph are visited.
+	 *
+	 * @param Blueprint The Blueprint owning the graph.
+	 * @param Graph The graph to capture.
+	 * @return The immutable snapshot.
+	 */
+	static TSharedRef<const FBlueprintSnapshot> CreateForGraph(const UBlueprint& Blueprint, const UEdGraph& Graph);
+
+	/**
+	 * @brief Builds a snapshot from JSON written by `ToJson` or by hand. Any thread.
+	 *
+	 * Links are listed once per graph as `"Node.Pin"` pairs; every other field is optional.
+	 *
+	 * @param Json The JSON document.
+	 * @param OutError Receives a description of the first error.
+	 * @return The snapshot, or null if the document is invalid.
+	 */
+	static TSharedPtr<const FBlueprintSnapshot> CreateFromJson(const FString& Json, FString& OutError);
+
+	/** @return The snapshot as JSON, readable by `CreateFromJson`. */
+	FString ToJson() const;
+
+	/** @return The pins of a node. */
+	TConstArrayView<FBlueprintSnapshotPin> GetPins(int32 NodeIndex) const;
+
+	/** @return The pin of a node with the given name, or null. */
+	const FBlueprintSnapshotPin* FindPin(int32 NodeIndex, FName PinName) const;
+
+	/** @return Index of the pin of a node with the given name, or `INDEX_NONE`. */
+	int32 FindPinIndex(int32 NodeIndex, FName PinName) const;
+
+	/** @return The links of a pin; `ToPin` of each is the linked pin. */
+	TConstArrayView<FBlueprintSnapshotLink> GetLinks(int32 PinIndex) const;
+
+	/** @return Index of the graph with the given name, or `INDEX_NONE`. */
+	int32 FindGraph(FName GraphName) const;
+
+	/** @return The nodes of a graph. */
+	TConstArrayView<FBlueprintSnapshotNode> GetNodes(int32 GraphIndex) const;
+
+	/** @return Indices of all Get and Set nodes referencing a variable. */
+	TConstArrayView<int32> FindVariableNodes(FName VarName) const;
+
+	/**
+	 * @brief Returns the def/use table entry of a variable: the Get nodes reading it.
+	 *
+	 * Get and Set nodes are resolved once, to the local variable of their graph first and to the
+	 * member variable of the same name otherwise, so each list only holds accesses of that variable.
+	 *
+	 * @param VariableIndex Index of the variable in `Variables`.
+	 * @return Indices of the Get nodes reading the variable.
+	 */
+	TConstArrayView<int32> FindVariableReads(int32 VariableIndex) const;
+
+	/** @return Indices of the Set nodes writing a variable, see `FindVariableReads`. */
+	TConstArrayView<int32> FindVariableWrites(int32 VariableIndex) const;
+
+	/** @return Index in `Variables` of the variable a Get or Set node accesses, resolved as in `FindVariableReads`, or `INDEX_NONE`. */
+	int32 FindNodeVariable(int32 NodeIndex) const;
+
+	/** @return Whether a data output pin of a node is linked, such as the value output of a Set node. */
+	bool HasLinkedDataOutput(int32 NodeIndex) const;
+
+	/** @return Whether a variable is read, by a Get node or through the linked value output of a Set node. */
+	bool IsVariableRead(int32 VariableIndex) const;
+
+	/** @return Indices of all call nodes referencing a function name. */
+	TConstArrayView<int32> FindFunctionCalls(FName FunctionName) const;
+
+	/** @return Indices of all macro instance nodes referencing a macro graph name. */
+	TConstArrayView<int32> FindMacroInstances(FName MacroName) const;
+
+	/** @return Indices of all delegate nodes referencing a delegate property. */
+	TConstArrayView<int32> FindDelegateNodes(FName PropertyName) const;
+
+	/** @return The member variable with the given name, or null. */
+	const FBlueprintSnapshotVariable* FindMemberVariable(FName VarName) const;
+
+	/** @brief Name of the Blueprint asset. */
+	FName BlueprintName;
+
+	/** @brief Package of the Blueprint asset. */
+	FName PackageName;
+
+	/** @brief All graphs, in `UBlueprint::GetAllGraphs` order. */
+	TArray<FBlueprintSnapshotGraph> Graphs;
+
+	/** @brief All nodes, grouped by graph. */
+	TArray<FBlueprintSnapshotNode> Nodes;
+
+	/** @brief All pins, grouped by node. */
+	TArray<FBlueprintSnapshotPin> Pins;
+
+	/** @brief All links, grouped by `FromPin`. */
+	TArray<FBlueprintSnapshotLink> Links;
+
+	/** @brief Member variables (declared and referenced inherited ones) followed by local variables. */
+	TArray<FBlueprintSnapshotVariable> Variables;
+
+private:
+	/** @brief Groups `Links` by pin, fills the pin link ranges and builds the lookup tables below once the flat arrays are filled. */
+	void BuildLookups();
+
+	/** @brief Graph indices keyed by name. */
+	TMap<FName, int32> GraphsByName;
+
+	/** @brief Get/Set node indices keyed by variable name. */
+	TMap<FName, TArray<int32>> VariableNodes;
+
+	/** @brief Call node indices keyed by function name. */
+	TMap<FName, TArray<int32>> FunctionCalls;
+
+	/** @brief Macro instance indices keyed by macro graph name. */
+	TMap<FName, TArray<int32>> MacroInstances;
+
+	/** @brief Delegate node indices keyed by property name. */
+	TMap<FName, TArray<int32>> DelegateNodes;
+
+	/** @brief Member variable indices keyed by name. */
+	TMap<FName, int32> MemberVariables;
+
+	/** @brief Get node indices of each variable, in the order of `Variables`. */
+	TArray<TArray<int32>> VariableReads;
+
+	/** @brief Set node indices of each variable, in the order of `Variables`. */
+	TArray<TArray<int32>> VariableWrites;
+
+	/** @brief Variable index of each Get and Set node, `INDEX_NONE` for other nodes, in the order of `Nodes`. */
+	TArray<int32> NodeVariables;
+};
@@ -0,0 +1,103 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+/**
+ * @brief Uniform grid over the comment boxes of a graph, answering "which box encloses this point".
+ *
+ * Boxes are bucketed once into the grid cells they overlap, so a containment query only tests the
+ * few boxes of one cell instead of every box of the graph, and does not allocate. The grid has at
+ * most `MaxCellsPerAxis` cells per axis, sized to the bounds of the boxes.
+ *
+ * Box bounds are inclusive on every side, matching `UBPUtilsNodeFunctionLibrary::IsNodeInsideComment`.
+ */
+class VALIDATORX_API FCommentSpatialIndex
+{
+public:
+	/** @brief Axis-aligned box, in graph coordinates. */
+	struct FBox
+	{
+		int32 MinX = 0;
+		int32 MinY = 0;
+		int32 MaxX = 0;
+		int32 MaxY = 0;
+
+		bool Contains(int32 X, int32 Y) const
+		{
+			return X >= MinX && X <= MaxX && Y >= MinY && Y <= MaxY;
+		}
+
+		int64 GetArea() const
+		{
+			return int64(MaxX - MinX) * int64(MaxY - MinY);
+		}
+	};
+
+	FCommentSpatialIndex() = default;
+
+	/**
+	 * @brief Builds the grid.
+	 *
+	 * @param InBoxes The boxes to index; queries return indices into this array.
+	 */
+	explicit FCommentSpatialIndex(TArray<FBox> InBoxes);
+
+	/** @return Whether at least one box contains the point. */
+	bool IsInsideAnyBox(int32 X, int32 Y) const;
+
+	/**
+	 * @brief Returns the innermost box containing a point.
+	 *
+	 * @return Index of the smallest box containing the point, or `INDEX_NONE`.
+	 */
+	int32 FindEnclosingBox(int32 X, int32 Y) const;
+
+	/**
+	 * @brief Calls a function for every box containing a point, in index order.
+	 *
+	 * @param Func Called with the index of each containing box.
+	 */
+	template <typename FuncType>
+	void ForEachEnclosingBox(int32 X, int32 Y, FuncType&& Func) const
+	{
+		for (const int32 BoxIndex : GetCellBoxes(X, Y))
+		{
+			if (Boxes[BoxIndex].Contains(X, Y))
+			{
+				Func(BoxIndex);
+			}
+		}
+	}
+
+	/** @return The indexed boxes. */
+	TConstArrayView<FBox> GetBoxes() const { return Boxes; }
+
+	/** @brief Maximum number of grid cells along each axis. */
+	static constexpr int32 MaxCellsPerAxis = 64;
+
+private:
+	/** @return The indices of the boxes overlapping the cell of a point, empty outside the grid. */
+	TConstArrayView<int32> GetCellBoxes(int32 X, int32 Y) const;
+
+	/** @brief The indexed boxes. */
+	TArray<FBox> Boxes;
+
+	/** @brief Bounds of every box, the area covered by the grid. */
+	FBox Bounds;
+
+	/** @brief Size of a cell, in graph units. */
+	int32 CellWidth = 1;
+	int32 CellHeight = 1;
+
+	/** @brief Number of cells along each axis. */
+	int32 NumCellsX = 0;
+	int32 NumCellsY = 0;
+
+	/** @brief Offset of the first box index of each cell in `CellBoxes`, plus a final end offset. */
+	TArray<int32> CellStarts;
+
+	/** @brief Box indices of every cell, stored contiguously cell after cell. */
+	TArray<int32> CellBoxes;
+};
@@ -0,0 +1,41 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+struct FBlueprintSnapshotNode;
+
+/** @brief Kinds of nodes too costly to run every frame or on every iteration of a loop. */
+enum class EValidatorXCostlyNode : uint8
+{
+	None,
+	/** Iterates over every actor or widget of the world. */
+	WorldQuery,
+	/** Line, shape and overlap traces. */
+	Trace,
+	/** Spawns an actor or creates a widget. */
+	Spawn,
+	/** Destroys an actor or component. */
+	Destroy,
+	AddComponent,
+	/** Loads an asset synchronously. */
+	LoadAsset,
+	/** Builds a string or text. */
+	StringFormat,
+	Cast,
+};
+
+/**
+ * @brief Classifies a snapshot node by the costly work it does.
+ *
+ * Shared by the validators looking for costly nodes on hot paths, so they agree on what is costly;
+ * each decides which kinds it reports.
+ *
+ * @param Node The node to classify.
+ * @return The kind of costly work, `None` for other nodes.
+ */
+VALIDATORX_API EValidatorXCostlyNode ClassifyCostlyNode(const FBlueprintSnapshotNode& Node);
+
+/** @return The name shown for a node in messages: the member it refers to, or the node class without its prefix. */
+VALIDATORX_API FString GetCostlyNodeDisplayName(const FBlueprintSnapshotNode& Node);
@@ -0,0 +1,72 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+struct FBlueprintSnapshot;
+
+/**
+ * @brief Execution reachability of every node of a Blueprint snapshot.
+ *
+ * Starts at every entry point (events, function entries, input tunnels of macro and collapsed graphs,
+ * and any other node with execution outputs but no execution input, such as input actions), follows
+ * execution links forward and then the data inputs of every reached node backward into the pure nodes
+ * feeding them. Every node and link is visited at most once, so the pass is O(nodes + links).
+ *
+ * Nodes left unmarked can never run. They are grouped into dead chains, the connected components of
+ * unreachable nodes, so a disconnected chain is reported once instead of once per node. Comments,
+ * function results and output tunnels are never part of a chain; events without any link are, as they
+ * do nothing, except ghost events the editor placed. Whether a derived Blueprint implements such an
+ * event depends on other assets, so validators check it on the game thread.
+ */
+class VALIDATORX_API FExecReachability
+{
+public:
+	/**
+	 * @brief Runs the reachability pass.
+	 *
+	 * @param Snapshot The snapshot to analyze. Only used during construction.
+	 */
+	explicit FExecReachability(const FBlueprintSnapshot& Snapshot);
+
+	/** @return Whether a node can run. */
+	bool IsReachable(int32 NodeIndex) const { return Reachable[NodeIndex]; }
+
+	/** @return Whether a node is an entry point the pass started from. */
+	bool IsEntryPoint(int32 NodeIndex) const { return EntryPoints[NodeIndex]; }
+
+	/** @return The number of dead chains. */
+	int32 GetNumChains() const { return ChainStarts.Num() - 1; }
+
+	/**
+	 * @brief Returns the nodes of a dead chain.
+	 *
+	 * Chains are ordered by their first node and never span graphs.
+	 *
+	 * @return Indices of the chain nodes in `FBlueprintSnapshot::Nodes`, ascending.
+	 */
+	TConstArrayView<int32> GetChain(int32 ChainIndex) const
+	{
+		return MakeArrayView(ChainNodes.GetData() + ChainStarts[ChainIndex], ChainStarts[ChainIndex + 1] - ChainStarts[ChainIndex]);
+	}
+
+private:
+	/** @brief Marks the nodes reached from the entry points. */
+	void MarkReachableNodes(const FBlueprintSnapshot& Snapshot);
+
+	/** @brief Groups the unmarked nodes into connected components. */
+	void CollectDeadChains(const FBlueprintSnapshot& Snapshot);
+
+	/** @brief One bit per snapshot node, set for reachable nodes. */
+	TBitArray<> Reachable;
+
+	/** @brief One bit per snapshot node, set for entry points. */
+	TBitArray<> EntryPoints;
+
+	/** @brief Offset of the first node of each chain in `ChainNodes`, plus a final end offset. */
+	TArray<int32> ChainStarts;
+
+	/** @brief Node indices of every chain, stored contiguously chain after chain. */
+	TArray<int32> ChainNodes;
+};
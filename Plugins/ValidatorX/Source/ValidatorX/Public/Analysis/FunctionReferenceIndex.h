@@ -0,0 +1,187 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UObject/TopLevelAssetPath.h"
+
+class UBlueprint;
+class UPackage;
+struct FAssetData;
+struct FObjectPostSaveContext;
+
+/** @brief Identifies a Blueprint callable function by its original declaration. */
+struct FValidatorXFunctionKey
+{
+	/** @brief Class declaring the function; the generated class for Blueprint functions. */
+	FTopLevelAssetPath OwnerClass;
+
+	/** @brief Name of the function. */
+	FName FunctionName;
+
+	bool operator==(const FValidatorXFunctionKey& Other) const
+	{
+		return OwnerClass == Other.OwnerClass && FunctionName == Other.FunctionName;
+	}
+
+	friend uint32 GetTypeHash(const FValidatorXFunctionKey& Key)
+	{
+		return HashCombine(GetTypeHash(Key.OwnerClass), GetTypeHash(Key.FunctionName));
+	}
+};
+
+/** @brief A graph calling a function, or binding it to a delegate. */
+struct FValidatorXFunctionCallSite
+{
+	/** @brief Package of the calling Blueprint. */
+	FName PackageName;
+
+	/** @brief Top level graph containing the call. */
+	FName GraphName;
+};
+
+/**
+ * @brief Project-wide reverse index of Blueprint function calls, stored under `Saved/ValidatorX`.
+ *
+ * Every Blueprint package contributes the functions called by its `K2Node_CallFunction` nodes and
+ * bound by its `K2Node_CreateDelegate` nodes. Calls are keyed by the original declaration of the
+ * called function, so a call through an override also counts for the overridden function.
+ *
+ * Package records are persisted with the saved hash of their package and reused while it does not
+ * change. Packages without an up to date record are indexed when their Blueprint is loaded, or by
+ * `IndexPendingPackages`, which loads them. Compiled and saved Blueprints are indexed again, and
+ * asset registry events keep the package list current.
+ *
+ * Obtain it through `FValidatorXManager::GetFunctionReferenceIndex`. Game thread only.
+ */
+class VALIDATORX_API FFunctionReferenceIndex
+{
+public:
+	FFunctionReferenceIndex() = default;
+	FFunctionReferenceIndex(const FFunctionReferenceIndex&) = delete;
+	FFunctionReferenceIndex& operator=(const FFunctionReferenceIndex&) = delete;
+	~FFunctionReferenceIndex();
+
+	/** @brief Loads the index file, checks it against the asset registry and subscribes to editor events. Does nothing if already initialized. */
+	void Initialize();
+
+	/** @brief Saves the index, unsubscribes from editor events and drops the index. */
+	void Shutdown();
+
+	/** @brief Indexes the pending packages whose Blueprint has been loaded, compiled or saved since the last refresh. */
+	void Refresh();
+
+	/**
+	 * @brief Indexes every pending package, loading the Blueprints that are not in memory.
+	 *
+	 * @param bShowProgress Whether to show a slow task dialog.
+	 * @return The number of packages indexed.
+	 */
+	int32 IndexPendingPackages(bool bShowProgress);
+
+	/** @return Whether every Blueprint package of the project has an up to date record. */
+	bool IsComplete() const { return bIsInitialized && PendingPackages.IsEmpty(); }
+
+	/** @return The number of Blueprint packages without an up to date record. */
+	int32 GetNumPendingPackages() const { return PendingPackages.Num(); }
+
+	/**
+	 * @brief Returns the key a function is indexed with.
+	 *
+	 * @param Function The function, possibly an override.
+	 * @return The key of its original declaration.
+	 */
+	static FValidatorXFunctionKey GetFunctionKey(const UFunction& Function);
+
+	/**
+	 * @brief Returns every call site of a function.
+	 *
+	 * @param Key The function, see `GetFunctionKey`.
+	 * @return The call sites, or an empty view if the function is never called.
+	 */
+	TConstArrayView<FValidatorXFunctionCallSite> FindCallSites(const FValidatorXFunctionKey& Key) const;
+
+	/**
+	 * @brief Collects the packages calling a function declared by the Blueprint saved in a package.
+	 *
+	 * @param PackageName The package declaring the functions.
+	 * @param OutPackages Receives the calling packages, sorted, excluding `PackageName` itself.
+	 */
+	void GetCallerPackages(FName PackageName, TArray<FName>& OutPackages) const;
+
+	/** @brief Writes the index file if it has changed since it was loaded. */
+	void Save();
+
+	/** @brief Drops every record, deletes the index file and marks every Blueprint package pending. */
+	void Clear();
+
+	/** @return Full path of the index file. */
+	static FString GetIndexFilename();
+
+	/** @brief Functions called by one Blueprint package. */
+	struct FPackageRecord
+	{
+		/** @brief A call from the package. */
+		struct FCall
+		{
+			FValidatorXFunctionKey Function;
+			FName GraphName;
+		};
+
+		/** @brief Saved hash of the package when it was indexed, empty if it had unsaved changes. */
+		FString PackageHash;
+
+		/** @brief Calls made by the package, in graph order. */
+		TArray<FCall> Calls;
+	};
+
+private:
+	/** @brief Records the calls made by a Blueprint, replacing the previous record of its package. */
+	void IndexBlueprint(const UBlueprint& Blueprint);
+
+	/** @brief Adds the call sites of a record to the reverse maps. */
+	void AddRecordCallSites(FName PackageName, const FPackageRecord& Record);
+
+	/** @brief Removes the record of a package and its call sites. */
+	void RemovePackage(FName PackageName);
+
+	/** @brief Marks a Blueprint package pending unless its record is up to date. */
+	void CheckPackage(FName PackageName);
+
+	/** @brief Editor and asset registry event handlers. */
+	void HandleAssetAdded(const FAssetData& AssetData);
+	void HandleAssetRemoved(const FAssetData& AssetData);
+	void HandleAssetRenamed(const FAssetData& AssetData, const FString& OldObjectPath);
+	void HandleAssetLoaded(UObject* Object);
+	void HandleBlueprintPreCompile(UBlueprint* Blueprint);
+	void HandlePackageSaved(const FString& PackageFilename, UPackage* Package, FObjectPostSaveContext ObjectSaveContext);
+
+	/** @brief Records keyed by Blueprint package. */
+	TMap<FName, FPackageRecord> Records;
+
+	/** @brief Call sites keyed by called function. */
+	TMap<FValidatorXFunctionKey, TArray<FValidatorXFunctionCallSite>> CallSites;
+
+	/** @brief Calling packages keyed by the package declaring the called function. */
+	TMap<FName, TSet<FName>> CallerPackages;
+
+	/** @brief Blueprint packages without an up to date record. */
+	TSet<FName> PendingPackages;
+
+	/** @brief Pending packages whose Blueprint is loaded, indexed by the next `Refresh`. */
+	TSet<FName> LoadedPendingPackages;
+
+	/** @brief Whether the index has been initialized. */
+	bool bIsInitialized = false;
+
+	/** @brief Whether records changed since the last load or save. */
+	bool bIsDirty = false;
+
+	/** @brief Handles of the event bindings. */
+	FDelegateHandle AssetAddedHandle;
+	FDelegateHandle AssetRemovedHandle;
+	FDelegateHandle AssetRenamedHandle;
+	FDelegateHandle AssetLoadedHandle;
+	FDelegateHandle BlueprintPreCompileHandle;
+	FDelegateHandle PackageSavedHandle;
+};
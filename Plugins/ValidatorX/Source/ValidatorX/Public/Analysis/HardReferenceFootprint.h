@@ -0,0 +1,96 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+/**
+ * @brief Load footprint of packages: everything loaded with them through hard references.
+ *
+ * Reads the hard package dependencies and package sizes from the asset registry, so nothing is
+ * loaded. Native `/Script` packages are always resident and never part of a footprint, and neither
+ * is engine content unless requested. Dependencies, sizes and the closure size of every single
+ * root are memoized per package for the lifetime of the object, so the closures of several roots
+ * share the registry queries and a package shared by several Blueprints is only walked once.
+ *
+ * The estimated size is the in-memory size where the registry tags allow one, such as texture
+ * dimensions, and the disk size scaled by a per asset class factor otherwise. Game thread only.
+ */
+class VALIDATORX_API FHardReferenceFootprint
+{
+public:
+	/** @brief Sizes summed over a set of packages. */
+	struct FSize
+	{
+		/** @brief Size of the package files. */
+		int64 DiskSize = 0;
+
+		/** @brief Estimated memory once loaded. */
+		int64 EstimatedSize = 0;
+
+		/** @brief Number of packages. */
+		int32 NumPackages = 0;
+	};
+
+	/**
+	 * @brief Creates an empty footprint cache.
+	 *
+	 * @param bInIncludeEngineContent Whether `/Engine` packages are part of footprints.
+	 * @param InClassSizeFactors Disk size multiplier per asset class name, one if missing.
+	 */
+	FHardReferenceFootprint(bool bInIncludeEngineContent, TMap<FName, float> InClassSizeFactors);
+
+	/** @return Whether the footprint was created with these settings. */
+	bool HasSettings(bool bInIncludeEngineContent, const TMap<FName, float>& InClassSizeFactors) const;
+
+	/** @return Whether a package can be part of a footprint. */
+	bool IsCounted(FName PackageName) const;
+
+	/** @return The counted packages a package references directly through hard references, valid until the next query. */
+	TConstArrayView<FName> GetDependencies(FName PackageName);
+
+	/**
+	 * @brief Sums the sizes of the packages reachable from roots through hard references.
+	 *
+	 * @param Roots The packages to start from; they are part of the closure if they are counted.
+	 * @param OutPackages If set, receives every package of the closure.
+	 * @return The sizes of the closure, every package counted once.
+	 */
+	FSize GetClosureSize(TConstArrayView<FName> Roots, TArray<FName>* OutPackages = nullptr);
+
+	/** @return The memoized sizes of the packages reachable from a single package through hard references. */
+	FSize GetClosureSize(FName PackageName);
+
+	/**
+	 * @brief Collects the packages loaded with a package through hard references, from the asset registry.
+	 *
+	 * @param PackageName The package to start from, not added.
+	 * @param bIncludeEngineContent Whether `/Engine` packages are collected.
+	 * @param OutPackages Receives the collected packages, sorted lexically.
+	 */
+	static void GetHardReferencedPackages(FName PackageName, bool bIncludeEngineContent, TArray<FName>& OutPackages);
+
+private:
+	/** @brief Registry data of a package. */
+	struct FPackageInfo
+	{
+		TArray<FName> Dependencies;
+		int64 DiskSize = 0;
+		int64 EstimatedSize = 0;
+	};
+
+	/** @return The memoized registry data of a package. */
+	const FPackageInfo& GetPackageInfo(FName PackageName);
+
+	/** @brief Whether `/Engine` packages are counted. */
+	bool bIncludeEngineContent = false;
+
+	/** @brief Disk size multiplier per asset class name. */
+	TMap<FName, float> ClassSizeFactors;
+
+	/** @brief Registry data of every package queried so far. */
+	TMap<FName, FPackageInfo> Packages;
+
+	/** @brief Closure size of every single root queried so far. */
+	TMap<FName, FSize> ClosureSizes;
+};
@@ -0,0 +1,59 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+/**
+ * @brief Memoized hierarchy of the Blueprint generated classes currently in memory.
+ *
+ * Built on first use with a single `TObjectIterator<UBlueprintGeneratedClass>` sweep, so looking up
+ * the derived classes of many parents does not iterate every loaded class each time. Also memoizes,
+ * per parent class, which events are implemented by its derived Blueprints.
+ *
+ * Stores raw class pointers: obtain it through `FValidatorXManager::GetLoadedClassHierarchy`, which
+ * resets it at validation run boundaries, after garbage collection and when Blueprints are compiled
+ * or reinstanced.
+ */
+class VALIDATORX_API FLoadedClassHierarchy
+{
+public:
+	/**
+	 * @brief Returns every loaded Blueprint generated class deriving from a class.
+	 *
+	 * @param ParentClass The parent class, Blueprint or native.
+	 * @return The derived classes, excluding `ParentClass` itself.
+	 */
+	TConstArrayView<UClass*> GetDerivedClasses(const UClass* ParentClass);
+
+	/**
+	 * @brief Checks whether a loaded Blueprint deriving from a class implements an event.
+	 *
+	 * An event counts as implemented when one of the derived Blueprint event graphs has an event
+	 * node with that function name whose exec output is connected.
+	 *
+	 * @param ParentClass The parent class.
+	 * @param EventName Function name of the event.
+	 * @return True if at least one derived Blueprint implements the event.
+	 */
+	bool IsEventImplementedByDerivedClass(const UClass* ParentClass, FName EventName);
+
+	/** @brief Drops every memoized result. */
+	void Reset();
+
+private:
+	/** @brief Collects the direct children of every loaded Blueprint generated class parent. */
+	void Build();
+
+	/** @brief Whether `DirectChildren` has been built. */
+	bool bIsBuilt = false;
+
+	/** @brief Loaded Blueprint generated classes keyed by their direct super class. */
+	TMap<const UClass*, TArray<UClass*>> DirectChildren;
+
+	/** @brief Memoized derived classes, keyed by parent class. */
+	TMap<const UClass*, TArray<UClass*>> DerivedClasses;
+
+	/** @brief Memoized events implemented by derived Blueprints, keyed by parent class. */
+	TMap<const UClass*, TSet<FName>> DerivedImplementedEvents;
+};
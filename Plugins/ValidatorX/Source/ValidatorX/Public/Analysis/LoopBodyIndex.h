@@ -0,0 +1,79 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+struct FBlueprintSnapshot;
+struct FBlueprintSnapshotNode;
+
+/**
+ * @brief The loop bodies of a Blueprint snapshot: the nodes run once per iteration of every loop.
+ *
+ * Loops are the ForEachLoop, ForLoop and WhileLoop instances of the engine StandardMacros library,
+ * found through the macro instance lookup of the snapshot rather than a scan of its nodes. A body
+ * starts at the LoopBody execution output and follows execution links forward and data inputs
+ * backward into the pure nodes feeding them, like `FExecReachability`. The pure nodes feeding the
+ * loop node itself are part of the body too, as macro inputs are evaluated again on every read.
+ * The loop node is never part of its own body, so Break links and Completed chains end the walk.
+ *
+ * Each body is walked once and only visits its own nodes, so building the index is O(total body
+ * size); nested loops are part of the bodies of the loops around them.
+ */
+class VALIDATORX_API FLoopBodyIndex
+{
+public:
+	/**
+	 * @brief Extracts the loop bodies.
+	 *
+	 * @param Snapshot The snapshot to analyze. Only used during construction.
+	 */
+	explicit FLoopBodyIndex(const FBlueprintSnapshot& Snapshot);
+
+	/** @return Whether a snapshot node is an instance of a StandardMacros loop. */
+	static bool IsLoopNode(const FBlueprintSnapshotNode& Node);
+
+	/** @return The number of loops. */
+	int32 GetNumLoops() const { return LoopNodes.Num(); }
+
+	/** @return Index of the macro instance node of a loop in `FBlueprintSnapshot::Nodes`. */
+	int32 GetLoopNode(int32 LoopIndex) const { return LoopNodes[LoopIndex]; }
+
+	/**
+	 * @brief Returns the body of a loop.
+	 *
+	 * @return Indices of the body nodes in `FBlueprintSnapshot::Nodes`, ascending.
+	 */
+	TConstArrayView<int32> GetBody(int32 LoopIndex) const
+	{
+		return MakeArrayView(BodyNodes.GetData() + BodyStarts[LoopIndex], BodyStarts[LoopIndex + 1] - BodyStarts[LoopIndex]);
+	}
+
+	/** @return The number of loop bodies a node is part of, zero outside of any loop. */
+	int32 GetLoopDepth(int32 NodeIndex) const { return LoopDepths.IsEmpty() ? 0 : LoopDepths[NodeIndex]; }
+
+	/** @return The innermost loop whose body holds a node, or `INDEX_NONE`. */
+	int32 GetInnermostLoop(int32 NodeIndex) const { return InnermostLoops.IsEmpty() ? INDEX_NONE : InnermostLoops[NodeIndex]; }
+
+private:
+	/** @brief Walks the body of a loop and appends it to `BodyNodes`; loops are collected in order. */
+	void CollectBody(const FBlueprintSnapshot& Snapshot, int32 LoopIndex, TArray<int32>& VisitStamps);
+
+	/** @brief Fills the loop depth and innermost loop of every node once all bodies are collected. */
+	void ComputeNesting();
+
+	/** @brief Macro instance node of each loop, in snapshot order. */
+	TArray<int32> LoopNodes;
+
+	/** @brief Offset of the first node of each body in `BodyNodes`, plus a final end offset. */
+	TArray<int32> BodyStarts;
+
+	/** @brief Node indices of every body, stored contiguously loop after loop. */
+	TArray<int32> BodyNodes;
+
+	/** @brief Loop depth per snapshot node; empty when the snapshot has no loop. */
+	TArray<int32> LoopDepths;
+
+	/** @brief Innermost loop per snapshot node; empty when the snapshot has no loop. */
+	TArray<int32> InnermostLoops;
+};
@@ -0,0 +1,45 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+struct FBlueprintSnapshot;
+
+/**
+ * @brief Backward liveness of the local variables of a function graph, along execution flow.
+ *
+ * Works on the execution graph of the function: every node with execution pins is a step, which
+ * defines the local it sets and uses the locals read by the pure nodes feeding its data inputs,
+ * taken from the def/use table of the snapshot (`FBlueprintSnapshot::FindVariableReads`). The linked
+ * value output of a Set node reads the local it set the same way, in the steps it flows into. A local
+ * is live after a step when some path from there reads it before setting it again.
+ *
+ * Macro instances, collapsed nodes and nodes with several execution outputs (sequences, switches,
+ * loops) may run again when one of their outgoing chains ends, so chain ends below them flow back
+ * to them. Liveness is therefore never underestimated: a reported store is never read.
+ */
+class VALIDATORX_API FVariableLiveness
+{
+public:
+	/**
+	 * @brief Runs the analysis.
+	 *
+	 * @param Snapshot The snapshot to analyze. Only used during construction.
+	 * @param GraphIndex The function graph whose locals are analyzed.
+	 */
+	FVariableLiveness(const FBlueprintSnapshot& Snapshot, int32 GraphIndex);
+
+	/** @return Set nodes whose value is overwritten or discarded before any read, ascending. */
+	TConstArrayView<int32> GetDeadStores() const { return DeadStores; }
+
+	/** @return Locals some path from the function entry reads before setting them, as indices into `FBlueprintSnapshot::Variables`. */
+	TConstArrayView<int32> GetLocalsReadBeforeAssigned() const { return LocalsReadBeforeAssigned; }
+
+private:
+	/** @brief Set nodes whose value is never read. */
+	TArray<int32> DeadStores;
+
+	/** @brief Locals live at the function entry. */
+	TArray<int32> LocalsReadBeforeAssigned;
+};
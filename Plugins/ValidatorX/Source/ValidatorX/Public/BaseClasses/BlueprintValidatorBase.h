@@ -7,6 +7,11 @@
 #include "Interface/ValidatorToggleInterface.h"
 #include "BlueprintValidatorBase.generated.h"
 
+class FBlueprintGraphIndex;
+class FTokenizedMessage;
+struct FBlueprintSnapshot;
+struct FValidatorXIssue;
+
 /**
  * @brief Base class for Blueprint validators in the editor.
  *
@@ -56,6 +61,215 @@ public:
 	 */
 	virtual void SetValidationEnabled(bool bEnabled) override {}
 
+	/**
+	 * @brief Returns whether this validator implements `AnalyzeSnapshot`.
+	 *
+	 * Snapshot validators only read an immutable `FBlueprintSnapshot`, so batch runs can analyze
+	 * many Blueprints on worker threads and commit the results on the game thread afterwards.
+	 * Other validators run entirely on the game thread through `ValidateLoadedAsset`.
+	 *
+	 * @return True if the validator supports snapshot analysis.
+	 */
+	virtual bool SupportsSnapshotAnalysis() const
+	{
+		return false;
+	}
+
+	/**
+	 * @brief Returns whether every issue of this validator depends only on the graph it is reported in.
+	 *
+	 * Graph-local snapshot validators are re-run by live validation on a single-graph snapshot
+	 * (`FBlueprintSnapshot::CreateForGraph`) whenever that graph is edited. Other validators are
+	 * re-run on the whole Blueprint when it is compiled.
+	 *
+	 * @return True if the validator is graph-local.
+	 */
+	virtual bool IsGraphLocal() const
+	{
+		return false;
+	}
+
+	/**
+	 * @brief Analyzes a Blueprint snapshot.
+	 *
+	 * May be called from any thread and concurrently for different snapshots, so implementations
+	 * must not touch UObjects or mutable validator state.
+	 *
+	 * @param Snapshot The snapshot to analyze.
+	 * @param OutIssues Receives the issues found, in a deterministic order.
+	 */
+	virtual void AnalyzeSnapshot(const FBlueprintSnapshot& Snapshot, TArray<FValidatorXIssue>& OutIssues) const {}
+
+	/**
+	 * @brief Game thread check run before an issue is committed.
+	 *
+	 * Lets a validator discard findings that depend on data outside of the snapshot,
+	 * such as other Blueprints.
+	 *
+	 * @param Blueprint The validated Blueprint.
+	 * @param Issue The issue about to be committed.
+	 * @return False to discard the issue.
+	 */
+	virtual bool ConfirmIssue(UBlueprint* Blueprint, const FValidatorXIssue& Issue) const
+	{
+		return true;
+	}
+
+	/**
+	 * @brief Adds the jump and fix action tokens of a committed issue. Game thread only.
+	 *
+	 * @param Blueprint The validated Blueprint.
+	 * @param Issue The committed issue.
+	 * @param Message The message the issue was committed as.
+	 */
+	virtual void AddIssueTokens(UBlueprint* Blueprint, const FValidatorXIssue& Issue, const TSharedRef<FTokenizedMessage>& Message) const {}
+
+	/**
+	 * @brief Applies the fix of a committed issue, without opening an editor or asking for confirmation.
+	 *
+	 * Called by `FValidatorXFixBatch` inside a transaction, after `ConfirmIssue`. The batch marks each
+	 * Blueprint as structurally modified once all of its fixes are applied, so implementations call
+	 * `Modify` on what they change but never compile or mark the Blueprint themselves. The issue may
+	 * come from an earlier run or have been fixed already by the same batch, so implementations check
+	 * that its graph, node or variable still exists. Game thread only.
+	 *
+	 * @param Blueprint The Blueprint the issue was reported for.
+	 * @param Issue The issue to fix.
+	 * @return True if the Blueprint was modified, false if the validator has no fix or the fix no longer applies.
+	 */
+	virtual bool ApplyIssueFix(UBlueprint* Blueprint, const FValidatorXIssue& Issue) const
+	{
+		return false;
+	}
+
+	/**
+	 * @brief Returns the version of the results produced by this validator.
+	 *
+	 * The version is part of the result cache key, so it must be bumped whenever a change to the
+	 * validator can change its results for an unchanged asset.
+	 *
+	 * @return The result version.
+	 */
+	virtual int32 GetCacheVersion() const
+	{
+		return 1;
+	}
+
+	/**
+	 * @brief Returns whether results depend on Blueprints derived from the validated one.
+	 *
+	 * Cached results are always invalidated when a parent Blueprint changes; validators returning
+	 * true are also invalidated when a child Blueprint changes.
+	 *
+	 * @return True if the validator inspects derived Blueprints.
+	 */
+	virtual bool DependsOnDerivedBlueprints() const
+	{
+		return false;
+	}
+
+	/**
+	 * @brief Returns whether results depend on the Blueprints the validated one references.
+	 *
+	 * Validators returning true are invalidated in the result cache when a Blueprint referenced
+	 * by the validated one changes, directly or through other Blueprints.
+	 *
+	 * @return True if the validator inspects referenced Blueprints.
+	 */
+	virtual bool DependsOnReferencedBlueprints() const
+	{
+		return false;
+	}
+
+	/**
+	 * @brief Returns whether results depend on every asset loaded with the validated Blueprint.
+	 *
+	 * Validators returning true are invalidated in the result cache when a package the validated
+	 * one hard references changes, directly or transitively, Blueprint or not.
+	 *
+	 * @return True if the validator inspects hard-referenced assets.
+	 */
+	virtual bool DependsOnHardReferencedAssets() const
+	{
+		return false;
+	}
+
+	/**
+	 * @brief Returns whether the validator queries the project-wide function reference index.
+	 *
+	 * Such validators are invalidated in the result cache when a Blueprint calling into the
+	 * validated one changes, and the commandlet indexes every pending package before running them.
+	 *
+	 * @return True if the validator uses `FValidatorXManager::GetFunctionReferenceIndex`.
+	 */
+	virtual bool UsesFunctionReferenceIndex() const
+	{
+		return false;
+	}
+
+	/**
+	 * @brief Commits the issues found by `AnalyzeSnapshot` to a validation context.
+	 *
+	 * Updates `bIsError` the same way `ValidateLoadedAsset` does. Game thread only.
+	 *
+	 * @param Blueprint The validated Blueprint.
+	 * @param Issues The issues to commit, in order.
+	 * @param Context The validation context receiving the messages.
+	 * @param OutCommittedIssues If set, receives the confirmed issues, one per message added to the context.
+	 * @param bAddTokens Whether the action tokens are added to the messages, see `AddIssueTokens`.
+	 * @return Invalid if at least one issue was committed, Valid otherwise.
+	 */
+	EDataValidationResult CommitIssues(UBlueprint* Blueprint, TConstArrayView<FValidatorXIssue> Issues, FDataValidationContext& Context, TArray<FValidatorXIssue>* OutCommittedIssues = nullptr, bool bAddTokens = true);
+
+protected:
+	/**
+	 * @brief Returns the shared graph index of a Blueprint.
+	 *
+	 * The index is built once per Blueprint and validation run and shared between all
+	 * validators, so validators should prefer its lookups over walking `Graph->Nodes`.
+	 *
+	 * @param Blueprint The Blueprint being validated.
+	 * @return The graph index of the Blueprint.
+	 */
+	TSharedRef<const FBlueprintGraphIndex> GetGraphIndex(UBlueprint* Blueprint) const;
+
+	/**
+	 * @brief Returns the shared snapshot of a Blueprint.
+	 *
+	 * @param Blueprint The Blueprint being validated.
+	 * @return The snapshot of the Blueprint.
+	 */
+	TSharedRef<const FBlueprintSnapshot> GetSnapshot(UBlueprint* Blueprint) const;
+
+	/**
+	 * @brief Validates a single Blueprint with `AnalyzeSnapshot` followed by `CommitIssues`.
+	 *
+	 * Snapshot validators call this from `ValidateLoadedAsset`, so the editor validation path
+	 * and batch runs report the same issues.
+	 *
+	 * @param Blueprint The Blueprint to validate.
+	 * @param Context The validation context receiving the messages.
+	 * @return The validation result.
+	 */
+	EDataValidationResult ValidateSnapshot(UBlueprint* Blueprint, FDataValidationContext& Context);
+
+	/** @return The graph an issue refers to, or null if it no longer exists. */
+	UEdGraph* FindIssueGraph(UBlueprint* Blueprint, const FValidatorXIssue& Issue) const;
+
+	/** @return The node an issue refers to, or null if it no longer exists. */
+	UEdGraphNode* FindIssueNode(UBlueprint* Blueprint, const FValidatorXIssue& Issue) const;
+
+	/**
+	 * @brief Adds a "Jump to" token opening the graph and node of an issue in the Blueprint editor.
+	 *
+	 * Does nothing if the graph or node of the issue no longer exists.
+	 *
+	 * @param Blueprint The validated Blueprint.
+	 * @param Issue The committed issue.
+	 * @param Message The message the issue was committed as.
+	 */
+	void AddJumpToNodeToken(UBlueprint* Blueprint, const FValidatorXIssue& Issue, const TSharedRef<FTokenizedMessage>& Message) const;
+
 public:
 	/** @brief Whether this validator currently has an error. */
 	bool bIsError = false;
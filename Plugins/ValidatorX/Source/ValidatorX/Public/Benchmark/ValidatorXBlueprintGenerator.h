@@ -0,0 +1,64 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+class UBlueprint;
+
+/** @brief Shape of the Blueprints built by `FValidatorXBlueprintGenerator`. */
+struct FValidatorXBlueprintGeneratorSettings
+{
+	/** @brief Number of function graphs of each Blueprint. */
+	int32 NumFunctions = 16;
+
+	/** @brief Number of nodes placed in each function graph, besides its entry node. */
+	int32 NodesPerGraph = 64;
+
+	/** @brief Number of comment boxes placed in each function graph. */
+	int32 CommentsPerGraph = 4;
+
+	/** @brief Number of boolean member variables of each Blueprint. */
+	int32 NumVariables = 16;
+
+	/** @brief Number of event dispatchers of each Blueprint. */
+	int32 NumDispatchers = 4;
+
+	/** @brief Number of Blueprints in the generated inheritance chain, at least one. */
+	int32 InheritanceDepth = 1;
+
+	/** @brief Seed of the random stream choosing node kinds and links, so runs are reproducible. */
+	int32 Seed = 0;
+};
+
+/**
+ * @brief Builds transient Blueprints of a configurable size, to benchmark validators reproducibly.
+ *
+ * Every generated Blueprint is an Actor Blueprint in its own transient package under `/Temp`. Each
+ * function graph holds an execution chain starting at its entry node, mixing calls to other generated
+ * functions, Branch nodes reading member variables, variable sets and unconnected pure nodes, so each
+ * validator has something to inspect. Node kinds and links are drawn from a seeded random stream.
+ */
+class VALIDATORX_API FValidatorXBlueprintGenerator
+{
+public:
+	/**
+	 * @brief Builds and compiles a chain of Blueprints, each deriving from the previous one.
+	 *
+	 * @param Settings Shape of every generated Blueprint.
+	 * @return The generated Blueprints, root class first. Callers must keep them referenced.
+	 */
+	static TArray<UBlueprint*> Generate(const FValidatorXBlueprintGeneratorSettings& Settings);
+
+private:
+	/**
+	 * @brief Builds and compiles one Blueprint.
+	 *
+	 * @param ParentClass The parent class of the Blueprint.
+	 * @param Name Name of the Blueprint and of its package.
+	 * @param Settings Shape of the Blueprint.
+	 * @param Random Stream choosing node kinds and links.
+	 * @return The generated Blueprint.
+	 */
+	static UBlueprint* GenerateBlueprint(UClass* ParentClass, const FString& Name, const FValidatorXBlueprintGeneratorSettings& Settings, FRandomStream& Random);
+};
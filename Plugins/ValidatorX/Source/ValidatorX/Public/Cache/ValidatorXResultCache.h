@@ -0,0 +1,195 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Misc/SecureHash.h"
+#include "ValidatorXTypes.h"
+
+class UBlueprintValidatorBase;
+
+/** @brief Hit and miss counters of the result cache. */
+struct FValidatorXCacheStats
+{
+	/** @brief Number of lookups answered from the cache. */
+	int32 Hits = 0;
+
+	/** @brief Number of lookups that required running the validator. */
+	int32 Misses = 0;
+
+	/** @brief Number of assets answered from the cache without loading their package. */
+	int32 SkippedLoads = 0;
+};
+
+/**
+ * @brief Persistent cache of validator results, stored under `Saved/ValidatorX`.
+ *
+ * Entries are keyed by package and validator class. Each entry records a hash of its inputs:
+ * the saved hash of the package, of every parent Blueprint package and, for validators that
+ * inspect derived classes, of every child Blueprint package, plus the validator cache version.
+ * Validators inspecting referenced Blueprints also depend on every Blueprint package the validated
+ * one references, and validators using the function reference index on every package calling into it.
+ * All of these are read from the asset registry, so a hit does not load the package.
+ * Cached messages are replayed as plain text. Messages committed from a snapshot issue also keep
+ * its graph, node and subject, so their jump and fix actions can be created again on the live asset.
+ */
+class VALIDATORX_API FValidatorXResultCache
+{
+public:
+	/** @brief A cached message, stored as plain text. */
+	struct FMessage
+	{
+		/** @brief `EMessageSeverity::Type` of the message. */
+		uint8 Severity = 0;
+
+		/** @brief Full text of the message. */
+		FString Text;
+
+		/** @brief Whether the message was committed from a snapshot issue, whose location follows. */
+		bool bHasIssue = false;
+
+		/** @brief `FValidatorXIssue::GraphName` of the issue. */
+		FName GraphName;
+
+		/** @brief `FValidatorXIssue::NodeGuid` of the issue. */
+		FGuid NodeGuid;
+
+		/** @brief `FValidatorXIssue::Subject` of the issue. */
+		FName Subject;
+	};
+
+	/** @brief Cached result of one validator on one package. */
+	struct FEntry
+	{
+		/** @brief Hash of every input the result depends on. */
+		FSHAHash InputsHash;
+
+		/** @brief Result returned by the validator. */
+		EDataValidationResult Result = EDataValidationResult::NotValidated;
+
+		/** @brief Reported messages, in order. */
+		TArray<FMessage> Messages;
+	};
+
+	/**
+	 * @brief Computes the inputs hash of a package for a validator.
+	 *
+	 * @param PackageName The validated package.
+	 * @param Validator The validator.
+	 * @param OutHash Receives the inputs hash.
+	 * @return False if the package hash is unknown (e.g. unsaved or dirty), in which case the cache must not be used.
+	 */
+	bool ComputeInputsHash(FName PackageName, const UBlueprintValidatorBase& Validator, FSHAHash& OutHash);
+
+	/**
+	 * @brief Looks up a cached result and updates the hit/miss counters.
+	 *
+	 * @param PackageName The validated package.
+	 * @param ValidatorName Class name of the validator.
+	 * @param InputsHash Current inputs hash, see `ComputeInputsHash`.
+	 * @return The cached entry, or null on a miss.
+	 */
+	const FEntry* Find(FName PackageName, FName ValidatorName, const FSHAHash& InputsHash);
+
+	/**
+	 * @brief Stores the result of a validator run.
+	 *
+	 * @param PackageName The validated package.
+	 * @param ValidatorName Class name of the validator.
+	 * @param InputsHash Inputs hash the result was computed for.
+	 * @param Result Result returned by the validator.
+	 * @param Messages Messages reported by the validator.
+	 */
+	void Store(FName PackageName, FName ValidatorName, const FSHAHash& InputsHash, EDataValidationResult Result, TConstArrayView<FValidatorXMessage> Messages);
+
+	/**
+	 * @brief Recreates the messages of a cached entry.
+	 *
+	 * @param Entry The cached entry.
+	 * @param AssetData The asset the messages refer to.
+	 * @param ValidatorName Class name of the validator that reported them.
+	 * @param OutMessages Receives the messages.
+	 */
+	static void ReplayMessages(const FEntry& Entry, const FAssetData& AssetData, FName ValidatorName, TArray<FValidatorXMessage>& OutMessages);
+
+	/** @brief Loads the cache file if it has not been loaded yet. */
+	void Load();
+
+	/** @brief Writes the cache file if it has changed since it was loaded. */
+	void Save();
+
+	/**
+	 * @brief Makes `Save` write another file than the shared cache file.
+	 *
+	 * Used by sharded commandlet runs, so concurrent processes read the shared cache but never
+	 * write it; the coordinator merges their files back with `Merge`.
+	 *
+	 * @param Filename The file to save to; the shared cache file if empty.
+	 */
+	void SetSaveFilename(const FString& Filename) { SaveFilename = Filename; }
+
+	/**
+	 * @brief Adds the entries of another cache file, replacing entries of the same package and validator.
+	 *
+	 * @param Filename A file written by `Save`.
+	 * @return False if the file is missing, has an unknown format or is corrupted.
+	 */
+	bool Merge(const FString& Filename);
+
+	/** @brief Drops every entry and deletes the cache file. */
+	void Clear();
+
+	/** @brief Resets the per-session package hash memo; call when packages may have been saved. */
+	void ResetPackageHashes();
+
+	/** @return The hit and miss counters since the last `ResetStats`. */
+	const FValidatorXCacheStats& GetStats() const { return Stats; }
+
+	/** @brief Resets the hit and miss counters. */
+	void ResetStats() { Stats = FValidatorXCacheStats(); }
+
+	/** @brief Records an asset whose package did not need to be loaded. */
+	void AddSkippedLoad() { ++Stats.SkippedLoads; }
+
+	/** @return Full path of the cache file. */
+	static FString GetCacheFilename();
+
+	/**
+	 * @brief Returns the saved hash of a package, memoized until `ResetPackageHashes`.
+	 *
+	 * @param PackageName The package.
+	 * @return The package hash, or an empty string if it is unknown or the package is dirty.
+	 */
+	const FString& GetPackageHash(FName PackageName);
+
+private:
+	/** @brief Reads the entries of a cache file. */
+	static bool ReadCacheFile(const FString& Filename, TMap<FName, TMap<FName, FEntry>>& OutEntries);
+
+	/** @brief Collects the packages of every parent Blueprint of a package, from the Blueprint hierarchy index. */
+	void GetParentPackages(FName PackageName, TArray<FName>& OutPackages) const;
+
+	/** @brief Collects the packages of every Blueprint derived from a package, from the Blueprint hierarchy index. */
+	void GetChildPackages(FName PackageName, TArray<FName>& OutPackages) const;
+
+	/** @brief Collects the Blueprint packages a package references, transitively through other Blueprints, from the asset registry. */
+	void GetReferencedPackages(FName PackageName, TArray<FName>& OutPackages) const;
+
+	/** @brief Cached entries keyed by package, then validator class. */
+	TMap<FName, TMap<FName, FEntry>> Entries;
+
+	/** @brief Package hashes computed during this session. */
+	TMap<FName, FString> PackageHashes;
+
+	/** @brief Hit and miss counters. */
+	FValidatorXCacheStats Stats;
+
+	/** @brief File written by `Save` instead of the shared cache file, if set. */
+	FString SaveFilename;
+
+	/** @brief Whether the cache file has been loaded. */
+	bool bIsLoaded = false;
+
+	/** @brief Whether entries changed since the last load or save. */
+	bool bIsDirty = false;
+};
@@ -0,0 +1,104 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Commandlets/Commandlet.h"
+#include "ValidatorXBenchmarkCommandlet.generated.h"
+
+class FJsonObject;
+class UBlueprint;
+struct FValidatorXBlueprintGeneratorSettings;
+
+/**
+ * @brief Benchmarks every ValidatorX validator on generated Blueprints and checks for regressions.
+ *
+ * Usage:
+ * `UnrealEditor-Cmd Project.uproject -run=ValidatorXBenchmark -nullrhi -unattended [options]`
+ *
+ * Generator options, see `FValidatorXBlueprintGeneratorSettings`:
+ * - `-Functions=16` Function graphs per Blueprint.
+ * - `-Nodes=64` Nodes per function graph.
+ * - `-Comments=4` Comment boxes per function graph.
+ * - `-Variables=16` Member variables per Blueprint.
+ * - `-Dispatchers=4` Event dispatchers per Blueprint.
+ * - `-Depth=1` Blueprints in the inheritance chain.
+ * - `-Seed=0` Seed of the generator.
+ *
+ * Run options:
+ * - `-Iterations=10` Timed runs of each validator over every generated Blueprint, after one warm-up run.
+ * - `-Output=Path` Writes the results as JSON; defaults to `Saved/ValidatorX/Benchmark.json`.
+ * - `-Baseline=Path` Compares the results with a JSON file previously written by `-Output`.
+ * - `-Threshold=0.2` Relative slowdown of the median time reported as a regression.
+ * - `-MinDeltaMs=0.05` Absolute slowdown below which a difference is treated as noise.
+ *
+ * Each validator is timed with the shared graph index and snapshot already built, as in a validation
+ * run; building them is reported separately. Memory is reported as the change of used physical memory
+ * over the timed runs and the peak used physical memory of the process.
+ *
+ * Returns 0 on success, 1 if at least one validator regressed, 2 on usage errors.
+ */
+UCLASS()
+class VALIDATORX_API UValidatorXBenchmarkCommandlet : public UCommandlet
+{
+	GENERATED_BODY()
+
+public:
+	UValidatorXBenchmarkCommandlet();
+
+	//~ Begin UCommandlet Interface
+	virtual int32 Main(const FString& Params) override;
+	//~ End UCommandlet Interface
+
+private:
+	/** @brief Timings of one benchmarked entry, a validator or a shared analysis step. */
+	struct FBenchmarkResult
+	{
+		/** @brief Validator class name, or name of the analysis step. */
+		FString Name;
+
+		/** @brief Duration of every timed run over all generated Blueprints, in milliseconds, sorted. */
+		TArray<double> Milliseconds;
+
+		/** @brief Change of used physical memory over the timed runs, in bytes. */
+		int64 UsedPhysicalDelta = 0;
+
+		/** @return The median duration, in milliseconds. */
+		double GetMedianMs() const
+		{
+			return Milliseconds.IsEmpty() ? 0.0 : Milliseconds[Milliseconds.Num() / 2];
+		}
+	};
+
+	/**
+	 * @brief Times a function over every timed run.
+	 *
+	 * @param Name Name of the result.
+	 * @param Iterations Number of timed runs, after one warm-up run.
+	 * @param Run The benchmarked function.
+	 * @return The timings.
+	 */
+	static FBenchmarkResult RunBenchmark(const FString& Name, int32 Iterations, TFunctionRef<void()> Run);
+
+	/**
+	 * @brief Converts the results to JSON.
+	 *
+	 * @param Settings The generator settings the results were measured with.
+	 * @param Iterations Number of timed runs.
+	 * @param Results The results.
+	 * @return The JSON document.
+	 */
+	static TSharedRef<FJsonObject> MakeJsonReport(const FValidatorXBlueprintGeneratorSettings& Settings, int32 Iterations, TConstArrayView<FBenchmarkResult> Results);
+
+	/**
+	 * @brief Compares results with a baseline report and logs every regression.
+	 *
+	 * @param Report The report of this run.
+	 * @param Baseline The baseline report.
+	 * @param Threshold Relative slowdown of the median reported as a regression.
+	 * @param MinDeltaMs Absolute slowdown below which differences are ignored.
+	 * @param OutNumRegressions Receives the number of regressed entries.
+	 * @return False if the baseline was measured with different settings and cannot be compared.
+	 */
+	static bool CompareWithBaseline(const FJsonObject& Report, const FJsonObject& Baseline, double Threshold, double MinDeltaMs, int32& OutNumRegressions);
+};
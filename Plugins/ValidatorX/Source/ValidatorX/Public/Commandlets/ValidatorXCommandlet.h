@@ -0,0 +1,130 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Commandlets/Commandlet.h"
+#include "UObject/StrongObjectPtr.h"
+#include "ValidatorXTypes.h"
+#include "ValidatorXCommandlet.generated.h"
+
+class UBlueprintValidatorBase;
+
+/**
+ * @brief Runs the ValidatorX Blueprint validators without the editor UI.
+ *
+ * Usage:
+ * `UnrealEditor-Cmd Project.uproject -run=ValidatorX -nullrhi [options]`
+ *
+ * Options:
+ * - `-Paths=/Game/A+/Game/B` Content paths to validate, recursively. Defaults to `/Game`.
+ * - `-Class=/Script/Engine.Blueprint` Asset class to validate, including subclasses. Defaults to every Blueprint.
+ * - `-Validators=EmptyBranchValidator+...` Validator class names to run. Defaults to every enabled validator.
+ * - `-BatchSize=64` Number of assets loaded before garbage is collected.
+ * - `-Json=Path` Writes a JSON report.
+ * - `-JUnit=Path` Writes a JUnit XML report, one test case per asset.
+ * - `-StatsCsv=Path` Writes the execution counters of every validator as CSV, see `FValidatorXStats`.
+ * - `-NoResultCache` Ignores the persistent result cache.
+ * - `-Shard=0/4` Validates only one of 4 size-balanced shards of the assets, see `PartitionAssets`.
+ * - `-Workers=4` Coordinator mode: validates the 4 shards in as many child editor processes, then
+ *   merges their reports. `-Workers=Auto` starts one process per physical core.
+ *
+ * Loading Blueprints is mostly serialized within an editor process, so large runs scale with
+ * `-Workers` on a single machine. Every worker computes the same partition from the asset registry
+ * and logs to `Saved/ValidatorX/Shards`. The merged JSON and JUnit reports list the assets in the
+ * same order as a single-process run, and the result cache entries added by the workers are merged
+ * back into the shared cache once they exit. Stats CSV files are written per shard.
+ *
+ * Validators using the function reference index, such as `UnusedFunctionValidator`, first index the
+ * function calls of every Blueprint whose record is missing or out of date, see `FFunctionReferenceIndex`.
+ *
+ * Returns 0 if every asset is valid, 1 if at least one asset has issues, 2 on usage errors, 3 if a
+ * shard worker failed.
+ */
+UCLASS()
+class VALIDATORX_API UValidatorXCommandlet : public UCommandlet
+{
+	GENERATED_BODY()
+
+public:
+	UValidatorXCommandlet();
+
+	//~ Begin UCommandlet Interface
+	virtual int32 Main(const FString& Params) override;
+	//~ End UCommandlet Interface
+
+private:
+	/**
+	 * @brief Creates the validators to run.
+	 *
+	 * @param ValidatorNames Class names to run; every enabled validator if empty.
+	 * @param OutValidators Receives the validator instances.
+	 * @return False if a requested validator does not exist.
+	 */
+	bool CreateValidators(const TArray<FString>& ValidatorNames, TArray<TStrongObjectPtr<UBlueprintValidatorBase>>& OutValidators) const;
+
+	/**
+	 * @brief Logs the issues and writes the requested reports.
+	 *
+	 * @param Reports The reports of every validated asset.
+	 * @param ValidatorNames Class names of the validators that ran.
+	 * @param Duration Wall clock duration of the run, in seconds.
+	 * @param ParamsMap The command line values, for the report file names.
+	 * @return The exit code of the run.
+	 */
+	static int32 ReportResults(TConstArrayView<FValidatorXAssetReport> Reports, TConstArrayView<FName> ValidatorNames, double Duration, const TMap<FString, FString>& ParamsMap);
+
+	/**
+	 * @brief Validates the assets in child editor processes, one shard each, and merges their reports.
+	 *
+	 * @param NumWorkers The number of shards and processes.
+	 * @param NumAssets The number of assets to validate; workers partition the asset registry themselves.
+	 * @param ParamsMap The command line values forwarded to the workers.
+	 * @param Switches The command line switches forwarded to the workers.
+	 * @return The exit code of the run.
+	 */
+	static int32 RunShardWorkers(int32 NumWorkers, int32 NumAssets, const TMap<FString, FString>& ParamsMap, const TArray<FString>& Switches);
+
+	/**
+	 * @brief Splits assets into shards of similar total package size.
+	 *
+	 * Assets are assigned largest first to the lightest shard, using the package sizes of the asset
+	 * registry. The result only depends on the assets and their sizes, so every worker computes the
+	 * same partition.
+	 *
+	 * @param Assets The assets, in report order.
+	 * @param NumShards The number of shards.
+	 * @param OutShards Receives the assets of every shard, in report order.
+	 */
+	static void PartitionAssets(TConstArrayView<FAssetData> Assets, int32 NumShards, TArray<TArray<FAssetData>>& OutShards);
+
+	/**
+	 * @brief Reads a JSON report written by `WriteJsonReport`.
+	 *
+	 * @param Filename Input file.
+	 * @param OutReports Receives the reports, appended.
+	 * @param OutValidatorNames Receives the validator class names, if still empty.
+	 * @return True on success.
+	 */
+	static bool ReadJsonReport(const FString& Filename, TArray<FValidatorXAssetReport>& OutReports, TArray<FName>& OutValidatorNames);
+
+	/**
+	 * @brief Writes the reports as JSON.
+	 *
+	 * @param Filename Output file.
+	 * @param Reports The reports of every validated asset.
+	 * @param ValidatorNames Class names of the validators that ran.
+	 * @return True on success.
+	 */
+	static bool WriteJsonReport(const FString& Filename, TConstArrayView<FValidatorXAssetReport> Reports, TConstArrayView<FName> ValidatorNames);
+
+	/**
+	 * @brief Writes the reports as JUnit XML, one test case per asset.
+	 *
+	 * @param Filename Output file.
+	 * @param Reports The reports of every validated asset.
+	 * @param Duration Wall clock duration of the run, in seconds.
+	 * @return True on success.
+	 */
+	static bool WriteJUnitReport(const FString& Filename, TConstArrayView<FValidatorXAssetReport> Reports, double Duration);
+};
@@ -0,0 +1,81 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UObject/ObjectKey.h"
+#include "ValidatorXTypes.h"
+
+class UBlueprint;
+class UBlueprintValidatorBase;
+
+/**
+ * @brief Applies the fixes of many issues at once.
+ *
+ * Fixes are grouped by Blueprint and applied with `UBlueprintValidatorBase::ApplyIssueFix` inside a
+ * single undoable transaction. No asset editor is opened and nothing asks for confirmation, and each
+ * modified Blueprint is marked as structurally modified, and so recompiled, exactly once after all
+ * of its fixes, instead of once per fix as the individual fix actions do.
+ */
+class VALIDATORX_API FValidatorXFixBatch
+{
+public:
+	/** @brief Outcome of `Apply`. */
+	struct FResult
+	{
+		/** @brief Number of fixes applied. */
+		int32 NumFixed = 0;
+
+		/** @brief Number of fixes that no longer applied, or whose validator has no fix. */
+		int32 NumSkipped = 0;
+
+		/** @brief Number of Blueprints modified, and recompiled. */
+		int32 NumBlueprints = 0;
+	};
+
+	/**
+	 * @brief Adds the fix of an issue. Fixes of a Blueprint are applied in the order they are added.
+	 *
+	 * @param Validator The validator that reported the issue.
+	 * @param Blueprint The Blueprint the issue was reported for.
+	 * @param Issue The issue to fix.
+	 */
+	void AddFix(UBlueprintValidatorBase* Validator, UBlueprint* Blueprint, const FValidatorXIssue& Issue);
+
+	/** @return The number of fixes added. */
+	int32 Num() const { return NumFixes; }
+
+	/**
+	 * @brief Applies every added fix and empties the batch. Game thread only.
+	 *
+	 * Issues are confirmed again with `UBlueprintValidatorBase::ConfirmIssue` before being fixed, so
+	 * issues reported by an earlier run that no longer hold are skipped.
+	 *
+	 * @return The number of fixes applied and skipped.
+	 */
+	FResult Apply();
+
+private:
+	/** @brief A single fix. */
+	struct FFix
+	{
+		TWeakObjectPtr<UBlueprintValidatorBase> Validator;
+		FValidatorXIssue Issue;
+	};
+
+	/** @brief The fixes of a Blueprint. */
+	struct FBlueprintFixes
+	{
+		TWeakObjectPtr<UBlueprint> Blueprint;
+		TArray<FFix> Fixes;
+	};
+
+	/** @brief Fixes grouped by Blueprint, in the order the Blueprints were first added. */
+	TArray<FBlueprintFixes> Blueprints;
+
+	/** @brief Index in `Blueprints` of every Blueprint. */
+	TMap<TObjectKey<UBlueprint>, int32> BlueprintIndices;
+
+	/** @brief Number of fixes added. */
+	int32 NumFixes = 0;
+};
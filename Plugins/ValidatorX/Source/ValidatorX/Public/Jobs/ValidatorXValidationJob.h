@@ -0,0 +1,111 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Containers/Ticker.h"
+#include "Results/ValidatorXIssueTable.h"
+#include "ValidatorXTypes.h"
+
+class UBlueprintValidatorBase;
+
+/**
+ * @brief Validates many assets in the background of the editor, without blocking Slate.
+ *
+ * The assets are processed on the game thread in slices, within a per-frame time budget, through
+ * `FValidatorXManager::ValidateAssetChunk`, so snapshot analysis of a slice still runs on worker
+ * threads. The slice size adapts to the measured time per asset: assets answered from the result
+ * cache are validated by the chunk, while a frame loading large Blueprints validates a single one.
+ * Messages are added to an issue table as soon as their slice is done and can be displayed while
+ * the job runs. Action tokens are deferred, see `FValidatorXBatchOptions::bDeferIssueTokens`, and
+ * created from the table for the messages the user acts on.
+ *
+ * Every slice is its own validation run, so Blueprints edited while the job runs are never
+ * validated with stale cached data. Work is paused during Play In Editor.
+ */
+class VALIDATORX_API FValidatorXValidationJob
+{
+public:
+	/**
+	 * @brief Creates a job. Nothing is validated before `Start`.
+	 *
+	 * @param InAssets The assets to validate, in report order.
+	 * @param InValidators The validators to run.
+	 * @param InOptions Maximum slice size and caching options. Action tokens are always deferred.
+	 */
+	FValidatorXValidationJob(TArray<FAssetData> InAssets, TConstArrayView<UBlueprintValidatorBase*> InValidators, const FValidatorXBatchOptions& InOptions = FValidatorXBatchOptions());
+
+	/** @brief Cancels the job if it is still running. */
+	~FValidatorXValidationJob();
+
+	/** @brief Starts validating on the next tick of the core ticker. */
+	void Start();
+
+	/** @brief Stops the job. Messages of the assets validated so far are kept. */
+	void Cancel();
+
+	/** @return Whether the job has been started and is neither finished nor cancelled. */
+	bool IsRunning() const { return TickerHandle.IsValid(); }
+
+	/** @return Whether the job was cancelled before validating every asset. */
+	bool IsCancelled() const { return bIsCancelled; }
+
+	/** @return The assets to validate, in report order. */
+	const TArray<FAssetData>& GetAssets() const { return Assets; }
+
+	/** @return The number of assets to validate. */
+	int32 GetNumAssets() const { return Assets.Num(); }
+
+	/** @return The number of assets validated so far. */
+	int32 GetNumValidated() const { return IssueTable.GetNumAssets(); }
+
+	/** @return The number of validated assets with at least one error. */
+	int32 GetNumInvalid() const { return IssueTable.GetNumInvalidAssets(); }
+
+	/** @return The fraction of validated assets, between 0 and 1. */
+	float GetProgress() const;
+
+	/** @return Wall time since the job was started, up to its end. */
+	double GetElapsedSeconds() const;
+
+	/** @return Average number of assets validated per second of wall time. */
+	double GetAssetsPerSecond() const;
+
+	/** @return Estimated wall time until the last asset is validated, unset until the rate is known. */
+	TOptional<double> GetRemainingSeconds() const;
+
+	/** @return The messages of the validated assets, in asset order. */
+	const FValidatorXIssueTable& GetIssueTable() const { return IssueTable; }
+
+private:
+	/** @brief Validates slices of assets until the frame budget is spent. */
+	bool Tick(float DeltaTime);
+
+	/** @brief Stops ticking and saves the result cache. */
+	void Finish();
+
+	/** @brief The assets to validate. */
+	TArray<FAssetData> Assets;
+
+	/** @brief The validators to run; validators destroyed in the meantime are skipped. */
+	TArray<TWeakObjectPtr<UBlueprintValidatorBase>> Validators;
+
+	/** @brief Maximum slice size and caching options. */
+	FValidatorXBatchOptions Options;
+
+	/** @brief Messages of the validated assets. */
+	FValidatorXIssueTable IssueTable;
+
+	/** @brief Smoothed game thread time per asset, zero until the first slice is measured. */
+	double SecondsPerAsset = 0.0;
+
+	/** @brief Time the job was started and ended at, zero if not yet. */
+	double StartTime = 0.0;
+	double EndTime = 0.0;
+
+	/** @brief Whether `Cancel` stopped the job. */
+	bool bIsCancelled = false;
+
+	/** @brief Handle of the ticker validating the slices. */
+	FTSTicker::FDelegateHandle TickerHandle;
+};
@@ -30,8 +30,9 @@ public:
 	/**
 	 * @brief Populates an array with all Blueprint-generated classes derived from a specified parent class.
 	 *
-	 * Iterates over all loaded `UBlueprintGeneratedClass` objects in memory and checks whether
-	 * each is a subclass of the given `ParentClass` (excluding the `ParentClass` itself).
+	 * Looks up the loaded `UBlueprintGeneratedClass` objects deriving from the given `ParentClass`
+	 * (excluding the `ParentClass` itself) in the hierarchy memoized by `FLoadedClassHierarchy`,
+	 * so repeated calls during a validation run do not iterate every loaded class.
 	 * Only loaded classes are returned.
 	 *
 	 * @param ParentClass The base class to search derived Blueprint classes from. Must not be null.
@@ -42,7 +43,8 @@ public:
 	/**
 	 * @brief Populates an array with derived Blueprint classes using the asset registry.
 	 *
-	 * Similar to `GetDerivedBlueprintClasses`, but also searches unloaded assets via the registry.
+	 * Similar to `GetDerivedBlueprintClasses`, but also finds unloaded Blueprints through
+	 * `FBlueprintHierarchyIndex`. Only the derived Blueprints are loaded.
 	 *
 	 * @param ParentClass The base class to search derived Blueprint classes from.
 	 * @param OutDerived  The output array that will be filled with matching classes.
@@ -52,7 +54,7 @@ public:
 	/**
 	 * @brief Retrieves all Blueprint-generated classes derived from a parent class.
 	 *
-	 * Searches both loaded classes and, optionally, the asset registry.
+	 * Searches loaded classes and, optionally, the asset registry; results are not duplicated.
 	 *
 	 * @param ParentClass        The parent class to search from.
 	 * @param OutDerived         The array to fill with derived classes.
@@ -119,11 +121,14 @@ public:
 	/**
 	 * @brief Determines if a node is inside a comment bubble.
 	 *
+	 * Tests every comment; when checking many nodes of a graph, build an
+	 * `FCommentSpatialIndex` of its comment boxes once instead.
+	 *
 	 * @param Node         The node to check.
 	 * @param CommentNodes Array of comment nodes to search within.
 	 * @return true if the node is inside any of the comment bubbles; false otherwise.
 	 */
-	static bool IsNodeInsideComment(UEdGraphNode* Node, const TArray<UEdGraphNode_Comment*>& CommentNodes);
+	static bool IsNodeInsideComment(UEdGraphNode* Node, TConstArrayView<UEdGraphNode_Comment*> CommentNodes);
 
 	/**
 	 * @brief Checks whether a node has execution output connections.
@@ -159,4 +164,12 @@ public:
 	 * @return true if all execution outputs are disconnected; false otherwise.
 	 */
 	static bool AreAllBranchExecsDisconnected(const UK2Node_IfThenElse* Branch);
+
+	/**
+	 * @brief Returns the Blueprint saved in a package, if the package is loaded.
+	 *
+	 * @param PackageName The long name of the package.
+	 * @return The loaded Blueprint, or nullptr if the package is not in memory or holds no Blueprint.
+	 */
+	static UBlueprint* FindLoadedBlueprint(FName PackageName);
 };
@@ -0,0 +1,118 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Containers/Ticker.h"
+#include "ValidatorXTypes.h"
+
+class IAssetEditorInstance;
+class UBlueprint;
+class UBlueprintValidatorBase;
+
+/**
+ * @brief Re-validates Blueprints open in an editor while they are being edited.
+ *
+ * Edits are tracked per graph: modifying a node or a graph only marks that graph dirty, and only
+ * graph-local validators (`UBlueprintValidatorBase::IsGraphLocal`) are re-run on a snapshot of
+ * that graph. Compiling a Blueprint marks every graph dirty and also re-runs the remaining
+ * validators on the whole Blueprint. Dirty work is processed on the game thread within a per-frame
+ * time budget, and the results are published to the "ValidatorX" message log.
+ */
+class VALIDATORX_API FValidatorXLiveValidation
+{
+public:
+	/** @brief Name of the message log listing live results are published to. */
+	static const FName MessageLogName;
+
+	/** @brief Subscribes to editor events and registers the message log listing. */
+	void Initialize();
+
+	/** @brief Removes every subscription and drops the stored results. */
+	void Shutdown();
+
+	/**
+	 * @brief Starts tracking a Blueprint and schedules a full re-validation.
+	 *
+	 * @param Blueprint The Blueprint to track.
+	 */
+	void TrackBlueprint(UBlueprint* Blueprint);
+
+	/**
+	 * @brief Marks a graph of a tracked Blueprint dirty.
+	 *
+	 * @param Blueprint The Blueprint owning the graph.
+	 * @param GraphName Name of the edited graph.
+	 */
+	void MarkGraphDirty(UBlueprint* Blueprint, FName GraphName);
+
+	/** @return The number of pending graph and Blueprint re-validations. */
+	int32 GetNumPendingWork() const { return PendingWork.Num(); }
+
+private:
+	/** @brief Live results of a tracked Blueprint. */
+	struct FLiveBlueprint
+	{
+		/** @brief Messages of graph-local validators, keyed by graph name. */
+		TMap<FName, TArray<FValidatorXMessage>> GraphMessages;
+
+		/** @brief Messages of validators that inspect the whole Blueprint. */
+		TArray<FValidatorXMessage> BlueprintMessages;
+
+		/** @brief Handle of the `UBlueprint::OnCompiled` binding. */
+		FDelegateHandle CompiledHandle;
+	};
+
+	/** @brief A pending re-validation. A `None` graph name re-runs the Blueprint-wide validators. */
+	struct FWorkItem
+	{
+		TWeakObjectPtr<UBlueprint> Blueprint;
+		FName GraphName;
+
+		bool operator==(const FWorkItem& Other) const
+		{
+			return Blueprint == Other.Blueprint && GraphName == Other.GraphName;
+		}
+	};
+
+	/** @brief Starts tracking Blueprints when their editor is opened. */
+	void HandleAssetOpenedInEditor(UObject* Asset, IAssetEditorInstance* EditorInstance);
+
+	/** @brief Marks the graph of a modified node or graph dirty. */
+	void HandleObjectModified(UObject* Object);
+
+	/** @brief Schedules a full re-validation of a compiled Blueprint. */
+	void HandleBlueprintCompiled(UBlueprint* Blueprint);
+
+	/** @brief Processes pending work within the frame budget. */
+	bool Tick(float DeltaTime);
+
+	/** @brief Stops tracking Blueprints that were destroyed or whose editor was closed. */
+	bool RemoveClosedBlueprints();
+
+	/** @brief Re-runs graph-local validators on a single graph. */
+	void ValidateGraph(UBlueprint& Blueprint, FLiveBlueprint& Live, FName GraphName, TConstArrayView<UBlueprintValidatorBase*> InValidators);
+
+	/** @brief Re-runs the validators that inspect the whole Blueprint. */
+	void ValidateBlueprint(UBlueprint& Blueprint, FLiveBlueprint& Live, TConstArrayView<UBlueprintValidatorBase*> InValidators);
+
+	/** @brief Replaces the content of the message log listing with the current results. */
+	void PublishMessages() const;
+
+	/** @brief Adds a work item unless it is already pending. */
+	void AddWork(UBlueprint* Blueprint, FName GraphName);
+
+	/** @brief Tracked Blueprints and their results. */
+	TMap<TWeakObjectPtr<UBlueprint>, FLiveBlueprint> LiveBlueprints;
+
+	/** @brief Pending re-validations, oldest first. */
+	TArray<FWorkItem> PendingWork;
+
+	/** @brief Handle of the ticker processing pending work. */
+	FTSTicker::FDelegateHandle TickerHandle;
+
+	/** @brief Handles of the editor event bindings. */
+	FDelegateHandle ObjectModifiedHandle;
+	FDelegateHandle AssetOpenedHandle;
+	FDelegateHandle PostEngineInitHandle;
+};
@@ -0,0 +1,157 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "ValidatorXTypes.h"
+
+class FTokenizedMessage;
+class FValidatorXFixBatch;
+class UBlueprintValidatorBase;
+
+/**
+ * @brief Compact, append-only table of the messages of a validation run.
+ *
+ * Holds hundreds of thousands of messages without keeping their `FTokenizedMessage`: every row only
+ * references its asset and validator by index, its message by an interned format plus a slice of a
+ * shared argument array, and its snapshot issue by graph name, node guid and subject. Message text,
+ * jump and fix actions are created on demand, for the rows being displayed.
+ */
+class VALIDATORX_API FValidatorXIssueTable
+{
+public:
+	/** @brief A single message. */
+	struct FRow
+	{
+		/** @brief Index of the asset, see `GetAsset`. */
+		int32 Asset = INDEX_NONE;
+
+		/** @brief Index of the validator, see `GetValidatorName`. */
+		int32 Validator = INDEX_NONE;
+
+		/** @brief Index of the interned message format. */
+		int32 Format = INDEX_NONE;
+
+		/** @brief Offset of the first format argument in the shared argument array. */
+		int32 FirstArgument = 0;
+
+		/** @brief Number of format arguments. */
+		int32 NumArguments = 0;
+
+		/** @brief `EMessageSeverity::Type` of the message. */
+		uint8 Severity = 0;
+
+		/** @brief Whether the message was committed from a snapshot issue, so its actions can be created again. */
+		bool bHasIssue = false;
+
+		/** @brief `FValidatorXIssue::GraphName` of the issue. */
+		FName GraphName;
+
+		/** @brief `FValidatorXIssue::NodeGuid` of the issue. */
+		FGuid NodeGuid;
+
+		/** @brief `FValidatorXIssue::Subject` of the issue. */
+		FName Subject;
+	};
+
+	/**
+	 * @brief Adds the asset of a report and one row per message.
+	 *
+	 * @param Report The report of a validated asset.
+	 */
+	void AddReport(const FValidatorXAssetReport& Report);
+
+	/** @brief Removes every asset and row. */
+	void Reset();
+
+	/** @return The number of rows. */
+	int32 Num() const { return Rows.Num(); }
+
+	/** @return A row. */
+	const FRow& GetRow(int32 RowIndex) const { return Rows[RowIndex]; }
+
+	/** @return The number of assets, including assets without any message. */
+	int32 GetNumAssets() const { return Assets.Num(); }
+
+	/** @return The number of assets with an `Invalid` result. */
+	int32 GetNumInvalidAssets() const { return NumInvalidAssets; }
+
+	/** @return An asset. */
+	const FAssetData& GetAsset(int32 AssetIndex) const { return Assets[AssetIndex]; }
+
+	/** @return The class name of a validator. */
+	FName GetValidatorName(int32 ValidatorIndex) const { return Validators[ValidatorIndex]; }
+
+	/**
+	 * @brief Formats the message of a row.
+	 *
+	 * @param RowIndex The row.
+	 * @return The message text, without asset name or action names.
+	 */
+	FText GetMessage(int32 RowIndex) const;
+
+	/**
+	 * @brief Creates the full message of a row, including the action tokens of its validator.
+	 *
+	 * Loads the Blueprint of the row if needed. Game thread only.
+	 *
+	 * @param RowIndex The row.
+	 * @return The message; without action tokens if the row has no issue, or its Blueprint or validator is gone.
+	 */
+	TSharedRef<FTokenizedMessage> CreateMessage(int32 RowIndex) const;
+
+	/**
+	 * @brief Adds the fixes of rows to a batch.
+	 *
+	 * Loads the Blueprints of the rows if needed. Rows without an issue, or whose Blueprint or
+	 * validator is gone, are ignored. Game thread only.
+	 *
+	 * @param RowIndices The rows to fix.
+	 * @param OutBatch The batch receiving the fixes.
+	 * @return The number of fixes added; the batch skips issues its validator cannot fix when applied.
+	 */
+	int32 AddFixes(TConstArrayView<int32> RowIndices, FValidatorXFixBatch& OutBatch) const;
+
+	/**
+	 * @brief Collects the rows matching a filter text.
+	 *
+	 * A row matches if its asset name, folder, validator, format or one of its format arguments
+	 * contains the text, ignoring case. Matching is decided per interned value, so most rows are
+	 * tested with a few lookups and the message is never formatted.
+	 *
+	 * @param FilterText The text to search for; every row matches an empty text.
+	 * @param FirstRow The first row to test, to filter rows added since the last call only.
+	 * @param OutRows Receives the matching rows, ascending.
+	 */
+	void FilterRows(const FString& FilterText, int32 FirstRow, TArray<int32>& OutRows) const;
+
+private:
+	/** @return The registered validator that reported a row, or null if it is gone. */
+	UBlueprintValidatorBase* FindValidator(const FRow& Row) const;
+
+	/** @return The snapshot issue of a row. */
+	FValidatorXIssue MakeIssue(const FRow& Row) const;
+
+	/** @brief Adds a format to the interned formats. */
+	int32 InternFormat(const FTextFormat& Format);
+
+	/** @brief The messages. */
+	TArray<FRow> Rows;
+
+	/** @brief The assets of the added reports. */
+	TArray<FAssetData> Assets;
+
+	/** @brief Number of added reports with an `Invalid` result. */
+	int32 NumInvalidAssets = 0;
+
+	/** @brief Class names of the validators, indexed by `FRow::Validator`. */
+	TArray<FName> Validators;
+	TMap<FName, int32> ValidatorIndices;
+
+	/** @brief Interned message formats, indexed by `FRow::Format`, and their source strings. */
+	TArray<FTextFormat> Formats;
+	TMap<FString, int32> FormatIndices;
+
+	/** @brief Format arguments of every row, stored contiguously row after row. */
+	TArray<FFormatArgumentValue> Arguments;
+};
@@ -0,0 +1,161 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "ProfilingDebugging/CpuProfilerTrace.h"
+#include "Stats/Stats.h"
+#include "UObject/SoftObjectPath.h"
+
+class UBlueprintValidatorBase;
+class FDataValidationContext;
+struct FAssetData;
+
+DECLARE_STATS_GROUP(TEXT("ValidatorX"), STATGROUP_ValidatorX, STATCAT_Advanced);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Validate Asset"), STAT_ValidatorX_ValidateAsset, STATGROUP_ValidatorX, VALIDATORX_API);
+
+/** @brief One slow execution of a validator, kept for the "worst assets" drill-down. */
+struct FValidatorXAssetTiming
+{
+	/** @brief The validated asset. */
+	FSoftObjectPath AssetPath;
+
+	/** @brief Time spent by the validator on the asset, in seconds. */
+	double Seconds = 0.0;
+
+	/** @brief Number of messages the validator reported on the asset. */
+	int32 NumMessages = 0;
+};
+
+/** @brief Execution counters of one validator. */
+struct FValidatorXValidatorStats
+{
+	/** @brief Number of executions, one per validated asset. */
+	int32 NumAssets = 0;
+
+	/** @brief Number of messages reported across every execution. */
+	int32 NumMessages = 0;
+
+	/** @brief Time spent across every execution, in seconds. */
+	double TotalSeconds = 0.0;
+
+	/** @brief Time of every execution, in seconds, sorted in ascending order. */
+	TArray<float> SortedSeconds;
+
+	/** @brief The slowest executions, slowest first. */
+	TArray<FValidatorXAssetTiming> WorstAssets;
+
+	/**
+	 * @brief Returns a percentile of the per-asset times, using the nearest rank.
+	 *
+	 * @param Percentile The percentile, between 0 and 1.
+	 * @return The time in seconds, 0 if the validator never ran.
+	 */
+	double GetPercentileSeconds(double Percentile) const;
+
+	/** @return The time of the slowest execution, in seconds. */
+	double GetMaxSeconds() const
+	{
+		return SortedSeconds.IsEmpty() ? 0.0 : SortedSeconds.Last();
+	}
+};
+
+/**
+ * @brief Per-validator execution counters of the editor session.
+ *
+ * Every execution of a validator on an asset records its duration and the number of messages it
+ * reported, whether it ran from the editor validation path (save, "Validate Assets"), from a batch
+ * run or from live validation of a compiled Blueprint. Results answered by the result cache are not
+ * executions and are not recorded. Counters are keyed by validator class name and kept until `Reset`.
+ *
+ * Game thread only; worker threads measure their own time and report it from the game thread.
+ */
+class VALIDATORX_API FValidatorXStats
+{
+public:
+	/** @brief Number of slowest executions kept per validator. */
+	static constexpr int32 MaxWorstAssets = 10;
+
+	/**
+	 * @brief Records one execution of a validator.
+	 *
+	 * @param ValidatorName Class name of the validator.
+	 * @param AssetPath The validated asset.
+	 * @param Cycles Duration of the execution, in `FPlatformTime::Cycles64` units.
+	 * @param NumMessages Number of messages the execution reported.
+	 */
+	void Record(FName ValidatorName, const FSoftObjectPath& AssetPath, uint64 Cycles, int32 NumMessages);
+
+	/** @return The counters of a validator, or null if it never ran. */
+	const FValidatorXValidatorStats* Find(FName ValidatorName) const
+	{
+		return ValidatorStats.Find(ValidatorName);
+	}
+
+	/** @return The counters of every validator that ran, keyed by class name. */
+	const TMap<FName, FValidatorXValidatorStats>& GetValidatorStats() const
+	{
+		return ValidatorStats;
+	}
+
+	/** @return A number that changes whenever an execution is recorded or the counters are reset. */
+	uint32 GetRevision() const
+	{
+		return Revision;
+	}
+
+	/** @brief Drops every counter. */
+	void Reset();
+
+	/**
+	 * @brief Writes the counters as CSV, one row per validator, slowest total time first.
+	 *
+	 * @param Filename Output file.
+	 * @return True on success.
+	 */
+	bool ExportCsv(const FString& Filename) const;
+
+	/** @return The default CSV export file, under `Saved/ValidatorX`. */
+	static FString GetDefaultCsvFilename();
+
+private:
+	/** @brief Counters keyed by validator class name. */
+	TMap<FName, FValidatorXValidatorStats> ValidatorStats;
+
+	/** @brief Incremented on every change. */
+	uint32 Revision = 0;
+};
+
+/**
+ * @brief Times one execution of a validator on an asset and records it in `FValidatorXStats`.
+ *
+ * Messages are counted from the issues the validator adds to the context while the scope is alive.
+ * Use through `VALIDATORX_SCOPE_VALIDATE`, which also emits an Unreal Insights event named after
+ * the validator class.
+ */
+class VALIDATORX_API FValidatorXStatScope
+{
+public:
+	FValidatorXStatScope(const UBlueprintValidatorBase& InValidator, const FAssetData& InAssetData, const FDataValidationContext& InContext);
+	~FValidatorXStatScope();
+
+	FValidatorXStatScope(const FValidatorXStatScope&) = delete;
+	FValidatorXStatScope& operator=(const FValidatorXStatScope&) = delete;
+
+private:
+	const UBlueprintValidatorBase& Validator;
+	const FAssetData& AssetData;
+	const FDataValidationContext& Context;
+	int32 NumIssuesBefore = 0;
+	uint64 StartCycles = 0;
+};
+
+/**
+ * Times the enclosing `ValidateLoadedAsset_Implementation` of a validator: records it in the
+ * per-validator stats, in the `stat ValidatorX` cycle counter and as an Insights CPU event named
+ * after the validator class.
+ */
+#define VALIDATORX_SCOPE_VALIDATE(AssetData, Context) \
+	SCOPE_CYCLE_COUNTER(STAT_ValidatorX_ValidateAsset); \
+	TRACE_CPUPROFILER_EVENT_SCOPE_TEXT(*GetClass()->GetName()); \
+	const FValidatorXStatScope ValidatorXStatScope(*this, AssetData, Context)
@@ -4,6 +4,18 @@
 
 #include "CoreMinimal.h"
 #include "BaseClasses/BlueprintValidatorBase.h"
+#include "Analysis/BlueprintHierarchyIndex.h"
+#include "Analysis/FunctionReferenceIndex.h"
+#include "Analysis/HardReferenceFootprint.h"
+#include "Analysis/LoadedClassHierarchy.h"
+#include "Cache/ValidatorXResultCache.h"
+#include "Live/ValidatorXLiveValidation.h"
+#include "Stats/ValidatorXStats.h"
+#include "ValidatorXTypes.h"
+
+class FBlueprintGraphIndex;
+class FValidatorXValidationJob;
+struct FBlueprintSnapshot;
 
 /**
  * @brief Singleton manager for Blueprint validators.
@@ -60,7 +72,273 @@ public:
 		return Validators;
 	}
 
+	/**
+	 * @brief Hooks the manager into the editor validation delegates.
+	 *
+	 * Called from module startup. Validation runs started by the `UEditorValidatorSubsystem`
+	 * are bracketed with `BeginValidationRun` / `EndValidationRun`.
+	 */
+	void Initialize();
+
+	/** @brief Removes the delegate bindings added in `Initialize`, stops live validation and drops cached data. */
+	void Shutdown();
+
+	/**
+	 * @brief Marks the start of a validation run.
+	 *
+	 * Cached per-run data is kept until the matching `EndValidationRun`. Runs may nest.
+	 */
+	void BeginValidationRun();
+
+	/** @brief Marks the end of a validation run and drops cached per-run data. */
+	void EndValidationRun();
+
+	/**
+	 * @brief Returns the graph index of a Blueprint, building it on first use.
+	 *
+	 * The index is shared by every validator that inspects the same Blueprint during a
+	 * validation run, so the Blueprint graphs are walked only once. Outside of a run the
+	 * index is kept for the current frame only. The most recently used indices are kept,
+	 * so validators that also inspect parent or child Blueprints do not evict each other.
+	 *
+	 * @param Blueprint The Blueprint to index.
+	 * @return The shared graph index.
+	 */
+	TSharedRef<const FBlueprintGraphIndex> GetGraphIndex(UBlueprint* Blueprint);
+
+	/**
+	 * @brief Returns the snapshot of a Blueprint, capturing it on first use.
+	 *
+	 * Snapshots are cached alongside the graph index and follow the same lifetime rules.
+	 *
+	 * @param Blueprint The Blueprint to capture.
+	 * @return The shared snapshot.
+	 */
+	TSharedRef<const FBlueprintSnapshot> GetSnapshot(UBlueprint* Blueprint);
+
+	/**
+	 * @brief Returns the member variables declared and set by a Blueprint and its Blueprint parents.
+	 *
+	 * The summary of a Blueprint extends the one of its parent, which is computed first and cached
+	 * alongside its graph index, so Blueprints sharing a parent only walk it once.
+	 *
+	 * @param Blueprint The Blueprint to summarize.
+	 * @return The shared summary.
+	 */
+	TSharedRef<const FValidatorXVariableWrites> GetVariableWrites(UBlueprint* Blueprint);
+
+	/** @brief Drops every cached graph index and snapshot. */
+	void ResetGraphIndexCache();
+
+	/**
+	 * @brief Returns the registered validators that are currently enabled.
+	 *
+	 * @return The enabled validators, in registration order.
+	 */
+	TArray<UBlueprintValidatorBase*> GetEnabledValidators() const;
+
+	/**
+	 * @brief Validates many Blueprint assets in one run.
+	 *
+	 * Assets are processed in chunks: every asset of a chunk is loaded and captured into a snapshot
+	 * on the game thread, snapshot validators then analyze the whole chunk in parallel, and the
+	 * results are committed on the game thread in asset order, then validator order, so reports do
+	 * not depend on thread scheduling. Validators without snapshot support run on the game thread
+	 * during the commit phase.
+	 *
+	 * With the result cache enabled, validators whose cached result is still up to date are not run,
+	 * and assets answered entirely from the cache are not loaded.
+	 *
+	 * @param Assets The assets to validate. Assets that are not Blueprints are reported as not validated.
+	 * @param InValidators The validators to run.
+	 * @param OutReports Receives one report per asset, in the order of `Assets`.
+	 * @param Options Chunking and caching options.
+	 */
+	void ValidateAssets(TConstArrayView<FAssetData> Assets, TConstArrayView<UBlueprintValidatorBase*> InValidators, TArray<FValidatorXAssetReport>& OutReports, const FValidatorXBatchOptions& Options = FValidatorXBatchOptions());
+
+	/**
+	 * @brief Validates one chunk of a batch validation run; every asset of the chunk is loaded at the same time.
+	 *
+	 * Must be called within a validation run, see `BeginValidationRun`. With the result cache enabled,
+	 * the caller loads the cache before the first chunk and saves it after the last one.
+	 *
+	 * @param Assets The assets of the chunk.
+	 * @param InValidators The validators to run.
+	 * @param OutReports Receives one report per asset, appended in the order of `Assets`.
+	 * @param Options Caching options; the chunk size is ignored.
+	 */
+	void ValidateAssetChunk(TConstArrayView<FAssetData> Assets, TConstArrayView<UBlueprintValidatorBase*> InValidators, TArray<FValidatorXAssetReport>& OutReports, const FValidatorXBatchOptions& Options);
+
+	/**
+	 * @brief Starts validating assets in the background with the enabled validators.
+	 *
+	 * Only one job runs at a time: a job still in progress is cancelled.
+	 *
+	 * @param Assets The assets to validate.
+	 * @param Options Maximum slice size and caching options.
+	 * @return The started job.
+	 */
+	TSharedRef<FValidatorXValidationJob> StartValidationJob(TArray<FAssetData> Assets, const FValidatorXBatchOptions& Options = FValidatorXBatchOptions());
+
+	/**
+	 * @brief Returns the last started background validation job.
+	 *
+	 * @return The job, which may be running, finished or cancelled; null if none was started.
+	 */
+	TSharedPtr<FValidatorXValidationJob> GetValidationJob() const
+	{
+		return ValidationJob;
+	}
+
+	/**
+	 * @brief Finds the Blueprint assets under content paths, without loading them.
+	 *
+	 * @param PackagePaths The content paths to search recursively, e.g. "/Game/Characters".
+	 * @param OutAssets Receives the assets, sorted by package name.
+	 */
+	static void FindBlueprintAssets(TConstArrayView<FName> PackagePaths, TArray<FAssetData>& OutAssets);
+
+	/**
+	 * @brief Returns the persistent result cache used by `ValidateAssets`.
+	 *
+	 * @return The result cache.
+	 */
+	FValidatorXResultCache& GetResultCache()
+	{
+		return ResultCache;
+	}
+
+	/**
+	 * @brief Returns the Blueprint class hierarchy index, building it on first use.
+	 *
+	 * @return The hierarchy index, kept up to date from asset registry events.
+	 */
+	FBlueprintHierarchyIndex& GetHierarchyIndex();
+
+	/**
+	 * @brief Returns the memoized hierarchy of the Blueprint classes in memory.
+	 *
+	 * The hierarchy is shared by every validator of a validation run; outside of a run it is kept
+	 * for the current frame only. It is also reset after garbage collection and whenever a
+	 * Blueprint is compiled or reinstanced.
+	 *
+	 * @return The loaded class hierarchy.
+	 */
+	FLoadedClassHierarchy& GetLoadedClassHierarchy();
+
+	/**
+	 * @brief Returns the memoized hard reference footprint of packages, created for the given settings.
+	 *
+	 * The footprint is shared by every validator of a validation run, so packages referenced by
+	 * several Blueprints are only measured once; outside of a run it is kept for the current frame
+	 * only. It is created again whenever it is requested with different settings.
+	 *
+	 * @param bIncludeEngineContent Whether `/Engine` packages are part of footprints.
+	 * @param ClassSizeFactors Disk size multiplier per asset class name.
+	 * @return The hard reference footprint.
+	 */
+	FHardReferenceFootprint& GetHardReferenceFootprint(bool bIncludeEngineContent, const TMap<FName, float>& ClassSizeFactors);
+
+	/**
+	 * @brief Returns the project-wide function reference index, loading it on first use.
+	 *
+	 * Pending packages whose Blueprint has been loaded, compiled or saved are indexed first.
+	 *
+	 * @return The function reference index.
+	 */
+	FFunctionReferenceIndex& GetFunctionReferenceIndex();
+
+	/**
+	 * @brief Returns the live validation of Blueprints open in an editor.
+	 *
+	 * @return The live validation.
+	 */
+	FValidatorXLiveValidation& GetLiveValidation()
+	{
+		return LiveValidation;
+	}
+
+	/**
+	 * @brief Returns the per-validator execution counters of the editor session.
+	 *
+	 * @return The validator stats.
+	 */
+	FValidatorXStats& GetStats()
+	{
+		return Stats;
+	}
+
 private:
+	/** @brief Cached analysis data of a single Blueprint. */
+	struct FCachedBlueprint
+	{
+		TWeakObjectPtr<UBlueprint> Blueprint;
+		TSharedRef<const FBlueprintGraphIndex> GraphIndex;
+		TSharedPtr<const FBlueprintSnapshot> Snapshot;
+		TSharedPtr<const FValidatorXVariableWrites> VariableWrites;
+	};
+
+	/**
+	 * @brief Returns the cache entry of a Blueprint, creating it if needed, and moves it to the front.
+	 *
+	 * @param Blueprint The Blueprint to look up.
+	 * @return The cache entry, which stays valid until the cache is modified again.
+	 */
+	FCachedBlueprint& FindOrAddCachedBlueprint(UBlueprint* Blueprint);
+
 	/** @brief Array storing all registered validators as weak object pointers. */
 	TArray<TWeakObjectPtr<UBlueprintValidatorBase>> Validators;
+
+	/** @brief Maximum number of Blueprints kept in the cache at the same time. */
+	static constexpr int32 MaxCachedBlueprints = 32;
+
+	/** @brief Cached Blueprint analysis data, most recently used first. */
+	TArray<FCachedBlueprint> CachedBlueprints;
+
+	/** @brief Frame the cached graph indices were built on, used outside of validation runs. */
+	uint64 CachedGraphIndexFrame = 0;
+
+	/** @brief Memoized hierarchy of the loaded Blueprint classes. */
+	FLoadedClassHierarchy LoadedClassHierarchy;
+
+	/** @brief Frame the loaded class hierarchy was used on, used outside of validation runs. */
+	uint64 LoadedClassHierarchyFrame = 0;
+
+	/** @brief Memoized hard reference footprint of the current run. */
+	TOptional<FHardReferenceFootprint> HardReferenceFootprint;
+
+	/** @brief Frame the hard reference footprint was used on, used outside of validation runs. */
+	uint64 HardReferenceFootprintFrame = 0;
+
+	/** @brief Load-free Blueprint class hierarchy. */
+	FBlueprintHierarchyIndex HierarchyIndex;
+
+	/** @brief Project-wide reverse index of Blueprint function calls. */
+	FFunctionReferenceIndex FunctionReferenceIndex;
+
+	/** @brief Persistent validator results of unchanged assets. */
+	FValidatorXResultCache ResultCache;
+
+	/** @brief Incremental validation of Blueprints being edited. */
+	FValidatorXLiveValidation LiveValidation;
+
+	/** @brief Per-validator execution counters. */
+	FValidatorXStats Stats;
+
+	/** @brief Last started background validation job. */
+	TSharedPtr<FValidatorXValidationJob> ValidationJob;
+
+	/** @brief Number of validation runs currently in progress. */
+	int32 ValidationRunDepth = 0;
+
+	/** @brief Handles of the editor validation delegate bindings. */
+	FDelegateHandle PreAssetValidationHandle;
+	FDelegateHandle PostAssetValidationHandle;
+
+	/** @brief Handles of the bindings resetting the loaded class hierarchy. */
+	FDelegateHandle PostGarbageCollectHandle;
+	FDelegateHandle ObjectsReplacedHandle;
+	FDelegateHandle PostEngineInitHandle;
+	FDelegateHandle BlueprintCompiledHandle;
+	FDelegateHandle BlueprintReinstancedHandle;
 };
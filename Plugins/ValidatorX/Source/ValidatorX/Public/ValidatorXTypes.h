@@ -3,10 +3,192 @@
 #pragma once
 
 #include "CoreMinimal.h"
+#include "AssetRegistry/AssetData.h"
+#include "Logging/TokenizedMessage.h"
+#include "Misc/DataValidation.h"
 
 namespace ValidatorListColumns
 {
 	static const FName ColumnID_Type("Type");
 	static const FName ColumnID_Name("Name");
 	static const FName ColumnID_Button("Button");
+	static const FName ColumnID_Assets("Assets");
+	static const FName ColumnID_Messages("Messages");
+	static const FName ColumnID_TotalTime("TotalTime");
+	static const FName ColumnID_P50Time("P50Time");
+	static const FName ColumnID_P95Time("P95Time");
+	static const FName ColumnID_MaxTime("MaxTime");
 } // namespace ValidatorListColumns
+
+/**
+ * @brief A single issue found by snapshot analysis.
+ *
+ * Issues are produced off the game thread by `UBlueprintValidatorBase::AnalyzeSnapshot`, so they
+ * only hold plain data: the message is kept as a format pattern plus arguments and is formatted
+ * when the issue is committed, and the offending graph and node are referenced by name and guid.
+ */
+struct FValidatorXIssue
+{
+	FValidatorXIssue() = default;
+
+	FValidatorXIssue(EMessageSeverity::Type InSeverity, FTextFormat InFormat, FFormatOrderedArguments InArguments)
+		: Severity(InSeverity)
+		, Format(MoveTemp(InFormat))
+		, Arguments(MoveTemp(InArguments))
+	{
+	}
+
+	/** @return The formatted message text. */
+	FText GetMessage() const
+	{
+		return FText::Format(Format, Arguments);
+	}
+
+	/** @brief Severity of the issue. */
+	EMessageSeverity::Type Severity = EMessageSeverity::Warning;
+
+	/** @brief Message pattern. */
+	FTextFormat Format;
+
+	/** @brief Arguments of the message pattern. */
+	FFormatOrderedArguments Arguments;
+
+	/** @brief Name of the graph the issue was found in, if any. */
+	FName GraphName;
+
+	/** @brief Guid of the node the issue was found on, if any. */
+	FGuid NodeGuid;
+
+	/** @brief Validator specific subject of the issue, e.g. a variable or function name. */
+	FName Subject;
+};
+
+/**
+ * @brief Hash of the settings of a validator, folded into its cache version.
+ *
+ * Validators whose results depend on config settings add every setting, so editing one
+ * invalidates their cached results. FName hashes differ between sessions, so names are
+ * hashed as strings.
+ */
+struct FValidatorXSettingsHash
+{
+	/** @brief Adds a number or flag. */
+	template <typename ValueType>
+	FValidatorXSettingsHash& Add(ValueType Value)
+	{
+		Hash = HashCombine(Hash, GetTypeHash(Value));
+		return *this;
+	}
+
+	/** @brief Adds a name. */
+	FValidatorXSettingsHash& AddName(FName Name)
+	{
+		Hash = HashCombine(Hash, GetTypeHash(Name.ToString()));
+		return *this;
+	}
+
+	/** @brief Adds a list of names, in order. */
+	FValidatorXSettingsHash& AddNames(TConstArrayView<FName> Names)
+	{
+		for (const FName Name : Names)
+		{
+			AddName(Name);
+		}
+		return *this;
+	}
+
+	/** @brief Adds a map of values keyed by name, in map order. */
+	template <typename ValueType>
+	FValidatorXSettingsHash& AddNameMap(const TMap<FName, ValueType>& Map)
+	{
+		for (const TPair<FName, ValueType>& Pair : Map)
+		{
+			AddName(Pair.Key);
+			Add(Pair.Value);
+		}
+		return *this;
+	}
+
+	/**
+	 * @brief Returns the cache version of a validator with these settings.
+	 *
+	 * @param Version The version of the validator code, bumped when its results change.
+	 * @return The version combined with the settings hash.
+	 */
+	int32 GetCacheVersion(int32 Version) const
+	{
+		return static_cast<int32>(HashCombine(static_cast<uint32>(Version), Hash));
+	}
+
+	/** @brief The settings hash so far. */
+	uint32 Hash = 0;
+};
+
+/** @brief Member variables declared and set along a Blueprint class hierarchy, see `FValidatorXManager::GetVariableWrites`. */
+struct FValidatorXVariableWrites
+{
+	/** @brief Member variables declared by the Blueprint or one of its Blueprint parents. */
+	TSet<FName> Declared;
+
+	/** @brief Member variables set by a node of the Blueprint or one of its Blueprint parents. */
+	TSet<FName> Written;
+};
+
+/** @brief A message reported by one validator during a batch validation run. */
+struct FValidatorXMessage
+{
+	/** @brief Class name of the validator that reported the message. */
+	FName ValidatorName;
+
+	/** @brief The reported message, including its action tokens unless they were deferred. */
+	TSharedRef<FTokenizedMessage> Message;
+
+	/**
+	 * @brief The snapshot issue the message was committed from, if any.
+	 *
+	 * Lets the action tokens be created later with `UBlueprintValidatorBase::AddIssueTokens`,
+	 * see `FValidatorXBatchOptions::bDeferIssueTokens`.
+	 */
+	TSharedPtr<const FValidatorXIssue> Issue;
+
+	/**
+	 * @brief Appends the issues a validator added to a validation context.
+	 *
+	 * @param Context The validation context the validator reported to.
+	 * @param FirstIssue Index of the first issue added by the validator.
+	 * @param InValidatorName Class name of the validator.
+	 * @param OutMessages Receives one message per issue.
+	 */
+	VALIDATORX_API static void AppendFromContext(const FDataValidationContext& Context, int32 FirstIssue, FName InValidatorName, TArray<FValidatorXMessage>& OutMessages);
+};
+
+/** @brief Result of validating a single asset in a batch validation run. */
+struct FValidatorXAssetReport
+{
+	/** @brief The validated asset. */
+	FAssetData AssetData;
+
+	/** @brief Combined result of every validator that ran on the asset. */
+	EDataValidationResult Result = EDataValidationResult::NotValidated;
+
+	/** @brief Messages in validator order. */
+	TArray<FValidatorXMessage> Messages;
+};
+
+/** @brief Options of a batch validation run. */
+struct FValidatorXBatchOptions
+{
+	/** @brief Maximum number of assets loaded at the same time. */
+	int32 ChunkSize = 64;
+
+	/** @brief Whether unchanged assets are answered from the persistent result cache. */
+	bool bUseResultCache = true;
+
+	/**
+	 * @brief Whether snapshot issues are committed without their jump and fix action tokens.
+	 *
+	 * The tokens capture the Blueprint and are costly to create for every issue of a large run,
+	 * so consumers listing many results create them on demand from `FValidatorXMessage::Issue`.
+	 */
+	bool bDeferIssueTokens = false;
+};
@@ -47,10 +47,58 @@ public:
 	 */
 	virtual EDataValidationResult ValidateLoadedAsset_Implementation(const FAssetData& InAssetData, UObject* InAsset, FDataValidationContext& Context) override;
 
+	/**
+	 * Reports whether this validator implements snapshot analysis.
+	 * Following external calls needs the snapshots of other Blueprints, captured on the game thread.
+	 *
+	 * @return True unless external calls are followed
+	 */
+	virtual bool SupportsSnapshotAnalysis() const override { return !bFollowExternalCalls; }
+
+	/**
+	 * Analyzes a Blueprint snapshot. Safe to call from any thread.
+	 *
+	 * @param Snapshot      Snapshot of the validated Blueprint
+	 * @param OutIssues     Receives the issues found
+	 */
+	virtual void AnalyzeSnapshot(const FBlueprintSnapshot& Snapshot, TArray<FValidatorXIssue>& OutIssues) const override;
+
+	/**
+	 * Adds the jump and fix tokens of a committed issue.
+	 *
+	 * @param Blueprint     The validated Blueprint
+	 * @param Issue         The committed issue
+	 * @param Message       The message the issue was committed as
+	 */
+	virtual void AddIssueTokens(UBlueprint* Blueprint, const FValidatorXIssue& Issue, const TSharedRef<FTokenizedMessage>& Message) const override;
+
+	/**
+	 * Reports that results depend on the called Blueprints when external calls are followed.
+	 *
+	 * @return True if external calls are followed
+	 */
+	virtual bool DependsOnReferencedBlueprints() const override { return bFollowExternalCalls; }
+
+	/**
+	 * Returns the version of cached results, bumped when every cycle group started being reported.
+	 *
+	 * @return The cache version
+	 */
+	virtual int32 GetCacheVersion() const override { return 2; }
+
+	/** Whether calls into functions of other Blueprints and macro libraries are followed. Only loaded Blueprints are followed. */
+	UPROPERTY(Config, EditAnywhere, Category = "Circular Dependency")
+	bool bFollowExternalCalls = false;
 
 private:
-	bool HasCircularDependency(UBlueprint* Blueprint, FDataValidationContext& Context);
-	bool DetectCycle(const FName& StartName, TMap<FName, TArray<FName>>& GraphMap, TSet<FName>& Visited, TSet<FName>& Stack, TArray<FName>& OutCyclePath);
-	UEdGraph* FindGraphByName(UBlueprint* Blueprint, const FName& GraphName);
+	/**
+	 * Reports every group of functions and macros calling each other, in O(graphs + calls).
+	 *
+	 * @param Snapshots     The validated Blueprint first, then the Blueprints it calls into
+	 * @param OutIssues     Receives one issue per cycle group involving the validated Blueprint
+	 */
+	static void AnalyzeCallGraph(TConstArrayView<const FBlueprintSnapshot*> Snapshots, TArray<FValidatorXIssue>& OutIssues);
+
+	UEdGraph* FindGraphByName(UBlueprint* Blueprint, const FName& GraphName) const;
 
 };
@@ -6,6 +6,8 @@
 #include "BaseClasses/BlueprintValidatorBase.h"
 #include "DeadBranchValidator.generated.h"
 
+struct FValidatorXVariableWrites;
+
 /**
  * 
  */
@@ -58,4 +60,43 @@ public:
 	 */
 	virtual EDataValidationResult ValidateLoadedAsset_Implementation(const FAssetData& InAssetData, UObject* InAsset, FDataValidationContext& Context) override;
 
+	/**
+	 * Adds the jump and fix tokens of a committed issue.
+	 *
+	 * @param Blueprint     The validated Blueprint
+	 * @param Issue         The committed issue
+	 * @param Message       The message the issue was committed as
+	 */
+	virtual void AddIssueTokens(UBlueprint* Blueprint, const FValidatorXIssue& Issue, const TSharedRef<FTokenizedMessage>& Message) const override;
+
+	/**
+	 * Deletes the Branch node of an issue.
+	 *
+	 * @param Blueprint     The validated Blueprint
+	 * @param Issue         The issue to fix
+	 * @return              True if the Blueprint was modified
+	 */
+	virtual bool ApplyIssueFix(UBlueprint* Blueprint, const FValidatorXIssue& Issue) const override;
+
+	/**
+	 * Returns the version of cached results, bumped when conditions started being constant folded
+	 * and when folding was limited to boolean and numeric types.
+	 *
+	 * @return The cache version
+	 */
+	virtual int32 GetCacheVersion() const override { return 3; }
+
+private:
+	/**
+	 * Finds the dead branches of a Blueprint snapshot.
+	 *
+	 * Conditions are constant folded (see FBlueprintConstantFolder); member variables are constant
+	 * when this Blueprint or a Blueprint parent declares them and none of them sets them.
+	 *
+	 * @param Snapshot        Snapshot of the validated Blueprint
+	 * @param VariableWrites  Variables declared and set along the Blueprint class hierarchy
+	 * @param OutIssues       Receives the issues found
+	 */
+	static void FindDeadBranches(const FBlueprintSnapshot& Snapshot, const FValidatorXVariableWrites& VariableWrites, TArray<FValidatorXIssue>& OutIssues);
+
 };
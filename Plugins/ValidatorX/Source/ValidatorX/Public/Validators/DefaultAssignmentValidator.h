@@ -57,4 +57,35 @@ public:
 	 */
 	virtual EDataValidationResult ValidateLoadedAsset_Implementation(const FAssetData& InAssetData, UObject* InAsset, FDataValidationContext& Context) override;
 
+	/**
+	 * Reports that this validator implements snapshot analysis.
+	 *
+	 * @return Always true
+	 */
+	virtual bool SupportsSnapshotAnalysis() const override { return true; }
+
+	/**
+	 * Reports that every issue only depends on the graph it is reported in.
+	 *
+	 * @return Always true
+	 */
+	virtual bool IsGraphLocal() const override { return true; }
+
+	/**
+	 * Analyzes a Blueprint snapshot. Safe to call from any thread.
+	 *
+	 * @param Snapshot      Snapshot of the validated Blueprint
+	 * @param OutIssues     Receives the issues found
+	 */
+	virtual void AnalyzeSnapshot(const FBlueprintSnapshot& Snapshot, TArray<FValidatorXIssue>& OutIssues) const override;
+
+	/**
+	 * Adds the jump and fix tokens of a committed issue.
+	 *
+	 * @param Blueprint     The validated Blueprint
+	 * @param Issue         The committed issue
+	 * @param Message       The message the issue was committed as
+	 */
+	virtual void AddIssueTokens(UBlueprint* Blueprint, const FValidatorXIssue& Issue, const TSharedRef<FTokenizedMessage>& Message) const override;
+
 };
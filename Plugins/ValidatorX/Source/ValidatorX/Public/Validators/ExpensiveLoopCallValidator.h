@@ -0,0 +1,102 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "BaseClasses/BlueprintValidatorBase.h"
+#include "ExpensiveLoopCallValidator.generated.h"
+
+/**
+ * Finds expensive calls run once per iteration of a loop.
+ *
+ * The bodies of the ForEachLoop, ForLoop and WhileLoop macros are extracted once per snapshot by
+ * `FLoopBodyIndex`. World queries, spawning and destroying actors or widgets, adding components and blocking
+ * loads inside a body are reported, and so are loops nested in other loops.
+ */
+UCLASS()
+class VALIDATORX_API UExpensiveLoopCallValidator : public UBlueprintValidatorBase
+{
+	GENERATED_BODY()
+
+public:
+	UExpensiveLoopCallValidator();
+
+	virtual void SetValidationEnabled(bool bEnabled) override
+	{
+		static UExpensiveLoopCallValidator* CDO = GetMutableDefault<UExpensiveLoopCallValidator>();
+		if(bIsConfigDisabled)
+		{
+			UE_LOG(LogTemp, Warning, TEXT("Validator is disabled by config!"));
+			return;
+		}
+
+		CDO->bIsEnabled = bEnabled;
+		SaveConfig();
+	}
+
+	/**
+	 * Checks if the validator is currently enabled.
+	 *
+	 * @return True if validation is active
+	 */
+	virtual bool IsEnabled() const override;
+
+	/**
+	 * Checks whether this validator can validate the given asset.
+	 *
+	 * @param InAssetData   Asset metadata (path, type, etc.)
+	 * @param InObject      Loaded asset object (null if not loaded)
+	 * @param InContext     Validation context for error/warning accumulation
+	 * @return True if this validator should process the asset
+	 */
+	virtual bool CanValidateAsset_Implementation(const FAssetData& InAssetData, UObject* InAsset, FDataValidationContext& InContext) const override;
+
+	/**
+	 * Performs validation on a loaded asset.
+	 *
+	 * @param InAssetData   Asset metadata
+	 * @param InAsset       Loaded asset object
+	 * @param Context       Validation context for reporting issues
+	 * @return EDataValidationResult::Passed if valid, Failed/Invalid otherwise
+	 */
+	virtual EDataValidationResult ValidateLoadedAsset_Implementation(const FAssetData& InAssetData, UObject* InAsset, FDataValidationContext& Context) override;
+
+	/**
+	 * Reports that this validator implements snapshot analysis.
+	 *
+	 * @return Always true
+	 */
+	virtual bool SupportsSnapshotAnalysis() const override { return true; }
+
+	/**
+	 * Reports that every issue only depends on the graph it is reported in.
+	 *
+	 * @return Always true
+	 */
+	virtual bool IsGraphLocal() const override { return true; }
+
+	/**
+	 * Analyzes a Blueprint snapshot. Safe to call from any thread.
+	 *
+	 * @param Snapshot      Snapshot of the validated Blueprint
+	 * @param OutIssues     Receives the issues found
+	 */
+	virtual void AnalyzeSnapshot(const FBlueprintSnapshot& Snapshot, TArray<FValidatorXIssue>& OutIssues) const override;
+
+	/**
+	 * Adds the jump tokens of a committed issue.
+	 *
+	 * @param Blueprint     The validated Blueprint
+	 * @param Issue         The committed issue
+	 * @param Message       The message the issue was committed as
+	 */
+	virtual void AddIssueTokens(UBlueprint* Blueprint, const FValidatorXIssue& Issue, const TSharedRef<FTokenizedMessage>& Message) const override;
+
+	/**
+	 * Returns the version of cached results, bumped when creating widgets started being reported.
+	 *
+	 * @return The cache version
+	 */
+	virtual int32 GetCacheVersion() const override { return 2; }
+
+};
@@ -58,4 +58,64 @@ public:
 	 */
 	virtual EDataValidationResult ValidateLoadedAsset_Implementation(const FAssetData& InAssetData, UObject* InAsset, FDataValidationContext& Context) override;
 
+	/**
+	 * Reports that this validator implements snapshot analysis.
+	 *
+	 * @return Always true
+	 */
+	virtual bool SupportsSnapshotAnalysis() const override { return true; }
+
+	/**
+	 * Analyzes a Blueprint snapshot. Safe to call from any thread.
+	 *
+	 * @param Snapshot      Snapshot of the validated Blueprint
+	 * @param OutIssues     Receives the issues found
+	 */
+	virtual void AnalyzeSnapshot(const FBlueprintSnapshot& Snapshot, TArray<FValidatorXIssue>& OutIssues) const override;
+
+	/**
+	 * Discards public variables that a Blueprint deriving from the validated one reads.
+	 *
+	 * The derived Blueprints are found through the asset registry and loaded if needed.
+	 *
+	 * @param Blueprint     The validated Blueprint
+	 * @param Issue         The issue about to be committed
+	 * @return              False if a derived Blueprint reads the variable
+	 */
+	virtual bool ConfirmIssue(UBlueprint* Blueprint, const FValidatorXIssue& Issue) const override;
+
+	/**
+	 * Adds the jump and fix tokens of a committed issue.
+	 *
+	 * @param Blueprint     The validated Blueprint
+	 * @param Issue         The committed issue
+	 * @param Message       The message the issue was committed as
+	 */
+	virtual void AddIssueTokens(UBlueprint* Blueprint, const FValidatorXIssue& Issue, const TSharedRef<FTokenizedMessage>& Message) const override;
+
+	/**
+	 * Deletes the variable of an issue, unless a node still references it.
+	 *
+	 * @param Blueprint     The validated Blueprint
+	 * @param Issue         The issue to fix
+	 * @return              True if the Blueprint was modified
+	 */
+	virtual bool ApplyIssueFix(UBlueprint* Blueprint, const FValidatorXIssue& Issue) const override;
+
+	/**
+	 * Returns the version of cached results, bumped when variables that are only set started being reported
+	 * and when reads by derived Blueprints and the access specifier started being considered, and again
+	 * when derived Blueprints started being looked up through the asset registry.
+	 *
+	 * @return The cache version
+	 */
+	virtual int32 GetCacheVersion() const override { return 4; }
+
+	/**
+	 * Reports that results depend on the graphs of derived Blueprints, which may read the variables.
+	 *
+	 * @return Always true
+	 */
+	virtual bool DependsOnDerivedBlueprints() const override { return true; }
+
 };
@@ -0,0 +1,104 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "BaseClasses/BlueprintValidatorBase.h"
+#include "HardReferenceFootprintValidator.generated.h"
+
+/**
+ * Checks the memory a Blueprint pulls in through hard references.
+ *
+ * The transitive hard dependencies of the Blueprint package are read from the asset registry
+ * (see FHardReferenceFootprint), without loading them, and their sizes summed. Blueprints over
+ * budget are reported together with the direct references pulling in the biggest subtrees, and the
+ * nodes, variables and components creating them, so they can be made soft references or interfaces.
+ */
+UCLASS()
+class VALIDATORX_API UHardReferenceFootprintValidator : public UBlueprintValidatorBase
+{
+	GENERATED_BODY()
+
+public:
+	UHardReferenceFootprintValidator();
+
+	virtual void SetValidationEnabled(bool bEnabled) override
+	{
+		static UHardReferenceFootprintValidator* CDO = GetMutableDefault<UHardReferenceFootprintValidator>();
+		if(bIsConfigDisabled)
+		{
+			UE_LOG(LogTemp, Warning, TEXT("Validator is disabled by config!"));
+			return;
+		}
+
+		CDO->bIsEnabled = bEnabled;
+		SaveConfig();
+	}
+
+	/**
+	 * Checks if the validator is currently enabled.
+	 *
+	 * @return True if validation is active
+	 */
+	virtual bool IsEnabled() const override;
+
+	/**
+	 * Checks whether this validator can validate the given asset.
+	 *
+	 * @param InAssetData   Asset metadata (path, type, etc.)
+	 * @param InObject      Loaded asset object (null if not loaded)
+	 * @param InContext     Validation context for error/warning accumulation
+	 * @return True if this validator should process the asset
+	 */
+	virtual bool CanValidateAsset_Implementation(const FAssetData& InAssetData, UObject* InAsset, FDataValidationContext& InContext) const override;
+
+	/**
+	 * Performs validation on a loaded asset.
+	 *
+	 * @param InAssetData   Asset metadata
+	 * @param InAsset       Loaded asset object
+	 * @param Context       Validation context for reporting issues
+	 * @return EDataValidationResult::Passed if valid, Failed/Invalid otherwise
+	 */
+	virtual EDataValidationResult ValidateLoadedAsset_Implementation(const FAssetData& InAssetData, UObject* InAsset, FDataValidationContext& Context) override;
+
+	/**
+	 * Adds the jump tokens of a committed issue.
+	 *
+	 * @param Blueprint     The validated Blueprint
+	 * @param Issue         The committed issue
+	 * @param Message       The message the issue was committed as
+	 */
+	virtual void AddIssueTokens(UBlueprint* Blueprint, const FValidatorXIssue& Issue, const TSharedRef<FTokenizedMessage>& Message) const override;
+
+	/**
+	 * Reports that results depend on every package loaded with the Blueprint.
+	 *
+	 * @return Always true
+	 */
+	virtual bool DependsOnHardReferencedAssets() const override { return true; }
+
+	/**
+	 * Returns the version of cached results, which also covers the budget and size settings.
+	 *
+	 * @return The cache version
+	 */
+	virtual int32 GetCacheVersion() const override;
+
+	/** Highest estimated memory, in megabytes, of a Blueprint and everything it hard references. */
+	UPROPERTY(Config, EditAnywhere, Category = "Hard Reference Footprint", meta = (ClampMin = "0"))
+	float FootprintBudgetMegabytes = 200.0f;
+
+	/** Number of direct references with the biggest footprints reported for a Blueprint over budget. */
+	UPROPERTY(Config, EditAnywhere, Category = "Hard Reference Footprint", meta = (ClampMin = "0"))
+	int32 MaxReportedReferences = 5;
+
+	/** Whether engine content counts towards footprints; it is usually loaded anyway. */
+	UPROPERTY(Config, EditAnywhere, Category = "Hard Reference Footprint")
+	bool bIncludeEngineContent = false;
+
+	/** Disk size multiplier per asset class name, used to estimate memory when no registry tag tells it. */
+	UPROPERTY(Config, EditAnywhere, Category = "Hard Reference Footprint")
+	TMap<FName, float> ClassSizeFactors;
+
+};
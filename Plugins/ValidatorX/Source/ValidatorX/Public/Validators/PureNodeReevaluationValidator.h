@@ -0,0 +1,126 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "BaseClasses/BlueprintValidatorBase.h"
+#include "PureNodeReevaluationValidator.generated.h"
+
+/**
+ * Finds expensive pure calls evaluated several times.
+ *
+ * A pure node has no execution pins: it is evaluated again by every impure node reading its
+ * result, directly or through other pure nodes, and by every iteration of a loop whose body reads
+ * it. Only consumers reachable along execution flow (see FExecReachability) are counted. The fix
+ * evaluates the call once, right before the reader that runs first, and reads a local variable instead.
+ */
+UCLASS()
+class VALIDATORX_API UPureNodeReevaluationValidator : public UBlueprintValidatorBase
+{
+	GENERATED_BODY()
+
+public:
+	UPureNodeReevaluationValidator();
+
+	virtual void SetValidationEnabled(bool bEnabled) override
+	{
+		static UPureNodeReevaluationValidator* CDO = GetMutableDefault<UPureNodeReevaluationValidator>();
+		if(bIsConfigDisabled)
+		{
+			UE_LOG(LogTemp, Warning, TEXT("Validator is disabled by config!"));
+			return;
+		}
+
+		CDO->bIsEnabled = bEnabled;
+		SaveConfig();
+	}
+
+	/**
+	 * Checks if the validator is currently enabled.
+	 *
+	 * @return True if validation is active
+	 */
+	virtual bool IsEnabled() const override;
+
+	/**
+	 * Checks whether this validator can validate the given asset.
+	 *
+	 * @param InAssetData   Asset metadata (path, type, etc.)
+	 * @param InObject      Loaded asset object (null if not loaded)
+	 * @param InContext     Validation context for error/warning accumulation
+	 * @return True if this validator should process the asset
+	 */
+	virtual bool CanValidateAsset_Implementation(const FAssetData& InAssetData, UObject* InAsset, FDataValidationContext& InContext) const override;
+
+	/**
+	 * Performs validation on a loaded asset.
+	 *
+	 * @param InAssetData   Asset metadata
+	 * @param InAsset       Loaded asset object
+	 * @param Context       Validation context for reporting issues
+	 * @return EDataValidationResult::Passed if valid, Failed/Invalid otherwise
+	 */
+	virtual EDataValidationResult ValidateLoadedAsset_Implementation(const FAssetData& InAssetData, UObject* InAsset, FDataValidationContext& Context) override;
+
+	/**
+	 * Reports that this validator implements snapshot analysis.
+	 *
+	 * @return Always true
+	 */
+	virtual bool SupportsSnapshotAnalysis() const override { return true; }
+
+	/**
+	 * Reports that every issue only depends on the graph it is reported in.
+	 *
+	 * @return Always true
+	 */
+	virtual bool IsGraphLocal() const override { return true; }
+
+	/**
+	 * Analyzes a Blueprint snapshot. Safe to call from any thread.
+	 *
+	 * @param Snapshot      Snapshot of the validated Blueprint
+	 * @param OutIssues     Receives the issues found
+	 */
+	virtual void AnalyzeSnapshot(const FBlueprintSnapshot& Snapshot, TArray<FValidatorXIssue>& OutIssues) const override;
+
+	/**
+	 * Adds the jump and fix tokens of a committed issue.
+	 *
+	 * @param Blueprint     The validated Blueprint
+	 * @param Issue         The committed issue
+	 * @param Message       The message the issue was committed as
+	 */
+	virtual void AddIssueTokens(UBlueprint* Blueprint, const FValidatorXIssue& Issue, const TSharedRef<FTokenizedMessage>& Message) const override;
+
+	/**
+	 * Stores the result of the pure node of an issue in a new local variable, set right before the
+	 * impure node reading it first, and reads the variable instead of the node everywhere it was linked.
+	 * Only applies in functions, when one reader runs on every execution path to the others.
+	 *
+	 * @param Blueprint     The validated Blueprint
+	 * @param Issue         The issue to fix
+	 * @return              True if the Blueprint was modified
+	 */
+	virtual bool ApplyIssueFix(UBlueprint* Blueprint, const FValidatorXIssue& Issue) const override;
+
+	/**
+	 * Returns the version of cached results, which also covers the list of expensive functions.
+	 *
+	 * @return The cache version
+	 */
+	virtual int32 GetCacheVersion() const override;
+
+	/** Pure functions expensive enough to be reported when they are evaluated several times. */
+	UPROPERTY(Config, EditAnywhere, Category = "Pure Node Re-evaluation")
+	TArray<FName> ExpensivePureFunctions;
+
+	/** Whether the pure functions of the validated Blueprint are expensive, as they run a whole graph on every evaluation. */
+	UPROPERTY(Config, EditAnywhere, Category = "Pure Node Re-evaluation")
+	bool bIncludeBlueprintPureFunctions = true;
+
+	/** Number of evaluations from which an expensive pure node is reported. */
+	UPROPERTY(Config, EditAnywhere, Category = "Pure Node Re-evaluation", meta = (ClampMin = "2"))
+	int32 MinEvaluations = 2;
+
+};
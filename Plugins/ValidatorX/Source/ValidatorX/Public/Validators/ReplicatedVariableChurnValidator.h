@@ -0,0 +1,138 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "BaseClasses/BlueprintValidatorBase.h"
+#include "ReplicatedVariableChurnValidator.generated.h"
+
+struct FBlueprintSnapshotVariable;
+
+/**
+ * Estimates the network bandwidth spent on replicated variables that change all the time.
+ *
+ * The execution chains of the events run every frame and of the events and functions run by looping
+ * timers are walked forward, into the functions and custom events of the Blueprint they call, and
+ * every Set node of a replicated member variable on them is weighed with the size of the generated
+ * property. Variables set faster than the threshold below are reported with the Blueprint's upper
+ * bound in bytes per second, and so are large replicated structs and arrays.
+ */
+UCLASS()
+class VALIDATORX_API UReplicatedVariableChurnValidator : public UBlueprintValidatorBase
+{
+	GENERATED_BODY()
+
+public:
+	UReplicatedVariableChurnValidator();
+
+	virtual void SetValidationEnabled(bool bEnabled) override
+	{
+		static UReplicatedVariableChurnValidator* CDO = GetMutableDefault<UReplicatedVariableChurnValidator>();
+		if(bIsConfigDisabled)
+		{
+			UE_LOG(LogTemp, Warning, TEXT("Validator is disabled by config!"));
+			return;
+		}
+
+		CDO->bIsEnabled = bEnabled;
+		SaveConfig();
+	}
+
+	/**
+	 * Checks if the validator is currently enabled.
+	 *
+	 * @return True if validation is active
+	 */
+	virtual bool IsEnabled() const override;
+
+	/**
+	 * Checks whether this validator can validate the given asset.
+	 *
+	 * @param InAssetData   Asset metadata (path, type, etc.)
+	 * @param InObject      Loaded asset object (null if not loaded)
+	 * @param InContext     Validation context for error/warning accumulation
+	 * @return True if this validator should process the asset
+	 */
+	virtual bool CanValidateAsset_Implementation(const FAssetData& InAssetData, UObject* InAsset, FDataValidationContext& InContext) const override;
+
+	/**
+	 * Performs validation on a loaded asset.
+	 *
+	 * @param InAssetData   Asset metadata
+	 * @param InAsset       Loaded asset object
+	 * @param Context       Validation context for reporting issues
+	 * @return EDataValidationResult::Passed if valid, Failed/Invalid otherwise
+	 */
+	virtual EDataValidationResult ValidateLoadedAsset_Implementation(const FAssetData& InAssetData, UObject* InAsset, FDataValidationContext& Context) override;
+
+	/**
+	 * Reports that this validator implements snapshot analysis.
+	 *
+	 * @return Always true
+	 */
+	virtual bool SupportsSnapshotAnalysis() const override { return true; }
+
+	/**
+	 * Analyzes a Blueprint snapshot. Safe to call from any thread.
+	 *
+	 * @param Snapshot      Snapshot of the validated Blueprint
+	 * @param OutIssues     Receives the issues found
+	 */
+	virtual void AnalyzeSnapshot(const FBlueprintSnapshot& Snapshot, TArray<FValidatorXIssue>& OutIssues) const override;
+
+	/**
+	 * Adds the jump tokens of a committed issue.
+	 *
+	 * @param Blueprint     The validated Blueprint
+	 * @param Issue         The committed issue
+	 * @param Message       The message the issue was committed as
+	 */
+	virtual void AddIssueTokens(UBlueprint* Blueprint, const FValidatorXIssue& Issue, const TSharedRef<FTokenizedMessage>& Message) const override;
+
+	/**
+	 * Returns the version of cached results, which also covers the rates and sizes below.
+	 *
+	 * @return The cache version
+	 */
+	virtual int32 GetCacheVersion() const override;
+
+	/** Events run every frame on the server, keyed by event function name or by node class name. */
+	UPROPERTY(Config, EditAnywhere, Category = "Replication")
+	TArray<FName> EveryFrameEvents;
+
+	/** Highest number of times a second a changed variable is sent: the server tick rate, or the net update frequency if lower. */
+	UPROPERTY(Config, EditAnywhere, Category = "Replication", meta = (ClampMin = "0.1"))
+	float MaxNetUpdateRate = 30.0f;
+
+	/** Number of times a second from which a replicated variable is reported as set too often. */
+	UPROPERTY(Config, EditAnywhere, Category = "Replication", meta = (ClampMin = "0"))
+	float MinChurnRate = 2.0f;
+
+	/** Number of elements an array is assumed to hold when its class default value holds fewer. */
+	UPROPERTY(Config, EditAnywhere, Category = "Replication", meta = (ClampMin = "1"))
+	int32 AssumedArrayLength = 8;
+
+	/** Size in bytes from which a replicated struct or array is reported as large. */
+	UPROPERTY(Config, EditAnywhere, Category = "Replication", meta = (ClampMin = "1"))
+	int32 LargeValueSize = 256;
+
+private:
+	/**
+	 * Returns the rate of every entry point of the snapshot run often: events run every frame and
+	 * the events and functions bound to looping timers.
+	 *
+	 * @param Snapshot      Snapshot of the validated Blueprint
+	 * @param Events        Event nodes of the snapshot keyed by function name
+	 * @param OutRates      Receives the number of runs a second of each node, zero for nodes that are not such entry points
+	 */
+	void CollectEntryRates(const FBlueprintSnapshot& Snapshot, const TMap<FName, int32>& Events, TArray<float>& OutRates) const;
+
+	/**
+	 * Returns the estimated size of one update of a variable.
+	 *
+	 * @param Variable      The snapshot variable
+	 * @return The size in bytes, zero if the variable has no property yet
+	 */
+	int64 GetValueSize(const FBlueprintSnapshotVariable& Variable) const;
+
+};
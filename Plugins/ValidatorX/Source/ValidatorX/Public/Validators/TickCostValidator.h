@@ -0,0 +1,133 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "BaseClasses/BlueprintValidatorBase.h"
+#include "TickCostValidator.generated.h"
+
+/**
+ * Scores the work done every frame by the Tick events of a Blueprint.
+ *
+ * The execution chain of every Tick event is walked forward, together with the pure nodes feeding
+ * it, and each node is scored with the cost table below. Chains over budget are reported, and so
+ * are the nodes that should rarely run every frame (see ClassifyCostlyNode): world queries, traces,
+ * spawning and destroying, adding components, blocking loads, string formatting and chains of casts.
+ */
+UCLASS()
+class VALIDATORX_API UTickCostValidator : public UBlueprintValidatorBase
+{
+	GENERATED_BODY()
+
+public:
+	UTickCostValidator();
+
+	virtual void SetValidationEnabled(bool bEnabled) override
+	{
+		static UTickCostValidator* CDO = GetMutableDefault<UTickCostValidator>();
+		if(bIsConfigDisabled)
+		{
+			UE_LOG(LogTemp, Warning, TEXT("Validator is disabled by config!"));
+			return;
+		}
+
+		CDO->bIsEnabled = bEnabled;
+		SaveConfig();
+	}
+
+	/**
+	 * Checks if the validator is currently enabled.
+	 *
+	 * @return True if validation is active
+	 */
+	virtual bool IsEnabled() const override;
+
+	/**
+	 * Checks whether this validator can validate the given asset.
+	 *
+	 * @param InAssetData   Asset metadata (path, type, etc.)
+	 * @param InObject      Loaded asset object (null if not loaded)
+	 * @param InContext     Validation context for error/warning accumulation
+	 * @return True if this validator should process the asset
+	 */
+	virtual bool CanValidateAsset_Implementation(const FAssetData& InAssetData, UObject* InAsset, FDataValidationContext& InContext) const override;
+
+	/**
+	 * Performs validation on a loaded asset.
+	 *
+	 * @param InAssetData   Asset metadata
+	 * @param InAsset       Loaded asset object
+	 * @param Context       Validation context for reporting issues
+	 * @return EDataValidationResult::Passed if valid, Failed/Invalid otherwise
+	 */
+	virtual EDataValidationResult ValidateLoadedAsset_Implementation(const FAssetData& InAssetData, UObject* InAsset, FDataValidationContext& Context) override;
+
+	/**
+	 * Reports that this validator implements snapshot analysis.
+	 *
+	 * @return Always true
+	 */
+	virtual bool SupportsSnapshotAnalysis() const override { return true; }
+
+	/**
+	 * Reports that every issue only depends on the graph it is reported in.
+	 *
+	 * @return Always true
+	 */
+	virtual bool IsGraphLocal() const override { return true; }
+
+	/**
+	 * Analyzes a Blueprint snapshot. Safe to call from any thread.
+	 *
+	 * @param Snapshot      Snapshot of the validated Blueprint
+	 * @param OutIssues     Receives the issues found
+	 */
+	virtual void AnalyzeSnapshot(const FBlueprintSnapshot& Snapshot, TArray<FValidatorXIssue>& OutIssues) const override;
+
+	/**
+	 * Adds the jump tokens of a committed issue.
+	 *
+	 * @param Blueprint     The validated Blueprint
+	 * @param Issue         The committed issue
+	 * @param Message       The message the issue was committed as
+	 */
+	virtual void AddIssueTokens(UBlueprint* Blueprint, const FValidatorXIssue& Issue, const TSharedRef<FTokenizedMessage>& Message) const override;
+
+	/**
+	 * Returns the version of cached results, which also covers the budget and cost table.
+	 *
+	 * @return The cache version
+	 */
+	virtual int32 GetCacheVersion() const override;
+
+	/** Names of the events run every frame: ReceiveTick for actors and components, Tick for widgets. */
+	UPROPERTY(Config, EditAnywhere, Category = "Tick Cost")
+	TArray<FName> TickEventNames;
+
+	/** Highest total cost of the nodes run by a Tick event before it is reported. */
+	UPROPERTY(Config, EditAnywhere, Category = "Tick Cost", meta = (ClampMin = "0"))
+	float TickCostBudget = 40.0f;
+
+	/** Cost of a node missing from the cost table. One is a simple node such as a math operation. */
+	UPROPERTY(Config, EditAnywhere, Category = "Tick Cost", meta = (ClampMin = "0"))
+	float DefaultNodeCost = 1.0f;
+
+	/** Cost of a node, keyed by the called function or macro name first and by the node class name otherwise. */
+	UPROPERTY(Config, EditAnywhere, Category = "Tick Cost")
+	TMap<FName, float> NodeCosts;
+
+	/** Number of casts run by a Tick event from which they are reported as a chain. */
+	UPROPERTY(Config, EditAnywhere, Category = "Tick Cost", meta = (ClampMin = "1"))
+	int32 CastChainLength = 3;
+
+private:
+	/**
+	 * Returns the cost of a node from the cost table.
+	 *
+	 * @param Snapshot      Snapshot of the validated Blueprint
+	 * @param NodeIndex     Index of the node in the snapshot
+	 * @return The cost of one run of the node
+	 */
+	float GetNodeCost(const FBlueprintSnapshot& Snapshot, int32 NodeIndex) const;
+
+};
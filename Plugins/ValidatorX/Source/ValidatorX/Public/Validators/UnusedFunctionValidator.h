@@ -57,4 +57,68 @@ public:
 	 */
 	virtual EDataValidationResult ValidateLoadedAsset_Implementation(const FAssetData& InAssetData, UObject* InAsset, FDataValidationContext& Context) override;
 
+	/**
+	 * Reports that this validator implements snapshot analysis.
+	 *
+	 * @return Always true
+	 */
+	virtual bool SupportsSnapshotAnalysis() const override { return true; }
+
+	/**
+	 * Analyzes a Blueprint snapshot. Safe to call from any thread.
+	 *
+	 * @param Snapshot      Snapshot of the validated Blueprint
+	 * @param OutIssues     Receives the issues found
+	 */
+	virtual void AnalyzeSnapshot(const FBlueprintSnapshot& Snapshot, TArray<FValidatorXIssue>& OutIssues) const override;
+
+	/**
+	 * Adds the jump and fix tokens of a committed issue.
+	 *
+	 * @param Blueprint     The validated Blueprint
+	 * @param Issue         The committed issue
+	 * @param Message       The message the issue was committed as
+	 */
+	virtual void AddIssueTokens(UBlueprint* Blueprint, const FValidatorXIssue& Issue, const TSharedRef<FTokenizedMessage>& Message) const override;
+
+	/**
+	 * Deletes the unused function of an issue.
+	 *
+	 * @param Blueprint     The validated Blueprint
+	 * @param Issue         The issue to fix
+	 * @return              True if the Blueprint was modified
+	 */
+	virtual bool ApplyIssueFix(UBlueprint* Blueprint, const FValidatorXIssue& Issue) const override;
+
+	/**
+	 * Discards unused function issues for functions called from other Blueprints.
+	 * Uses the project-wide function reference index when it is complete, child Blueprints otherwise.
+	 *
+	 * @param Blueprint     The validated Blueprint
+	 * @param Issue         The issue about to be committed
+	 * @return False if another Blueprint calls the function, or it may be called from C++
+	 */
+	virtual bool ConfirmIssue(UBlueprint* Blueprint, const FValidatorXIssue& Issue) const override;
+
+	/**
+	 * Reports that results depend on child Blueprints, which may call the checked functions.
+	 *
+	 * @return Always true
+	 */
+	virtual bool DependsOnDerivedBlueprints() const override { return true; }
+
+	/**
+	 * Reports that results depend on every Blueprint calling into the validated one.
+	 *
+	 * @return Always true
+	 */
+	virtual bool UsesFunctionReferenceIndex() const override { return true; }
+
+	/**
+	 * Returns the version of cached results, bumped when project-wide callers started counting.
+	 *
+	 * @return The cache version
+	 */
+	virtual int32 GetCacheVersion() const override { return 2; }
+
 };
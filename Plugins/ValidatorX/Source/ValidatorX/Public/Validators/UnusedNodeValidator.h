@@ -57,4 +57,65 @@ public:
 	 * @return EDataValidationResult::Passed if valid, Failed/Invalid otherwise
 	 */
 	virtual EDataValidationResult ValidateLoadedAsset_Implementation(const FAssetData& InAssetData, UObject* InAsset, FDataValidationContext& Context) override;
+
+	/**
+	 * Reports that this validator implements snapshot analysis.
+	 *
+	 * @return Always true
+	 */
+	virtual bool SupportsSnapshotAnalysis() const override { return true; }
+
+	/**
+	 * Reports that every issue only depends on the graph it is reported in.
+	 *
+	 * @return Always true
+	 */
+	virtual bool IsGraphLocal() const override { return true; }
+
+	/**
+	 * Analyzes a Blueprint snapshot. Safe to call from any thread.
+	 *
+	 * Reports every chain of nodes execution can never reach (see FExecReachability) once,
+	 * unless one of its nodes lies inside a comment box.
+	 *
+	 * @param Snapshot      Snapshot of the validated Blueprint
+	 * @param OutIssues     Receives the issues found
+	 */
+	virtual void AnalyzeSnapshot(const FBlueprintSnapshot& Snapshot, TArray<FValidatorXIssue>& OutIssues) const override;
+
+	/**
+	 * Discards unlinked events that a Blueprint deriving from the validated one implements.
+	 *
+	 * The derived Blueprints are found through the asset registry and loaded if needed.
+	 *
+	 * @param Blueprint     The validated Blueprint
+	 * @param Issue         The issue about to be committed
+	 * @return              False if the issue is an event implemented by a derived Blueprint
+	 */
+	virtual bool ConfirmIssue(UBlueprint* Blueprint, const FValidatorXIssue& Issue) const override;
+
+	/**
+	 * Adds the jump token of a committed issue.
+	 *
+	 * @param Blueprint     The validated Blueprint
+	 * @param Issue         The committed issue
+	 * @param Message       The message the issue was committed as
+	 */
+	virtual void AddIssueTokens(UBlueprint* Blueprint, const FValidatorXIssue& Issue, const TSharedRef<FTokenizedMessage>& Message) const override;
+
+	/**
+	 * Returns the version of cached results, bumped when unused nodes became unreachable chains,
+	 * when ghost and overridden events stopped being reported, when overridden events started being
+	 * looked up in every saved derived Blueprint and when messages went back to node titles.
+	 *
+	 * @return The cache version
+	 */
+	virtual int32 GetCacheVersion() const override { return 5; }
+
+	/**
+	 * Reports that unlinked events are kept when a derived Blueprint implements them.
+	 *
+	 * @return Always true
+	 */
+	virtual bool DependsOnDerivedBlueprints() const override { return true; }
 };
@@ -11,7 +11,7 @@
 /**
  * @brief Represents a single row in the validator list table.
  *
- * Each row displays a validator's type, name, and an enable/disable button.
+ * Each row displays a validator's type, name, an enable/disable button and its execution counters.
  * Inherits from SMultiColumnTableRow to support multiple columns.
  */
 class VALIDATORX_API SValidatorTableRow : public SMultiColumnTableRow<TWeakObjectPtr<UBlueprintValidatorBase>>
@@ -81,6 +81,15 @@ public:
 	 */
 	virtual FReply OnKeyDown(const FGeometry& MyGeometry, const FKeyEvent& InKeyEvent) override;
 
+	/**
+	 * @brief Returns the value a stat column shows for a validator.
+	 *
+	 * @param InValidator The validator.
+	 * @param ColumnId One of the stat columns of `ValidatorListColumns`.
+	 * @return The count, or the time in milliseconds; 0 if the validator never ran.
+	 */
+	static double GetStatValue(const UBlueprintValidatorBase* InValidator, FName ColumnId);
+
 private:
 	/**
 	 * @brief Handles changes to the row's checkbox state.
@@ -112,6 +121,28 @@ private:
 	 */
 	[[nodiscard]] TSharedRef<SBox> GetButtonBox();
 
+	/**
+	 * @brief Creates the widget for a stat column, refreshed whenever new counters are recorded.
+	 *
+	 * @param ColumnId The stat column.
+	 * @return A shared reference to the widget displaying the stat.
+	 */
+	[[nodiscard]] TSharedRef<SBox> GetStatBox(FName ColumnId);
+
+	/**
+	 * @brief Creates the "Max" column, a drop-down listing the slowest assets of the validator.
+	 *
+	 * @return A shared reference to the drop-down.
+	 */
+	[[nodiscard]] TSharedRef<SBox> GetWorstAssetsBox();
+
+	/**
+	 * @brief Builds the menu of the slowest assets; selecting one shows it in the Content Browser.
+	 *
+	 * @return The menu widget.
+	 */
+	TSharedRef<SWidget> GetWorstAssetsMenu() const;
+
 	/**
 	 * @brief Retrieves the current state of the row's checkbox.
 	 *
@@ -4,14 +4,23 @@
 
 #include "CoreMinimal.h"
 #include "Widgets/SCompoundWidget.h"
+#include "ValidatorXTypes.h"
 
+class FValidatorXIssueTable;
+class FValidatorXValidationJob;
 class UBlueprintValidatorBase;
 
 /**
  * @brief Main widget for displaying and managing Blueprint validators.
  *
  * SValidatorWidget provides a UI for listing validators and interacting with them
- * via Slate widgets, including custom styles for checkboxes.
+ * via Slate widgets, including custom styles for checkboxes. Each validator row also shows
+ * the execution counters recorded in `FValidatorXStats`, sortable by column and exportable as CSV.
+ * Blueprints selected in the Content Browser are validated by a background `FValidatorXValidationJob`,
+ * whose progress is displayed with a Cancel button and whose messages are listed as assets finish.
+ * The results view reads the compact issue table of the job: only the rows on screen are generated,
+ * rows are grouped by validator, asset or folder and filtered as the user types, and jump and fix
+ * actions are only created when the actions menu of a row is opened.
  *
  * @ingroup ValidatorX
  */
@@ -36,7 +45,44 @@ public:
 	 */
 	void Construct(const FArguments& InArgs);
 
+	/**
+	 * @brief Re-sorts the list when new execution counters were recorded, and lists the new messages of the validation job.
+	 *
+	 * @param AllottedGeometry The geometry of this widget.
+	 * @param InCurrentTime Current absolute real time.
+	 * @param InDeltaTime Real time passed since the last tick.
+	 */
+	virtual void Tick(const FGeometry& AllottedGeometry, const double InCurrentTime, const float InDeltaTime) override;
+
 private:
+	/** @brief How the results view groups the messages. */
+	enum class EResultGrouping : uint8
+	{
+		Validator,
+		Asset,
+		Folder
+	};
+
+	/** @brief A line of the results view: a group header, or a message of an expanded group. */
+	struct FResultEntry
+	{
+		/** @brief Index of the group in `ResultGroups`. */
+		int32 Group = INDEX_NONE;
+
+		/** @brief Row of the message in the issue table, `INDEX_NONE` for the group header. */
+		int32 Row = INDEX_NONE;
+	};
+
+	/** @brief Messages sharing a validator, asset or folder. */
+	struct FResultGroup
+	{
+		/** @brief Validator name, package name or folder. */
+		FName Label;
+
+		/** @brief Rows of the filtered messages, ascending. */
+		TArray<int32> Rows;
+	};
+
 	/**
 	 * @brief Generates a row for each validator in the list.
 	 *
@@ -70,9 +116,187 @@ private:
 	 */
 	TSharedRef<SHeaderRow> GetValidatorHeaderRow();
 
+	/**
+	 * @brief Handles a click on a sortable column header.
+	 *
+	 * @param SortPriority The sort priority of the column.
+	 * @param ColumnId The clicked column.
+	 * @param NewSortMode The requested sort mode.
+	 */
+	void OnSortColumn(EColumnSortPriority::Type SortPriority, const FName& ColumnId, EColumnSortMode::Type NewSortMode);
+
+	/**
+	 * @brief Returns the sort mode displayed in a column header.
+	 *
+	 * @param ColumnId The column.
+	 * @return The sort mode if the list is sorted by this column, None otherwise.
+	 */
+	EColumnSortMode::Type GetColumnSortMode(FName ColumnId) const;
+
+	/** @brief Sorts `LocalValidators` by the current sort column; registration order if there is none. */
+	void SortValidators();
+
+	/**
+	 * @brief Writes the execution counters to `FValidatorXStats::GetDefaultCsvFilename` and notifies the user.
+	 *
+	 * @return Handled.
+	 */
+	FReply OnExportStatsClicked();
+
+	/**
+	 * @brief Drops every execution counter.
+	 *
+	 * @return Handled.
+	 */
+	FReply OnResetStatsClicked();
+
+	/**
+	 * @brief Starts a validation job on the Blueprints selected in the Content Browser.
+	 *
+	 * Without a selected asset, every Blueprint under the folder shown in the Content Browser is validated.
+	 *
+	 * @return Handled.
+	 */
+	FReply OnValidateSelectionClicked();
+
+	/**
+	 * @brief Cancels the running validation job.
+	 *
+	 * @return Handled.
+	 */
+	FReply OnCancelValidationClicked();
+
+	/**
+	 * @brief Applies the fixes of the selected messages with a `FValidatorXFixBatch`.
+	 *
+	 * A selected group header selects every message of the group. The assets of the job are
+	 * validated again afterwards, so the list no longer shows the fixed issues.
+	 *
+	 * @return Handled.
+	 */
+	FReply OnFixSelectedClicked();
+
+	/** @return Whether a validation job is running. */
+	bool IsValidationRunning() const;
+
+	/** @return The progress of the validation job, zero if none was started. */
+	TOptional<float> GetValidationProgress() const;
+
+	/** @return Progress, rate and remaining time of the running job, or the summary of the last one. */
+	FText GetValidationStatusText() const;
+
+	/**
+	 * @brief Groups the messages the validation job added since the last call.
+	 *
+	 * While the job runs, the view is updated a few times per second rather than every frame.
+	 */
+	void RefreshResults();
+
+	/** @return The issue table of the displayed job, null if there is none. */
+	const FValidatorXIssueTable* GetDisplayedIssueTable() const;
+
+	/** @brief Drops the groups, so every message is filtered and grouped again. */
+	void ResetResultGroups();
+
+	/** @brief Filters the messages added to the issue table since the last call and adds them to their group. */
+	void UpdateResultGroups();
+
+	/** @brief Rebuilds the lines of the results view from the groups, sorted by label. */
+	void RebuildResultEntries();
+
+	/**
+	 * @brief Filters the results view.
+	 *
+	 * @param InFilterText The text to search for in asset, folder, validator and message.
+	 */
+	void OnResultFilterChanged(const FText& InFilterText);
+
+	/**
+	 * @brief Regroups the results view.
+	 *
+	 * @param InGrouping The new grouping.
+	 */
+	void OnResultGroupingChanged(EResultGrouping InGrouping);
+
+	/**
+	 * @brief Generates a line of the results view.
+	 *
+	 * @param InEntry The group header or message.
+	 * @param OwnerTable The results view.
+	 * @return The generated table row.
+	 */
+	TSharedRef<ITableRow> OnGenerateResultRow(TSharedPtr<FResultEntry> InEntry, const TSharedRef<STableViewBase>& OwnerTable);
+
+	/**
+	 * @brief Expands or collapses a clicked group.
+	 *
+	 * @param InEntry The clicked line.
+	 */
+	void OnResultClicked(TSharedPtr<FResultEntry> InEntry);
+
+	/**
+	 * @brief Runs the first action of a double-clicked message, usually its jump, or opens its asset.
+	 *
+	 * @param InEntry The double-clicked line.
+	 */
+	void OnResultDoubleClicked(TSharedPtr<FResultEntry> InEntry);
+
+	/**
+	 * @brief Creates the actions menu of a message, with the action tokens of its validator.
+	 *
+	 * @param Row Row of the message in the issue table.
+	 * @return The menu.
+	 */
+	TSharedRef<SWidget> MakeResultActionsMenu(int32 Row) const;
+
 	/** @brief Local copy of validators for internal widget use. */
 	TArray<TWeakObjectPtr<UBlueprintValidatorBase>> LocalValidators;
 
+	/** @brief Validators in registration order, restored when sorting is cleared. */
+	TArray<TWeakObjectPtr<UBlueprintValidatorBase>> RegisteredValidators;
+
+	/** @brief Column the list is sorted by, none for registration order. */
+	FName SortColumn;
+
+	/** @brief Sort direction of `SortColumn`. */
+	EColumnSortMode::Type SortMode = EColumnSortMode::None;
+
+	/** @brief Stats revision the list was last sorted with. */
+	uint32 SortedStatsRevision = 0;
+
+	/** @brief Lines of the results view. */
+	TArray<TSharedPtr<FResultEntry>> ResultEntries;
+
+	/** @brief Groups of the filtered messages. */
+	TArray<FResultGroup> ResultGroups;
+
+	/** @brief Index in `ResultGroups` of every group label. */
+	TMap<FName, int32> ResultGroupIndices;
+
+	/** @brief Labels of the expanded groups; groups start collapsed. */
+	TSet<FName> ExpandedResultGroups;
+
+	/** @brief How the results view groups the messages. */
+	EResultGrouping ResultGrouping = EResultGrouping::Validator;
+
+	/** @brief Text the results view is filtered with. */
+	FString ResultFilterText;
+
+	/** @brief The validation job whose messages are listed. */
+	TWeakPtr<FValidatorXValidationJob> DisplayedJob;
+
+	/** @brief Number of rows of the issue table already filtered and grouped. */
+	int32 NumGroupedRows = 0;
+
+	/** @brief Time the results view was last updated while the job was running. */
+	double LastResultsUpdateTime = 0.0;
+
+	/** @brief Whether `DisplayedJob` was running on the last tick, to notify the user once it finishes. */
+	bool bWasJobRunning = false;
+
+	/** @brief List widget for displaying the messages of the validation job. */
+	TSharedPtr<SListView<TSharedPtr<FResultEntry>>> ResultListWidget;
+
 	/** @brief List widget for displaying validators. */
 	TSharedPtr<SListView<TWeakObjectPtr<UBlueprintValidatorBase>>> ListViewWidget;
 
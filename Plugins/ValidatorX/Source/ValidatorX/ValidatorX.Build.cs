@@ -45,6 +45,10 @@ public class ValidatorX : ModuleRules
 				"InputCore",
 				"ToolMenus",
 				"AssetRegistry",
+				"ContentBrowser",
+				"ContentBrowserData",
+				"MessageLog",
+				"Json",
                 "WorkspaceMenuStructure",
             }
 			);